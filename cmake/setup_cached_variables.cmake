@@ -24,6 +24,7 @@
 #     DEAL_II_ALLOW_BUNDLED
 #     DEAL_II_COMPONENT_DOCUMENTATION
 #     DEAL_II_COMPONENT_EXAMPLES
+#     DEAL_II_COMPONENT_MATRIX_FREE_HIGH_DEGREE
 #     DEAL_II_COMPONENT_PACKAGE
 #     DEAL_II_COMPONENT_PYTHON_BINDINGS
 #     DEAL_II_FORCE_AUTODETECTION
@@ -89,6 +90,12 @@ OPTION(DEAL_II_COMPONENT_EXAMPLES
   )
 LIST(APPEND DEAL_II_COMPONENTS EXAMPLES)
 
+OPTION(DEAL_II_COMPONENT_MATRIX_FREE_HIGH_DEGREE
+  "Precompile the sum factorization kernels used by FEEvaluation with a polynomial degree that is only known at run time also for the degrees 7 to 15. This adds considerably to the compile time of the library."
+  OFF
+  )
+LIST(APPEND DEAL_II_COMPONENTS MATRIX_FREE_HIGH_DEGREE)
+
 OPTION(DEAL_II_COMPONENT_PACKAGE
   "Generates additional targets for packaging deal.II"
   OFF
@@ -454,7 +461,7 @@ FOREACH(_var ${_res})
   #
   # Same for components:
   #
-  IF(_var MATCHES "^(DOCUMENTATION|EXAMPLES|PACKAGE|PYTHON_BINDINGS)")
+  IF(_var MATCHES "^(DOCUMENTATION|EXAMPLES|MATRIX_FREE_HIGH_DEGREE|PACKAGE|PYTHON_BINDINGS)")
     SET(DEAL_II_COMPONENT_${_var} ${${_var}} CACHE BOOL "" FORCE)
     UNSET(${_var} CACHE)
   ENDIF()
@@ -1,504 +1,876 @@
-
-#ifndef dealii_fe_cont_hermite
-#define dealii_fe_cont_hermite
-
-#define HERMITE_CUSTOM_FE_CLASS 0
-
-#include <deal.II/base/config.h>
-
-#include <deal.II/base/polynomials_hermite.h>
-#include <deal.II/base/tensor_product_polynomials.h>
-#include <deal.II/base/thread_management.h>
-
-#include <deal.II/dofs/dof_handler.h>
-
-#include <deal.II/fe/fe_poly.h>
-#include <deal.II/fe/mapping_hermite.h>
-
-#include <deal.II/numerics/vector_tools_project.h>
-
-#include <string>
-#include <vector>
-
-
-DEAL_II_NAMESPACE_OPEN
-
-/**
- * Header file for constructing a Hermite basis. Maximum regularity elements
- * are always of odd polynomial degree, have regularity $q = (p-1)/2$ and are
- * defined up to degree $p=13$. Custom regularity elements are defined by
- * adding Lagrange-style interplation nodes inside the elements.
- *
- * For maximum regularity elements each node has (q+1)^d degrees of freedom
- * (d.o.fs) assigned to it, corresponding to the different combinations of
- * directional derivatives up to the required regularity at that node. DoFs
- * at each node are not consecutive in either the global or local ordering,
- * due to the tensor product construction of the basis. The ordering is
- * determined by the direction of the derivative each function corresponds to;
- * first by x-derivatives, then y, then z. Locally over each element the
- * d.o.fs are ordered similarly. See below for the local ordering for
- * regularity 1 (FE_MaxHermite(1)):
- *
- *       (40,41,44,45)__(42,43,46,47)          (40,41,44,45)__(42,43,46,47)
- *       (56,57,60,61)  (58,59,62,63)          (56,57,60,61)  (58,59,62,63)
- *          /  |              |                    /           /  |
- *         /   |              |                   /           /   |
- *        /    |              |                  /           /    |
- *(32,33,36,37)|              |         (32,33,36,37)__(34,35,38,39)
- *(48,49,52,53)|              |         (48,49,52,53)  (50,51,54,55)
- *       |     |              |                |            |     |
- *       |( 8,9,12,13 )__(10,11,14,15)         |            |(10,11,14,15)
- *       |(24,25,28,29)  (26,27,30,31)         |            |(26,27,30,31)
- *       |    /              /                 |            |    /
- *       |   /              /                  |            |   /
- *       |  /              /                   |            |  /
- *  (  0,1,4,5  )___(  2,3,6,7  )      (  0,1,4,5  )___(  2,3,6,7  )
- *  (16,17,20,21)   (18,19,22,23)      (16,17,20,21)   (18,19,22,23)
-
- *
- * For custom regularity elements extra degrees of freedom are included at
- * interpolation points along the element edges, faces and in the element
- * interior. Edge nodes will have (q+1)^(d-1) d.o.fs, face nodes (q+1)^(d-2)
- * etc.  This will lead to a total of (2q+n+2)^d basis functions that are
- * non-zero on any given element, where n is the number of interpolation nodes
- * added in a given direction. d.o.fs are ordered by derivatives in the same
- * way as before, with derivatives parallel to the edge or face an
- * interpolation node is on disregarded. See below for the local ordering over
- * an element for regularity 1 with one interpolation node
- * (FE_CustomHermite(1,1)):
- *
- *
- *                 (90,91,95,96)  __  (92,97) ___  (93,94,98,99)
- *               (115,116,120,121)   (117,122)   (118,119,123,124)
- *                      /|                               |
- *                     / |                               |
- *                    /  |                               |
- *                   /   |                               |
- *               (85,86) |                               |
- *              (110,111)|                               |
- *                /      |                               |
- *               /       |                               |
- *              /  (65,66,70,71)      (67,72)      (68,69,73,74)
- *             /         |                               |
- *       (75,76,80,81)   |                               |
- *     (100,101,105,106) |                               |
- *            |          |                               |
- *            |          |                               |
- *            |  (60,61) |       (62)                    |
- *            |          |                               |
- *            |          |                               |
- *            |          |                               |
- *            |    (15,16,20,21)______(17,22)______(18,19,23,24)
- *            |    (40,41,45,46)      (42,47)      (43,44,48,49)
- *      (50,51,55,56)   /                              /
- *            |        /                              /
- *            |       /                              /
- *            |      /                              /
- *            |  (10,11)         (12)           (13,14)
- *            |  (35,36)         (37)           (38,39)
- *            |   /                              /
- *            |  /                              /
- *            | /                              /
- *            |/                              /
- *      (  0,1,5,6  )______( 2,7 )______(  3,4,8,9  )
- *      (25,26,30,31)      (27,32)      (28,29,33,34)
- *
- *
- *
- *                 (90,91,95,96)  __ (92,97) ___  (93,94,98,99)
- *               (115,116,120,121)  (117,122)   (118,119,123,124)
- *                      /                              /|
- *                     /                              / |
- *                    /                              /  |
- *                   /                              /   |
- *               (85,86)         (87)           (88,89) |
- *              (110,111)       (112)          (113,114)|
- *                /                              /      |
- *               /                              /       |
- *              /                              /  (68,69,73,74)
- *             /                              /         |
- *      (75,76,80,81)  ___ (77,82) __  (78,79,83,84)    |
- *    (100,101,105,106)   (102,107)  (103,104,108,109)  |
- *            |                              |          |
- *            |                              |          |
- *            |                              | (63,64)  |
- *            |                              |          |
- *            |                              |          |
- *            |                              |          |
- *            |                              |    (18,19,23,24)
- *            |                              |    (43,44,48,49)
- *      (50,51,55,56)      (52,57)     (53,54,58,59)   /
- *            |                              |        /
- *            |                              |       /
- *            |                              |      /
- *            |                              |  (13,14)
- *            |                              |  (38,39)
- *            |                              |   /
- *            |                              |  /
- *            |                              | /
- *            |                              |/
- *      (  0,1,5,6  )______( 2,7 )______(  3,4,8,9  )
- *      (25,26,30,31)      (27,32)      (28,29,33,34)
- *
- *
- * DoF 62 lies at the centre of the cell in the above diagram.
- *
- * The interpolation points used lie at the Chebyshev Gauss-Lobatto points in
- * each direction. This distribution was chosen due to being easy to calculate
- * (an explicit formula exists) and to avoid the issue of the Runge phenomenom
- * as the number of nodes becomes larger.
- *
- * Note that while the number of functions defined on each cell appears large,
- * due to the increased regularity constraints many of these functions are
- * shared between elements.
- */
-
-/*
- * Use one class for both maximum regularity and custom regularity. To take
- * advantage of the easier math for the max regularity, define two sets of
- * functions differentiated by the number of input arguments.
- */
-
-
-template <int dim, int spacedim = dim>
-class FE_Hermite : public FE_Poly<dim, spacedim>
-{
-public:
-  /*
-   * Constructors
-   */
-  FE_Hermite<dim, spacedim>(const unsigned int regularity);
-#if HERMITE_CUSTOM_FE_CLASS
-  FE_Hermite<dim, spacedim>(const unsigned int regularity, const unsigned int nodes);
-#endif
-
-  /*
-   * Matrix functions, comparable to FE_Q_Base implementations
-   */
-  /*
-  virtual void
-  get_interpolation_matrix(const FiniteElement<dim, spacedim> &source,
-                         FullMatrix<double> &matrix) const override;
-
-  virtual void
-  get_face_interpolation_matrix(const FiniteElement<dim, spacedim> &source,
-                              FullMatrix<double> &matrix) const override;
-
-  virtual void
-  get_subface_interpolation_matrix(const FiniteElement<dim, spacedim> &source,
-                                 const unsigned int                  subface,
-                                 FullMatrix<double> &matrix) const override;
-
-  virtual bool
-  has_support_on_face(const unsigned int shape_index,
-                    const unsigned int face_index) const override;
-
-  virtual const FullMatrix<double> &
-  get_restriction_matrix(const unsigned int child,
-                         const RefinementCase<dim> &refinement_case =
-                         RefinementCase<dim>::isotropic_refinement) const
-  override;
-
-  virtual const FullMatrix<double> &
-  get_prolongation_matrix(const unsigned int child,
-                          const RefinementCase<dim> &refinement_case =
-                          RefinementCase<dim>::isotropic_refinement) const
-  override;
-
-  virtual unsigned int
-  face_to_cell_index(const unsigned int face_dof_index,
-                     const unsigned int face,
-                     const bool         face_orientation = true,
-                     const bool         face_flip        = false,
-                     const bool         face_rotation = false) const override;
-
-  virtual std::pair<Table<2, bool>, std::vector<unsigned int>>
-  get_constant_modes() const override;                                  // Should be quick to implement 
-  */
-  /*
-   * hp functions
-
-  virtual bool
-  hp_constraints_are_implemented() const override;
-
-  virtual std::vector<std::pair<unsigned int, unsigned int>>
-  hp_vertex_dof_identities(const FiniteElement<dim, spacedim> &fe_other) const
-  override;
-
-  virtual std::vector<std::pair<unsigned int, unsigned int>>
-  hp_line_dof_identities(const FiniteElement<dim, spacedim> &fe_other) const
-  override;
-
-  virtual std::vector<std::pair<unsigned int, unsigned int>>
-  hp_quad_dof_identities(const FiniteElement<dim, spacedim> &fe_other) const
-  override;
-  */
-  /*
-   * Other functions
-   */
-  virtual std::string
-  get_name() const override;
-
-  virtual std::unique_ptr<FiniteElement<dim, spacedim>>
-  clone() const override;
-  
-  virtual void
-  fill_fe_values(
-    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
-    const CellSimilarity::Similarity                            cell_similarity,
-    const Quadrature<dim> &                                     quadrature,
-    const Mapping<dim, spacedim> &                              mapping,
-    const typename Mapping<dim, spacedim>::InternalDataBase &mapping_internal,
-    const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
-                                                                       spacedim>
-      &                                                            mapping_data,
-    const typename FiniteElement<dim, spacedim>::InternalDataBase &fe_internal,
-    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
-                                                                       spacedim>
-      &output_data) const override;
-      
-  using FiniteElement<dim, spacedim>::fill_fe_face_values;
-  
-  virtual void
-  fill_fe_face_values(
-    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
-    const unsigned int                                          face_no,
-    const hp::QCollection<dim - 1> &                                 quadrature,
-    const Mapping<dim, spacedim> &                              mapping,
-    const typename Mapping<dim, spacedim>::InternalDataBase &   mapping_internal,
-    const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
-                                                                     spacedim>
-      &                                                            mapping_data,
-    const typename FiniteElement<dim, spacedim>::InternalDataBase &fe_internal,
-    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
-                                                                     spacedim>
-    &output_data) const override;
-      
-  
-  /*
-  virtual std::size_t
-  memory_consumption() const override;
-
-  virtual void
-  convert_generalized_support_point_values_to_dof_values(
-  const std::vector<Vector<double>> &support_point_values,
-  std::vector<double> &              nodal_values) const override;
-
-  virtual FiniteElementDomination::Domination
-  compare_for_domination(const FiniteElement<dim, spacedim> &fe_other,
-                       const unsigned int codim = 0) const override final;
-  */
-protected:
-  void
-  initialize_constraints();
-  // void initialize_quad_dof_index_permutation();
-
-  struct Implementation;
-  friend struct FE_Hermite<dim, spacedim>::Implementation;
-  
-  /*virtual std::unique_ptr<
-  typename FiniteElement<dim, spacedim>::InternalDataBase>
-  get_data(
-    const UpdateFlags update_flags,
-    const Mapping<dim, spacedim> & / *mapping* /,
-    const Quadrature<dim> &quadrature,
-    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
-                                                                       spacedim>
-      &/ * output_data* /) const override
-  {
-    // generate a new data object and
-    // initialize some fields
-    std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>
-          data_ptr   = std::make_unique<typename FE_Poly<dim, spacedim>::InternalData>();
-    auto &data       = dynamic_cast<typename FE_Poly<dim, spacedim>::InternalData &>(*data_ptr);
-    data.update_each = this->requires_update_flags(update_flags);
-
-    const unsigned int n_q_points = quadrature.size();
-
-    // initialize some scratch arrays. we need them for the underlying
-    // polynomial to put the values and derivatives of shape functions
-    // to put there, depending on what the user requested
-    std::vector<double> values(
-      update_flags & update_values ? this->dofs_per_cell : 0);
-    std::vector<Tensor<1, dim>> grads(
-      update_flags & update_gradients ? this->dofs_per_cell : 0);
-    std::vector<Tensor<2, dim>> grad_grads(
-      update_flags & update_hessians ? this->dofs_per_cell : 0);
-    std::vector<Tensor<3, dim>> third_derivatives(
-      update_flags & update_3rd_derivatives ? this->dofs_per_cell : 0);
-    std::vector<Tensor<4, dim>>
-      fourth_derivatives; // won't be needed, so leave empty
-
-    // now also initialize fields the fields of this class's own
-    // temporary storage, depending on what we need for the given
-    // update flags.
-    //
-    // there is one exception from the rule: if we are dealing with
-    // cells (i.e., if this function is not called via
-    // get_(sub)face_data()), then we can already store things in the
-    // final location where FEValues::reinit() later wants to see
-    // things. we then don't need the intermediate space. we determine
-    // whether we are on a cell by asking whether the number of
-    // elements in the output array equals the number of quadrature
-    // points (yes, it's a cell) or not (because in that case the
-    // number of quadrature points we use here equals the number of
-    // quadrature points summed over *all* faces or subfaces, whereas
-    // the number of output slots equals the number of quadrature
-    // points on only *one* face)
-    if (update_flags & update_values)
-      data.shape_values.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_gradients)
-      data.shape_gradients.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_hessians)
-      data.shape_hessians.reinit(this->dofs_per_cell, n_q_points);
-
-    if (update_flags & update_3rd_derivatives)
-      data.shape_3rd_derivatives.reinit(this->dofs_per_cell, n_q_points);
-
-    // next already fill those fields of which we have information by
-    // now. note that the shape gradients are only those on the unit
-    // cell, and need to be transformed when visiting an actual cell
-    if (update_flags & (update_values | update_gradients | update_hessians |
-                        update_3rd_derivatives))
-      for (unsigned int i = 0; i < n_q_points; ++i)
-        {
-          this->poly_space->evaluate(quadrature.point(i),
-                              values,
-                              grads,
-                              grad_grads,
-                              third_derivatives,
-                              fourth_derivatives);
-
-          // for Hermite everything needs to be transformed,
-          // so we write them into our scratch space and only later
-          // copy stuff into where FEValues wants it
-          if (update_flags & update_values)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_values[k][i] = values[k];
-
-          if (update_flags & update_gradients)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_gradients[k][i] = grads[k];
-
-          if (update_flags & update_hessians)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_hessians[k][i] = grad_grads[k];
-
-          if (update_flags & update_3rd_derivatives)
-            for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-              data.shape_3rd_derivatives[k][i] = third_derivatives[k];
-        }
-    return data_ptr;
-  }*/
-  
-  virtual std::unique_ptr<
-  typename FiniteElement<dim, spacedim>::InternalDataBase>
-  get_data(
-    const UpdateFlags             update_flags,
-    const Mapping<dim, spacedim> &mapping,
-    const Quadrature<dim> &       quadrature,
-    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
-                                                                       spacedim>
-      &output_data) const override
-  {
-    std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>
-          data_ptr   = FE_Poly<dim, spacedim>::get_data(update_flags, mapping, quadrature, output_data);
-    auto &data       = dynamic_cast<typename FE_Poly<dim, spacedim>::InternalData &>(*data_ptr);
-    const unsigned int n_q_points = quadrature.size();
-    if ((update_flags & update_values) &&
-        ((output_data.shape_values.n_rows() > 0) &&
-         (output_data.shape_values.n_cols() == n_q_points)))
-      data.shape_values = output_data.shape_values;
-    return data_ptr;
-  }
-
-private:
-  mutable Threads::Mutex mutex;
-  unsigned int           regularity;
-  unsigned int           nodes;
-  
-public:
-  inline unsigned int
-  get_regularity() const
-  {return this->regularity;};
-  
-  inline unsigned int
-  n_nodes() const
-  {return this->nodes;};
-};
-
-
-
-namespace VectorTools
-{
-    enum HermiteBoundaryType {
-            hermite_dirichlet,
-            hermite_neumann,
-            hermite_2nd_derivative,
-            hermite_robin,
-            hermite_other_combined
-    };
-    
-    template <int dim, int spacedim = dim, typename Number = double>
-    void
-    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
-                            const DoFHandler<dim, spacedim> &                                      dof_handler,
-                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                            const Quadrature<dim - 1> &                                            quadrature,
-                            const HermiteBoundaryType                                              projection_mode,
-                            std::map<types::global_dof_index, Number> &                            boundary_values,
-                            std::vector<unsigned int>                                              component_mapping = {});
-    
-    //The following does exactly the same as the above, but uses hermite_dirichlet. This is to match existing function calls
-    template <int dim, int spacedim = dim, typename Number = double>
-    void
-    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
-                            const DoFHandler<dim, spacedim> &                                      dof_handler,
-                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                            const Quadrature<dim - 1> &                                            quadrature,
-                            std::map<types::global_dof_index, Number> &                            boundary_values,
-                            std::vector<unsigned int>                                              component_mapping = {});
-    
-    template <int dim, int spacedim = dim, typename Number = double>
-    void
-    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
-                            const DoFHandler<dim, spacedim> &                                      dof_handler,
-                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                            const Quadrature<dim - 1> &                                            quadrature,
-                            const HermiteBoundaryType                                              projection_mode,
-                            AffineConstraints<Number>                                              constraints,
-                            std::vector<unsigned int>                                              component_mapping = {});
-    
-    //Same as above, but with hermite_dirichlet set
-    template <int dim, int spacedim = dim, typename Number = double>
-    void
-    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
-                            const DoFHandler<dim, spacedim> &                                      dof_handler,
-                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                            const Quadrature<dim - 1> &                                            quadrature,
-                            AffineConstraints<Number>                                              constraints,
-                            std::vector<unsigned int>                                              component_mapping = {});
-    
-    //Overwrite the following function in the case of Hermite elements to account for poorer conditioning
-    using VectorTools::project;
-    
-    template <int dim, typename VectorType, int spacedim> void
-    project(const MappingHermite<dim, spacedim> &                     mapping,
-            const DoFHandler<dim, spacedim> &                         dof,
-            const AffineConstraints<typename VectorType::value_type> &constraints,
-            const Quadrature<dim> &                                   quadrature,
-            const Function<spacedim, typename VectorType::value_type> &function,
-            VectorType &                                               vec,
-            const bool                 enforce_zero_boundary     = false,
-            const Quadrature<dim - 1> &q_boundary                = (dim > 1 ?
-                                                       QGauss<dim - 1>(2) :
-                                                       Quadrature<dim - 1>(0)),
-            const bool                 project_to_boundary_first = false);
-    
-}
-
-DEAL_II_NAMESPACE_CLOSE
-
-#endif
+
+#ifndef dealii_fe_cont_hermite
+#define dealii_fe_cont_hermite
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/polynomials_hermite.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/thread_management.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_project.h>
+
+#include <array>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * Header file for constructing a Hermite basis. Maximum regularity elements
+ * are always of odd polynomial degree, have regularity $q = (p-1)/2$ and are
+ * defined up to degree $p=13$. Custom regularity elements are defined by
+ * adding Lagrange-style interplation nodes inside the elements.
+ *
+ * For maximum regularity elements each node has (q+1)^d degrees of freedom
+ * (d.o.fs) assigned to it, corresponding to the different combinations of
+ * directional derivatives up to the required regularity at that node. DoFs
+ * at each node are not consecutive in either the global or local ordering,
+ * due to the tensor product construction of the basis. The ordering is
+ * determined by the direction of the derivative each function corresponds to;
+ * first by x-derivatives, then y, then z. Locally over each element the
+ * d.o.fs are ordered similarly. See below for the local ordering for
+ * regularity 1 (FE_MaxHermite(1)):
+ *
+ *       (40,41,44,45)__(42,43,46,47)          (40,41,44,45)__(42,43,46,47)
+ *       (56,57,60,61)  (58,59,62,63)          (56,57,60,61)  (58,59,62,63)
+ *          /  |              |                    /           /  |
+ *         /   |              |                   /           /   |
+ *        /    |              |                  /           /    |
+ *(32,33,36,37)|              |         (32,33,36,37)__(34,35,38,39)
+ *(48,49,52,53)|              |         (48,49,52,53)  (50,51,54,55)
+ *       |     |              |                |            |     |
+ *       |( 8,9,12,13 )__(10,11,14,15)         |            |(10,11,14,15)
+ *       |(24,25,28,29)  (26,27,30,31)         |            |(26,27,30,31)
+ *       |    /              /                 |            |    /
+ *       |   /              /                  |            |   /
+ *       |  /              /                   |            |  /
+ *  (  0,1,4,5  )___(  2,3,6,7  )      (  0,1,4,5  )___(  2,3,6,7  )
+ *  (16,17,20,21)   (18,19,22,23)      (16,17,20,21)   (18,19,22,23)
+
+ *
+ * For custom regularity elements extra degrees of freedom are included at
+ * interpolation points along the element edges, faces and in the element
+ * interior. Edge nodes will have (q+1)^(d-1) d.o.fs, face nodes (q+1)^(d-2)
+ * etc.  This will lead to a total of (2q+n+2)^d basis functions that are
+ * non-zero on any given element, where n is the number of interpolation nodes
+ * added in a given direction. d.o.fs are ordered by derivatives in the same
+ * way as before, with derivatives parallel to the edge or face an
+ * interpolation node is on disregarded. See below for the local ordering over
+ * an element for regularity 1 with one interpolation node
+ * (FE_CustomHermite(1,1)):
+ *
+ *
+ *                 (90,91,95,96)  __  (92,97) ___  (93,94,98,99)
+ *               (115,116,120,121)   (117,122)   (118,119,123,124)
+ *                      /|                               |
+ *                     / |                               |
+ *                    /  |                               |
+ *                   /   |                               |
+ *               (85,86) |                               |
+ *              (110,111)|                               |
+ *                /      |                               |
+ *               /       |                               |
+ *              /  (65,66,70,71)      (67,72)      (68,69,73,74)
+ *             /         |                               |
+ *       (75,76,80,81)   |                               |
+ *     (100,101,105,106) |                               |
+ *            |          |                               |
+ *            |          |                               |
+ *            |  (60,61) |       (62)                    |
+ *            |          |                               |
+ *            |          |                               |
+ *            |          |                               |
+ *            |    (15,16,20,21)______(17,22)______(18,19,23,24)
+ *            |    (40,41,45,46)      (42,47)      (43,44,48,49)
+ *      (50,51,55,56)   /                              /
+ *            |        /                              /
+ *            |       /                              /
+ *            |      /                              /
+ *            |  (10,11)         (12)           (13,14)
+ *            |  (35,36)         (37)           (38,39)
+ *            |   /                              /
+ *            |  /                              /
+ *            | /                              /
+ *            |/                              /
+ *      (  0,1,5,6  )______( 2,7 )______(  3,4,8,9  )
+ *      (25,26,30,31)      (27,32)      (28,29,33,34)
+ *
+ *
+ *
+ *                 (90,91,95,96)  __ (92,97) ___  (93,94,98,99)
+ *               (115,116,120,121)  (117,122)   (118,119,123,124)
+ *                      /                              /|
+ *                     /                              / |
+ *                    /                              /  |
+ *                   /                              /   |
+ *               (85,86)         (87)           (88,89) |
+ *              (110,111)       (112)          (113,114)|
+ *                /                              /      |
+ *               /                              /       |
+ *              /                              /  (68,69,73,74)
+ *             /                              /         |
+ *      (75,76,80,81)  ___ (77,82) __  (78,79,83,84)    |
+ *    (100,101,105,106)   (102,107)  (103,104,108,109)  |
+ *            |                              |          |
+ *            |                              |          |
+ *            |                              | (63,64)  |
+ *            |                              |          |
+ *            |                              |          |
+ *            |                              |          |
+ *            |                              |    (18,19,23,24)
+ *            |                              |    (43,44,48,49)
+ *      (50,51,55,56)      (52,57)     (53,54,58,59)   /
+ *            |                              |        /
+ *            |                              |       /
+ *            |                              |      /
+ *            |                              |  (13,14)
+ *            |                              |  (38,39)
+ *            |                              |   /
+ *            |                              |  /
+ *            |                              | /
+ *            |                              |/
+ *      (  0,1,5,6  )______( 2,7 )______(  3,4,8,9  )
+ *      (25,26,30,31)      (27,32)      (28,29,33,34)
+ *
+ *
+ * DoF 62 lies at the centre of the cell in the above diagram.
+ *
+ * The interpolation points used lie at the Chebyshev Gauss-Lobatto points in
+ * each direction. This distribution was chosen due to being easy to calculate
+ * (an explicit formula exists) and to avoid the issue of the Runge phenomenom
+ * as the number of nodes becomes larger.
+ *
+ * Note that while the number of functions defined on each cell appears large,
+ * due to the increased regularity constraints many of these functions are
+ * shared between elements.
+ */
+
+/*
+ * Use one class for both maximum regularity and custom regularity. To take
+ * advantage of the easier math for the max regularity, define two sets of
+ * functions differentiated by the number of input arguments.
+ */
+
+
+template <int dim, int spacedim = dim>
+class FE_Hermite : public FE_Poly<dim, spacedim>
+{
+public:
+  /*
+   * Constructors
+   */
+  FE_Hermite<dim, spacedim>(const unsigned int regularity);
+
+  /*
+   * Custom regularity element of polynomial degree 2*regularity+1+nodes,
+   * with @p nodes interpolation nodes at the Chebyshev Gauss-Lobatto points
+   * in the interior of each direction. With @p nodes equal to zero this is
+   * the maximum regularity element.
+   */
+  FE_Hermite<dim, spacedim>(const unsigned int regularity,
+                            const unsigned int nodes);
+
+  /**
+   * Return whether the shape function @p shape_index is nonzero on the face
+   * @p face_index. The shape functions associated with derivatives of order
+   * one or higher in the direction normal to a face vanish on it, so only
+   * $(p+1)^{d-1}$ of the shape functions of the $(r+1)\,(p+1)^{d-1}$
+   * degrees of freedom on a face, for regularity $r$ and polynomial degree
+   * $p$, have support there. The answers are computed in the constructor.
+   */
+  virtual bool
+  has_support_on_face(const unsigned int shape_index,
+                      const unsigned int face_index) const override;
+
+  /*
+   * hp functions
+   */
+
+  /**
+   * Return true. The constraints between cells with different FE_Hermite
+   * elements depend on the size of the cells, since the degrees of freedom
+   * are derivatives in real space, so they are not computed from face
+   * interpolation matrices but by DoFTools::make_hanging_node_constraints()
+   * directly.
+   */
+  virtual bool
+  hp_constraints_are_implemented() const override;
+
+  /**
+   * The derivatives at a vertex of the same order in each direction are
+   * identical for two FE_Hermite elements, as long as the order does not
+   * exceed the regularity of either element. The normalization of the
+   * degrees of freedom of order $m$ by $m!\,4^m$ is the same for all
+   * regularities and numbers of interpolation nodes.
+   */
+  virtual std::vector<std::pair<unsigned int, unsigned int>>
+  hp_vertex_dof_identities(
+    const FiniteElement<dim, spacedim> &fe_other) const override;
+
+  /**
+   * The degrees of freedom on a line are the derivatives normal to it at
+   * the interpolation nodes. They are identical for two FE_Hermite elements
+   * with the same number of interpolation nodes, for orders up to the
+   * smaller regularity.
+   */
+  virtual std::vector<std::pair<unsigned int, unsigned int>>
+  hp_line_dof_identities(
+    const FiniteElement<dim, spacedim> &fe_other) const override;
+
+  /**
+   * Same as hp_line_dof_identities() for the degrees of freedom on the
+   * faces of a hexahedron.
+   */
+  virtual std::vector<std::pair<unsigned int, unsigned int>>
+  hp_quad_dof_identities(const FiniteElement<dim, spacedim> &fe_other,
+                         const unsigned int face_no = 0) const override;
+
+  /**
+   * Like FE_Q, the element of lower polynomial degree dominates, since the
+   * traces of both elements on a face are the polynomials of their degree.
+   */
+  virtual FiniteElementDomination::Domination
+  compare_for_domination(const FiniteElement<dim, spacedim> &fe_other,
+                         const unsigned int codim = 0) const override final;
+
+  /*
+   * Other functions
+   */
+
+  /**
+   * Return the matrix that maps the degrees of freedom of the 1D element on
+   * the unit interval to the ones of its left (@p child = 0) or right
+   * (@p child = 1) half, both in lexicographic numbering. Since the degrees
+   * of freedom are derivatives in real space, entry $(j,k)$ is the
+   * derivative of order $m_j$ of the basis function $k$ at the end point of
+   * the child that degree of freedom $j$ belongs to, or its value at the
+   * interpolation node for the degrees of freedom in the interior of the
+   * interval. The matrices are computed once in the constructor, from the
+   * Bernstein representation of the basis by de Casteljau subdivision for
+   * maximum regularity elements and by direct evaluation of the basis
+   * otherwise.
+   *
+   * The prolongation matrices of the element are the tensor products of
+   * these matrices: entry $(i,j)$ is the product over all directions $d$ of
+   * the entries of the 1D matrix of the child in direction $d$ at the
+   * lexicographic indices of $i$ and $j$ in that direction, as given by
+   * FE_Poly::get_poly_space_numbering(). Transfer operators can use this
+   * structure to apply the prolongation with sum factorization rather than
+   * with the full matrix of size $(p+1)^{2\,dim}$.
+   *
+   * On a cell with extents other than one, the matrices need to be
+   * rescaled according to compute_dof_rescaling() as
+   * $D^{-1} P D$, and the same holds for hanging node constraints, which is
+   * why DoFTools::make_hanging_node_constraints() and
+   * DoFCellAccessor::set_dof_values_by_interpolation() treat this element
+   * separately.
+   */
+  const FullMatrix<double> &
+  get_prolongation_matrix_1d(const unsigned int child) const;
+
+  /**
+   * Return the 1D restriction matrix of the left (@p child = 0) or right
+   * (@p child = 1) half of the unit interval, with the same tensor product
+   * structure as described for get_prolongation_matrix_1d(). The
+   * restriction injects the derivatives at the vertex the parent shares
+   * with the child, which needs no rescaling, and for custom regularity
+   * elements the values at those interpolation nodes of the parent that lie
+   * in the child.
+   */
+  const FullMatrix<double> &
+  get_restriction_matrix_1d(const unsigned int child) const;
+
+  /**
+   * Return the mass matrix of the 1D element on the unit interval, in
+   * lexicographic numbering. Entry $(i,j)$ is the integral of the product of
+   * the 1D basis functions $i$ and $j$, computed exactly by Gauss
+   * quadrature in the constructor.
+   *
+   * Since the shape functions on a cell are tensor products of the 1D basis
+   * functions in the coordinates along the edges, the mass matrix of an
+   * axis-parallel cell is the Kronecker product of the 1D mass matrices
+   * returned by compute_matrices_1d() for the extents of the cell, and its
+   * Laplace matrix is the sum over the directions $d$ of the Kronecker
+   * products with the 1D Laplace matrix in direction $d$ and the 1D mass
+   * matrices in all other directions. TensorProductMatrixHermite uses this
+   * structure to apply these matrices and their inverses with sum
+   * factorization.
+   */
+  const FullMatrix<double> &
+  get_mass_matrix_1d() const;
+
+  /**
+   * Return the Laplace matrix of the 1D element on the unit interval, in
+   * lexicographic numbering. Entry $(i,j)$ is the integral of the product of
+   * the first derivatives of the 1D basis functions $i$ and $j$.
+   */
+  const FullMatrix<double> &
+  get_laplace_matrix_1d() const;
+
+  /**
+   * Compute the 1D mass and Laplace matrices of an interval of length
+   * @p extent in lexicographic numbering. The basis function belonging to a
+   * derivative of order $k_i$ is scaled by $h^{k_i}$ as described for
+   * compute_dof_rescaling(), so entry $(i,j)$ of the matrices returned by
+   * get_mass_matrix_1d() and get_laplace_matrix_1d() is multiplied by
+   * $h^{k_i+k_j+1}$ and $h^{k_i+k_j-1}$, respectively.
+   */
+  void
+  compute_matrices_1d(const double        extent,
+                      FullMatrix<double> &mass_matrix,
+                      FullMatrix<double> &laplace_matrix) const;
+
+  /**
+   * Embedding matrix between the mother element and the child element with
+   * the given @p child index. The matrix is computed as a tensor product of
+   * the 1D matrices returned by get_prolongation_matrix_1d() upon the first
+   * request and then cached. Directions in which the cell is not refined
+   * use the identity.
+   */
+  virtual const FullMatrix<double> &
+  get_prolongation_matrix(
+    const unsigned int         child,
+    const RefinementCase<dim> &refinement_case =
+      RefinementCase<dim>::isotropic_refinement) const override;
+
+  /**
+   * Projection from the child element with the given @p child index to the
+   * mother element. Computed and cached like get_prolongation_matrix().
+   */
+  virtual const FullMatrix<double> &
+  get_restriction_matrix(
+    const unsigned int         child,
+    const RefinementCase<dim> &refinement_case =
+      RefinementCase<dim>::isotropic_refinement) const override;
+
+  /**
+   * Compute the factors $\prod_d h_d^{k_d}$ by which the shape functions on
+   * a cell with extents @p cell_extents differ from the ones on the
+   * reference cell, where $k_d$ is the order of the derivative a shape
+   * function is associated with in direction $d$. The factors are stored in
+   * @p dof_rescaling in the numbering of the shape functions.
+   */
+  void
+  compute_dof_rescaling(const Tensor<1, dim> &cell_extents,
+                        std::vector<double> & dof_rescaling) const;
+
+  virtual std::string
+  get_name() const override;
+
+  virtual std::unique_ptr<FiniteElement<dim, spacedim>>
+  clone() const override;
+
+  virtual void
+  fill_fe_values(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const CellSimilarity::Similarity                            cell_similarity,
+    const Quadrature<dim> &                                     quadrature,
+    const Mapping<dim, spacedim> &                              mapping,
+    const typename Mapping<dim, spacedim>::InternalDataBase &mapping_internal,
+    const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
+                                                                       spacedim>
+      &                                                            mapping_data,
+    const typename FiniteElement<dim, spacedim>::InternalDataBase &fe_internal,
+    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                       spacedim>
+      &output_data) const override;
+
+  using FiniteElement<dim, spacedim>::fill_fe_face_values;
+
+  virtual void
+  fill_fe_face_values(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const unsigned int                                          face_no,
+    const hp::QCollection<dim - 1> &                                 quadrature,
+    const Mapping<dim, spacedim> &                              mapping,
+    const typename Mapping<dim, spacedim>::InternalDataBase &   mapping_internal,
+    const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
+                                                                     spacedim>
+      &                                                            mapping_data,
+    const typename FiniteElement<dim, spacedim>::InternalDataBase &fe_internal,
+    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                     spacedim>
+    &output_data) const override;
+
+
+  /*
+  virtual std::size_t
+  memory_consumption() const override;
+
+  virtual void
+  convert_generalized_support_point_values_to_dof_values(
+  const std::vector<Vector<double>> &support_point_values,
+  std::vector<double> &              nodal_values) const override;
+  */
+protected:
+  /**
+   * Set up the 1D embedding and restriction matrices. The matrices for the
+   * cell are only formed from them when they are first requested.
+   */
+  void
+  initialize_embedding();
+
+  /**
+   * Set up the 1D embedding and restriction matrices of a custom regularity
+   * element by evaluating the basis at the positions of the degrees of
+   * freedom on the children.
+   */
+  void
+  initialize_embedding_custom();
+
+  /**
+   * Set up the 1D mass and Laplace matrices returned by
+   * get_mass_matrix_1d() and get_laplace_matrix_1d().
+   */
+  void
+  initialize_matrices_1d();
+
+  /**
+   * Determine the shape functions with support on each face, which are the
+   * ones of the values in the direction normal to the face.
+   */
+  void
+  initialize_face_support();
+
+  /**
+   * Fill @p matrix with the Kronecker product of the 1D matrices in
+   * @p matrices_1d that belong to the child with index @p child of a cell
+   * refined with @p refinement_case, in the numbering of the shape
+   * functions.
+   */
+  void
+  assemble_tensor_product(const std::array<FullMatrix<double>, 2> &matrices_1d,
+                          const unsigned int                       child,
+                          const RefinementCase<dim> &refinement_case,
+                          FullMatrix<double> &       matrix) const;
+  // void initialize_quad_dof_index_permutation();
+
+  /**
+   * Internal data for FE_Hermite. On top of the shape function tables on the
+   * reference cell that FE_Poly stores, this keeps everything needed to
+   * rescale the shape functions to the size of the current cell. The
+   * rescaling only depends on the cell extents, so it is computed once per
+   * cell and then applied to all quadrature points as a scaling of the rows
+   * of the shape function tables.
+   */
+  class InternalData : public FE_Poly<dim, spacedim>::InternalData
+  {
+  public:
+    /**
+     * Rescaling factor for each shape function on the current cell. A shape
+     * function associated with a derivative of order $(k_1, \ldots, k_d)$ is
+     * multiplied by $h_1^{k_1} \cdots h_d^{k_d}$, where $h_j$ are the cell
+     * extents returned by MappingHermite.
+     */
+    mutable std::vector<double> dof_rescaling;
+
+    /**
+     * Jacobian of the cell that @p dof_rescaling and the output tables were
+     * last computed for. If the next cell has exactly the same Jacobian, the
+     * rescaled shape function tables of the previous cell can be reused
+     * without touching them.
+     */
+    mutable DerivativeForm<1, dim, spacedim> rescaled_jacobian;
+
+    /**
+     * Offset into the face quadrature data of the face the output tables
+     * were last filled for. Only used for face data.
+     */
+    mutable unsigned int face_data_offset;
+  };
+
+  /**
+   * Compute the rescaling factors stored in @p data for the cell that
+   * @p mapping_data was last filled for. Return @p false without doing any
+   * work if the factors and output tables stored in @p data already belong
+   * to a cell with the same Jacobian.
+   */
+  bool
+  update_dof_rescaling(
+    const typename MappingHermite<dim, spacedim>::InternalData &mapping_data,
+    const InternalData &                                        data) const;
+
+  virtual std::unique_ptr<
+    typename FiniteElement<dim, spacedim>::InternalDataBase>
+  get_data(
+    const UpdateFlags             update_flags,
+    const Mapping<dim, spacedim> &mapping,
+    const Quadrature<dim> &       quadrature,
+    dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                       spacedim>
+      &output_data) const override;
+
+private:
+  mutable Threads::Mutex mutex;
+  unsigned int           regularity;
+  unsigned int           nodes;
+
+  /**
+   * The 1D embedding matrices returned by get_prolongation_matrix_1d().
+   */
+  std::array<FullMatrix<double>, 2> prolongation_1d;
+
+  /**
+   * The 1D restriction matrices returned by get_restriction_matrix_1d().
+   */
+  std::array<FullMatrix<double>, 2> restriction_1d;
+
+  /**
+   * The 1D mass matrix returned by get_mass_matrix_1d().
+   */
+  FullMatrix<double> mass_matrix_1d;
+
+  /**
+   * The 1D Laplace matrix returned by get_laplace_matrix_1d().
+   */
+  FullMatrix<double> laplace_matrix_1d;
+
+  /**
+   * Entry $(i,f)$ is true if shape function $i$ does not vanish on face $f$,
+   * see has_support_on_face().
+   */
+  Table<2, bool> face_support;
+
+public:
+  inline unsigned int
+  get_regularity() const
+  {return this->regularity;};
+
+  inline unsigned int
+  n_nodes() const
+  {return this->nodes;};
+};
+
+
+
+/**
+ * The mass matrix, the Laplace matrix or a linear combination
+ * $\alpha M + \beta L$ of both for an FE_Hermite element on an axis-parallel
+ * cell, represented by the 1D matrices of FE_Hermite::compute_matrices_1d()
+ * for the extents of the cell. The matrix is the sum over the directions
+ * $d$ of the Kronecker products of the matrix $\frac{\alpha}{d} M_d +
+ * \beta L_d$ in direction $d$ with the 1D mass matrices in all other
+ * directions, which is the structure of TensorProductMatrixSymmetricSum.
+ * vmult() applies it with sum factorization at a cost of
+ * $\mathcal O(p^{d+1})$ operations, and apply_inverse() applies its
+ * inverse at the same cost rather than the $\mathcal O(p^{3d})$ of a
+ * factorization of the full cell matrix. This makes the class suitable for
+ * block Jacobi and Schwarz smoothers and for explicit time integration,
+ * where the inverse of the mass matrix is needed on every cell in every
+ * step.
+ *
+ * If $\beta = 0$, the inverse is the Kronecker product of the inverse 1D
+ * mass matrices. Otherwise, it is computed by the fast diagonalization
+ * method of TensorProductMatrixSymmetricSum from the generalized
+ * eigenvalues of the 1D matrices, which requires deal.II to be configured
+ * with LAPACK. The Laplace matrix alone is singular on a single cell, so
+ * apply_inverse() needs $\alpha > 0$.
+ *
+ * Vectors are in lexicographic numbering, i.e., entry $i$ belongs to the
+ * shape function $j$ with FE_Poly::get_poly_space_numbering()[j] = i. This
+ * is the numbering of TensorProductMatrixSymmetricSum and of the cell
+ * values in FEEvaluation. Only cells whose edges are parallel to the
+ * coordinate axes are supported, since the Laplace matrix of a
+ * parallelogram has contributions from mixed derivatives that do not
+ * factorize in this form.
+ *
+ * @tparam Number The number type of the matrix entries, either double or
+ * float.
+ */
+template <int dim, typename Number = double>
+class TensorProductMatrixHermite
+  : public TensorProductMatrixSymmetricSumBase<dim, Number>
+{
+public:
+  /**
+   * Default constructor. reinit() needs to be called before the matrix is
+   * used.
+   */
+  TensorProductMatrixHermite() = default;
+
+  /**
+   * Constructor. Equivalent to calling reinit() with the same arguments.
+   */
+  TensorProductMatrixHermite(const FE_Hermite<dim> &fe,
+                             const Tensor<1, dim> & cell_extents,
+                             const Number           mass_factor    = 1.,
+                             const Number           laplace_factor = 0.);
+
+  /**
+   * Set up the matrix $\alpha M + \beta L$ with $\alpha$ = @p mass_factor
+   * and $\beta$ = @p laplace_factor for the element @p fe on an
+   * axis-parallel cell with extents @p cell_extents. The default arguments
+   * give the mass matrix.
+   */
+  void
+  reinit(const FE_Hermite<dim> &fe,
+         const Tensor<1, dim> & cell_extents,
+         const Number           mass_factor    = 1.,
+         const Number           laplace_factor = 0.);
+
+  /**
+   * Apply the inverse of the matrix to @p src and write the result into
+   * @p dst.
+   */
+  void
+  apply_inverse(const ArrayView<Number> &      dst,
+                const ArrayView<const Number> &src) const;
+
+private:
+  /**
+   * Inverses of the 1D mass matrices in each direction, divided by
+   * $\alpha^{1/d}$. Only set up for $\beta = 0$.
+   */
+  std::array<Table<2, Number>, dim> inverse_mass_matrix;
+
+  /**
+   * Whether the matrix is a multiple of the mass matrix, i.e., $\beta = 0$.
+   */
+  bool is_mass_matrix = true;
+
+  /**
+   * An array for temporary data of apply_inverse().
+   */
+  mutable AlignedVector<Number> tmp_array;
+
+  /**
+   * A mutex that guards access to the array @p tmp_array.
+   */
+  mutable Threads::Mutex mutex;
+};
+
+
+
+namespace VectorTools
+{
+    enum HermiteBoundaryType {
+            hermite_dirichlet,
+            hermite_neumann,
+            hermite_2nd_derivative,
+            hermite_robin,
+            hermite_other_combined
+    };
+
+    /**
+     * Project the boundary values given by @p boundary_functions onto the
+     * degrees of freedom selected by @p projection_mode. On distributed
+     * triangulations, the boundary mass matrix is applied face by face to
+     * a LinearAlgebra::distributed::Vector and inverted with CG, and
+     * @p boundary_values receives the values of all locally relevant
+     * boundary degrees of freedom.
+     *
+     * @note Hanging nodes on the selected parts of the boundary are not
+     * supported and raise ExcNotImplemented. They only occur in 3D, where a
+     * boundary face borders a refined face along one of its edges; in 2D,
+     * adaptively refined meshes are fine.
+     */
+    template <int dim, int spacedim = dim, typename Number = double>
+    void
+    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
+                            const DoFHandler<dim, spacedim> &                                      dof_handler,
+                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                            const Quadrature<dim - 1> &                                            quadrature,
+                            const HermiteBoundaryType                                              projection_mode,
+                            std::map<types::global_dof_index, Number> &                            boundary_values,
+                            std::vector<unsigned int>                                              component_mapping = {});
+
+    //The following does exactly the same as the above, but uses hermite_dirichlet. This is to match existing function calls
+    template <int dim, int spacedim = dim, typename Number = double>
+    void
+    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
+                            const DoFHandler<dim, spacedim> &                                      dof_handler,
+                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                            const Quadrature<dim - 1> &                                            quadrature,
+                            std::map<types::global_dof_index, Number> &                            boundary_values,
+                            std::vector<unsigned int>                                              component_mapping = {});
+
+    template <int dim, int spacedim = dim, typename Number = double>
+    void
+    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
+                            const DoFHandler<dim, spacedim> &                                      dof_handler,
+                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                            const Quadrature<dim - 1> &                                            quadrature,
+                            const HermiteBoundaryType                                              projection_mode,
+                            AffineConstraints<Number>                                              constraints,
+                            std::vector<unsigned int>                                              component_mapping = {});
+
+    //Same as above, but with hermite_dirichlet set
+    template <int dim, int spacedim = dim, typename Number = double>
+    void
+    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
+                            const DoFHandler<dim, spacedim> &                                      dof_handler,
+                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                            const Quadrature<dim - 1> &                                            quadrature,
+                            AffineConstraints<Number>                                              constraints,
+                            std::vector<unsigned int>                                              component_mapping = {});
+
+    //Overwrite the following function in the case of Hermite elements to account for poorer conditioning
+    using VectorTools::project;
+
+    /**
+     * Compute the L2 projection of @p function onto the FE_Hermite space of
+     * @p dof. For LinearAlgebra::distributed::Vector, the mass matrix is
+     * never assembled: it is applied matrix-free with FEEvaluation and
+     * inverted by a CG solver preconditioned with its diagonal, which is
+     * computed from the cell extents. Boundary values requested by
+     * @p enforce_zero_boundary or @p project_to_boundary_first enter as
+     * inhomogeneous constraints. This is the only variant that works on
+     * distributed triangulations. All other vector types assemble a sparse
+     * mass matrix and factorize it if UMFPACK is available, or use CG with
+     * an SSOR preconditioner otherwise.
+     */
+    template <int dim, typename VectorType, int spacedim> void
+    project(const MappingHermite<dim, spacedim> &                     mapping,
+            const DoFHandler<dim, spacedim> &                         dof,
+            const AffineConstraints<typename VectorType::value_type> &constraints,
+            const Quadrature<dim> &                                   quadrature,
+            const Function<spacedim, typename VectorType::value_type> &function,
+            VectorType &                                               vec,
+            const bool                 enforce_zero_boundary     = false,
+            const Quadrature<dim - 1> &q_boundary                = (dim > 1 ?
+                                                       QGauss<dim - 1>(2) :
+                                                       Quadrature<dim - 1>(0)),
+            const bool                 project_to_boundary_first = false);
+
+
+
+    /**
+     * A class for repeated L2 projections onto an FE_Hermite space on a
+     * fixed mesh, for example of time dependent initial or boundary data.
+     * The free functions project() and project_boundary_values() above
+     * assemble and factorize a mass matrix on every call. This class
+     * assembles the mass matrix of the domain, and the mass matrix of the
+     * boundary degrees of freedom, upon the first call that needs it and
+     * keeps the factorization, so that every further projection only costs
+     * the assembly of the right hand side and a solve. The factorization is
+     * done with UMFPACK if deal.II is configured with it, otherwise the
+     * matrix is inverted with a CG solver preconditioned by SSOR.
+     *
+     * The boundary mass matrix depends on the set of boundary ids and on
+     * the projection mode, and is rebuilt when either of them changes
+     * between two calls of project_boundary_values(). The objects passed to
+     * the constructor must not change while this class is in use.
+     *
+     * On distributed triangulations, only project_boundary_values() is
+     * supported, and it falls back to VectorTools::project_boundary_values()
+     * on every call.
+     */
+    template <int dim, int spacedim = dim, typename Number = double>
+    class HermiteProjector
+    {
+    public:
+      /**
+       * Constructor. The @p constraints must be homogeneous, since their
+       * contribution to the right hand side depends on the projected
+       * function. The @p quadrature is used in project(), the
+       * @p face_quadrature in project_boundary_values(). No matrix is
+       * assembled here.
+       */
+      HermiteProjector(const MappingHermite<dim, spacedim> &mapping,
+                       const DoFHandler<dim, spacedim> &    dof_handler,
+                       const AffineConstraints<Number> &    constraints,
+                       const Quadrature<dim> &              quadrature,
+                       const Quadrature<dim - 1> &          face_quadrature);
+
+      /**
+       * Compute the L2 projection of @p function, as
+       * VectorTools::project() without boundary values does.
+       */
+      void
+      project(const Function<spacedim, Number> &function, Vector<Number> &vec);
+
+      /**
+       * Project several functions at once. The right hand sides are
+       * assembled in a single loop over the cells, such that the shape
+       * functions are evaluated only once for all of them.
+       */
+      void
+      project(const std::vector<const Function<spacedim, Number> *> &functions,
+              std::vector<Vector<Number>> &                           vectors);
+
+      /**
+       * Compute the boundary values of the degrees of freedom selected by
+       * @p projection_mode, as VectorTools::project_boundary_values() does.
+       * The keys of @p boundary_functions select the parts of the boundary,
+       * and the computed values are added to @p boundary_values.
+       */
+      void
+      project_boundary_values(
+        const std::map<types::boundary_id, const Function<spacedim, Number> *>
+          &                                        boundary_functions,
+        const HermiteBoundaryType                  projection_mode,
+        std::map<types::global_dof_index, Number> &boundary_values);
+
+    private:
+      /**
+       * A mass matrix together with its factorization, or with the
+       * preconditioner used to invert it if UMFPACK is not available.
+       */
+      struct FactorizedMassMatrix
+      {
+        void
+        factorize();
+
+        void
+        solve(Vector<Number> &dst, const Vector<Number> &src) const;
+
+        SparsityPattern                        sparsity;
+        SparseMatrix<Number>                   matrix;
+        SparseDirectUMFPACK                    direct_solver;
+        PreconditionSSOR<SparseMatrix<Number>> preconditioner;
+      };
+
+      /**
+       * Assemble and factorize the boundary mass matrix for the degrees of
+       * freedom with derivative order @p position on the parts of the
+       * boundary given by the keys of @p boundary_functions.
+       */
+      void
+      assemble_boundary_mass_matrix(
+        const std::map<types::boundary_id, const Function<spacedim, Number> *>
+          &                boundary_functions,
+        const unsigned int position);
+
+      SmartPointer<const MappingHermite<dim, spacedim>> mapping;
+      SmartPointer<const DoFHandler<dim, spacedim>>     dof_handler;
+      SmartPointer<const AffineConstraints<Number>>     constraints;
+      const Quadrature<dim>                             quadrature;
+      const Quadrature<dim - 1>                         face_quadrature;
+
+      FactorizedMassMatrix mass_matrix;
+      bool                 mass_matrix_is_assembled;
+
+      FactorizedMassMatrix         boundary_mass_matrix;
+      std::set<types::boundary_id> boundary_ids;
+      unsigned int                 boundary_position;
+
+      /**
+       * The numbering of the boundary degrees of freedom in
+       * boundary_mass_matrix, indexed by the global degree of freedom.
+       */
+      std::map<types::global_dof_index, types::global_dof_index>
+        dof_to_boundary;
+    };
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
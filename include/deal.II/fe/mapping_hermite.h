@@ -3,6 +3,8 @@
 #define dealii_mapping_hermite_h
 
 #include <deal.II/base/config.h>
+
+#include <deal.II/base/derivative_form.h>
 #include <deal.II/base/qprojector.h>
 
 #include <deal.II/fe/mapping.h>
@@ -25,14 +27,24 @@ DEAL_II_NAMESPACE_OPEN
  * between elements of different sizes, due to derivatives being affected by
  * coordinate transformations.
  * 
- * At present this class is a reimplementation of the MappingCartesian class with
- * minor changes to account for the rescaling of basis functions. This is necessary 
- * to ensure element corners are right-angled, which prevents lines and planes 
- * bordering elements from forming discontinuous gradients whenever they meet other 
- * divisions. This in turn ensures that derivatives of all orders can be easily 
- * matched across element boundaries without the need to solve complex linear 
- * systems for every grid vertex, which would be highly numerically inefficient.
- * */
+ * The mapping is affine, i.e., the cells have to be parallelograms or
+ * parallelepipeds, and its Jacobian is the constant matrix whose columns are
+ * the edges from vertex 0 of the cell in each coordinate direction of the
+ * reference cell. The degrees of freedom of FE_Hermite are the directional
+ * derivatives along these edges, so a shape function associated with a
+ * derivative of order $k_d$ in direction $d$ is rescaled by $h_d^{k_d}$ for
+ * an edge of length $h_d$, and gradients and higher derivatives are
+ * transformed with the full Jacobian. Derivatives of all orders can be
+ * matched across element boundaries this way as long as neighboring cells
+ * share the directions of their edges, as is the case on structured meshes
+ * that are sheared or rotated as a whole, without the need to solve linear
+ * systems for every grid vertex. On axis-parallel meshes, this class behaves
+ * like MappingCartesian.
+ *
+ * The hanging node and hp constraints for FE_Hermite computed by
+ * DoFTools::make_hanging_node_constraints() still require axis-parallel
+ * cells.
+ */
 
 template <int dim, int spacedim = dim>
 class MappingHermite : public Mapping<dim, spacedim>
@@ -44,8 +56,8 @@ public:
   clone() const override;
 
   /**
-   * Return @p true because MappingHermite currently preserves vertex
-   * locations.
+   * Return @p true because MappingHermite preserves vertex locations, as
+   * long as the cells are parallelograms or parallelepipeds.
    */
   virtual bool
   preserves_vertex_locations() const override;
@@ -154,6 +166,17 @@ public:
      */
     mutable Tensor<1, dim> cell_extents;
 
+    /**
+     * Jacobian of the last cell we have seen, which is constant on the cell.
+     */
+    mutable DerivativeForm<1, dim, spacedim> jacobian;
+
+    /**
+     * Covariant form of the Jacobian, i.e., the transpose of its inverse,
+     * which transforms gradients.
+     */
+    mutable DerivativeForm<1, dim, spacedim> covariant;
+
     /**
      * The volume element
      */
@@ -218,13 +241,38 @@ public:
     internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
       &output_data) const override;
 
+  /**
+   * Compute the quadrature points, Jacobians and inverse Jacobians, as
+   * selected by @p update_flags, at arbitrary points @p unit_points of the
+   * reference cell, without setting up an InternalData object first. This
+   * is the counterpart of MappingQ::fill_mapping_data_for_generic_points()
+   * and is used by FEPointEvaluation, where the points change from cell to
+   * cell. The Jacobian is the same at all points.
+   */
+  void
+  fill_mapping_data_for_generic_points(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<dim>> &                         unit_points,
+    const UpdateFlags                                           update_flags,
+    internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+      &output_data) const;
+
   /**
    * @}
    */
 
   /**
-   * Update the cell_extents field of the incoming InternalData object with the
-   * size of the incoming cell.
+   * Return the constant Jacobian of the affine map from the reference cell
+   * to @p cell. In debug mode, check that the cell is a parallelogram or
+   * parallelepiped.
+   */
+  static DerivativeForm<1, dim, spacedim>
+  compute_jacobian(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
+  /**
+   * Update the cell_extents, jacobian, covariant and volume_element fields of
+   * the incoming InternalData object for the incoming cell.
    */
   void
   update_cell_extents(
@@ -272,8 +320,8 @@ public:
     std::vector<Point<dim>> &quadrature_points) const;
 
   /**
-   * Transform quadrature points in InternalData to real space by scaling unit
-   * coordinates with cell_extends in each direction.
+   * Transform quadrature points in InternalData to real space by applying
+   * the Jacobian to the unit coordinates.
    *
    * Called from the various maybe_update_*_quadrature_points functions.
    */
@@ -890,6 +890,38 @@ private:
  * products are %parallel and the inner preconditioner is %parallel). Its use
  * is demonstrated in the step-37 and step-59 tutorial programs.
  *
+ * <h4>Chebyshev polynomials of the fourth kind</h4>
+ *
+ * As an alternative to the classical Chebyshev polynomials described above,
+ * AdditionalData::polynomial_type can select the Chebyshev polynomials of
+ * the fourth kind, which only rely on the largest eigenvalue
+ * $\lambda_{\max{}}$. With $x^0 = 0$ and $x^1 = \frac{4}{3\lambda_{\max{}}}
+ * P^{-1} b$, they are given by the recurrence
+ * @f[
+ *  x^{n+1} = x^{n} + \frac{2n-1}{2n+3} (x^{n} - x^{n-1}) +
+ *     \frac{8n+4}{(2n+3)\lambda_{\max{}}} P^{-1} (b-Ax^n),
+ * @f]
+ * which has the same form as the one above and is thus evaluated with the
+ * same fused vector updates. The smoothing range is not used in this case.
+ * The polynomial damps the upper part of the spectrum more strongly the
+ * higher the degree, which makes it a good multigrid smoother that does not
+ * need to be tuned to the lower end of the spectrum. The variant with
+ * optimized coefficients additionally weights the increments $x^{n+1}-x^n$
+ * by factors $\beta_n$ that minimize the bound on the convergence rate of
+ * a two-level method, at the cost of one more vector update per iteration.
+ * For details, see
+ * @code{.bib}
+ * @article{Lottes2022,
+ *   Title     = {Optimal polynomial smoothers for multigrid V-cycles},
+ *   Author    = {Lottes, J.},
+ *   Journal   = {Numerical Linear Algebra with Applications},
+ *   Year      = {2022},
+ *   Volume    = {30},
+ *   Number    = {6},
+ *   Pages     = {e2518},
+ * }
+ * @endcode
+ *
  * <h4>Estimation of the eigenvalues</h4>
  *
  * The Chebyshev method relies on an estimate of the eigenvalues of the matrix
@@ -1002,14 +1034,38 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * An enum to define the available types of polynomials.
+     */
+    enum class PolynomialType
+    {
+      /**
+       * Chebyshev polynomials of the first kind, which act on the eigenvalue
+       * range given by the smoothing range.
+       */
+      first_kind,
+      /**
+       * Chebyshev polynomials of the fourth kind, which only need the
+       * largest eigenvalue.
+       */
+      fourth_kind,
+      /**
+       * Chebyshev polynomials of the fourth kind with the optimized
+       * coefficients of Lottes (2022). Only available for degrees up to 16.
+       */
+      fourth_kind_optimal
+    };
+
     /**
      * Constructor.
      */
-    AdditionalData(const unsigned int degree              = 1,
-                   const double       smoothing_range     = 0.,
-                   const unsigned int eig_cg_n_iterations = 8,
-                   const double       eig_cg_residual     = 1e-2,
-                   const double       max_eigenvalue      = 1);
+    AdditionalData(const unsigned int   degree              = 1,
+                   const double         smoothing_range     = 0.,
+                   const unsigned int   eig_cg_n_iterations = 8,
+                   const double         eig_cg_residual     = 1e-2,
+                   const double         max_eigenvalue      = 1,
+                   const PolynomialType polynomial_type =
+                     PolynomialType::first_kind);
 
     /**
      *  Copy assignment operator.
@@ -1074,6 +1130,13 @@ public:
      * Stores the preconditioner object that the Chebyshev is wrapped around.
      */
     std::shared_ptr<PreconditionerType> preconditioner;
+
+    /**
+     * The kind of Chebyshev polynomial to be used. For the polynomials of
+     * the fourth kind, the smoothing range is not used and the degree must
+     * be given explicitly.
+     */
+    PolynomialType polynomial_type;
   };
 
 
@@ -1111,6 +1174,25 @@ public:
   void
   Tvmult(VectorType &dst, const VectorType &src) const;
 
+  /**
+   * Same as vmult(), but for a vector @p src of a different type than
+   * VectorType, typically a vector in double precision in case this class
+   * works in single precision. The vector @p src is converted into @p rhs
+   * within the first update of the Chebyshev iteration, which saves a
+   * separate pass through memory compared to converting the vector before
+   * calling vmult(). The vector @p rhs needs to have the same layout as
+   * @p dst and holds the converted right hand side on exit, ready to be used
+   * e.g. for computing a residual. This fused operation is available for
+   * LinearAlgebra::distributed::Vector in combination with a DiagonalMatrix
+   * as the inner preconditioner; for other types, @p src is assigned to
+   * @p rhs before running the iteration.
+   */
+  template <typename OtherVectorType>
+  void
+  vmult_with_conversion(VectorType &           dst,
+                        VectorType &           rhs,
+                        const OtherVectorType &src) const;
+
   /**
    * Perform one step of the preconditioned Richardson iteration.
    */
@@ -1216,6 +1298,13 @@ private:
    */
   mutable VectorType temp_vector2;
 
+  /**
+   * Internal vector used for the <tt>vmult</tt> operation with the optimized
+   * polynomial of the fourth kind, where it accumulates the weighted
+   * iterates.
+   */
+  mutable VectorType temp_vector3;
+
   /**
    * Stores the additional data passed to the initialize function, obtained
    * through a copy operation.
@@ -1244,6 +1333,22 @@ private:
    * overwrite the temporary vectors.
    */
   mutable Threads::Mutex mutex;
+
+  /**
+   * Run the Chebyshev iteration on @p solution, which is either assumed to
+   * be zero (vmult() and Tvmult()) or contains the initial guess (step()
+   * and Tstep()). The function object @p apply_matrix computes the product
+   * of the matrix or its transpose with @p solution into temp_vector1. If
+   * @p first_update_done is true, the caller has already performed the first
+   * update of the iteration, see vmult_with_conversion().
+   */
+  template <typename MatrixApplyType>
+  void
+  do_chebyshev_loop(const MatrixApplyType &apply_matrix,
+                    VectorType &           solution,
+                    const VectorType &     rhs,
+                    const bool             zero_initial_guess,
+                    const bool             first_update_done = false) const;
 };
 
 
@@ -2026,6 +2131,76 @@ namespace internal
         solution.swap(solution_old);
     }
 
+    // first update of the Chebyshev iteration with a zero initial guess for
+    // a right hand side of a different vector type, which gets converted
+    // into rhs. The generic part converts in a separate step.
+    template <typename VectorType,
+              typename OtherVectorType,
+              typename PreconditionerType>
+    inline void
+    vector_updates_with_conversion(const OtherVectorType &   src,
+                                   const PreconditionerType &preconditioner,
+                                   const double              factor,
+                                   VectorType &              rhs,
+                                   VectorType &              solution_old,
+                                   VectorType &              temp_vector1,
+                                   VectorType &              temp_vector2,
+                                   VectorType &              solution)
+    {
+      rhs = src;
+      vector_updates(rhs,
+                     preconditioner,
+                     0,
+                     0.,
+                     factor,
+                     solution_old,
+                     temp_vector1,
+                     temp_vector2,
+                     solution);
+    }
+
+    // selection for diagonal matrix around parallel deal.II vector, where
+    // the conversion is merged into the first update
+    template <typename Number, typename OtherNumber>
+    inline void
+    vector_updates_with_conversion(
+      const LinearAlgebra::distributed::Vector<OtherNumber, MemorySpace::Host>
+        &src,
+      const DiagonalMatrix<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>> &jacobi,
+      const double factor,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &rhs,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &solution)
+    {
+      AssertDimension(src.locally_owned_size(), rhs.locally_owned_size());
+      AssertDimension(solution.locally_owned_size(), rhs.locally_owned_size());
+
+      const OtherNumber *src_ptr                 = src.begin();
+      const Number *     matrix_diagonal_inverse = jacobi.get_vector().begin();
+      Number *           rhs_ptr                 = rhs.begin();
+      Number *           solution_ptr            = solution.begin();
+      const Number       factor2                 = factor;
+
+      // same operation as in VectorUpdater for iteration_index == 0, such
+      // that the result does not depend on the place of the conversion
+      ::dealii::parallel::apply_to_subranges(
+        std::size_t(0),
+        std::size_t(rhs.locally_owned_size()),
+        [&](const std::size_t begin, const std::size_t end) {
+          DEAL_II_OPENMP_SIMD_PRAGMA
+          for (std::size_t i = begin; i < end; ++i)
+            {
+              const Number value = src_ptr[i];
+              rhs_ptr[i]         = value;
+              solution_ptr[i]    = factor2 * matrix_diagonal_inverse[i] * value;
+            }
+        },
+        internal::VectorImplementation::minimum_parallel_grain_size);
+    }
+
     template <typename MatrixType, typename PreconditionerType>
     inline void
     initialize_preconditioner(
@@ -2171,6 +2346,68 @@ namespace internal
 
       std::vector<double> values;
     };
+
+    // The coefficients beta_i, i = 0, ..., degree - 1, that weight the
+    // increments of the Chebyshev iteration of the fourth kind in the
+    // optimized variant of J. Lottes, Optimal polynomial smoothers for
+    // multigrid V-cycles, Numer. Linear Algebra Appl. 30 (2022), for degrees
+    // 1 to 16. They minimize max_{0 < x <= 1} x p(x)^2 / (1 - p(x)^2) for
+    // the error propagation polynomial p in terms of the normalized
+    // eigenvalue x.
+    inline double
+    optimal_fourth_kind_coefficient(const unsigned int degree,
+                                    const unsigned int i)
+    {
+      static const double betas[16][16] = {
+        {1.12500000000000},
+        {1.02387287570313, 1.26408905371085},
+        {1.00842544782028, 1.08867839208730, 1.33753125909618},
+        {1.00391310427285, 1.04035811188593, 1.14863498546254,
+         1.38268869241000},
+        {1.00212930146164, 1.02173711549260, 1.07872433192603, 1.19810065292663,
+         1.41322542791682},
+        {1.00128517255940, 1.01304293035233, 1.04678215124113, 1.11616489419675,
+         1.23829020218444, 1.43524297106744},
+        {1.00083464397912, 1.00843949430122, 1.03008707768713, 1.07408384092003,
+         1.15036186707366, 1.27116474046139, 1.45186658649363},
+        {1.00057246631197, 1.00577427662415, 1.02050187922941, 1.05019803444565,
+         1.10115572984940, 1.18086042806856, 1.29838585382575,
+         1.46486073151099},
+        {1.00040960072832, 1.00412439506106, 1.01460212148266, 1.03561113626671,
+         1.07139972529194, 1.12688273710962, 1.20785219140729, 1.32121930716746,
+         1.47529642820699},
+        {1.00030312229652, 1.00304840660796, 1.01077022715387, 1.02619011597640,
+         1.05231724933755, 1.09255743207549, 1.15083376663971, 1.23172250870894,
+         1.34060802024459, 1.48386124407011},
+        {1.00023058595209, 1.00231675024028, 1.00817245396304, 1.01982986566342,
+         1.03950210235324, 1.06965042700541, 1.11305754295742, 1.17290876275564,
+         1.25288300576792, 1.35725579919519, 1.49101672564138},
+        {1.00017947200828, 1.00180189139619, 1.00634861907307, 1.01537864566306,
+         1.03056942830760, 1.05376019693943, 1.08699862592072, 1.13259183097913,
+         1.19316273358172, 1.27171293675110, 1.37169337969799,
+         1.49708418575562},
+        {1.00014241921559, 1.00142906932629, 1.00503028986298, 1.01216910518495,
+         1.02414874342792, 1.04238158880820, 1.06842008128700, 1.10399010936759,
+         1.15102748242645, 1.21171811910124, 1.28854264865128, 1.38432619380991,
+         1.50229418757369},
+        {1.00011490538261, 1.00115246376914, 1.00405357333264, 1.00979590573153,
+         1.01941300472994, 1.03401425035436, 1.05480599606629, 1.08311420301812,
+         1.12040891660892, 1.16833095655445, 1.22872122288238, 1.30365305707817,
+         1.39546814053678, 1.50681646209583},
+        {1.00009404750752, 1.00094291696343, 1.00331449056444, 1.00800294833816,
+         1.01584236259140, 1.02772083317704, 1.04459535422831, 1.06750761206125,
+         1.09760092545889, 1.13613855366157, 1.18452361426236, 1.24432087304475,
+         1.31728069083392, 1.40536543893559, 1.51077872501845},
+        {1.00007794828179, 1.00078126847253, 1.00274487974401, 1.00662291017015,
+         1.01309858836971, 1.02289448329337, 1.03678321409984, 1.05559875719896,
+         1.08024848405560, 1.11172607131497, 1.15112543431072, 1.19965584614973,
+         1.25865841744945, 1.32962412656665, 1.41421360695575,
+         1.51427891730346},
+      };
+      AssertIndexRange(degree - 1, 16);
+      AssertIndexRange(i, degree);
+      return betas[degree - 1][i];
+    }
   } // namespace PreconditionChebyshevImplementation
 } // namespace internal
 
@@ -2178,16 +2415,18 @@ namespace internal
 
 template <typename MatrixType, class VectorType, typename PreconditionerType>
 inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
-  AdditionalData::AdditionalData(const unsigned int degree,
-                                 const double       smoothing_range,
-                                 const unsigned int eig_cg_n_iterations,
-                                 const double       eig_cg_residual,
-                                 const double       max_eigenvalue)
+  AdditionalData::AdditionalData(const unsigned int   degree,
+                                 const double         smoothing_range,
+                                 const unsigned int   eig_cg_n_iterations,
+                                 const double         eig_cg_residual,
+                                 const double         max_eigenvalue,
+                                 const PolynomialType polynomial_type)
   : degree(degree)
   , smoothing_range(smoothing_range)
   , eig_cg_n_iterations(eig_cg_n_iterations)
   , eig_cg_residual(eig_cg_residual)
   , max_eigenvalue(max_eigenvalue)
+  , polynomial_type(polynomial_type)
 {}
 
 
@@ -2205,6 +2444,7 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   eig_cg_residual     = other_data.eig_cg_residual;
   max_eigenvalue      = other_data.max_eigenvalue;
   preconditioner      = other_data.preconditioner;
+  polynomial_type     = other_data.polynomial_type;
   constraints.copy_from(other_data.constraints);
 
   return *this;
@@ -2236,6 +2476,15 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::initialize(
   data       = additional_data;
   Assert(data.degree > 0,
          ExcMessage("The degree of the Chebyshev method must be positive."));
+  Assert(data.polynomial_type == AdditionalData::PolynomialType::first_kind ||
+           data.degree != numbers::invalid_unsigned_int,
+         ExcMessage("The degree of the Chebyshev polynomials of the fourth "
+                    "kind cannot be determined automatically."));
+  Assert(data.polynomial_type !=
+             AdditionalData::PolynomialType::fourth_kind_optimal ||
+           data.degree <= 16,
+         ExcMessage("The optimized Chebyshev polynomials of the fourth kind "
+                    "are only available for degrees up to 16."));
   internal::PreconditionChebyshevImplementation::initialize_preconditioner(
     matrix, data.preconditioner);
   eigenvalues_are_initialized = false;
@@ -2255,6 +2504,7 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
     solution_old.reinit(empty_vector);
     temp_vector1.reinit(empty_vector);
     temp_vector2.reinit(empty_vector);
+    temp_vector3.reinit(empty_vector);
   }
   data.preconditioner.reset();
 }
@@ -2333,8 +2583,12 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
     }
   else
     {
+      // the smoothing range is not needed for the polynomials of the fourth
+      // kind and might not be set
       info.max_eigenvalue_estimate = data.max_eigenvalue;
-      info.min_eigenvalue_estimate = data.max_eigenvalue / data.smoothing_range;
+      info.min_eigenvalue_estimate =
+        data.smoothing_range > 0. ? data.max_eigenvalue / data.smoothing_range :
+                                    data.max_eigenvalue;
     }
 
   const double alpha = (data.smoothing_range > 1. ?
@@ -2392,6 +2646,15 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
       temp_vector2.reinit(empty_vector);
     }
 
+  if (data.polynomial_type ==
+      AdditionalData::PolynomialType::fourth_kind_optimal)
+    temp_vector3.reinit(src, true);
+  else
+    {
+      VectorType empty_vector;
+      temp_vector3.reinit(empty_vector);
+    }
+
   const_cast<
     PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(this)
     ->eigenvalues_are_initialized = true;
@@ -2402,49 +2665,111 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
 
 
 template <typename MatrixType, typename VectorType, typename PreconditionerType>
+template <typename MatrixApplyType>
 inline void
-PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::vmult(
-  VectorType &      solution,
-  const VectorType &rhs) const
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  do_chebyshev_loop(const MatrixApplyType &apply_matrix,
+                    VectorType &           solution,
+                    const VectorType &     rhs,
+                    const bool             zero_initial_guess,
+                    const bool             first_update_done) const
 {
-  std::lock_guard<std::mutex> lock(mutex);
-  if (eigenvalues_are_initialized == false)
-    estimate_eigenvalues(rhs);
-
-  internal::PreconditionChebyshevImplementation::vector_updates(
-    rhs,
-    *data.preconditioner,
-    0,
-    0.,
-    1. / theta,
-    solution_old,
-    temp_vector1,
-    temp_vector2,
-    solution);
-
-  // if delta is zero, we do not need to iterate because the updates will be
-  // zero
-  if (data.degree < 2 || std::abs(delta) < 1e-40)
-    return;
+  const bool first_kind =
+    data.polynomial_type == AdditionalData::PolynomialType::first_kind;
+  const bool optimal =
+    data.polynomial_type == AdditionalData::PolynomialType::fourth_kind_optimal;
+  const double max_eigenvalue = theta + delta;
+
+  // for the optimized polynomial, the result is the sum of the increments
+  // weighted by the coefficients beta, which we rewrite as a sum over the
+  // iterates of the plain polynomial of the fourth kind weighted by the
+  // differences of consecutive betas, starting with the initial guess
+  const auto beta = [&](const unsigned int i) {
+    return internal::PreconditionChebyshevImplementation::
+      optimal_fourth_kind_coefficient(data.degree, i);
+  };
+  if (optimal)
+    {
+      if (zero_initial_guess)
+        temp_vector3 = 0.;
+      else
+        temp_vector3.equ(1. - beta(0), solution);
+    }
 
-  double rhok = delta / theta, sigma = theta / delta;
-  for (unsigned int k = 0; k < data.degree - 1; ++k)
+  if (first_update_done == false)
     {
-      matrix_ptr->vmult(temp_vector1, solution);
-      const double rhokp   = 1. / (2. * sigma - rhok);
-      const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
-      rhok = rhokp;
+      if (zero_initial_guess == false)
+        apply_matrix();
       internal::PreconditionChebyshevImplementation::vector_updates(
         rhs,
         *data.preconditioner,
-        k + 1,
-        factor1,
-        factor2,
+        zero_initial_guess ? 0 : 1,
+        0.,
+        first_kind ? 1. / theta : 4. / (3. * max_eigenvalue),
         solution_old,
         temp_vector1,
         temp_vector2,
         solution);
     }
+
+  // if delta is zero, we do not need to iterate because the updates will be
+  // zero
+  if (data.degree > 1 && (first_kind == false || std::abs(delta) >= 1e-40))
+    {
+      const unsigned int index_offset = zero_initial_guess ? 1 : 2;
+      double             rhok = delta / theta, sigma = theta / delta;
+      for (unsigned int k = 0; k < data.degree - 1; ++k)
+        {
+          if (optimal)
+            temp_vector3.add(beta(k) - beta(k + 1), solution);
+
+          apply_matrix();
+          double factor1, factor2;
+          if (first_kind)
+            {
+              const double rhokp = 1. / (2. * sigma - rhok);
+              factor1            = rhokp * rhok;
+              factor2            = 2. * rhokp / delta;
+              rhok               = rhokp;
+            }
+          else
+            {
+              factor1 = (2. * k + 1.) / (2. * k + 5.);
+              factor2 = (8. * k + 12.) / ((2. * k + 5.) * max_eigenvalue);
+            }
+          internal::PreconditionChebyshevImplementation::vector_updates(
+            rhs,
+            *data.preconditioner,
+            k + index_offset,
+            factor1,
+            factor2,
+            solution_old,
+            temp_vector1,
+            temp_vector2,
+            solution);
+        }
+    }
+
+  if (optimal)
+    solution.sadd(beta(data.degree - 1), 1., temp_vector3);
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+inline void
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::vmult(
+  VectorType &      solution,
+  const VectorType &rhs) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (eigenvalues_are_initialized == false)
+    estimate_eigenvalues(rhs);
+
+  do_chebyshev_loop([&]() { matrix_ptr->vmult(temp_vector1, solution); },
+                    solution,
+                    rhs,
+                    true);
 }
 
 
@@ -2459,38 +2784,45 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::Tvmult(
   if (eigenvalues_are_initialized == false)
     estimate_eigenvalues(rhs);
 
-  internal::PreconditionChebyshevImplementation::vector_updates(
-    rhs,
-    *data.preconditioner,
-    0,
-    0.,
-    1. / theta,
-    solution_old,
-    temp_vector1,
-    temp_vector2,
-    solution);
-
-  if (data.degree < 2 || std::abs(delta) < 1e-40)
-    return;
-
-  double rhok = delta / theta, sigma = theta / delta;
-  for (unsigned int k = 0; k < data.degree - 1; ++k)
-    {
-      matrix_ptr->Tvmult(temp_vector1, solution);
-      const double rhokp   = 1. / (2. * sigma - rhok);
-      const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
-      rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
-        rhs,
-        *data.preconditioner,
-        k + 1,
-        factor1,
-        factor2,
-        solution_old,
-        temp_vector1,
-        temp_vector2,
-        solution);
-    }
+  do_chebyshev_loop([&]() { matrix_ptr->Tvmult(temp_vector1, solution); },
+                    solution,
+                    rhs,
+                    true);
+}
+
+
+
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+template <typename OtherVectorType>
+inline void
+PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
+  vmult_with_conversion(VectorType &           solution,
+                        VectorType &           rhs,
+                        const OtherVectorType &src) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (eigenvalues_are_initialized == false)
+    estimate_eigenvalues(rhs);
+
+  const double first_factor =
+    data.polynomial_type == AdditionalData::PolynomialType::first_kind ?
+      1. / theta :
+      4. / (3. * (theta + delta));
+  internal::PreconditionChebyshevImplementation::
+    vector_updates_with_conversion(src,
+                                   *data.preconditioner,
+                                   first_factor,
+                                   rhs,
+                                   solution_old,
+                                   temp_vector1,
+                                   temp_vector2,
+                                   solution);
+
+  do_chebyshev_loop([&]() { matrix_ptr->vmult(temp_vector1, solution); },
+                    solution,
+                    rhs,
+                    true,
+                    true);
 }
 
 
@@ -2505,39 +2837,10 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::step(
   if (eigenvalues_are_initialized == false)
     estimate_eigenvalues(rhs);
 
-  matrix_ptr->vmult(temp_vector1, solution);
-  internal::PreconditionChebyshevImplementation::vector_updates(
-    rhs,
-    *data.preconditioner,
-    1,
-    0.,
-    1. / theta,
-    solution_old,
-    temp_vector1,
-    temp_vector2,
-    solution);
-
-  if (data.degree < 2 || std::abs(delta) < 1e-40)
-    return;
-
-  double rhok = delta / theta, sigma = theta / delta;
-  for (unsigned int k = 0; k < data.degree - 1; ++k)
-    {
-      matrix_ptr->vmult(temp_vector1, solution);
-      const double rhokp   = 1. / (2. * sigma - rhok);
-      const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
-      rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
-        rhs,
-        *data.preconditioner,
-        k + 2,
-        factor1,
-        factor2,
-        solution_old,
-        temp_vector1,
-        temp_vector2,
-        solution);
-    }
+  do_chebyshev_loop([&]() { matrix_ptr->vmult(temp_vector1, solution); },
+                    solution,
+                    rhs,
+                    false);
 }
 
 
@@ -2552,39 +2855,10 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::Tstep(
   if (eigenvalues_are_initialized == false)
     estimate_eigenvalues(rhs);
 
-  matrix_ptr->Tvmult(temp_vector1, solution);
-  internal::PreconditionChebyshevImplementation::vector_updates(
-    rhs,
-    *data.preconditioner,
-    1,
-    0.,
-    1. / theta,
-    solution_old,
-    temp_vector1,
-    temp_vector2,
-    solution);
-
-  if (data.degree < 2 || std::abs(delta) < 1e-40)
-    return;
-
-  double rhok = delta / theta, sigma = theta / delta;
-  for (unsigned int k = 0; k < data.degree - 1; ++k)
-    {
-      matrix_ptr->Tvmult(temp_vector1, solution);
-      const double rhokp   = 1. / (2. * sigma - rhok);
-      const double factor1 = rhokp * rhok, factor2 = 2. * rhokp / delta;
-      rhok = rhokp;
-      internal::PreconditionChebyshevImplementation::vector_updates(
-        rhs,
-        *data.preconditioner,
-        k + 2,
-        factor1,
-        factor2,
-        solution_old,
-        temp_vector1,
-        temp_vector2,
-        solution);
-    }
+  do_chebyshev_loop([&]() { matrix_ptr->Tvmult(temp_vector1, solution); },
+                    solution,
+                    rhs,
+                    false);
 }
 
 
@@ -490,7 +490,7 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::vmult(
   AssertDimension(src_view.size(), this->n());
   std::lock_guard<std::mutex> lock(this->mutex);
   const unsigned int          n = Utilities::fixed_power<dim>(
-    n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size());
+    n_rows_1d > 0 ? n_rows_1d : mass_matrix[0].n_rows());
   tmp_array.resize_fast(n * 2);
   constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
   internal::EvaluatorTensorProduct<internal::evaluate_general,
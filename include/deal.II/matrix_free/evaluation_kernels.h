@@ -109,14 +109,28 @@ namespace internal
    * identity) and FEEvaluationImplTransformToCollocation (which can be
    * transformed to a collocation space and can then use the identity in these
    * spaces), which both allow for shorter code.
+   *
+   * If @p vectorize_within_cell is true, the data of a single cell is passed
+   * in a scalar number type such as @p double, and the kernels of
+   * EvaluatorTensorProductWithinCell fill the SIMD lanes with the 1D stripes
+   * of that cell, rather than with several cells. This is meant for very
+   * high polynomial degrees with few cells per processor. It is only
+   * supported for polynomial degrees and numbers of quadrature points given
+   * at compile time.
    */
   template <MatrixFreeFunctions::ElementType type,
             int                              dim,
             int                              fe_degree,
             int                              n_q_points_1d,
-            typename Number>
+            typename Number,
+            bool                             vectorize_within_cell = false>
   struct FEEvaluationImpl
   {
+    static_assert(vectorize_within_cell == false ||
+                    type != MatrixFreeFunctions::tensor_none,
+                  "The vectorization within a cell needs a tensor product "
+                  "element.");
+
     static void
     evaluate(const unsigned int                            n_components,
              const EvaluationFlags::EvaluationFlags        evaluation_flag,
@@ -180,9 +194,15 @@ namespace internal
             int                              dim,
             int                              fe_degree,
             int                              n_q_points_1d,
-            typename Number>
+            typename Number,
+            bool                             vectorize_within_cell>
   inline void
-  FEEvaluationImpl<type, dim, fe_degree, n_q_points_1d, Number>::evaluate(
+  FEEvaluationImpl<type,
+                   dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   Number,
+                   vectorize_within_cell>::evaluate(
     const unsigned int                            n_components,
     const EvaluationFlags::EvaluationFlags        evaluation_flag,
     const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
@@ -197,11 +217,18 @@ namespace internal
 
     const EvaluatorVariant variant =
       EvaluatorSelector<type, (fe_degree + n_q_points_1d > 4)>::variant;
-    using Eval = EvaluatorTensorProduct<variant,
-                                        dim,
-                                        fe_degree + 1,
-                                        n_q_points_1d,
-                                        Number>;
+    using Eval = typename std::conditional<
+      vectorize_within_cell,
+      EvaluatorTensorProductWithinCell<variant,
+                                       dim,
+                                       fe_degree + 1,
+                                       n_q_points_1d,
+                                       Number>,
+      EvaluatorTensorProduct<variant,
+                             dim,
+                             fe_degree + 1,
+                             n_q_points_1d,
+                             Number>>::type;
     Eval eval(variant == evaluate_evenodd ?
                 shape_info.data.front().shape_values_eo :
                 shape_info.data.front().shape_values,
@@ -455,9 +482,15 @@ namespace internal
             int                              dim,
             int                              fe_degree,
             int                              n_q_points_1d,
-            typename Number>
+            typename Number,
+            bool                             vectorize_within_cell>
   inline void
-  FEEvaluationImpl<type, dim, fe_degree, n_q_points_1d, Number>::integrate(
+  FEEvaluationImpl<type,
+                   dim,
+                   fe_degree,
+                   n_q_points_1d,
+                   Number,
+                   vectorize_within_cell>::integrate(
     const unsigned int                            n_components,
     const EvaluationFlags::EvaluationFlags        integration_flag,
     const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
@@ -470,11 +503,18 @@ namespace internal
   {
     const EvaluatorVariant variant =
       EvaluatorSelector<type, (fe_degree + n_q_points_1d > 4)>::variant;
-    using Eval = EvaluatorTensorProduct<variant,
-                                        dim,
-                                        fe_degree + 1,
-                                        n_q_points_1d,
-                                        Number>;
+    using Eval = typename std::conditional<
+      vectorize_within_cell,
+      EvaluatorTensorProductWithinCell<variant,
+                                       dim,
+                                       fe_degree + 1,
+                                       n_q_points_1d,
+                                       Number>,
+      EvaluatorTensorProduct<variant,
+                             dim,
+                             fe_degree + 1,
+                             n_q_points_1d,
+                             Number>>::type;
     Eval eval(variant == evaluate_evenodd ?
                 shape_info.data.front().shape_values_eo :
                 shape_info.data.front().shape_values,
@@ -35,9 +35,27 @@ class FEEvaluationBaseData;
 
 namespace internal
 {
+  /**
+   * Entry points to the sum factorization kernels of FEEvaluation and
+   * FEFaceEvaluation for elements whose polynomial degree is only known at
+   * run time. The library contains instantiations of the kernels for the
+   * degrees 1 to `FE_EVAL_FACTORY_DEGREE_MAX` and the common numbers of
+   * quadrature points, see
+   * `include/deal.II/matrix_free/evaluation_template_factory.templates.h`,
+   * and selects them from a table indexed by the degree and the number of
+   * quadrature points. All other combinations take the slow path with
+   * loop bounds that are only known at run time.
+   *
+   * If deal.II is configured with `DEAL_II_COMPONENT_MATRIX_FREE_HIGH_DEGREE`,
+   * the classes with @p high_degree set to true contain the kernels for the
+   * degrees 7 to 15. They are compiled into separate object files of the
+   * library, and the functions of the default classes forward these degrees
+   * to them.
+   */
   template <int dim,
             typename Number,
-            typename VectorizedArrayType = VectorizedArray<Number>>
+            typename VectorizedArrayType = VectorizedArray<Number>,
+            bool high_degree             = false>
   struct FEEvaluationFactory
   {
     static void
@@ -72,7 +90,8 @@ namespace internal
 
   template <int dim,
             typename Number,
-            typename VectorizedArrayType = VectorizedArray<Number>>
+            typename VectorizedArrayType = VectorizedArray<Number>,
+            bool high_degree             = false>
   struct FEFaceEvaluationFactory
   {
     static void
@@ -167,7 +186,8 @@ namespace internal
 
   template <int dim,
             typename Number,
-            typename VectorizedArrayType = VectorizedArray<Number>>
+            typename VectorizedArrayType = VectorizedArray<Number>,
+            bool high_degree             = false>
   struct CellwiseInverseMassFactory
   {
     static void
@@ -199,7 +219,8 @@ namespace internal
 
   template <int dim,
             typename Number,
-            typename VectorizedArrayType = VectorizedArray<Number>>
+            typename VectorizedArrayType = VectorizedArray<Number>,
+            bool high_degree             = false>
   struct FEEvaluationHangingNodesFactory
   {
     /**
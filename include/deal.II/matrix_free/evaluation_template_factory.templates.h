@@ -25,6 +25,8 @@
 #include <deal.II/matrix_free/evaluation_template_factory.h>
 #include <deal.II/matrix_free/fe_evaluation.h>
 
+#include <array>
+
 #ifndef FE_EVAL_FACTORY_DEGREE_MAX
 #  define FE_EVAL_FACTORY_DEGREE_MAX 6
 #endif
@@ -33,34 +35,119 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace internal
 {
-  template <int degree, typename EvaluatorType, typename... Args>
+  /**
+   * The range of polynomial degrees of the kernels in the classes with
+   * template argument `high_degree = true`, which are compiled into the
+   * library if it is configured with
+   * `DEAL_II_COMPONENT_MATRIX_FREE_HIGH_DEGREE`.
+   */
+  constexpr unsigned int fe_eval_factory_high_degree_min = 7;
+  constexpr unsigned int fe_eval_factory_high_degree_max = 15;
+
+#ifdef DEAL_II_COMPONENT_MATRIX_FREE_HIGH_DEGREE
+  constexpr bool fe_eval_factory_has_high_degree = true;
+#else
+  constexpr bool fe_eval_factory_has_high_degree = false;
+#endif
+
+
+
+  /**
+   * Return whether a function of a factory class with the given value of
+   * @p high_degree should forward @p degree to the class with the kernels for
+   * high degrees, because it does not have a precompiled kernel for it
+   * itself.
+   */
+  template <bool high_degree>
+  inline bool
+  forward_to_high_degree(const unsigned int degree)
+  {
+    return fe_eval_factory_has_high_degree && !high_degree &&
+           degree > FE_EVAL_FACTORY_DEGREE_MAX &&
+           degree <= fe_eval_factory_high_degree_max;
+  }
+
+
+
+  /**
+   * Table of the functions `EvaluatorType::run<degree, n_q_points_1d>()`
+   * for the degrees from @p min_degree to @p max_degree, each with
+   * `n_q_points_1d` equal to `degree`, `degree+1`, `degree+2` and
+   * `3*degree/2+1`, indexed by the degree and the number of quadrature
+   * points. All other entries point to the slow path
+   * `EvaluatorType::run<-1, 0>()`. Looking up a kernel thus costs a single
+   * indirect call rather than a comparison for every precompiled degree.
+   */
+  template <int min_degree,
+            int max_degree,
+            typename EvaluatorType,
+            typename... Args>
+  class InstantiationTable
+  {
+  public:
+    using FunctionType = bool (*)(Args &...);
+
+    InstantiationTable()
+    {
+      for (auto &row : table)
+        row.fill(&run_kernel<-1, 0>);
+      fill<min_degree>();
+    }
+
+    FunctionType
+    get(const unsigned int degree, const unsigned int n_q_points_1d) const
+    {
+      if (degree < min_degree || degree > max_degree ||
+          n_q_points_1d >= n_columns)
+        return &run_kernel<-1, 0>;
+      else
+        return table[degree - min_degree][n_q_points_1d];
+    }
+
+  private:
+    static constexpr unsigned int n_columns = (3 * max_degree) / 2 + 3;
+
+    template <int degree, int n_q_points_1d>
+    static bool
+    run_kernel(Args &...args)
+    {
+      return EvaluatorType::template run<degree, n_q_points_1d>(args...);
+    }
+
+    template <int degree>
+    void
+    fill()
+    {
+      auto &row                   = table[degree - min_degree];
+      row[(3 * degree) / 2 + 1]   = &run_kernel<degree, (3 * degree) / 2 + 1>;
+      row[degree]                 = &run_kernel<degree, degree>;
+      row[degree + 2]             = &run_kernel<degree, degree + 2>;
+      row[degree + 1]             = &run_kernel<degree, degree + 1>;
+      if (degree < max_degree)
+        fill<(degree < max_degree ? degree + 1 : degree)>();
+    }
+
+    std::array<std::array<FunctionType, n_columns>,
+               max_degree - min_degree + 1>
+      table;
+  };
+
+
+
+  template <bool high_degree, typename EvaluatorType, typename... Args>
   bool
   instantiation_helper_run(const unsigned int given_degree,
                            const unsigned int n_q_points_1d,
                            Args &...args)
   {
-    if (given_degree == degree)
-      {
-        if (n_q_points_1d == degree + 1)
-          return EvaluatorType::template run<degree, degree + 1>(args...);
-        else if (n_q_points_1d == degree + 2)
-          return EvaluatorType::template run<degree, degree + 2>(args...);
-        else if (n_q_points_1d == degree)
-          return EvaluatorType::template run<degree, degree>(args...);
-        else if (n_q_points_1d == (3 * degree) / 2 + 1)
-          return EvaluatorType::template run<degree, (3 * degree) / 2 + 1>(
-            args...);
-        else
-          // slow path
-          return EvaluatorType::template run<-1, 0>(args...);
-      }
-    else if (degree < FE_EVAL_FACTORY_DEGREE_MAX)
-      return instantiation_helper_run<
-        (degree < FE_EVAL_FACTORY_DEGREE_MAX ? degree + 1 : degree),
-        EvaluatorType>(given_degree, n_q_points_1d, args...);
-    else
-      // slow path
-      return EvaluatorType::template run<-1, 0>(args...);
+    static const InstantiationTable<
+      high_degree ? fe_eval_factory_high_degree_min : 1,
+      high_degree ? fe_eval_factory_high_degree_max :
+                    FE_EVAL_FACTORY_DEGREE_MAX,
+      EvaluatorType,
+      Args...>
+      table;
+    return table.get(given_degree, n_q_points_1d)(args...);
   }
 
   struct FastEvaluationSupported
@@ -75,9 +162,12 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  FEEvaluationFactory<dim, Number, VectorizedArrayType>::evaluate(
+  FEEvaluationFactory<dim, Number, VectorizedArrayType, high_degree>::evaluate(
     const unsigned int                                         n_components,
     const EvaluationFlags::EvaluationFlags                     evaluation_flag,
     const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &shape_info,
@@ -87,8 +177,22 @@ namespace internal
     VectorizedArrayType *hessians_quad,
     VectorizedArrayType *scratch_data)
   {
+    if (forward_to_high_degree<high_degree>(shape_info.data[0].fe_degree))
+      return FEEvaluationFactory<dim,
+                                 Number,
+                                 VectorizedArrayType,
+                                 fe_eval_factory_has_high_degree>::
+        evaluate(n_components,
+                 evaluation_flag,
+                 shape_info,
+                 values_dofs_actual,
+                 values_quad,
+                 gradients_quad,
+                 hessians_quad,
+                 scratch_data);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       FEEvaluationImplEvaluateSelector<dim, VectorizedArrayType>>(
       shape_info.data[0].fe_degree,
       shape_info.data[0].n_q_points_1d,
@@ -104,9 +208,12 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  FEEvaluationFactory<dim, Number, VectorizedArrayType>::integrate(
+  FEEvaluationFactory<dim, Number, VectorizedArrayType, high_degree>::integrate(
     const unsigned int                                         n_components,
     const EvaluationFlags::EvaluationFlags                     integration_flag,
     const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &shape_info,
@@ -117,8 +224,23 @@ namespace internal
     VectorizedArrayType *scratch_data,
     const bool           sum_into_values_array)
   {
+    if (forward_to_high_degree<high_degree>(shape_info.data[0].fe_degree))
+      return FEEvaluationFactory<dim,
+                                 Number,
+                                 VectorizedArrayType,
+                                 fe_eval_factory_has_high_degree>::
+        integrate(n_components,
+                  integration_flag,
+                  shape_info,
+                  values_dofs_actual,
+                  values_quad,
+                  gradients_quad,
+                  hessians_quad,
+                  scratch_data,
+                  sum_into_values_array);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       FEEvaluationImplIntegrateSelector<dim, VectorizedArrayType>>(
       shape_info.data[0].fe_degree,
       shape_info.data[0].n_q_points_1d,
@@ -135,38 +257,73 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   bool
-  FEEvaluationFactory<dim, Number, VectorizedArrayType>::
+  FEEvaluationFactory<dim, Number, VectorizedArrayType, high_degree>::
     fast_evaluation_supported(const unsigned int given_degree,
                               const unsigned int n_q_points_1d)
   {
-    return instantiation_helper_run<1, FastEvaluationSupported>(given_degree,
-                                                                n_q_points_1d);
+    if (forward_to_high_degree<high_degree>(given_degree))
+      return FEEvaluationFactory<dim,
+                                 Number,
+                                 VectorizedArrayType,
+                                 fe_eval_factory_has_high_degree>::
+        fast_evaluation_supported(given_degree,
+                                  n_q_points_1d);
+
+    return instantiation_helper_run<high_degree, FastEvaluationSupported>(
+      given_degree, n_q_points_1d);
   }
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType>::evaluate(
-    const unsigned int                                         n_components,
-    const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &data,
-    const VectorizedArrayType *                                values_array,
-    VectorizedArrayType *                                      values_quad,
-    VectorizedArrayType *                                      gradients_quad,
-    VectorizedArrayType *                                      hessians_quad,
-    VectorizedArrayType *                                      scratch_data,
-    const bool                                                 evaluate_values,
-    const bool                    evaluate_gradients,
-    const bool                    evaluate_hessians,
-    const unsigned int            face_no,
-    const unsigned int            subface_index,
-    const unsigned int            face_orientation,
-    const Table<2, unsigned int> &orientation_map)
+  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType, high_degree>::
+    evaluate(
+      const unsigned int                                         n_components,
+      const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &data,
+      const VectorizedArrayType *                                values_array,
+      VectorizedArrayType *                                      values_quad,
+      VectorizedArrayType *                                      gradients_quad,
+      VectorizedArrayType *                                      hessians_quad,
+      VectorizedArrayType *                                      scratch_data,
+      const bool                    evaluate_values,
+      const bool                    evaluate_gradients,
+      const bool                    evaluate_hessians,
+      const unsigned int            face_no,
+      const unsigned int            subface_index,
+      const unsigned int            face_orientation,
+      const Table<2, unsigned int> &orientation_map)
   {
+    if (forward_to_high_degree<high_degree>(data.data[0].fe_degree))
+      return FEFaceEvaluationFactory<dim,
+                                     Number,
+                                     VectorizedArrayType,
+                                     fe_eval_factory_has_high_degree>::
+        evaluate(n_components,
+                 data,
+                 values_array,
+                 values_quad,
+                 gradients_quad,
+                 hessians_quad,
+                 scratch_data,
+                 evaluate_values,
+                 evaluate_gradients,
+                 evaluate_hessians,
+                 face_no,
+                 subface_index,
+                 face_orientation,
+                 orientation_map);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       FEFaceEvaluationImplEvaluateSelector<dim, VectorizedArrayType>>(
       data.data[0].fe_degree,
       data.data[0].n_q_points_1d,
@@ -188,26 +345,50 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType>::integrate(
-    const unsigned int                                         n_components,
-    const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &data,
-    VectorizedArrayType *                                      values_array,
-    VectorizedArrayType *                                      values_quad,
-    VectorizedArrayType *                                      gradients_quad,
-    VectorizedArrayType *                                      hessians_quad,
-    VectorizedArrayType *                                      scratch_data,
-    const bool                                                 integrate_values,
-    const bool                    integrate_gradients,
-    const bool                    integrate_hessians,
-    const unsigned int            face_no,
-    const unsigned int            subface_index,
-    const unsigned int            face_orientation,
-    const Table<2, unsigned int> &orientation_map)
+  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType, high_degree>::
+    integrate(
+      const unsigned int                                         n_components,
+      const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &data,
+      VectorizedArrayType *                                      values_array,
+      VectorizedArrayType *                                      values_quad,
+      VectorizedArrayType *                                      gradients_quad,
+      VectorizedArrayType *                                      hessians_quad,
+      VectorizedArrayType *                                      scratch_data,
+      const bool                    integrate_values,
+      const bool                    integrate_gradients,
+      const bool                    integrate_hessians,
+      const unsigned int            face_no,
+      const unsigned int            subface_index,
+      const unsigned int            face_orientation,
+      const Table<2, unsigned int> &orientation_map)
   {
+    if (forward_to_high_degree<high_degree>(data.data[0].fe_degree))
+      return FEFaceEvaluationFactory<dim,
+                                     Number,
+                                     VectorizedArrayType,
+                                     fe_eval_factory_has_high_degree>::
+        integrate(n_components,
+                  data,
+                  values_array,
+                  values_quad,
+                  gradients_quad,
+                  hessians_quad,
+                  scratch_data,
+                  integrate_values,
+                  integrate_gradients,
+                  integrate_hessians,
+                  face_no,
+                  subface_index,
+                  face_orientation,
+                  orientation_map);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       FEFaceEvaluationImplIntegrateSelector<dim, VectorizedArrayType>>(
       data.data[0].fe_degree,
       data.data[0].n_q_points_1d,
@@ -229,34 +410,65 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   bool
-  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType>::gather_evaluate(
-    const unsigned int                          n_components,
-    const std::size_t                           n_face_orientations,
-    const Number *                              src_ptr,
-    const std::vector<ArrayView<const Number>> *sm_ptr,
-    const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &data,
-    const MatrixFreeFunctions::DoFInfo &                       dof_info,
-    VectorizedArrayType *                                      values_quad,
-    VectorizedArrayType *                                      gradients_quad,
-    VectorizedArrayType *                                      hessians_quad,
-    VectorizedArrayType *                                      scratch_data,
-    const bool                                                 evaluate_values,
-    const bool         evaluate_gradients,
-    const bool         evaluate_hessians,
-    const unsigned int active_fe_index,
-    const unsigned int first_selected_component,
-    const std::array<unsigned int, VectorizedArrayType::size()> cells,
-    const std::array<unsigned int, VectorizedArrayType::size()> face_nos,
-    const unsigned int                                          subface_index,
-    const MatrixFreeFunctions::DoFInfo::DoFAccessIndex dof_access_index,
-    const std::array<unsigned int, VectorizedArrayType::size()>
-                                  face_orientations,
-    const Table<2, unsigned int> &orientation_map)
+  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType, high_degree>::
+    gather_evaluate(
+      const unsigned int                          n_components,
+      const std::size_t                           n_face_orientations,
+      const Number *                              src_ptr,
+      const std::vector<ArrayView<const Number>> *sm_ptr,
+      const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &data,
+      const MatrixFreeFunctions::DoFInfo &                       dof_info,
+      VectorizedArrayType *                                      values_quad,
+      VectorizedArrayType *                                      gradients_quad,
+      VectorizedArrayType *                                      hessians_quad,
+      VectorizedArrayType *                                      scratch_data,
+      const bool                    evaluate_values,
+      const bool         evaluate_gradients,
+      const bool         evaluate_hessians,
+      const unsigned int active_fe_index,
+      const unsigned int first_selected_component,
+      const std::array<unsigned int, VectorizedArrayType::size()> cells,
+      const std::array<unsigned int, VectorizedArrayType::size()> face_nos,
+      const unsigned int                                          subface_index,
+      const MatrixFreeFunctions::DoFInfo::DoFAccessIndex dof_access_index,
+      const std::array<unsigned int, VectorizedArrayType::size()>
+                                    face_orientations,
+      const Table<2, unsigned int> &orientation_map)
   {
+    if (forward_to_high_degree<high_degree>(data.data[0].fe_degree))
+      return FEFaceEvaluationFactory<dim,
+                                     Number,
+                                     VectorizedArrayType,
+                                     fe_eval_factory_has_high_degree>::
+        gather_evaluate(n_components,
+                        n_face_orientations,
+                        src_ptr,
+                        sm_ptr,
+                        data,
+                        dof_info,
+                        values_quad,
+                        gradients_quad,
+                        hessians_quad,
+                        scratch_data,
+                        evaluate_values,
+                        evaluate_gradients,
+                        evaluate_hessians,
+                        active_fe_index,
+                        first_selected_component,
+                        cells,
+                        face_nos,
+                        subface_index,
+                        dof_access_index,
+                        face_orientations,
+                        orientation_map);
+
     return instantiation_helper_run<
-      1,
+      high_degree,
       FEFaceEvaluationImplGatherEvaluateSelector<dim,
                                                  Number,
                                                  VectorizedArrayType>>(
@@ -287,35 +499,67 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   bool
-  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType>::integrate_scatter(
-    const unsigned int                          n_components,
-    const std::size_t                           n_face_orientations,
-    Number *                                    dst_ptr,
-    const std::vector<ArrayView<const Number>> *sm_ptr,
-    const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &data,
-    const MatrixFreeFunctions::DoFInfo &                       dof_info,
-    VectorizedArrayType *                                      values_array,
-    VectorizedArrayType *                                      values_quad,
-    VectorizedArrayType *                                      gradients_quad,
-    VectorizedArrayType *                                      hessians_quad,
-    VectorizedArrayType *                                      scratch_data,
-    const bool                                                 integrate_values,
-    const bool         integrate_gradients,
-    const bool         integrate_hessians,
-    const unsigned int active_fe_index,
-    const unsigned int first_selected_component,
-    const std::array<unsigned int, VectorizedArrayType::size()> cells,
-    const std::array<unsigned int, VectorizedArrayType::size()> face_nos,
-    const unsigned int                                          subface_index,
-    const MatrixFreeFunctions::DoFInfo::DoFAccessIndex dof_access_index,
-    const std::array<unsigned int, VectorizedArrayType::size()>
-                                  face_orientations,
-    const Table<2, unsigned int> &orientation_map)
+  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType, high_degree>::
+    integrate_scatter(
+      const unsigned int                          n_components,
+      const std::size_t                           n_face_orientations,
+      Number *                                    dst_ptr,
+      const std::vector<ArrayView<const Number>> *sm_ptr,
+      const MatrixFreeFunctions::ShapeInfo<VectorizedArrayType> &data,
+      const MatrixFreeFunctions::DoFInfo &                       dof_info,
+      VectorizedArrayType *                                      values_array,
+      VectorizedArrayType *                                      values_quad,
+      VectorizedArrayType *                                      gradients_quad,
+      VectorizedArrayType *                                      hessians_quad,
+      VectorizedArrayType *                                      scratch_data,
+      const bool                    integrate_values,
+      const bool         integrate_gradients,
+      const bool         integrate_hessians,
+      const unsigned int active_fe_index,
+      const unsigned int first_selected_component,
+      const std::array<unsigned int, VectorizedArrayType::size()> cells,
+      const std::array<unsigned int, VectorizedArrayType::size()> face_nos,
+      const unsigned int                                          subface_index,
+      const MatrixFreeFunctions::DoFInfo::DoFAccessIndex dof_access_index,
+      const std::array<unsigned int, VectorizedArrayType::size()>
+                                    face_orientations,
+      const Table<2, unsigned int> &orientation_map)
   {
+    if (forward_to_high_degree<high_degree>(data.data[0].fe_degree))
+      return FEFaceEvaluationFactory<dim,
+                                     Number,
+                                     VectorizedArrayType,
+                                     fe_eval_factory_has_high_degree>::
+        integrate_scatter(n_components,
+                          n_face_orientations,
+                          dst_ptr,
+                          sm_ptr,
+                          data,
+                          dof_info,
+                          values_array,
+                          values_quad,
+                          gradients_quad,
+                          hessians_quad,
+                          scratch_data,
+                          integrate_values,
+                          integrate_gradients,
+                          integrate_hessians,
+                          active_fe_index,
+                          first_selected_component,
+                          cells,
+                          face_nos,
+                          subface_index,
+                          dof_access_index,
+                          face_orientations,
+                          orientation_map);
+
     return instantiation_helper_run<
-      1,
+      high_degree,
       FEFaceEvaluationImplIntegrateScatterSelector<dim,
                                                    Number,
                                                    VectorizedArrayType>>(
@@ -347,48 +591,90 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   bool
-  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType>::
+  FEFaceEvaluationFactory<dim, Number, VectorizedArrayType, high_degree>::
     fast_evaluation_supported(const unsigned int given_degree,
                               const unsigned int n_q_points_1d)
   {
-    return instantiation_helper_run<1, FastEvaluationSupported>(given_degree,
-                                                                n_q_points_1d);
+    if (forward_to_high_degree<high_degree>(given_degree))
+      return FEFaceEvaluationFactory<dim,
+                                     Number,
+                                     VectorizedArrayType,
+                                     fe_eval_factory_has_high_degree>::
+        fast_evaluation_supported(given_degree,
+                                  n_q_points_1d);
+
+    return instantiation_helper_run<high_degree, FastEvaluationSupported>(
+      given_degree, n_q_points_1d);
   }
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  CellwiseInverseMassFactory<dim, Number, VectorizedArrayType>::apply(
-    const unsigned int n_components,
-    const unsigned int fe_degree,
-    const FEEvaluationBaseData<dim, Number, false, VectorizedArrayType>
-      &                        fe_eval,
-    const VectorizedArrayType *in_array,
-    VectorizedArrayType *      out_array)
+  CellwiseInverseMassFactory<dim, Number, VectorizedArrayType, high_degree>::
+    apply(
+      const unsigned int n_components,
+      const unsigned int fe_degree,
+      const FEEvaluationBaseData<dim, Number, false, VectorizedArrayType>
+        &                        fe_eval,
+      const VectorizedArrayType *in_array,
+      VectorizedArrayType *      out_array)
   {
+    if (forward_to_high_degree<high_degree>(fe_degree))
+      return CellwiseInverseMassFactory<dim,
+                                        Number,
+                                        VectorizedArrayType,
+                                        fe_eval_factory_has_high_degree>::
+        apply(n_components,
+              fe_degree,
+              fe_eval,
+              in_array,
+              out_array);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       CellwiseInverseMassMatrixImplBasic<dim, VectorizedArrayType>>(
       fe_degree, fe_degree + 1, n_components, fe_eval, in_array, out_array);
   }
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  CellwiseInverseMassFactory<dim, Number, VectorizedArrayType>::apply(
-    const unsigned int                        n_components,
-    const unsigned int                        fe_degree,
-    const AlignedVector<VectorizedArrayType> &inverse_shape,
-    const AlignedVector<VectorizedArrayType> &inverse_coefficients,
-    const VectorizedArrayType *               in_array,
-    VectorizedArrayType *                     out_array)
+  CellwiseInverseMassFactory<dim, Number, VectorizedArrayType, high_degree>::
+    apply(
+      const unsigned int                        n_components,
+      const unsigned int                        fe_degree,
+      const AlignedVector<VectorizedArrayType> &inverse_shape,
+      const AlignedVector<VectorizedArrayType> &inverse_coefficients,
+      const VectorizedArrayType *               in_array,
+      VectorizedArrayType *                     out_array)
   {
+    if (forward_to_high_degree<high_degree>(fe_degree))
+      return CellwiseInverseMassFactory<dim,
+                                        Number,
+                                        VectorizedArrayType,
+                                        fe_eval_factory_has_high_degree>::
+        apply(n_components,
+              fe_degree,
+              inverse_shape,
+              inverse_coefficients,
+              in_array,
+              out_array);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       CellwiseInverseMassMatrixImplFlexible<dim, VectorizedArrayType>>(
       fe_degree,
       fe_degree + 1,
@@ -401,9 +687,12 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  CellwiseInverseMassFactory<dim, Number, VectorizedArrayType>::
+  CellwiseInverseMassFactory<dim, Number, VectorizedArrayType, high_degree>::
     transform_from_q_points_to_basis(
       const unsigned int n_components,
       const unsigned int fe_degree,
@@ -413,8 +702,20 @@ namespace internal
       const VectorizedArrayType *in_array,
       VectorizedArrayType *      out_array)
   {
+    if (forward_to_high_degree<high_degree>(fe_degree))
+      return CellwiseInverseMassFactory<dim,
+                                        Number,
+                                        VectorizedArrayType,
+                                        fe_eval_factory_has_high_degree>::
+        transform_from_q_points_to_basis(n_components,
+                                         fe_degree,
+                                         n_q_points_1d,
+                                         fe_eval,
+                                         in_array,
+                                         out_array);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       CellwiseInverseMassMatrixImplTransformFromQPoints<dim,
                                                         VectorizedArrayType>>(
       fe_degree, n_q_points_1d, n_components, fe_eval, in_array, out_array);
@@ -422,20 +723,39 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  FEEvaluationHangingNodesFactory<dim, Number, VectorizedArrayType>::apply(
-    const unsigned int n_components,
-    const unsigned int fe_degree,
-    const FEEvaluationBaseData<dim, Number, false, VectorizedArrayType>
-      &                                            fe_eval,
-    const bool                                     transpose,
-    const std::array<MatrixFreeFunctions::ConstraintKinds,
-                     VectorizedArrayType::size()> &c_mask,
-    VectorizedArrayType *                          values)
+  FEEvaluationHangingNodesFactory<dim,
+                                  Number,
+                                  VectorizedArrayType,
+                                  high_degree>::
+    apply(
+      const unsigned int n_components,
+      const unsigned int fe_degree,
+      const FEEvaluationBaseData<dim, Number, false, VectorizedArrayType>
+        &                                            fe_eval,
+      const bool                                     transpose,
+      const std::array<MatrixFreeFunctions::ConstraintKinds,
+                       VectorizedArrayType::size()> &c_mask,
+      VectorizedArrayType *                          values)
   {
+    if (forward_to_high_degree<high_degree>(fe_degree))
+      return FEEvaluationHangingNodesFactory<dim,
+                                             Number,
+                                             VectorizedArrayType,
+                                             fe_eval_factory_has_high_degree>::
+        apply(n_components,
+              fe_degree,
+              fe_eval,
+              transpose,
+              c_mask,
+              values);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       FEEvaluationImplHangingNodes<dim, VectorizedArrayType, false>>(
       fe_degree,
       fe_degree + 1,
@@ -448,19 +768,39 @@ namespace internal
 
 
 
-  template <int dim, typename Number, typename VectorizedArrayType>
+  template <int dim,
+            typename Number,
+            typename VectorizedArrayType,
+            bool high_degree>
   void
-  FEEvaluationHangingNodesFactory<dim, Number, VectorizedArrayType>::apply(
-    const unsigned int n_components,
-    const unsigned int fe_degree,
-    const FEEvaluationBaseData<dim, Number, true, VectorizedArrayType> &fe_eval,
-    const bool                                     transpose,
-    const std::array<MatrixFreeFunctions::ConstraintKinds,
-                     VectorizedArrayType::size()> &c_mask,
-    VectorizedArrayType *                          values)
+  FEEvaluationHangingNodesFactory<dim,
+                                  Number,
+                                  VectorizedArrayType,
+                                  high_degree>::
+    apply(
+      const unsigned int n_components,
+      const unsigned int fe_degree,
+      const FEEvaluationBaseData<dim, Number, true, VectorizedArrayType>
+        &                                            fe_eval,
+      const bool                                     transpose,
+      const std::array<MatrixFreeFunctions::ConstraintKinds,
+                       VectorizedArrayType::size()> &c_mask,
+      VectorizedArrayType *                          values)
   {
+    if (forward_to_high_degree<high_degree>(fe_degree))
+      return FEEvaluationHangingNodesFactory<dim,
+                                             Number,
+                                             VectorizedArrayType,
+                                             fe_eval_factory_has_high_degree>::
+        apply(n_components,
+              fe_degree,
+              fe_eval,
+              transpose,
+              c_mask,
+              values);
+
     instantiation_helper_run<
-      1,
+      high_degree,
       FEEvaluationImplHangingNodes<dim, VectorizedArrayType, true>>(
       fe_degree,
       fe_degree + 1,
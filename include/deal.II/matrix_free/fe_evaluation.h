@@ -1409,6 +1409,19 @@ private:
   template <bool transpose>
   void
   apply_hanging_node_constraints() const;
+
+  /**
+   * Apply the cell-wise diagonal scaling of the degrees of freedom of
+   * elements whose degrees of freedom are derivatives, such as FE_Hermite,
+   * see ShapeInfo::derivative_order_1d. Without @p inverse, the entries
+   * are multiplied by $\prod_d h_d^{k_d}$, otherwise they are divided by
+   * this factor. The cell extents $h_d$ are the lengths of the edges of the
+   * cell, which are computed from the Jacobian, i.e., the cells must be
+   * parallelograms or parallelepipeds as described for MappingHermite.
+   */
+  template <bool inverse>
+  void
+  apply_dof_rescaling() const;
 };
 
 
@@ -2355,7 +2368,9 @@ protected:
  * 2.1e-9 seconds per degree of freedom or 48 million degrees of freedom per
  * second. Note that using FEEvaluation with template `degree=-1` selects the
  * fast path for degrees between one and six, and the slow path for other
- * degrees.
+ * degrees, unless deal.II is configured with
+ * `-DDEAL_II_COMPONENT_MATRIX_FREE_HIGH_DEGREE=ON`, which adds precompiled
+ * kernels for the degrees seven to fifteen to the library.
  *
  * <h4>Pre-compiling code for more polynomial degrees</h4>
  *
@@ -5409,6 +5424,60 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
 
 
 
+template <int dim,
+          int n_components_,
+          typename Number,
+          bool is_face,
+          typename VectorizedArrayType>
+template <bool inverse>
+inline void
+FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
+  apply_dof_rescaling() const
+{
+  const std::vector<unsigned int> &derivative_order =
+    this->data->derivative_order_1d;
+  if (derivative_order.empty())
+    return; // nothing to do for elements with nodal degrees of freedom
+
+  AssertThrow(is_face == false,
+              ExcMessage("The rescaling of the degrees of freedom of "
+                         "FE_Hermite is only implemented for FEEvaluation "
+                         "on cells."));
+  Assert(this->jacobian != nullptr, ExcNotInitialized());
+
+  // The stored inverse Jacobian is the transpose of the inverse of the
+  // Jacobian of the affine cell, so the rows of its inverse are the edges of
+  // the cell, whose lengths are the extents h_d. Apply the scaling one
+  // direction at a time, such that the power of h_d only needs to be formed
+  // once per 1D shape function.
+  const Tensor<2, dim, VectorizedArrayType> edges = invert(this->jacobian[0]);
+  const unsigned int n_dofs_1d = derivative_order.size();
+  unsigned int       stride    = 1;
+  for (unsigned int d = 0; d < dim; ++d, stride *= n_dofs_1d)
+    {
+      const VectorizedArrayType h = edges[d].norm();
+      const VectorizedArrayType h_power_base = inverse ? Number(1.) / h : h;
+      const unsigned int n_blocks =
+        this->data->dofs_per_component_on_cell / (stride * n_dofs_1d);
+      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+        {
+          if (derivative_order[i] == 0)
+            continue;
+
+          VectorizedArrayType factor = h_power_base;
+          for (unsigned int k = 1; k < derivative_order[i]; ++k)
+            factor *= h_power_base;
+
+          for (unsigned int c = 0; c < n_components; ++c)
+            for (unsigned int b = 0; b < n_blocks; ++b)
+              for (unsigned int j = 0; j < stride; ++j)
+                values_dofs[c][(b * n_dofs_1d + i) * stride + j] *= factor;
+        }
+    }
+}
+
+
+
 template <int dim,
           int n_components_,
           typename Number,
@@ -5435,6 +5504,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                        true);
 
   apply_hanging_node_constraints<false>();
+  apply_dof_rescaling<false>();
 
 #  ifdef DEBUG
   dof_values_initialized = true;
@@ -5468,6 +5538,8 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
                        std::bitset<VectorizedArrayType::size()>().flip(),
                        false);
 
+  apply_dof_rescaling<false>();
+
 #  ifdef DEBUG
   dof_values_initialized = true;
 #  endif
@@ -5493,6 +5565,7 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
          internal::ExcAccessToUninitializedField());
 #  endif
 
+  apply_dof_rescaling<false>();
   apply_hanging_node_constraints<true>();
 
   const auto dst_data = internal::get_vector_data<n_components_>(
@@ -5535,8 +5608,15 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
     this->active_fe_index,
     this->dof_info);
 
+  // the values are coefficients of the shape functions on the reference
+  // cell, so undo the scaling applied by read_dof_values() and restore the
+  // values afterwards
+  apply_dof_rescaling<true>();
+
   internal::VectorSetter<Number, VectorizedArrayType> setter;
   read_write_operation(setter, dst_data.first, dst_data.second, mask);
+
+  apply_dof_rescaling<false>();
 }
 
 
@@ -5567,8 +5647,12 @@ FEEvaluationBase<dim, n_components_, Number, is_face, VectorizedArrayType>::
     this->active_fe_index,
     this->dof_info);
 
+  apply_dof_rescaling<true>();
+
   internal::VectorSetter<Number, VectorizedArrayType> setter;
   read_write_operation(setter, dst_data.first, dst_data.second, mask, false);
+
+  apply_dof_rescaling<false>();
 }
 
 
@@ -8375,6 +8459,7 @@ namespace internal
     // vector to the evaluate() call, without reading the vector entries into a
     // separate data field. This saves some operations.
     if (std::is_same<typename VectorType::value_type, Number>::value &&
+        phi->get_shape_info().derivative_order_1d.empty() &&
         dof_info->index_storage_variants
             [internal::MatrixFreeFunctions::DoFInfo::dof_access_cell][cell] ==
           internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
@@ -8464,6 +8549,7 @@ namespace internal
     // separate data field that will later be added into the vector. This saves
     // some operations.
     if (std::is_same<typename VectorType::value_type, Number>::value &&
+        data->derivative_order_1d.empty() &&
         dof_info->index_storage_variants
             [internal::MatrixFreeFunctions::DoFInfo::dof_access_cell][cell] ==
           internal::MatrixFreeFunctions::DoFInfo::IndexStorageVariants::
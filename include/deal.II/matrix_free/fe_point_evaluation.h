@@ -26,6 +26,7 @@
 #include <deal.II/base/vectorization.h>
 
 #include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
 #include <deal.II/fe/mapping_q.h>
 
 #include <deal.II/matrix_free/evaluation_flags.h>
@@ -391,6 +392,10 @@ namespace internal
  * that work with the @ref matrixfree module. In those cases, the cost implied
  * by this class is similar (or sometimes even somewhat lower) than using
  * `FEValues::reinit(cell)` followed by `FEValues::get_function_gradients`.
+ * The same holds for FE_Hermite together with MappingHermite, where the
+ * degrees of freedom, which are derivatives in real space, are rescaled with
+ * the extents of the cell before the evaluation with the 1D Hermite
+ * polynomials, as done by FEEvaluation.
  */
 template <int n_components,
           int dim,
@@ -583,6 +588,12 @@ private:
    */
   const MappingQ<dim, spacedim> *mapping_q;
 
+  /**
+   * Pointer to MappingHermite class that enables the fast path of this
+   * class for FE_Hermite.
+   */
+  const MappingHermite<dim, spacedim> *mapping_hermite;
+
   /**
    * Pointer to the FiniteElement object passed to the constructor.
    */
@@ -605,6 +616,21 @@ private:
    */
   std::vector<unsigned int> renumber;
 
+  /**
+   * The order of the derivative each 1D shape function is associated with
+   * for elements whose degrees of freedom are derivatives in the vertices,
+   * such as FE_Hermite, see ShapeInfo::derivative_order_1d. Empty for
+   * elements with nodal degrees of freedom.
+   */
+  std::vector<unsigned int> derivative_order_1d;
+
+  /**
+   * Factors $\prod_d h_d^{k_d}$ by which the unknowns in lexicographic
+   * numbering are scaled on the current cell in the fast path for
+   * FE_Hermite, computed in reinit() from the cell extents.
+   */
+  std::vector<Number> dof_rescaling;
+
   /**
    * Temporary array to store the `solution_values` passed to the evaluate()
    * function in a format compatible with the tensor product evaluators. For
@@ -692,6 +718,8 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::FEPointEvaluation(
   const unsigned int        first_selected_component)
   : mapping(&mapping)
   , mapping_q(dynamic_cast<const MappingQ<dim, spacedim> *>(&mapping))
+  , mapping_hermite(
+      dynamic_cast<const MappingHermite<dim, spacedim> *>(&mapping))
   , fe(&fe)
   , update_flags(update_flags)
   , update_flags_mapping(update_default)
@@ -713,7 +741,7 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::FEPointEvaluation(
       }
     else
       component += fe.element_multiplicity(base_element_number);
-  if (mapping_q != nullptr &&
+  if ((mapping_q != nullptr || mapping_hermite != nullptr) &&
       internal::FEPointEvaluation::is_fast_path_supported(
         fe, base_element_number) &&
       same_base_element)
@@ -721,9 +749,18 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::FEPointEvaluation(
       internal::MatrixFreeFunctions::ShapeInfo<double> shape_info;
 
       shape_info.reinit(QMidpoint<1>(), fe, base_element_number);
-      renumber           = shape_info.lexicographic_numbering;
-      dofs_per_component = shape_info.dofs_per_component_on_cell;
-      poly               = internal::FEPointEvaluation::get_polynomial_space(
+      renumber            = shape_info.lexicographic_numbering;
+      dofs_per_component  = shape_info.dofs_per_component_on_cell;
+      derivative_order_1d = shape_info.derivative_order_1d;
+
+      // the unknowns of FE_Hermite are derivatives in real space, which
+      // only the path of MappingHermite rescales with the cell extents
+      AssertThrow(derivative_order_1d.empty() || mapping_hermite != nullptr,
+                  ExcMessage("Elements whose unknowns are derivatives, such "
+                             "as FE_Hermite, can only be evaluated together "
+                             "with MappingHermite."));
+
+      poly = internal::FEPointEvaluation::get_polynomial_space(
         fe.base_element(base_element_number));
 
       polynomials_are_hat_functions =
@@ -758,6 +795,11 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::FEPointEvaluation(
     update_flags_mapping |= update_inverse_jacobians;
   if (update_flags & update_quadrature_points)
     update_flags_mapping |= update_quadrature_points;
+
+  // the Jacobian of MappingHermite holds the cell extents, which are needed
+  // to rescale the unknowns of FE_Hermite
+  if (!derivative_order_1d.empty())
+    update_flags_mapping |= update_jacobians;
 }
 
 
@@ -771,11 +813,39 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::reinit(
   this->unit_points.resize(unit_points.size());
   std::copy(unit_points.begin(), unit_points.end(), this->unit_points.begin());
 
-  if (!poly.empty())
+  if (!poly.empty() && derivative_order_1d.empty() && mapping_q != nullptr)
     mapping_q->fill_mapping_data_for_generic_points(cell,
                                                     unit_points,
                                                     update_flags_mapping,
                                                     mapping_data);
+  else if (!poly.empty())
+    {
+      mapping_hermite->fill_mapping_data_for_generic_points(
+        cell, unit_points, update_flags_mapping, mapping_data);
+
+      // the shape functions of FE_Hermite on a cell with extents h_d are the
+      // ones on the reference cell times h_d^k, where k is the order of the
+      // derivative in direction d the shape function belongs to. the extents
+      // are the lengths of the columns of the Jacobian
+      if (!derivative_order_1d.empty() && unit_points.size() > 0)
+        {
+          const unsigned int n_dofs_1d = derivative_order_1d.size();
+          const DerivativeForm<1, spacedim, dim> edges =
+            mapping_data.jacobians[0].transpose();
+          dof_rescaling.resize(dofs_per_component);
+          for (unsigned int i = 0; i < dofs_per_component; ++i)
+            {
+              double       factor = 1.;
+              unsigned int index  = i;
+              for (unsigned int d = 0; d < dim; ++d, index /= n_dofs_1d)
+                for (unsigned int k = 0;
+                     k < derivative_order_1d[index % n_dofs_1d];
+                     ++k)
+                  factor *= edges[d].norm();
+              dof_rescaling[i] = factor;
+            }
+        }
+    }
   else
     {
       fe_values = std::make_shared<FEValues<dim, spacedim>>(
@@ -830,6 +900,8 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::evaluate(
               solution_values[renumber[comp * dofs_per_component + i]],
               comp,
               solution_renumbered[i]);
+      for (unsigned int i = 0; i < dof_rescaling.size(); ++i)
+        solution_renumbered[i] *= dof_rescaling[i];
 
       // unit gradients are currently only implemented with the fast tensor
       // path
@@ -1033,7 +1105,7 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::integrate(
               for (unsigned int j = 0; j < lane; ++j)
                 result[j] += result[lane + j];
             solution_values[renumber[comp * dofs_per_component + i]] =
-              result[0];
+              dof_rescaling.empty() ? result[0] : result[0] * dof_rescaling[i];
           }
     }
   else if ((integration_flags & EvaluationFlags::values) ||
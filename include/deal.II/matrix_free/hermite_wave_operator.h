@@ -0,0 +1,648 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_hermite_wave_operator_h
+#define dealii_matrix_free_hermite_wave_operator_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/time_stepping.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
+#include <array>
+#include <map>
+#include <memory>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace MatrixFreeOperators
+{
+  /**
+   * The right hand side of the wave equation $u_{tt} = c^2 \Delta u$
+   * discretized with FE_Hermite, written as the first order system
+   * @f[
+   *   \frac{d}{dt} \begin{pmatrix} u \\ v \end{pmatrix} =
+   *   \begin{pmatrix} v \\ -c^2 M^{-1} L u \end{pmatrix}
+   * @f]
+   * for the explicit time integrators of the TimeStepping namespace, in
+   * particular TimeStepping::LowStorageRungeKutta. The two components are the
+   * blocks of a LinearAlgebra::distributed::BlockVector.
+   *
+   * The mass matrix $M$ and the Laplace matrix $L$ are applied with
+   * MassOperator and LaplaceOperator on a MatrixFree object set up with
+   * MappingHermite, so no sparse matrix is assembled. Since the shape
+   * functions of FE_Hermite are continuously differentiable across the cell
+   * boundaries for regularity one and higher, the mass matrix is not block
+   * diagonal and its inverse is applied with a conjugate gradient solver. It
+   * is preconditioned by the additive Schwarz method over the cells, which
+   * takes the scaling of the derivative degrees of freedom with powers of
+   * the cell size out of the condition number. The local problems are the
+   * mass matrix restricted to the degrees of freedom of a cell, including
+   * the contributions of the neighbors to the degrees of freedom on the
+   * vertices. On a mesh that is a tensor product of 1D meshes, this is the
+   * Kronecker product of the 1D mass matrices from
+   * FE_Hermite::compute_matrices_1d() of the cell, with the vertex blocks
+   * of the 1D mass matrices of the two neighbors in the same direction
+   * added. The inverses of these 1D matrices are applied with sum
+   * factorization and stored once for each distinct combination of the
+   * sizes of a cell and its neighbors, so a solve costs a few applications
+   * of the mass matrix. The inverses of the plain cell mass matrices would
+   * count the vertex degrees of freedom several times and need many more
+   * iterations.
+   *
+   * The preconditioner requires cells with edges parallel to the coordinate
+   * axes. The constraints must be homogeneous, e.g., hanging node
+   * constraints or zero Dirichlet values of the degrees of freedom on the
+   * boundary, and are applied to both components. Without constraints on the
+   * boundary, the boundary condition is $\partial_n u = 0$.
+   */
+  template <int dim, typename Number = double>
+  class HermiteWaveOperator : public Subscriptor
+  {
+  public:
+    /**
+     * Type of the vectors of the two components.
+     */
+    using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+    /**
+     * Type of the vector holding both components.
+     */
+    using BlockVectorType = LinearAlgebra::distributed::BlockVector<Number>;
+
+    /**
+     * Default constructor. reinit() needs to be called before the operator
+     * is used.
+     */
+    HermiteWaveOperator();
+
+    /**
+     * Set up the matrix-free operators and the cell inverses of the mass
+     * matrix for the FE_Hermite element of @p dof_handler, with the 1D
+     * quadrature @p quadrature and the wave speed @p wave_speed. The
+     * inverse of the mass matrix is computed to a relative accuracy of
+     * @p mass_solver_tolerance.
+     */
+    void
+    reinit(const MappingHermite<dim> &      mapping,
+           const DoFHandler<dim> &          dof_handler,
+           const AffineConstraints<Number> &constraints,
+           const Quadrature<1> &            quadrature,
+           const Number                     wave_speed            = 1.,
+           const Number                     mass_solver_tolerance = 1e-12);
+
+    /**
+     * Initialize @p vec with two blocks that hold the displacement $u$ and
+     * the velocity $v$, with the layout of the MatrixFree object.
+     */
+    void
+    initialize_dof_vector(BlockVectorType &vec) const;
+
+    /**
+     * Initialize @p vec with the layout of the MatrixFree object.
+     */
+    void
+    initialize_dof_vector(VectorType &vec) const;
+
+    /**
+     * Evaluate the right hand side of the first order system at the state
+     * @p src and write it into @p dst.
+     */
+    void
+    apply(BlockVectorType &dst, const BlockVectorType &src) const;
+
+    /**
+     * Apply the inverse of the mass matrix to @p src and write the result
+     * into @p dst.
+     */
+    void
+    apply_inverse_mass(VectorType &dst, const VectorType &src) const;
+
+    /**
+     * Advance @p solution from time @p t by the step @p delta_t with the
+     * low-storage Runge-Kutta method @p integrator, and return the new time.
+     * The stages are computed here with the coefficients of @p integrator,
+     * writing the right hand side directly into the two auxiliary vectors of
+     * the method, which are kept in this class, so a time step does not
+     * allocate any vectors.
+     */
+    double
+    evolve_one_time_step(
+      TimeStepping::LowStorageRungeKutta<BlockVectorType> &integrator,
+      const double                                         t,
+      const double                                         delta_t,
+      BlockVectorType &                                    solution) const;
+
+    /**
+     * Return the number of conjugate gradient iterations of the last
+     * application of the inverse mass matrix.
+     */
+    unsigned int
+    get_last_mass_iterations() const;
+
+    /**
+     * Return the MatrixFree object the operators are based on.
+     */
+    std::shared_ptr<const MatrixFree<dim, Number>>
+    get_matrix_free() const;
+
+    /**
+     * Return the memory consumption of this object in bytes, including the
+     * MatrixFree object and the auxiliary vectors of the time integration.
+     */
+    std::size_t
+    memory_consumption() const;
+
+  private:
+    /**
+     * The additive Schwarz preconditioner over the cells described in the
+     * documentation of the class.
+     */
+    class CellwiseInverseMass
+    {
+    public:
+      void
+      reinit(const FE_Hermite<dim> &          fe,
+             const DoFHandler<dim> &          dof_handler,
+             const MatrixFree<dim, Number> &  matrix_free,
+             const AffineConstraints<Number> &constraints);
+
+      void
+      vmult(VectorType &dst, const VectorType &src) const;
+
+      std::size_t
+      memory_consumption() const;
+
+    private:
+      /**
+       * The inverses of the 1D matrices of the local problems in each
+       * direction, one set for each distinct combination of the sizes of a
+       * cell and its neighbors.
+       */
+      std::vector<std::array<Table<2, Number>, dim>> inverse_matrices_1d;
+
+      /**
+       * The index into @p inverse_matrices_1d for each locally owned cell.
+       */
+      std::vector<unsigned int> cell_matrix_indices;
+
+      /**
+       * The indices of the degrees of freedom of each locally owned cell in
+       * the locally owned and ghost range of the vectors, in lexicographic
+       * numbering.
+       */
+      std::vector<unsigned int> dof_indices;
+
+      /**
+       * The locally owned degrees of freedom that are constrained.
+       */
+      std::vector<unsigned int> constrained_dofs;
+
+      /**
+       * The number of degrees of freedom of the 1D element.
+       */
+      unsigned int n_dofs_1d;
+
+      /**
+       * Temporary arrays for the cell vectors.
+       */
+      mutable AlignedVector<Number> src_local, dst_local, tmp_local;
+    };
+
+    std::shared_ptr<MatrixFree<dim, Number>>      matrix_free;
+    MassOperator<dim, -1, 0, 1, VectorType>       mass_operator;
+    LaplaceOperator<dim, -1, 0, 1, VectorType>    laplace_operator;
+    CellwiseInverseMass                           preconditioner;
+    SmartPointer<const AffineConstraints<Number>> constraints;
+    Number                                        wave_speed;
+    Number                                        mass_solver_tolerance;
+    mutable unsigned int                          last_mass_iterations;
+    mutable VectorType                            tmp;
+    mutable BlockVectorType                       vec_ri;
+    mutable BlockVectorType                       vec_ki;
+    mutable std::vector<double>                   rk_a, rk_b, rk_c;
+  };
+
+
+
+  // ------------------------------ implementation ---------------------------
+
+#ifndef DOXYGEN
+
+  template <int dim, typename Number>
+  HermiteWaveOperator<dim, Number>::HermiteWaveOperator()
+    : wave_speed(1.)
+    , mass_solver_tolerance(1e-12)
+    , last_mass_iterations(0)
+  {}
+
+
+
+  template <int dim, typename Number>
+  void
+  HermiteWaveOperator<dim, Number>::reinit(
+    const MappingHermite<dim> &      mapping,
+    const DoFHandler<dim> &          dof_handler,
+    const AffineConstraints<Number> &constraints,
+    const Quadrature<1> &            quadrature,
+    const Number                     wave_speed,
+    const Number                     mass_solver_tolerance)
+  {
+    const FE_Hermite<dim> *fe =
+      dynamic_cast<const FE_Hermite<dim> *>(&dof_handler.get_fe());
+    Assert(fe != nullptr,
+           ExcMessage("HermiteWaveOperator requires an FE_Hermite element."));
+
+    this->constraints           = &constraints;
+    this->wave_speed            = wave_speed;
+    this->mass_solver_tolerance = mass_solver_tolerance;
+
+    typename MatrixFree<dim, Number>::AdditionalData additional_data;
+    additional_data.tasks_parallel_scheme =
+      MatrixFree<dim, Number>::AdditionalData::none;
+    additional_data.mapping_update_flags =
+      (update_values | update_gradients | update_JxW_values);
+    matrix_free = std::make_shared<MatrixFree<dim, Number>>();
+    matrix_free->reinit(
+      mapping, dof_handler, constraints, quadrature, additional_data);
+
+    mass_operator.initialize(matrix_free);
+    laplace_operator.initialize(matrix_free);
+    preconditioner.reinit(*fe, dof_handler, *matrix_free, constraints);
+
+    matrix_free->initialize_dof_vector(tmp);
+    initialize_dof_vector(vec_ri);
+    initialize_dof_vector(vec_ki);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  HermiteWaveOperator<dim, Number>::initialize_dof_vector(
+    BlockVectorType &vec) const
+  {
+    vec.reinit(2);
+    for (unsigned int b = 0; b < 2; ++b)
+      matrix_free->initialize_dof_vector(vec.block(b));
+    vec.collect_sizes();
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  HermiteWaveOperator<dim, Number>::initialize_dof_vector(
+    VectorType &vec) const
+  {
+    matrix_free->initialize_dof_vector(vec);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  HermiteWaveOperator<dim, Number>::apply(BlockVectorType &      dst,
+                                          const BlockVectorType &src) const
+  {
+    dst.block(0) = src.block(1);
+
+    laplace_operator.vmult(tmp, src.block(0));
+    tmp *= -wave_speed * wave_speed;
+    apply_inverse_mass(dst.block(1), tmp);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  HermiteWaveOperator<dim, Number>::apply_inverse_mass(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    // n steps may not be sufficient because of roundoff for small problems
+    ReductionControl control(
+      5 * src.size(), 0., mass_solver_tolerance, false, false);
+    SolverCG<VectorType> cg(control);
+    dst = 0.;
+    cg.solve(mass_operator, dst, src, preconditioner);
+    constraints->distribute(dst);
+    last_mass_iterations = control.last_step();
+  }
+
+
+
+  template <int dim, typename Number>
+  double
+  HermiteWaveOperator<dim, Number>::evolve_one_time_step(
+    TimeStepping::LowStorageRungeKutta<BlockVectorType> &integrator,
+    const double                                         t,
+    const double                                         delta_t,
+    BlockVectorType &                                    solution) const
+  {
+    // the same stages as LowStorageRungeKutta::evolve_one_time_step(), whose
+    // right hand side would have to return a new vector in each stage
+    integrator.get_coefficients(rk_a, rk_b, rk_c);
+    const unsigned int n_stages = rk_b.size();
+    for (unsigned int stage = 0; stage < n_stages; ++stage)
+      {
+        apply(vec_ki, stage == 0 ? solution : vec_ri);
+
+        const double factor_ai =
+          (stage == n_stages - 1 ? 0. : rk_a[stage] * delta_t);
+        if (factor_ai != 0.)
+          {
+            vec_ri = solution;
+            vec_ri.add(factor_ai, vec_ki);
+          }
+        solution.add(rk_b[stage] * delta_t, vec_ki);
+      }
+    return t + delta_t;
+  }
+
+
+
+  template <int dim, typename Number>
+  unsigned int
+  HermiteWaveOperator<dim, Number>::get_last_mass_iterations() const
+  {
+    return last_mass_iterations;
+  }
+
+
+
+  template <int dim, typename Number>
+  std::shared_ptr<const MatrixFree<dim, Number>>
+  HermiteWaveOperator<dim, Number>::get_matrix_free() const
+  {
+    return matrix_free;
+  }
+
+
+
+  template <int dim, typename Number>
+  std::size_t
+  HermiteWaveOperator<dim, Number>::memory_consumption() const
+  {
+    return matrix_free->memory_consumption() +
+           preconditioner.memory_consumption() + tmp.memory_consumption() +
+           vec_ri.memory_consumption() + vec_ki.memory_consumption();
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  HermiteWaveOperator<dim, Number>::CellwiseInverseMass::reinit(
+    const FE_Hermite<dim> &          fe,
+    const DoFHandler<dim> &          dof_handler,
+    const MatrixFree<dim, Number> &  matrix_free,
+    const AffineConstraints<Number> &constraints)
+  {
+    const Utilities::MPI::Partitioner &partitioner =
+      *matrix_free.get_vector_partitioner();
+    const unsigned int              n_dofs    = fe.n_dofs_per_cell();
+    const std::vector<unsigned int> numbering = fe.get_poly_space_numbering();
+
+    n_dofs_1d = fe.degree + 1;
+    inverse_matrices_1d.clear();
+    cell_matrix_indices.clear();
+    dof_indices.clear();
+
+    // the derivatives at the left vertex are the first regularity+1 1D
+    // degrees of freedom, the ones at the right vertex the last
+    const unsigned int n_vertex_dofs_1d = fe.get_regularity() + 1;
+    const unsigned int right_offset     = n_dofs_1d - n_vertex_dofs_1d;
+
+    // the extent of a cell in direction d, which must be parallel to the
+    // coordinate axes
+    const auto extent_of =
+      [](const typename DoFHandler<dim>::cell_iterator &cell,
+         const unsigned int                             d) {
+        const DerivativeForm<1, dim, dim> jacobian =
+          MappingHermite<dim>::compute_jacobian(cell);
+        for (unsigned int e = 0; e < dim; ++e)
+          Assert(e == d || std::abs(jacobian[e][d]) <= 1e-12 * jacobian[d][d],
+                 ExcMessage("The cell inverses of the mass matrix "
+                            "require cells with edges parallel to "
+                            "the coordinate axes."));
+        return jacobian[d][d];
+      };
+
+    // the sizes of each cell and its two neighbors in each direction, with
+    // zero for a boundary face, identify the local problem
+    std::map<std::array<double, 3 * dim>, unsigned int> local_problem_of_sizes;
+    std::vector<types::global_dof_index> local_dof_indices(n_dofs);
+    FullMatrix<double>                   mass, neighbor_mass, laplace;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          std::array<double, 3 * dim> sizes;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              sizes[3 * d + 1] = extent_of(cell, d);
+              for (unsigned int side = 0; side < 2; ++side)
+                {
+                  double &neighbor_size = sizes[3 * d + 2 * side];
+                  neighbor_size         = 0.;
+                  if (cell->at_boundary(2 * d + side))
+                    continue;
+                  // descend to an active neighbor that touches the face
+                  auto neighbor = cell->neighbor(2 * d + side);
+                  while (neighbor->has_children())
+                    neighbor = neighbor->child(side == 0 ? (1U << d) : 0U);
+                  neighbor_size = extent_of(neighbor, d);
+                }
+            }
+
+          const auto entry =
+            local_problem_of_sizes.emplace(sizes, inverse_matrices_1d.size());
+          if (entry.second)
+            {
+              std::array<Table<2, Number>, dim> inverses;
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  fe.compute_matrices_1d(sizes[3 * d + 1], mass, laplace);
+                  if (sizes[3 * d] > 0.)
+                    {
+                      fe.compute_matrices_1d(sizes[3 * d],
+                                             neighbor_mass,
+                                             laplace);
+                      for (unsigned int i = 0; i < n_vertex_dofs_1d; ++i)
+                        for (unsigned int j = 0; j < n_vertex_dofs_1d; ++j)
+                          mass(i, j) += neighbor_mass(i + right_offset,
+                                                      j + right_offset);
+                    }
+                  if (sizes[3 * d + 2] > 0.)
+                    {
+                      fe.compute_matrices_1d(sizes[3 * d + 2],
+                                             neighbor_mass,
+                                             laplace);
+                      for (unsigned int i = 0; i < n_vertex_dofs_1d; ++i)
+                        for (unsigned int j = 0; j < n_vertex_dofs_1d; ++j)
+                          mass(i + right_offset, j + right_offset) +=
+                            neighbor_mass(i, j);
+                    }
+                  mass.gauss_jordan();
+                  inverses[d].reinit(n_dofs_1d, n_dofs_1d);
+                  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                    for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                      inverses[d](i, j) = mass(i, j);
+                }
+              inverse_matrices_1d.push_back(std::move(inverses));
+            }
+          cell_matrix_indices.push_back(entry.first->second);
+
+          cell->get_dof_indices(local_dof_indices);
+          const std::size_t offset = dof_indices.size();
+          dof_indices.resize(offset + n_dofs);
+          for (unsigned int i = 0; i < n_dofs; ++i)
+            dof_indices[offset + numbering[i]] =
+              partitioner.global_to_local(local_dof_indices[i]);
+        }
+
+    constrained_dofs.clear();
+    for (unsigned int i = 0; i < partitioner.locally_owned_size(); ++i)
+      if (constraints.is_constrained(partitioner.local_to_global(i)))
+        constrained_dofs.push_back(i);
+
+    src_local.resize(n_dofs);
+    dst_local.resize(n_dofs);
+    tmp_local.resize(n_dofs);
+  }
+
+
+
+  template <int dim, typename Number>
+  void
+  HermiteWaveOperator<dim, Number>::CellwiseInverseMass::vmult(
+    VectorType &      dst,
+    const VectorType &src) const
+  {
+    const bool src_has_ghost_elements = src.has_ghost_elements();
+    if (src_has_ghost_elements == false)
+      src.update_ghost_values();
+
+    dst = 0.;
+    const unsigned int n_dofs = src_local.size();
+    internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                     dim,
+                                     0,
+                                     0,
+                                     Number>
+      eval(AlignedVector<Number>(),
+           AlignedVector<Number>(),
+           AlignedVector<Number>(),
+           n_dofs_1d,
+           n_dofs_1d);
+    for (unsigned int c = 0; c < cell_matrix_indices.size(); ++c)
+      {
+        const unsigned int *indices = dof_indices.data() + c * n_dofs;
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          src_local[i] = src.local_element(indices[i]);
+
+        // the 1D inverses are symmetric, so it does not matter whether the
+        // evaluator contracts over their rows or columns
+        const std::array<Table<2, Number>, dim> &inverses =
+          inverse_matrices_1d[cell_matrix_indices[c]];
+        if (dim == 1)
+          eval.template apply<0, false, false>(&inverses[0](0, 0),
+                                               src_local.data(),
+                                               dst_local.data());
+        else if (dim == 2)
+          {
+            eval.template apply<0, false, false>(&inverses[0](0, 0),
+                                                 src_local.data(),
+                                                 tmp_local.data());
+            eval.template apply<1, false, false>(&inverses[1](0, 0),
+                                                 tmp_local.data(),
+                                                 dst_local.data());
+          }
+        else
+          {
+            eval.template apply<0, false, false>(&inverses[0](0, 0),
+                                                 src_local.data(),
+                                                 dst_local.data());
+            eval.template apply<1, false, false>(&inverses[1](0, 0),
+                                                 dst_local.data(),
+                                                 tmp_local.data());
+            eval.template apply<2, false, false>(&inverses[2](0, 0),
+                                                 tmp_local.data(),
+                                                 dst_local.data());
+          }
+
+        for (unsigned int i = 0; i < n_dofs; ++i)
+          dst.local_element(indices[i]) += dst_local[i];
+      }
+    dst.compress(VectorOperation::add);
+
+    if (src_has_ghost_elements == false)
+      src.zero_out_ghost_values();
+
+    for (const unsigned int i : constrained_dofs)
+      dst.local_element(i) = src.local_element(i);
+  }
+
+
+
+  template <int dim, typename Number>
+  std::size_t
+  HermiteWaveOperator<dim, Number>::CellwiseInverseMass::memory_consumption()
+    const
+  {
+    std::size_t memory =
+      MemoryConsumption::memory_consumption(cell_matrix_indices) +
+      MemoryConsumption::memory_consumption(dof_indices) +
+      MemoryConsumption::memory_consumption(constrained_dofs) +
+      src_local.memory_consumption() + dst_local.memory_consumption() +
+      tmp_local.memory_consumption();
+    // the 1D inverses of the local problems
+    memory += inverse_matrices_1d.size() * dim * n_dofs_1d * n_dofs_1d *
+              sizeof(Number);
+    return memory;
+  }
+
+#endif // DOXYGEN
+
+} // namespace MatrixFreeOperators
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
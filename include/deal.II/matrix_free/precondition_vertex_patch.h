@@ -0,0 +1,778 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_precondition_vertex_patch_h
+#define dealii_precondition_vertex_patch_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/graph_coloring.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <limits>
+#include <map>
+#include <numeric>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/*!@addtogroup Preconditioners */
+/*@{*/
+
+/**
+ * A matrix-free overlapping Schwarz smoother on vertex patches, i.e., on the
+ * $2^\text{dim}$ cells around each vertex of the mesh. On each patch, the
+ * operator is restricted to the degrees of freedom in the interior of the
+ * patch, i.e., the local problems have homogeneous Dirichlet conditions on
+ * the boundary of the patch. For continuous elements of degree $k$, a patch
+ * thus contains $(2k-1)^\text{dim}$ unknowns, and the patches overlap by
+ * one layer of cells. Compared to point Jacobi or Chebyshev smoothers, which
+ * deteriorate with the polynomial degree, a multigrid V-cycle with vertex
+ * patch smoothers needs an almost constant number of iterations for high
+ * polynomial degrees, see e.g. the following paper:
+ * @code{.bib}
+ * @article{Witte2021,
+ *   author  = {Witte, Julius and Arndt, Daniel and Kanschat, Guido},
+ *   title   = {Fast tensor product Schwarz smoothers for high-order
+ *              discontinuous Galerkin methods},
+ *   journal = {Computational Methods in Applied Mathematics},
+ *   volume  = {21},
+ *   number  = {3},
+ *   pages   = {709--728},
+ *   year    = {2021},
+ *   doi     = {10.1515/cmam-2020-0078}
+ * }
+ * @endcode
+ *
+ * The local problems are solved by the fast diagonalization method of
+ * TensorProductMatrixSymmetricSum, which needs $\mathcal O(k^{\text{dim}+1})$
+ * operations per patch. The separable form of the local matrices is exact
+ * for the operator
+ * @f[
+ *   a(u,v) = \alpha (\nabla u, \nabla v)_\Omega + \beta (u, v)_\Omega
+ * @f]
+ * with constant coefficients $\alpha$ and $\beta$, given by
+ * AdditionalData::laplace_coefficient and AdditionalData::mass_coefficient,
+ * on meshes of axis-parallel cells without hanging nodes. The 1D matrices
+ * are computed from the shape functions and the quadrature formula stored in
+ * the MatrixFree object of the operator, and the cell sizes are taken from
+ * the cells of the MatrixFree object. Since the local matrices only depend
+ * on the sizes of the cells around the vertex, patches with the same cell
+ * sizes share one local solver, which keeps the memory consumption and the
+ * number of eigenvalue problems small on (piecewise) uniform meshes.
+ *
+ * Two variants are available:
+ * <ul>
+ * <li> The additive variant adds up the local solutions of all patches,
+ * weighted by AdditionalData::relaxation. Since each unknown is contained in
+ * up to $2^\text{dim}$ patches, the relaxation parameter should be chosen
+ * smaller than one, e.g., 0.25 in 2D or 0.125 in 3D, or the smoother is to be
+ * used inside a Chebyshev iteration.
+ * <li> The multiplicative variant visits the patches one after the other
+ * and updates the residual after each local solve. The patches are colored
+ * by GraphColoring::make_graph_coloring() such that patches of the same color
+ * do not share a cell. Such patches are decoupled, so all patches of a color
+ * are processed in parallel with the residual of the previous color, which
+ * gives the same result as the sequential sweep in the order of the colors.
+ * This needs one operator evaluation per color, i.e., around $2^\text{dim}$
+ * operator evaluations per step for vertex patches.
+ * </ul>
+ * The additive variant also uses the colors to avoid write conflicts between
+ * threads.
+ *
+ * Patches are created around all vertices that are surrounded by
+ * $2^\text{dim}$ cells of the MatrixFree object on the same level. On meshes
+ * with Dirichlet conditions on the whole boundary, the patches thus cover
+ * all unknowns. Unknowns on a Neumann boundary or, in parallel computations,
+ * around vertices at the boundary of the locally owned subdomain are not
+ * contained in any patch and are left untouched by the smoother.
+ *
+ * The class is typically used as a smoother in multigrid via
+ * MGSmootherPrecondition. The operator type @p MatrixType needs to provide a
+ * function <tt>get_matrix_free()</tt> that returns a shared pointer to the
+ * underlying MatrixFree object, as in MatrixFreeOperators::Base, and a
+ * <tt>vmult()</tt> function for the multiplicative variant and for step().
+ * Only scalar FE_Q elements are supported. The level of the multigrid
+ * hierarchy is taken from MatrixFree::get_mg_level().
+ *
+ * @note The fast diagonalization requires deal.II to be configured with
+ * LAPACK.
+ */
+template <int dim,
+          typename MatrixType,
+          typename Number = typename MatrixType::value_type>
+class PreconditionVertexPatch : public Subscriptor
+{
+public:
+  /**
+   * Type of the vectors this class works on.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Standardized data struct to pipe additional parameters to the
+   * preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * The way the patch corrections are combined.
+     */
+    enum class SmootherVariant
+    {
+      /**
+       * Add the weighted corrections of all patches computed from the same
+       * residual.
+       */
+      additive,
+      /**
+       * Update the residual after each color of patches.
+       */
+      multiplicative
+    };
+
+    /**
+     * Constructor.
+     */
+    AdditionalData(
+      const SmootherVariant variant = SmootherVariant::multiplicative,
+      const double          relaxation          = 1.,
+      const double          laplace_coefficient = 1.,
+      const double          mass_coefficient    = 0.);
+
+    /**
+     * The way the patch corrections are combined.
+     */
+    SmootherVariant variant;
+
+    /**
+     * Factor by which the local solutions are multiplied before they are
+     * added to the solution vector.
+     */
+    double relaxation;
+
+    /**
+     * The coefficient $\alpha$ of the Laplacian in the local problems.
+     */
+    double laplace_coefficient;
+
+    /**
+     * The coefficient $\beta$ of the mass matrix in the local problems.
+     */
+    double mass_coefficient;
+  };
+
+  /**
+   * Constructor.
+   */
+  PreconditionVertexPatch();
+
+  /**
+   * Set up the patches for the cells of the MatrixFree object of @p matrix,
+   * compute the local inverses, and color the patches. The matrix needs to
+   * live as long as this class is used.
+   */
+  void
+  initialize(const MatrixType &    matrix,
+             const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the smoother to @p src with a zero initial guess, storing the
+   * result in @p dst.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Apply the transposed smoother, which visits the colors in reverse order
+   * for the multiplicative variant.
+   */
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Perform one smoothing step on @p dst, which contains the initial guess
+   * on entry, for the right hand side @p src.
+   */
+  void
+  step(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Perform one transposed smoothing step.
+   */
+  void
+  Tstep(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Return the dimension of the codomain (or range) space.
+   */
+  size_type
+  m() const;
+
+  /**
+   * Return the dimension of the domain space.
+   */
+  size_type
+  n() const;
+
+  /**
+   * Return the number of patches on the current processor.
+   */
+  unsigned int
+  n_patches() const;
+
+  /**
+   * Return the number of colors of the patches.
+   */
+  unsigned int
+  n_colors() const;
+
+private:
+  /**
+   * Add the relaxed local solutions for the residual @p residual on the
+   * given patches to @p solution. The patches must not share any unknown.
+   */
+  void
+  apply_local_inverses(const std::vector<unsigned int> &patches,
+                       VectorType &                     solution,
+                       const VectorType &               residual) const;
+
+  /**
+   * Run one sweep over all patches, starting from a zero initial guess or
+   * the content of @p solution.
+   */
+  void
+  do_sweep(VectorType &      solution,
+           const VectorType &rhs,
+           const bool        zero_initial_guess,
+           const bool        transpose) const;
+
+  /**
+   * A pointer to the underlying matrix.
+   */
+  SmartPointer<const MatrixType,
+               PreconditionVertexPatch<dim, MatrixType, Number>>
+    matrix_ptr;
+
+  /**
+   * Stores the additional data passed to the initialize function.
+   */
+  AdditionalData data;
+
+  /**
+   * The number of unknowns of each patch.
+   */
+  unsigned int n_patch_dofs;
+
+  /**
+   * The MPI-local indices of the unknowns of all patches in lexicographic
+   * order, with n_patch_dofs entries per patch.
+   */
+  std::vector<unsigned int> patch_dof_indices;
+
+  /**
+   * The local matrices in separable form, one for each distinct combination
+   * of cell sizes around the vertex.
+   */
+  std::vector<TensorProductMatrixSymmetricSum<dim, Number>> local_matrices;
+
+  /**
+   * The index into local_matrices for each patch.
+   */
+  std::vector<unsigned int> patch_matrix_indices;
+
+  /**
+   * The patches grouped by colors.
+   */
+  std::vector<std::vector<unsigned int>> colors;
+
+  /**
+   * Internal vector for the residual.
+   */
+  mutable VectorType residual;
+
+  /**
+   * A mutex to avoid that multiple vmult() invocations by different threads
+   * overwrite the residual vector.
+   */
+  mutable Threads::Mutex mutex;
+};
+
+/*@}*/
+
+
+#ifndef DOXYGEN
+
+/* ---------------------------- Inline functions ------------------------- */
+
+
+template <int dim, typename MatrixType, typename Number>
+inline PreconditionVertexPatch<dim, MatrixType, Number>::AdditionalData::
+  AdditionalData(const SmootherVariant variant,
+                 const double          relaxation,
+                 const double          laplace_coefficient,
+                 const double          mass_coefficient)
+  : variant(variant)
+  , relaxation(relaxation)
+  , laplace_coefficient(laplace_coefficient)
+  , mass_coefficient(mass_coefficient)
+{}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline PreconditionVertexPatch<dim, MatrixType, Number>::
+  PreconditionVertexPatch()
+  : n_patch_dofs(0)
+{}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+PreconditionVertexPatch<dim, MatrixType, Number>::initialize(
+  const MatrixType &    matrix,
+  const AdditionalData &additional_data)
+{
+  clear();
+  matrix_ptr = &matrix;
+  data       = additional_data;
+  Assert(data.laplace_coefficient > 0. || data.mass_coefficient > 0.,
+         ExcMessage("The local problems must be positive definite."));
+
+  const auto             matrix_free = matrix.get_matrix_free();
+  const DoFHandler<dim> &dof_handler = matrix_free->get_dof_handler();
+  const unsigned int     level       = matrix_free->get_mg_level();
+  const auto &           partitioner = *matrix_free->get_vector_partitioner();
+  const auto &           shape_info  = matrix_free->get_shape_info();
+  const auto &           shape_data  = shape_info.data.front();
+  AssertThrow(shape_info.n_components == 1 &&
+                dof_handler.get_fe().n_dofs_per_vertex() == 1 &&
+                shape_info.element_type <=
+                  internal::MatrixFreeFunctions::tensor_symmetric,
+              ExcMessage("Vertex patches are only implemented for scalar "
+                         "FE_Q elements."));
+
+  // 1D mass and Laplace matrices on the unit interval in lexicographic
+  // numbering, computed from the shape data of the MatrixFree object
+  const unsigned int degree          = shape_data.fe_degree;
+  const unsigned int n_dofs_1d       = degree + 1;
+  const unsigned int n_q_points_1d   = shape_data.n_q_points_1d;
+  const unsigned int n_patch_dofs_1d = 2 * degree - 1;
+  Table<2, double>   mass_1d(n_dofs_1d, n_dofs_1d);
+  Table<2, double>   laplace_1d(n_dofs_1d, n_dofs_1d);
+  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+    for (unsigned int j = 0; j < n_dofs_1d; ++j)
+      for (unsigned int q = 0; q < n_q_points_1d; ++q)
+        {
+          const double weight = shape_data.quadrature.weight(q);
+          mass_1d(i, j) += shape_data.shape_values[i * n_q_points_1d + q][0] *
+                           shape_data.shape_values[j * n_q_points_1d + q][0] *
+                           weight;
+          laplace_1d(i, j) +=
+            shape_data.shape_gradients[i * n_q_points_1d + q][0] *
+            shape_data.shape_gradients[j * n_q_points_1d + q][0] * weight;
+        }
+
+  // collect the cells of the MatrixFree object, their unknowns in
+  // lexicographic order, and the cells around each vertex together with the
+  // local index of the vertex within the cell
+  const unsigned int dofs_per_cell = Utilities::pow(n_dofs_1d, dim);
+  std::vector<typename DoFHandler<dim>::cell_iterator> cells;
+  std::vector<unsigned int>                            cell_dof_indices;
+  std::map<unsigned int, std::vector<std::pair<unsigned int, unsigned int>>>
+                                       vertex_to_cells;
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+
+  double min_cell_size = std::numeric_limits<double>::max();
+  for (unsigned int cell_batch = 0; cell_batch < matrix_free->n_cell_batches();
+       ++cell_batch)
+    for (unsigned int lane = 0;
+         lane < matrix_free->n_active_entries_per_cell_batch(cell_batch);
+         ++lane)
+      {
+        const auto cell = matrix_free->get_cell_iterator(cell_batch, lane);
+        if (level == numbers::invalid_unsigned_int)
+          cell->get_dof_indices(dof_indices);
+        else
+          cell->get_mg_dof_indices(dof_indices);
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          cell_dof_indices.push_back(partitioner.global_to_local(
+            dof_indices[shape_info.lexicographic_numbering[i]]));
+
+        for (const unsigned int v : cell->vertex_indices())
+          vertex_to_cells[cell->vertex_index(v)].emplace_back(cells.size(), v);
+        min_cell_size =
+          std::min(min_cell_size, cell->minimum_vertex_distance());
+        cells.push_back(cell);
+      }
+
+  const unsigned int n_cells_per_patch = GeometryInfo<dim>::vertices_per_cell;
+  n_patch_dofs = Utilities::pow(n_patch_dofs_1d, dim);
+  std::vector<unsigned int> patch_cells;
+
+  // patches with the same cell sizes share the local solver; the cell sizes
+  // are compared with a tolerance relative to the smallest cell
+  std::map<std::vector<double>,
+           unsigned int,
+           internal::MatrixFreeFunctions::FPArrayComparator<double>>
+    cell_sizes_to_matrix(
+      internal::MatrixFreeFunctions::FPArrayComparator<double>(
+        1e4 * min_cell_size));
+  for (const auto &vertex : vertex_to_cells)
+    {
+      const auto &patch = vertex.second;
+      if (patch.size() != n_cells_per_patch)
+        continue;
+      bool same_level = true;
+      for (const auto &cell : patch)
+        if (cells[cell.first]->level() != cells[patch[0].first]->level())
+          same_level = false;
+      if (same_level == false)
+        continue;
+
+      // the cell sizes below and above the vertex in each direction; the
+      // vertex is the upper vertex of the cell in direction d if bit d of the
+      // local vertex index is set
+      std::array<double, dim> h_lower, h_upper;
+      for (unsigned int d = 0; d < dim; ++d)
+        h_lower[d] = h_upper[d] = -1.;
+      for (const auto &cell_and_vertex : patch)
+        {
+          const auto &cell = cells[cell_and_vertex.first];
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const Tensor<1, dim> edge =
+                cell->vertex(1 << d) - cell->vertex(0);
+              const double h = edge[d];
+              AssertThrow(h > 0. && std::abs(edge.norm() - h) < 1e-12 * h,
+                          ExcMessage("Vertex patches need axis-parallel "
+                                     "cells in standard orientation."));
+              double &h_side =
+                (cell_and_vertex.second & (1 << d)) ? h_lower[d] : h_upper[d];
+              AssertThrow(h_side < 0. || std::abs(h_side - h) < 1e-12 * h,
+                          ExcMessage("The cells of a vertex patch must form "
+                                     "a tensor product."));
+              h_side = h;
+            }
+        }
+
+      std::vector<double> cell_sizes(h_lower.begin(), h_lower.end());
+      cell_sizes.insert(cell_sizes.end(), h_upper.begin(), h_upper.end());
+      const auto inserted = cell_sizes_to_matrix.insert(
+        std::make_pair(cell_sizes, local_matrices.size()));
+      patch_matrix_indices.push_back(inserted.first->second);
+
+      // for a new combination of cell sizes, set up the 1D matrices of the
+      // two cells in each direction, restricted to the unknowns in the
+      // interior of the patch
+      if (inserted.second)
+        {
+          std::array<Table<2, Number>, dim> mass_matrices, derivative_matrices;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              Table<2, double> mass(2 * degree + 1, 2 * degree + 1);
+              Table<2, double> laplace(2 * degree + 1, 2 * degree + 1);
+              for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                for (unsigned int j = 0; j < n_dofs_1d; ++j)
+                  {
+                    mass(i, j) += h_lower[d] * mass_1d(i, j);
+                    laplace(i, j) += laplace_1d(i, j) / h_lower[d];
+                    mass(degree + i, degree + j) += h_upper[d] * mass_1d(i, j);
+                    laplace(degree + i, degree + j) +=
+                      laplace_1d(i, j) / h_upper[d];
+                  }
+
+              mass_matrices[d].reinit(n_patch_dofs_1d, n_patch_dofs_1d);
+              derivative_matrices[d].reinit(n_patch_dofs_1d, n_patch_dofs_1d);
+              for (unsigned int i = 0; i < n_patch_dofs_1d; ++i)
+                for (unsigned int j = 0; j < n_patch_dofs_1d; ++j)
+                  {
+                    mass_matrices[d](i, j) = mass(i + 1, j + 1);
+                    derivative_matrices[d](i, j) =
+                      data.laplace_coefficient * laplace(i + 1, j + 1) +
+                      data.mass_coefficient / dim * mass(i + 1, j + 1);
+                  }
+            }
+          local_matrices.emplace_back();
+          local_matrices.back().reinit(mass_matrices, derivative_matrices);
+        }
+
+      // unknowns of the patch in lexicographic order, skipping the ones on
+      // the boundary of the patch
+      const unsigned int first = patch_dof_indices.size();
+      patch_dof_indices.resize(first + n_patch_dofs);
+      for (const auto &cell_and_vertex : patch)
+        {
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            {
+              unsigned int index = 0, stride = 1;
+              bool         interior = true;
+              for (unsigned int d = 0, i_cell = i; d < dim;
+                   ++d, i_cell /= n_dofs_1d, stride *= n_patch_dofs_1d)
+                {
+                  const unsigned int i_patch =
+                    i_cell % n_dofs_1d +
+                    ((cell_and_vertex.second & (1 << d)) ? 0 : degree);
+                  if (i_patch == 0 || i_patch == 2 * degree)
+                    interior = false;
+                  else
+                    index += (i_patch - 1) * stride;
+                }
+              if (interior)
+                {
+                  const unsigned int dof_index =
+                    cell_dof_indices[cell_and_vertex.first * dofs_per_cell + i];
+                  AssertIndexRange(dof_index, partitioner.locally_owned_size());
+                  patch_dof_indices[first + index] = dof_index;
+                }
+            }
+          patch_cells.push_back(cell_and_vertex.first);
+        }
+    }
+
+  // color the patches such that patches of the same color do not share a
+  // cell, which makes them independent in the multiplicative sweep
+  if (patch_matrix_indices.empty() == false)
+    {
+      using Iterator = std::vector<unsigned int>::const_iterator;
+      std::vector<unsigned int> patch_numbers(patch_matrix_indices.size());
+      std::iota(patch_numbers.begin(), patch_numbers.end(), 0U);
+      const std::function<std::vector<types::global_dof_index>(
+        const Iterator &)>
+        get_conflict_indices = [&](const Iterator &patch) {
+          return std::vector<types::global_dof_index>(
+            patch_cells.begin() + *patch * n_cells_per_patch,
+            patch_cells.begin() + (*patch + 1) * n_cells_per_patch);
+        };
+      const std::vector<std::vector<Iterator>> coloring =
+        GraphColoring::make_graph_coloring(patch_numbers.cbegin(),
+                                           patch_numbers.cend(),
+                                           get_conflict_indices);
+      colors.resize(coloring.size());
+      for (unsigned int c = 0; c < coloring.size(); ++c)
+        for (const Iterator &patch : coloring[c])
+          colors[c].push_back(*patch);
+    }
+
+  matrix_free->initialize_dof_vector(residual);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+PreconditionVertexPatch<dim, MatrixType, Number>::clear()
+{
+  matrix_ptr   = nullptr;
+  n_patch_dofs = 0;
+  patch_dof_indices.clear();
+  local_matrices.clear();
+  patch_matrix_indices.clear();
+  colors.clear();
+  residual.reinit(0);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+PreconditionVertexPatch<dim, MatrixType, Number>::apply_local_inverses(
+  const std::vector<unsigned int> &patches,
+  VectorType &                     solution,
+  const VectorType &               residual) const
+{
+  const Number relaxation = data.relaxation;
+  parallel::apply_to_subranges(
+    0U,
+    static_cast<unsigned int>(patches.size()),
+    [&](const unsigned int begin, const unsigned int end) {
+      std::vector<Number> local_residual(n_patch_dofs);
+      std::vector<Number> local_solution(n_patch_dofs);
+      for (unsigned int p = begin; p < end; ++p)
+        {
+          const unsigned int *indices =
+            patch_dof_indices.data() + patches[p] * n_patch_dofs;
+          for (unsigned int i = 0; i < n_patch_dofs; ++i)
+            local_residual[i] = residual.local_element(indices[i]);
+          local_matrices[patch_matrix_indices[patches[p]]].apply_inverse(
+            make_array_view(local_solution), make_array_view(local_residual));
+          for (unsigned int i = 0; i < n_patch_dofs; ++i)
+            solution.local_element(indices[i]) +=
+              relaxation * local_solution[i];
+        }
+    },
+    16);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+PreconditionVertexPatch<dim, MatrixType, Number>::do_sweep(
+  VectorType &      solution,
+  const VectorType &rhs,
+  const bool        zero_initial_guess,
+  const bool        transpose) const
+{
+  Assert(matrix_ptr != nullptr, ExcNotInitialized());
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (zero_initial_guess)
+    solution = Number();
+
+  if (data.variant == AdditionalData::SmootherVariant::additive)
+    {
+      if (zero_initial_guess == false)
+        {
+          matrix_ptr->vmult(residual, solution);
+          residual.sadd(-1., 1., rhs);
+        }
+      for (const auto &color : colors)
+        apply_local_inverses(color,
+                             solution,
+                             zero_initial_guess ? rhs : residual);
+    }
+  else
+    for (unsigned int c = 0; c < colors.size(); ++c)
+      {
+        const auto &color = colors[transpose ? colors.size() - 1 - c : c];
+        if (zero_initial_guess && c == 0)
+          apply_local_inverses(color, solution, rhs);
+        else
+          {
+            matrix_ptr->vmult(residual, solution);
+            residual.sadd(-1., 1., rhs);
+            apply_local_inverses(color, solution, residual);
+          }
+      }
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+PreconditionVertexPatch<dim, MatrixType, Number>::vmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  do_sweep(dst, src, true, false);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+PreconditionVertexPatch<dim, MatrixType, Number>::Tvmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  do_sweep(dst, src, true, true);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+PreconditionVertexPatch<dim, MatrixType, Number>::step(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  do_sweep(dst, src, false, false);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline void
+PreconditionVertexPatch<dim, MatrixType, Number>::Tstep(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  do_sweep(dst, src, false, true);
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline typename PreconditionVertexPatch<dim, MatrixType, Number>::size_type
+PreconditionVertexPatch<dim, MatrixType, Number>::m() const
+{
+  Assert(matrix_ptr != nullptr, ExcNotInitialized());
+  return matrix_ptr->m();
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline typename PreconditionVertexPatch<dim, MatrixType, Number>::size_type
+PreconditionVertexPatch<dim, MatrixType, Number>::n() const
+{
+  Assert(matrix_ptr != nullptr, ExcNotInitialized());
+  return matrix_ptr->n();
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline unsigned int
+PreconditionVertexPatch<dim, MatrixType, Number>::n_patches() const
+{
+  return patch_matrix_indices.size();
+}
+
+
+
+template <int dim, typename MatrixType, typename Number>
+inline unsigned int
+PreconditionVertexPatch<dim, MatrixType, Number>::n_colors() const
+{
+  return colors.size();
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -522,6 +522,20 @@ namespace internal
        */
       dealii::Table<2, unsigned int> face_orientations;
 
+      /**
+       * For elements whose degrees of freedom are derivatives at the vertices
+       * of the cell, such as FE_Hermite, the shape functions on a cell of
+       * extent $h_d$ in direction $d$ differ from the ones on the reference
+       * cell by a factor $\prod_d h_d^{k_d}$, where $k_d$ is the order of the
+       * derivative the 1D shape function in direction $d$ represents. This
+       * field stores the order $k$ for each 1D shape function in
+       * lexicographic numbering. FEEvaluation applies the resulting diagonal
+       * scaling when reading from and writing into vectors.
+       *
+       * @note This object is only filled for FE_Hermite and empty otherwise.
+       */
+      std::vector<unsigned int> derivative_order_1d;
+
     private:
       /**
        * Check whether we have symmetries in the shape values. In that case,
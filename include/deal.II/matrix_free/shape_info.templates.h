@@ -225,8 +225,7 @@ namespace internal
             return false;
 
           // then check if the base element is supported or not
-          if (dynamic_cast<const FE_Poly<dim, spacedim> *>(fe_ptr) != nullptr && 
-              dynamic_cast<const FE_Hermite<dim, spacedim> *>(fe_ptr) == nullptr)
+          if (dynamic_cast<const FE_Poly<dim, spacedim> *>(fe_ptr) != nullptr)
             {
               const FE_Poly<dim, spacedim> *fe_poly_ptr =
                 dynamic_cast<const FE_Poly<dim, spacedim> *>(fe_ptr);
@@ -479,6 +478,23 @@ namespace internal
       univariate_shape_data.fe_degree     = fe.degree;
       univariate_shape_data.n_q_points_1d = quad.size();
 
+      // the degrees of freedom of FE_Hermite are derivatives in the vertices
+      // of the cell: the first and last regularity+1 1D shape functions in
+      // lexicographic numbering represent derivatives of increasing order
+      // at the left and right end point, respectively, with the interior
+      // nodes (if any) in between
+      derivative_order_1d.clear();
+      if (const auto fe_hermite = dynamic_cast<const FE_Hermite<dim> *>(&fe))
+        {
+          const unsigned int regularity = fe_hermite->get_regularity();
+          derivative_order_1d.resize(fe.degree + 1, 0);
+          for (unsigned int k = 0; k <= regularity; ++k)
+            {
+              derivative_order_1d[k]                          = k;
+              derivative_order_1d[fe.degree - regularity + k] = k;
+            }
+        }
+
       if ((fe.n_dofs_per_cell() == 0) || (quad.size() == 0))
         return;
 
@@ -1112,6 +1128,7 @@ namespace internal
       std::size_t memory = sizeof(*this);
       for (const auto &univariate_shape_data : data)
         memory += univariate_shape_data.memory_consumption();
+      memory += MemoryConsumption::memory_consumption(derivative_order_1d);
       return memory;
     }
 
@@ -22,6 +22,7 @@
 #include <deal.II/base/aligned_vector.h>
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -2328,6 +2329,299 @@ namespace internal
 
 
 
+  /**
+   * Internal evaluator for the shape functions of a single cell in arbitrary
+   * dimension, using the tensor product form of the basis functions. As
+   * opposed to EvaluatorTensorProduct, which is usually applied to arrays of
+   * VectorizedArray holding the data of several cells, this class works on
+   * arrays of a scalar number type such as @p double for one cell and
+   * vectorizes the sum factorization within the cell. This is useful for
+   * high polynomial degrees with few cells per processor, where the cell
+   * batches of MatrixFree would leave most SIMD lanes empty.
+   *
+   * The SIMD lanes are filled with VectorizedArray<Number>::size() 1D stripes
+   * of the tensor product:
+   * <ul>
+   * <li> Along direction 0, where the stripes are contiguous in memory, the
+   * stripes are loaded and transposed into the SIMD lanes, see
+   * vectorized_load_and_transpose().
+   * <li> Along the other directions, the SIMD lanes are filled by
+   * consecutive entries in direction 0, which are contiguous in memory
+   * because they belong to neighboring stripes with the same stride.
+   * </ul>
+   * The 1D operation on the stripes is done by the one-dimensional
+   * EvaluatorTensorProduct of the given @p variant on VectorizedArray data,
+   * so that the even-odd decomposition and the other symmetries are used in
+   * the same way as for the evaluation over several cells. Stripes that do
+   * not fill all SIMD lanes are computed with scalar arithmetic.
+   *
+   * @tparam variant Variant of the 1D kernel, which also determines the
+   *                 layout of the shape data passed to the constructor
+   * @tparam dim Space dimension in which this class is applied
+   * @tparam n_rows Number of rows in the transformation matrix, which corresponds
+   *                to the number of 1d shape functions in the usual tensor
+   *                contraction setting
+   * @tparam n_columns Number of columns in the transformation matrix, which
+   *                   corresponds to the number of 1d shape functions in the
+   *                   usual tensor contraction setting
+   * @tparam Number Scalar number type for input and output arrays
+   * @tparam Number2 Scalar number type for coefficient arrays (defaults to
+   *                 same type as the input/output arrays)
+   */
+  template <EvaluatorVariant variant,
+            int              dim,
+            int              n_rows,
+            int              n_columns,
+            typename Number,
+            typename Number2 = Number>
+  struct EvaluatorTensorProductWithinCell
+  {
+    static_assert(n_rows > 0 && n_columns > 0,
+                  "The vectorization within a cell needs the number of rows "
+                  "and columns as compile-time constants.");
+    static_assert(std::is_arithmetic<Number>::value,
+                  "The vectorization within a cell works on scalar data.");
+
+    static constexpr unsigned int n_rows_of_product =
+      Utilities::pow(n_rows, dim);
+    static constexpr unsigned int n_columns_of_product =
+      Utilities::pow(n_columns, dim);
+
+    /**
+     * Constructor, taking the data from ShapeInfo in the layout expected by
+     * the given @p variant.
+     */
+    EvaluatorTensorProductWithinCell(
+      const AlignedVector<Number2> &shape_values,
+      const AlignedVector<Number2> &shape_gradients,
+      const AlignedVector<Number2> &shape_hessians,
+      const unsigned int            dummy1 = 0,
+      const unsigned int            dummy2 = 0)
+      : line_evaluator(shape_values,
+                       shape_gradients,
+                       shape_hessians,
+                       dummy1,
+                       dummy2)
+      , line_evaluator_scalar(shape_values,
+                              shape_gradients,
+                              shape_hessians,
+                              dummy1,
+                              dummy2)
+    {}
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    values(const Number in[], Number out[]) const
+    {
+      apply<direction, contract_over_rows, add, 0>(in, out);
+    }
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    gradients(const Number in[], Number out[]) const
+    {
+      apply<direction, contract_over_rows, add, 1>(in, out);
+    }
+
+    template <int direction, bool contract_over_rows, bool add>
+    void
+    hessians(const Number in[], Number out[]) const
+    {
+      apply<direction, contract_over_rows, add, 2>(in, out);
+    }
+
+    /**
+     * This function applies the tensor product kernel, corresponding to a
+     * multiplication of 1D stripes, along the given @p direction of the tensor
+     * data in the input array. The @p in and @p out arrays may alias for the
+     * case n_rows == n_columns.
+     *
+     * @tparam direction Direction that is evaluated
+     * @tparam contract_over_rows If true, the tensor contraction sums
+     *                            over the rows in the given @p shape_data
+     *                            array, otherwise it sums over the columns
+     * @tparam add If true, the result is added to the output vector, else
+     *             the computed values overwrite the content in the output
+     * @tparam derivative Selects the values (0), gradients (1) or hessians
+     *                    (2) of the 1D evaluator
+     *
+     * @param in Pointer to the start of the input data vector
+     * @param out Pointer to the start of the output data vector
+     */
+    template <int  direction,
+              bool contract_over_rows,
+              bool add,
+              int  derivative>
+    void
+    apply(const Number *in, Number *out) const;
+
+  private:
+    /**
+     * Apply the 1D operation of the given derivative to a single stripe,
+     * stored contiguously in @p in and @p out.
+     */
+    template <bool contract_over_rows,
+              int  derivative,
+              typename Evaluator,
+              typename Number3>
+    static void
+    apply_line(const Evaluator &evaluator, const Number3 *in, Number3 *out);
+
+    /**
+     * The 1D evaluator on SIMD data.
+     */
+    EvaluatorTensorProduct<variant,
+                           1,
+                           n_rows,
+                           n_columns,
+                           VectorizedArray<Number>,
+                           Number2>
+      line_evaluator;
+
+    /**
+     * The 1D evaluator on scalar data for the stripes that do not fill all
+     * SIMD lanes.
+     */
+    EvaluatorTensorProduct<variant, 1, n_rows, n_columns, Number, Number2>
+      line_evaluator_scalar;
+  };
+
+
+
+  template <EvaluatorVariant variant,
+            int              dim,
+            int              n_rows,
+            int              n_columns,
+            typename Number,
+            typename Number2>
+  template <bool contract_over_rows,
+            int  derivative,
+            typename Evaluator,
+            typename Number3>
+  inline void
+  EvaluatorTensorProductWithinCell<variant,
+                                   dim,
+                                   n_rows,
+                                   n_columns,
+                                   Number,
+                                   Number2>::
+    apply_line(const Evaluator &evaluator, const Number3 *in, Number3 *out)
+  {
+    if (derivative == 0)
+      evaluator.template values<0, contract_over_rows, false>(in, out);
+    else if (derivative == 1)
+      evaluator.template gradients<0, contract_over_rows, false>(in, out);
+    else
+      evaluator.template hessians<0, contract_over_rows, false>(in, out);
+  }
+
+
+
+  template <EvaluatorVariant variant,
+            int              dim,
+            int              n_rows,
+            int              n_columns,
+            typename Number,
+            typename Number2>
+  template <int direction, bool contract_over_rows, bool add, int derivative>
+  inline void
+  EvaluatorTensorProductWithinCell<variant,
+                                   dim,
+                                   n_rows,
+                                   n_columns,
+                                   Number,
+                                   Number2>::apply(const Number *in,
+                                                   Number *      out) const
+  {
+    static_assert(derivative < 3, "Only derivatives up to two implemented");
+    Assert(dim == direction + 1 || n_rows == n_columns || in != out,
+           ExcMessage("In-place operation only supported for "
+                      "n_rows==n_columns"));
+    AssertIndexRange(direction, dim);
+    constexpr int mm = contract_over_rows ? n_rows : n_columns,
+                  nn = contract_over_rows ? n_columns : n_rows;
+
+    constexpr int stride = Utilities::pow(n_columns, direction);
+    constexpr int n_blocks2 =
+      Utilities::pow(n_rows, (direction >= dim) ? 0 : (dim - direction - 1));
+
+    using VectorizedType  = VectorizedArray<Number>;
+    constexpr int n_lanes = VectorizedType::size();
+
+    // the stripes that do not fill all SIMD lanes are copied into a
+    // contiguous array and computed one at a time
+    const auto apply_scalar = [&](const Number *in_ptr, Number *out_ptr) {
+      Number x[mm], y[nn];
+      for (int i = 0; i < mm; ++i)
+        x[i] = in_ptr[stride * i];
+      apply_line<contract_over_rows, derivative>(line_evaluator_scalar, x, y);
+      for (int i = 0; i < nn; ++i)
+        if (add == false)
+          out_ptr[stride * i] = y[i];
+        else
+          out_ptr[stride * i] += y[i];
+    };
+
+    // value-initialize the output array; the even-odd kernels write all of
+    // its entries, but gcc cannot see this through the transpose and warns
+    // with -Wmaybe-uninitialized
+    VectorizedType x[mm], y[nn] = {};
+    if (direction == 0)
+      {
+        // the stripes are contiguous in memory, so we put n_lanes stripes
+        // into the SIMD lanes by a transpose
+        unsigned int offsets_in[n_lanes], offsets_out[n_lanes];
+        int          line = 0;
+        for (; line + n_lanes <= n_blocks2; line += n_lanes)
+          {
+            for (int v = 0; v < n_lanes; ++v)
+              {
+                offsets_in[v]  = (line + v) * mm;
+                offsets_out[v] = (line + v) * nn;
+              }
+            vectorized_load_and_transpose(mm, in, offsets_in, x);
+            apply_line<contract_over_rows, derivative>(line_evaluator, x, y);
+            vectorized_transpose_and_store(add, nn, y, offsets_out, out);
+          }
+        for (; line < n_blocks2; ++line)
+          apply_scalar(in + line * mm, out + line * nn);
+      }
+    else
+      {
+        // consecutive entries in direction 0 belong to different stripes
+        // with the same stride, so we fill the SIMD lanes with them
+        for (int i2 = 0; i2 < n_blocks2; ++i2)
+          {
+            int i1 = 0;
+            for (; i1 + n_lanes <= stride; i1 += n_lanes)
+              {
+                for (int i = 0; i < mm; ++i)
+                  x[i].load(in + stride * i + i1);
+                apply_line<contract_over_rows, derivative>(line_evaluator,
+                                                           x,
+                                                           y);
+                for (int i = 0; i < nn; ++i)
+                  {
+                    if (add == true)
+                      {
+                        VectorizedType old;
+                        old.load(out + stride * i + i1);
+                        y[i] += old;
+                      }
+                    y[i].store(out + stride * i + i1);
+                  }
+              }
+            for (; i1 < stride; ++i1)
+              apply_scalar(in + i1, out + i1);
+
+            in += stride * mm;
+            out += stride * nn;
+          }
+      }
+  }
+
+
+
   /**
    * Struct to avoid using Tensor<1, dim, Point<dim2>> in
    * evaluate_tensor_product_value_and_gradient because a Point cannot be used
@@ -0,0 +1,392 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_mixed_precision_h
+#define dealii_mg_mixed_precision_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mg_level_object.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <deal.II/multigrid/mg_base.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * A geometric or polynomial multigrid V-cycle in reduced precision, packaged
+ * as a preconditioner for an outer iterative solver in higher precision.
+ * Typically, the level operators, the transfer operators between the levels
+ * (e.g. of type MGTransferGlobalCoarsening), the Chebyshev smoothers and the
+ * coarse-grid solver all work on vectors of type
+ * LinearAlgebra::distributed::Vector<float>, whereas the outer solver, e.g.
+ * SolverCG or SolverFGMRES, runs in double precision. Since matrix-free
+ * level operators are limited by the memory bandwidth, single precision
+ * almost halves the cost of the V-cycle, and the outer solver corrects for
+ * the lower accuracy of the preconditioner.
+ *
+ * The vector handed to vmult() is converted into the precision of the
+ * levels within the first update of the Chebyshev pre-smoother on the finest
+ * level, see PreconditionChebyshev::vmult_with_conversion(), rather than in
+ * a separate copy operation. On the coarsest level, the system is solved
+ * by a conjugate gradient method preconditioned by the Chebyshev iteration
+ * of that level up to a relative tolerance given in AdditionalData.
+ *
+ * The level matrices of type @p LevelMatrixType need to provide the
+ * functions <tt>vmult()</tt> and <tt>initialize_dof_vector()</tt> for vectors
+ * of type LinearAlgebra::distributed::Vector with the number type
+ * <tt>LevelMatrixType::value_type</tt>, besides the interface required by
+ * PreconditionChebyshev, as for example the classes derived from
+ * MatrixFreeOperators::Base.
+ *
+ * A typical setup reads
+ * @code
+ * using LevelVectorType = LinearAlgebra::distributed::Vector<float>;
+ * using Preconditioner =
+ *   PreconditionMGMixedPrecision<LevelMatrixType, double>;
+ *
+ * MGLevelObject<Preconditioner::SmootherType::AdditionalData> smoother_data(
+ *   min_level, max_level);
+ * for (unsigned int level = min_level; level <= max_level; ++level)
+ *   {
+ *     smoother_data[level].preconditioner =
+ *       std::make_shared<DiagonalMatrix<LevelVectorType>>();
+ *     level_matrices[level].compute_inverse_diagonal(
+ *       smoother_data[level].preconditioner->get_vector());
+ *     smoother_data[level].degree          = 3;
+ *     smoother_data[level].polynomial_type = Preconditioner::SmootherType::
+ *       AdditionalData::PolynomialType::fourth_kind;
+ *   }
+ *
+ * Preconditioner preconditioner;
+ * preconditioner.initialize(level_matrices, transfer, smoother_data);
+ * SolverCG<LinearAlgebra::distributed::Vector<double>> solver(control);
+ * solver.solve(system_matrix, solution, rhs, preconditioner);
+ * @endcode
+ */
+template <typename LevelMatrixType, typename Number = double>
+class PreconditionMGMixedPrecision : public Subscriptor
+{
+public:
+  /**
+   * The number type of the level operations.
+   */
+  using LevelNumber = typename LevelMatrixType::value_type;
+
+  /**
+   * The vector type of the level operations.
+   */
+  using LevelVectorType = LinearAlgebra::distributed::Vector<LevelNumber>;
+
+  /**
+   * The vector type of the outer solver.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * The type of the smoother on each level.
+   */
+  using SmootherType = PreconditionChebyshev<LevelMatrixType,
+                                             LevelVectorType,
+                                             DiagonalMatrix<LevelVectorType>>;
+
+  /**
+   * Standardized data struct to pipe additional parameters to the
+   * preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double       coarse_tolerance      = 1e-2,
+                   const unsigned int coarse_max_iterations = 100);
+
+    /**
+     * Relative tolerance of the conjugate gradient solver on the coarsest
+     * level. Since the V-cycle is only used as a preconditioner, a moderate
+     * tolerance is enough and avoids to push the single-precision solver to
+     * the limits of roundoff.
+     */
+    double coarse_tolerance;
+
+    /**
+     * Maximum number of iterations of the conjugate gradient solver on the
+     * coarsest level. The solver stops without an error when this number is
+     * reached.
+     */
+    unsigned int coarse_max_iterations;
+  };
+
+  /**
+   * Initialize the preconditioner with the level matrices, the transfer
+   * between the levels and the settings of the Chebyshev smoothers on each
+   * level. The level matrices and the transfer object need to live as long
+   * as this class is used.
+   */
+  void
+  initialize(
+    const MGLevelObject<LevelMatrixType> &                      matrices,
+    const MGTransferBase<LevelVectorType> &                     transfer,
+    const MGLevelObject<typename SmootherType::AdditionalData> &smoother_data,
+    const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Apply one V-cycle to @p src and return the result in @p dst.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Return the number of iterations of the conjugate gradient solver on the
+   * coarsest level in the last call to vmult().
+   */
+  unsigned int
+  get_last_coarse_iterations() const;
+
+private:
+  /**
+   * Apply a V-cycle on the given level and all coarser ones, assuming that
+   * the pre-smoothing on the given level has been done already.
+   */
+  void
+  coarse_correction_and_post_smoothing(const unsigned int level) const;
+
+  /**
+   * Apply a V-cycle on the given level and all coarser ones.
+   */
+  void
+  v_cycle(const unsigned int level) const;
+
+  /**
+   * Solve on the coarsest level.
+   */
+  void
+  coarse_solve() const;
+
+  /**
+   * Pointer to the level matrices.
+   */
+  SmartPointer<const MGLevelObject<LevelMatrixType>,
+               PreconditionMGMixedPrecision<LevelMatrixType, Number>>
+    matrices;
+
+  /**
+   * Pointer to the transfer between the levels.
+   */
+  SmartPointer<const MGTransferBase<LevelVectorType>,
+               PreconditionMGMixedPrecision<LevelMatrixType, Number>>
+    transfer;
+
+  /**
+   * The smoothers on each level.
+   */
+  MGLevelObject<SmootherType> smoothers;
+
+  /**
+   * The settings of the coarse-grid solver.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The right hand side on each level.
+   */
+  mutable MGLevelObject<LevelVectorType> defect;
+
+  /**
+   * The solution on each level.
+   */
+  mutable MGLevelObject<LevelVectorType> solution;
+
+  /**
+   * Auxiliary vector for the residual on each level.
+   */
+  mutable MGLevelObject<LevelVectorType> residual;
+
+  /**
+   * The number of iterations of the coarse solver in the last V-cycle.
+   */
+  mutable unsigned int last_coarse_iterations;
+};
+
+/*@}*/
+
+#ifndef DOXYGEN
+/* --------------------------- inline functions --------------------- */
+
+
+template <typename LevelMatrixType, typename Number>
+inline PreconditionMGMixedPrecision<LevelMatrixType, Number>::
+  AdditionalData::AdditionalData(const double       coarse_tolerance,
+                                 const unsigned int coarse_max_iterations)
+  : coarse_tolerance(coarse_tolerance)
+  , coarse_max_iterations(coarse_max_iterations)
+{}
+
+
+
+template <typename LevelMatrixType, typename Number>
+inline void
+PreconditionMGMixedPrecision<LevelMatrixType, Number>::initialize(
+  const MGLevelObject<LevelMatrixType> &                      matrices,
+  const MGTransferBase<LevelVectorType> &                     transfer,
+  const MGLevelObject<typename SmootherType::AdditionalData> &smoother_data,
+  const AdditionalData &                                      additional_data)
+{
+  const unsigned int min_level = matrices.min_level();
+  const unsigned int max_level = matrices.max_level();
+  AssertDimension(smoother_data.min_level(), min_level);
+  AssertDimension(smoother_data.max_level(), max_level);
+
+  this->matrices        = &matrices;
+  this->transfer        = &transfer;
+  this->additional_data = additional_data;
+
+  smoothers.resize(min_level, max_level);
+  defect.resize(min_level, max_level);
+  solution.resize(min_level, max_level);
+  residual.resize(min_level, max_level);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      smoothers[level].initialize(matrices[level], smoother_data[level]);
+      matrices[level].initialize_dof_vector(defect[level]);
+      matrices[level].initialize_dof_vector(solution[level]);
+      matrices[level].initialize_dof_vector(residual[level]);
+    }
+  last_coarse_iterations = 0;
+}
+
+
+
+template <typename LevelMatrixType, typename Number>
+inline void
+PreconditionMGMixedPrecision<LevelMatrixType, Number>::vmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  Assert(matrices != nullptr, ExcNotInitialized());
+  const unsigned int max_level = matrices->max_level();
+
+  if (max_level == matrices->min_level())
+    {
+      defect[max_level].copy_locally_owned_data_from(src);
+      coarse_solve();
+    }
+  else
+    {
+      // the pre-smoother on the finest level reads the vector in the
+      // precision of the outer solver and fills the level right hand side
+      // along the way
+      smoothers[max_level].vmult_with_conversion(solution[max_level],
+                                                 defect[max_level],
+                                                 src);
+      coarse_correction_and_post_smoothing(max_level);
+    }
+
+  dst.copy_locally_owned_data_from(solution[max_level]);
+}
+
+
+
+template <typename LevelMatrixType, typename Number>
+inline void
+PreconditionMGMixedPrecision<LevelMatrixType, Number>::v_cycle(
+  const unsigned int level) const
+{
+  if (level == matrices->min_level())
+    coarse_solve();
+  else
+    {
+      smoothers[level].vmult(solution[level], defect[level]);
+      coarse_correction_and_post_smoothing(level);
+    }
+}
+
+
+
+template <typename LevelMatrixType, typename Number>
+inline void
+PreconditionMGMixedPrecision<LevelMatrixType, Number>::
+  coarse_correction_and_post_smoothing(const unsigned int level) const
+{
+  (*matrices)[level].vmult(residual[level], solution[level]);
+  residual[level].sadd(-1., 1., defect[level]);
+
+  defect[level - 1] = 0.;
+  transfer->restrict_and_add(level, defect[level - 1], residual[level]);
+
+  v_cycle(level - 1);
+
+  transfer->prolongate_and_add(level, solution[level], solution[level - 1]);
+  smoothers[level].step(solution[level], defect[level]);
+}
+
+
+
+template <typename LevelMatrixType, typename Number>
+inline void
+PreconditionMGMixedPrecision<LevelMatrixType, Number>::coarse_solve()
+  const
+{
+  const unsigned int level = matrices->min_level();
+
+  ReductionControl control(additional_data.coarse_max_iterations,
+                           0.,
+                           additional_data.coarse_tolerance,
+                           false,
+                           false);
+  SolverCG<LevelVectorType> solver(control);
+  solution[level] = 0.;
+  try
+    {
+      solver.solve((*matrices)[level],
+                   solution[level],
+                   defect[level],
+                   smoothers[level]);
+    }
+  catch (const SolverControl::NoConvergence &)
+    {
+      // the solution after the maximum number of iterations is good enough
+      // for a preconditioner
+    }
+  last_coarse_iterations = control.last_step();
+}
+
+
+
+template <typename LevelMatrixType, typename Number>
+inline unsigned int
+PreconditionMGMixedPrecision<LevelMatrixType, Number>::
+  get_last_coarse_iterations() const
+{
+  return last_coarse_iterations;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -90,6 +90,23 @@ namespace internal
        */
       bool element_is_continuous;
 
+      /**
+       * A variable storing the number of degrees of freedom the two children
+       * share in the center of the 1D line. This is zero for discontinuous
+       * elements, one for FE_Q, and the number of derivatives per vertex for
+       * FE_Hermite.
+       */
+      unsigned int n_joint_dofs_1d;
+
+      /**
+       * For FE_Hermite, whose degrees of freedom are derivatives in real
+       * space, the order of the derivative of each degree of freedom in the
+       * lexicographic numbering of the 1D children. The first
+       * <tt>fe_degree+1</tt> entries also give the orders on the parent. The
+       * vector is empty for all other elements.
+       */
+      std::vector<unsigned int> derivative_order_1d;
+
       /**
        * A variable storing the number of components in the finite element.
        */
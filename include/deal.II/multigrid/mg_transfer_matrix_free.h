@@ -47,8 +47,15 @@ DEAL_II_NAMESPACE_OPEN
  *
  * This class currently only works for tensor-product finite elements based on
  * FE_Q and FE_DGQ elements, including systems involving multiple components
- * of one of these elements. Systems with different elements or other elements
- * are currently not implemented.
+ * of one of these elements, and for FE_Hermite. Systems with different
+ * elements or other elements are currently not implemented.
+ *
+ * The degrees of freedom of FE_Hermite are derivatives in real space. The
+ * transfer applies the 1D embedding matrix of the reference cell returned by
+ * FE_Hermite::get_prolongation_matrix_1d() with sum factorization and
+ * rescales the degrees of freedom by powers of the lengths of the edges of
+ * the parent cell, which must be a parallelogram or parallelepiped as for
+ * MappingHermite.
  */
 template <int dim, typename Number>
 class MGTransferMatrixFree
@@ -201,6 +208,33 @@ private:
    */
   bool element_is_continuous;
 
+  /**
+   * A variable storing the number of degrees of freedom the two children
+   * share in the center of the 1D line, which is one for FE_Q and the number
+   * of derivatives per vertex for FE_Hermite.
+   */
+  unsigned int n_joint_dofs_1d;
+
+  /**
+   * For FE_Hermite, the order of the derivative of each degree of freedom in
+   * the lexicographic numbering of the 1D children, see
+   * internal::MGTransfer::ElementInfo. Empty for all other elements.
+   */
+  std::vector<unsigned int> derivative_order_1d;
+
+  /**
+   * For FE_Hermite, the extents of the parent cells in each direction, in
+   * vectorized form with <tt>dim</tt> entries per batch of cells. The 1D
+   * embedding matrix refers to a parent of unit size, so the degrees of
+   * freedom on the parent are multiplied by $h^k$ before and the ones on the
+   * children divided by $h^m$ after its application, with $k$ and $m$ the
+   * orders of the derivatives. Empty for all other elements.
+   *
+   * Data is organized in terms of each level (outer vector) and the cells on
+   * each level (inner vector).
+   */
+  std::vector<AlignedVector<VectorizedArray<Number>>> parent_cell_extents;
+
   /**
    * A variable storing the number of components in the finite element contained
    * in the DoFHandler passed to build().
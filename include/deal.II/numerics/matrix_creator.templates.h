@@ -600,6 +600,36 @@ namespace MatrixCreator
         Scratch() = default;
       };
 
+      // scratch data of the boundary mass matrix of a single finite
+      // element, which sets up FEFaceValues once per thread and only
+      // reinitializes it on each face
+      template <int dim, int spacedim>
+      struct FaceScratch
+      {
+        FaceScratch(const Mapping<dim, spacedim> &      mapping,
+                    const FiniteElement<dim, spacedim> &fe,
+                    const Quadrature<dim - 1> &         quadrature,
+                    const UpdateFlags                   update_flags)
+          : fe_values(mapping, fe, quadrature, update_flags)
+        {}
+
+        FaceScratch(const FaceScratch &data)
+          : fe_values(data.fe_values.get_mapping(),
+                      data.fe_values.get_fe(),
+                      data.fe_values.get_quadrature(),
+                      data.fe_values.get_update_flags())
+        {}
+
+        FaceScratch &
+        operator=(const FaceScratch &)
+        {
+          Assert(false, ExcNotImplemented());
+          return *this;
+        }
+
+        FEFaceValues<dim, spacedim> fe_values;
+      };
+
       template <int dim, int spacedim, typename number>
       struct CopyData
       {
@@ -929,12 +959,11 @@ namespace MatrixCreator
     template <int dim, int spacedim, typename number>
     void static inline create_boundary_mass_matrix_1(
       typename DoFHandler<dim, spacedim>::active_cell_iterator const &cell,
-      MatrixCreator::internal::AssemblerBoundary::Scratch const &,
+      MatrixCreator::internal::AssemblerBoundary::FaceScratch<dim, spacedim>
+        &scratch,
       MatrixCreator::internal::AssemblerBoundary::
         CopyData<dim, spacedim, number> & copy_data,
-      Mapping<dim, spacedim> const &      mapping,
       FiniteElement<dim, spacedim> const &fe,
-      Quadrature<dim - 1> const &         q,
       std::map<types::boundary_id, const Function<spacedim, number> *> const
         &                                     boundary_functions,
       Function<spacedim, number> const *const coefficient,
@@ -953,11 +982,25 @@ namespace MatrixCreator
       copy_data.cell          = cell;
       copy_data.dofs_per_cell = fe.n_dofs_per_cell();
 
-      UpdateFlags update_flags =
-        UpdateFlags(update_values | update_JxW_values | update_normal_vectors |
-                    update_quadrature_points);
-      if (fe_is_hermite) update_flags = update_flags | update_mapping;
-      FEFaceValues<dim, spacedim> fe_values(mapping, fe, q, update_flags);
+      // Because CopyData objects are reused and emplace_back is
+      // used, dof_is_on_face, cell_matrix, and cell_vector must be
+      // cleared before they are reused
+      copy_data.dof_is_on_face.clear();
+      copy_data.cell_matrix.clear();
+      copy_data.cell_vector.clear();
+
+      // cells without a face on the selected part of the boundary do not
+      // contribute
+      bool has_selected_face = false;
+      if (cell->at_boundary())
+        for (const unsigned int face : cell->face_indices())
+          if (boundary_functions.find(cell->face(face)->boundary_id()) !=
+              boundary_functions.end())
+            has_selected_face = true;
+      if (!has_selected_face)
+        return;
+
+      FEFaceValues<dim, spacedim> &fe_values = scratch.fe_values;
 
       // two variables for the coefficient, one for the two cases
       // indicated in the name
@@ -976,12 +1019,11 @@ namespace MatrixCreator
 
       std::vector<types::global_dof_index> dofs_on_face_vector;
 
-      // Because CopyData objects are reused and emplace_back is
-      // used, dof_is_on_face, cell_matrix, and cell_vector must be
-      // cleared before they are reused
-      copy_data.dof_is_on_face.clear();
-      copy_data.cell_matrix.clear();
-      copy_data.cell_vector.clear();
+      // the shape functions of FE_Hermite that belong to derivatives in
+      // the direction normal to a face vanish on it, so for this element
+      // only the ones with support on the face are assembled
+      std::vector<unsigned int> dofs_with_support;
+      dofs_with_support.reserve(copy_data.dofs_per_cell);
 
       for (const unsigned int face : cell->face_indices())
         // check if this face is on that part of the boundary we are
@@ -1126,16 +1168,21 @@ namespace MatrixCreator
                 if (coefficient != nullptr)
                   coefficient->value_list(fe_values.get_quadrature_points(),
                                           coefficient_values);
+
+                dofs_with_support.clear();
+                for (unsigned int i = 0; i < fe_values.dofs_per_cell; ++i)
+                  if (!fe_is_hermite || fe.has_support_on_face(i, face))
+                    dofs_with_support.push_back(i);
+
                 for (unsigned int point = 0;
                      point < fe_values.n_quadrature_points;
                      ++point)
                   {
                     const double weight = fe_values.JxW(point);
-                    for (unsigned int i = 0; i < fe_values.dofs_per_cell; ++i)
+                    for (const unsigned int i : dofs_with_support)
                       {
                         const double v = fe_values.shape_value(i, point);
-                        for (unsigned int j = 0; j < fe_values.dofs_per_cell;
-                             ++j)
+                        for (const unsigned int j : dofs_with_support)
                           {
                             const double u = fe_values.shape_value(j, point);
                             copy_data.cell_matrix.back()(i, j) +=
@@ -1148,11 +1195,20 @@ namespace MatrixCreator
               }
 
 
-            dofs_on_face_vector.resize(fe.n_dofs_per_face(face));
-            cell->face(face)->get_dof_indices(dofs_on_face_vector);
             // for each dof on the cell, have a flag whether it is on
             // the face
             copy_data.dof_is_on_face.emplace_back(copy_data.dofs_per_cell);
+            if (fe_is_hermite)
+              {
+                // the entries of the other dofs on the face are zero, so
+                // they need not be copied either
+                for (const unsigned int i : dofs_with_support)
+                  copy_data.dof_is_on_face.back()[i] = true;
+                continue;
+              }
+
+            dofs_on_face_vector.resize(fe.n_dofs_per_face(face));
+            cell->face(face)->get_dof_indices(dofs_on_face_vector);
             // check for each of the dofs on this cell whether it is
             // on the face
             for (unsigned int i = 0; i < copy_data.dofs_per_cell; ++i)
@@ -1240,12 +1296,10 @@ namespace MatrixCreator
     template <>
     void inline create_boundary_mass_matrix_1<1, 3, float>(
       DoFHandler<1, 3>::active_cell_iterator const & /*cell*/,
-      MatrixCreator::internal::AssemblerBoundary::Scratch const &,
+      MatrixCreator::internal::AssemblerBoundary::FaceScratch<1, 3> &,
       MatrixCreator::internal::AssemblerBoundary::CopyData<1, 3, float>
         & /*copy_data*/,
-      Mapping<1, 3> const &,
       FiniteElement<1, 3> const &,
-      Quadrature<0> const &,
       std::map<types::boundary_id, const Function<3, float> *> const
         & /*boundary_functions*/,
       Function<3, float> const *const /*coefficient*/,
@@ -1257,12 +1311,10 @@ namespace MatrixCreator
     template <>
     void inline create_boundary_mass_matrix_1<1, 3, double>(
       DoFHandler<1, 3>::active_cell_iterator const & /*cell*/,
-      MatrixCreator::internal::AssemblerBoundary::Scratch const &,
+      MatrixCreator::internal::AssemblerBoundary::FaceScratch<1, 3> &,
       MatrixCreator::internal::AssemblerBoundary::CopyData<1, 3, double>
         & /*copy_data*/,
-      Mapping<1, 3> const &,
       FiniteElement<1, 3> const &,
-      Quadrature<0> const &,
       std::map<types::boundary_id, const Function<3, double> *> const
         & /*boundary_functions*/,
       Function<3, double> const *const /*coefficient*/,
@@ -1319,24 +1371,30 @@ namespace MatrixCreator
     else
       AssertDimension(n_components, component_mapping.size());
 
-    MatrixCreator::internal::AssemblerBoundary::Scratch scratch;
+    UpdateFlags update_flags =
+      UpdateFlags(update_values | update_JxW_values | update_normal_vectors |
+                  update_quadrature_points);
+    if (dynamic_cast<const FE_Hermite<dim, spacedim> *>(&fe) != nullptr)
+      update_flags = update_flags | update_mapping;
+
+    MatrixCreator::internal::AssemblerBoundary::FaceScratch<dim, spacedim>
+      scratch(mapping, fe, q, update_flags);
     MatrixCreator::internal::AssemblerBoundary::CopyData<dim, spacedim, number>
       copy_data;
 
     WorkStream::run(
       dof.begin_active(),
       dof.end(),
-      [&mapping, &fe, &q, &boundary_functions, coefficient, &component_mapping](
+      [&fe, &boundary_functions, coefficient, &component_mapping](
         typename DoFHandler<dim, spacedim>::active_cell_iterator const &cell,
-        MatrixCreator::internal::AssemblerBoundary::Scratch const &scratch_data,
+        MatrixCreator::internal::AssemblerBoundary::FaceScratch<dim, spacedim>
+          &scratch_data,
         MatrixCreator::internal::AssemblerBoundary::
           CopyData<dim, spacedim, number> &copy_data) {
         internal::create_boundary_mass_matrix_1(cell,
                                                 scratch_data,
                                                 copy_data,
-                                                mapping,
                                                 fe,
-                                                q,
                                                 boundary_functions,
                                                 coefficient,
                                                 component_mapping);
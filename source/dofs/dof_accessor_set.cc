@@ -18,6 +18,7 @@
 #include <deal.II/dofs/dof_levels.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_hermite.h>
 
 #include <deal.II/grid/tria_iterator.h>
 #include <deal.II/grid/tria_iterator.templates.h>
@@ -116,11 +117,35 @@ DoFCellAccessor<dim, spacedim, lda>::set_dof_values_by_interpolation(
 
       Vector<number> tmp(dofs_per_cell);
 
+      // the degrees of freedom of FE_Hermite are derivatives in real space,
+      // whereas its prolongation matrices are set up for a cell of unit
+      // size. rescale the values to the unit cell before applying them and
+      // back to the size of this cell afterwards
+      std::vector<double>   dof_rescaling;
+      Vector<number>        scaled_values;
+      const Vector<number> *unit_cell_values = &local_values;
+      if (const auto fe_hermite =
+            dynamic_cast<const FE_Hermite<dim, spacedim> *>(&fe))
+        {
+          Tensor<1, dim> cell_extents;
+          for (unsigned int d = 0; d < dim; ++d)
+            cell_extents[d] =
+              this->vertex(0).distance(this->vertex(1U << d));
+          fe_hermite->compute_dof_rescaling(cell_extents, dof_rescaling);
+
+          scaled_values = local_values;
+          for (unsigned int i = 0; i < dof_rescaling.size(); ++i)
+            scaled_values[i] *= dof_rescaling[i];
+          unit_cell_values = &scaled_values;
+        }
+
       for (unsigned int child = 0; child < this->n_children(); ++child)
         {
           if (tmp.size() > 0)
             fe.get_prolongation_matrix(child, this->refinement_case())
-              .vmult(tmp, local_values);
+              .vmult(tmp, *unit_cell_values);
+          for (unsigned int i = 0; i < dof_rescaling.size(); ++i)
+            tmp[i] /= dof_rescaling[i];
           this->child(child)->set_dof_values_by_interpolation(tmp,
                                                               values,
                                                               fe_index);
@@ -23,6 +23,7 @@
 #include <deal.II/dofs/dof_tools.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_hermite.h>
 #include <deal.II/fe/fe_tools.h>
 #include <deal.II/fe/fe_values.h>
 
@@ -1778,6 +1779,475 @@ namespace DoFTools
               }
         }
     }
+
+
+
+    /**
+     * Throw an exception unless all edges of the given cell are parallel to
+     * the coordinate axes. The constraints for FE_Hermite below take the
+     * extents of cells and faces from their bounding boxes, which is only
+     * correct for such cells.
+     */
+    template <typename CellIterator>
+    void
+    check_hermite_cell_is_axis_parallel(const CellIterator &cell)
+    {
+      constexpr int dim      = CellIterator::AccessorType::dimension;
+      constexpr int spacedim = CellIterator::AccessorType::space_dimension;
+      for (const unsigned int l : cell->line_indices())
+        {
+          const Tensor<1, spacedim> edge =
+            cell->vertex(GeometryInfo<dim>::line_to_cell_vertices(l, 1)) -
+            cell->vertex(GeometryInfo<dim>::line_to_cell_vertices(l, 0));
+          unsigned int n_nonzero_components = 0;
+          for (unsigned int d = 0; d < spacedim; ++d)
+            if (std::abs(edge[d]) > 1e-10 * edge.norm())
+              ++n_nonzero_components;
+          AssertThrow(n_nonzero_components == 1,
+                      ExcMessage(
+                        "The constraints of FE_Hermite can only be computed "
+                        "on meshes whose cells are aligned with the "
+                        "coordinate axes."));
+        }
+    }
+
+
+
+    /**
+     * Hanging node constraints for FE_Hermite. The degrees of freedom of
+     * this element are derivatives in real space, so the constraints depend
+     * on the size of the face and on which of the derivatives are
+     * tangential to it, and cannot be expressed by the single matrix that
+     * FiniteElement::constraints() provides.
+     *
+     * Each degree of freedom at a vertex in the interior of a refined face is
+     * a derivative of the function on the coarse side of the face, which is
+     * determined by the degrees of freedom at the vertices of the coarse
+     * face. In each tangential direction $t$ in which the hanging vertex
+     * lies at the midpoint of the face, the derivative of order $m$ of the
+     * 1D basis function of order $k$ is taken from the 1D embedding matrix
+     * and scaled by $H_t^{k-m}$ for a face of extent $H_t$. In all other
+     * directions, the derivative is simply the one at the coinciding vertex
+     * of the coarse face. This assumes that the cells are aligned with the
+     * coordinate axes, as MappingHermite does, which is checked at run time.
+     *
+     * The element is the one of the cell on the coarse side of each face,
+     * so this function also works with an hp::FECollection of FE_Hermite
+     * elements as long as the cells on both sides of a refined face use the
+     * same element.
+     */
+    template <int dim, int spacedim, typename number>
+    void
+    make_hermite_hanging_node_constraints(
+      const DoFHandler<dim, spacedim> &dof_handler,
+      AffineConstraints<number> &      constraints)
+    {
+      const unsigned int n_face_vertices = GeometryInfo<dim>::vertices_per_face;
+
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        {
+          // artificial cells can at best neighbor ghost cells, but we're not
+          // interested in these interfaces
+          if (cell->is_artificial())
+            continue;
+
+          for (const unsigned int f : cell->face_indices())
+            if (cell->face(f)->has_children())
+              {
+                const auto fe =
+                  dynamic_cast<const FE_Hermite<dim, spacedim> *>(
+                    &cell->get_fe());
+                // no constraints are needed next to an FE_Nothing
+                if (fe == nullptr)
+                  continue;
+                Assert(fe->n_nodes() == 0, ExcNotImplemented());
+                check_hermite_cell_is_axis_parallel(cell);
+
+                const unsigned int n_orders = fe->get_regularity() + 1;
+                const unsigned int dofs_per_vertex = fe->n_dofs_per_vertex();
+
+                // the derivatives at the midpoint of the unit interval are
+                // the entries of the embedding matrix of the left child that
+                // belong to its right end point
+                const FullMatrix<double> &prolongation_1d =
+                  fe->get_prolongation_matrix_1d(0);
+
+                std::vector<types::global_dof_index> dofs_on_mother(
+                  n_face_vertices * dofs_per_vertex);
+                std::vector<types::global_dof_index> dofs_on_vertex(
+                  dofs_per_vertex);
+                std::vector<unsigned int> derivative_order(dofs_per_vertex *
+                                                           dim);
+                for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+                  for (unsigned int d = 0, index = i; d < dim;
+                       ++d, index /= n_orders)
+                    derivative_order[i * dim + d] = index % n_orders;
+
+                const auto face = cell->face(f);
+
+                // bounding box of the coarse face and position of its
+                // vertices within it
+                Point<spacedim> lower = face->vertex(0), upper = face->vertex(0);
+                for (unsigned int v = 1; v < n_face_vertices; ++v)
+                  for (unsigned int d = 0; d < spacedim; ++d)
+                    {
+                      lower[d] = std::min(lower[d], face->vertex(v)[d]);
+                      upper[d] = std::max(upper[d], face->vertex(v)[d]);
+                    }
+                const Tensor<1, spacedim> face_extents = upper - lower;
+                const double tolerance = 1e-10 * face_extents.norm();
+
+                std::vector<std::array<bool, spacedim>> mother_vertex_at_upper(
+                  n_face_vertices);
+                for (unsigned int v = 0; v < n_face_vertices; ++v)
+                  {
+                    for (unsigned int d = 0; d < spacedim; ++d)
+                      mother_vertex_at_upper[v][d] =
+                        face->vertex(v)[d] > lower[d] + tolerance;
+                    for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+                      dofs_on_mother[v * dofs_per_vertex + i] =
+                        face->vertex_dof_index(v, i, cell->active_fe_index());
+                  }
+
+                for (unsigned int c = 0; c < face->n_children(); ++c)
+                  {
+                    if (cell->neighbor_child_on_subface(f, c)->is_artificial())
+                      continue;
+                    Assert(cell->neighbor_child_on_subface(f, c)
+                               ->active_fe_index() == cell->active_fe_index(),
+                           ExcNotImplemented());
+
+                    for (unsigned int w = 0; w < n_face_vertices; ++w)
+                      {
+                        for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+                          dofs_on_vertex[i] = face->child(c)->vertex_dof_index(
+                            w, i, cell->active_fe_index());
+
+                        // skip the vertices of the coarse face and the ones
+                        // shared with another child that were already
+                        // constrained
+                        if (std::find(dofs_on_mother.begin(),
+                                      dofs_on_mother.end(),
+                                      dofs_on_vertex[0]) !=
+                              dofs_on_mother.end() ||
+                            constraints.is_constrained(dofs_on_vertex[0]))
+                          continue;
+
+                        // classify the position of the hanging vertex in
+                        // each direction: 0 or 2 for the lower or upper end
+                        // of the coarse face, 1 for the midpoint, and
+                        // invalid for the direction normal to the face
+                        std::array<unsigned int, spacedim> position;
+                        const Point<spacedim> &p = face->child(c)->vertex(w);
+                        for (unsigned int d = 0; d < spacedim; ++d)
+                          if (face_extents[d] <= tolerance)
+                            position[d] = numbers::invalid_unsigned_int;
+                          else if (p[d] < lower[d] + tolerance)
+                            position[d] = 0;
+                          else if (p[d] > upper[d] - tolerance)
+                            position[d] = 2;
+                          else
+                            position[d] = 1;
+
+                        for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+                          {
+                            constraints.add_line(dofs_on_vertex[i]);
+                            for (unsigned int v = 0; v < n_face_vertices; ++v)
+                              for (unsigned int j = 0; j < dofs_per_vertex;
+                                   ++j)
+                                {
+                                  double entry = 1.;
+                                  for (unsigned int d = 0; d < dim; ++d)
+                                    {
+                                      const unsigned int m =
+                                        derivative_order[i * dim + d];
+                                      const unsigned int k =
+                                        derivative_order[j * dim + d];
+                                      if (position[d] == 1)
+                                        entry *=
+                                          prolongation_1d(
+                                            n_orders + m,
+                                            (mother_vertex_at_upper[v][d] ?
+                                               n_orders :
+                                               0) +
+                                              k) *
+                                          std::pow(face_extents[d],
+                                                   static_cast<int>(k) -
+                                                     static_cast<int>(m));
+                                      else if (m != k ||
+                                               (position[d] !=
+                                                  numbers::invalid_unsigned_int &&
+                                                (position[d] == 2) !=
+                                                  mother_vertex_at_upper[v][d]))
+                                        entry = 0.;
+                                    }
+                                  if (entry != 0.)
+                                    constraints.add_entry(
+                                      dofs_on_vertex[i],
+                                      dofs_on_mother[v * dofs_per_vertex + j],
+                                      entry);
+                                }
+                            constraints.set_inhomogeneity(dofs_on_vertex[i],
+                                                          0.);
+                          }
+                      }
+                  }
+              }
+        }
+    }
+
+
+
+    /**
+     * Constraints between different FE_Hermite elements of an
+     * hp::FECollection on neighboring cells. On a face between two cells,
+     * the function on the side of the dominated element, i.e., the one of
+     * higher degree, must match the one on the side of the dominating
+     * element. For each derivative order $k$ up to the lower of the two
+     * regularities, the degrees of freedom of the dominated element that
+     * belong to the $k$-th normal derivative on the face are constrained to
+     * interpolate the $k$-th normal derivative of the function on the
+     * dominating side, which is a polynomial of a lower or equal degree in
+     * the tangential directions. In each tangential direction $t$, the
+     * derivative of order $m$ of the 1D basis function of order $k$ of the
+     * dominating element is scaled by $H_t^{k-m}$ for a face of extent
+     * $H_t$. The degrees of freedom the DoFHandler already identified
+     * through the hp dof identities of FE_Hermite are skipped.
+     *
+     * As for the hanging node constraints, the cells must be aligned with
+     * the coordinate axes, and faces between cells with different elements
+     * must not be refined.
+     */
+    template <int dim, int spacedim, typename number>
+    void
+    make_hermite_hp_constraints(const DoFHandler<dim, spacedim> &dof_handler,
+                                AffineConstraints<number> &      constraints)
+    {
+      const hp::FECollection<dim, spacedim> &fe_collection =
+        dof_handler.get_fe_collection();
+
+      // the 1D basis of each element along with the position and the
+      // derivative order of its 1D degrees of freedom, and the inverse of
+      // the numbering of the polynomial space
+      struct Hermite1D
+      {
+        std::vector<Polynomials::Polynomial<double>> basis;
+        std::vector<double>                          position;
+        std::vector<unsigned int>                    order;
+        std::vector<unsigned int>                    lexicographic_to_hierarchic;
+      };
+      std::vector<Hermite1D> data(fe_collection.size());
+      for (unsigned int i = 0; i < fe_collection.size(); ++i)
+        if (const auto fe = dynamic_cast<const FE_Hermite<dim, spacedim> *>(
+              &fe_collection[i]))
+          {
+            const unsigned int regularity   = fe->get_regularity();
+            const unsigned int right_offset = fe->degree - regularity;
+
+            data[i].basis =
+              (fe->n_nodes() == 0) ?
+                Polynomials::HermiteMaxreg::generate_complete_basis(
+                  regularity) :
+                Polynomials::HermiteCustomreg::generate_complete_basis(
+                  fe->degree, regularity);
+            data[i].position.resize(fe->degree + 1, 0.);
+            data[i].order.resize(fe->degree + 1, 0);
+            for (unsigned int m = 0; m <= regularity; ++m)
+              {
+                data[i].order[m]                   = m;
+                data[i].position[right_offset + m] = 1.;
+                data[i].order[right_offset + m]    = m;
+              }
+            if (fe->n_nodes() > 0)
+              {
+                const std::vector<Point<1>> nodes = Polynomials::
+                  HermiteCustomreg::create_chebyshevgausslobatto_nodes(
+                    fe->n_nodes());
+                for (unsigned int j = 0; j < fe->n_nodes(); ++j)
+                  data[i].position[regularity + 1 + j] = nodes[j](0);
+              }
+
+            data[i].lexicographic_to_hierarchic =
+              Utilities::invert_permutation(fe->get_poly_space_numbering());
+          }
+
+      // derivative of the given order of a 1D basis function
+      const auto derivative = [](const Polynomials::Polynomial<double> &p,
+                                 const double                           x,
+                                 const unsigned int order) {
+        std::vector<double> values(order + 1);
+        p.value(x, values);
+        return values[order];
+      };
+
+      std::vector<types::global_dof_index> dof_indices, neighbor_dof_indices;
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        {
+          if (cell->is_artificial())
+            continue;
+
+          for (const unsigned int f : cell->face_indices())
+            {
+              if (cell->at_boundary(f) || cell->face(f)->has_children() ||
+                  cell->neighbor_is_coarser(f))
+                continue;
+
+              const auto neighbor = cell->neighbor(f);
+              if (neighbor->is_artificial() ||
+                  neighbor->active_fe_index() == cell->active_fe_index())
+                continue;
+
+              const auto fe = dynamic_cast<const FE_Hermite<dim, spacedim> *>(
+                &cell->get_fe());
+              const auto neighbor_fe =
+                dynamic_cast<const FE_Hermite<dim, spacedim> *>(
+                  &neighbor->get_fe());
+              if (fe == nullptr || neighbor_fe == nullptr)
+                continue;
+
+              // only constrain from the side of the dominated element, and
+              // let the element with the lower index dominate if either can
+              const FiniteElementDomination::Domination domination =
+                fe->compare_for_domination(*neighbor_fe, 1);
+              if (!(domination ==
+                      FiniteElementDomination::other_element_dominates ||
+                    (domination ==
+                       FiniteElementDomination::either_element_can_dominate &&
+                     neighbor->active_fe_index() < cell->active_fe_index())))
+                continue;
+
+              check_hermite_cell_is_axis_parallel(cell);
+
+              const Hermite1D &this_1d     = data[cell->active_fe_index()];
+              const Hermite1D &neighbor_1d = data[neighbor->active_fe_index()];
+
+              const unsigned int normal_direction = f / 2;
+              const unsigned int neighbor_face    = cell->neighbor_face_no(f);
+              Assert(neighbor_face / 2 == normal_direction,
+                     ExcNotImplemented());
+
+              const unsigned int n_dofs_1d          = fe->degree + 1;
+              const unsigned int n_neighbor_dofs_1d = neighbor_fe->degree + 1;
+              const unsigned int n_orders =
+                std::min(fe->get_regularity(), neighbor_fe->get_regularity()) +
+                1;
+              const Tensor<1, spacedim> extents =
+                cell->vertex(GeometryInfo<dim>::vertices_per_cell - 1) -
+                cell->vertex(0);
+
+              // derivatives of the 1D basis of the neighbor at the 1D degrees
+              // of freedom of this element on the unit interval
+              FullMatrix<double> interpolation_1d(n_dofs_1d,
+                                                  n_neighbor_dofs_1d);
+              for (unsigned int a = 0; a < n_dofs_1d; ++a)
+                for (unsigned int b = 0; b < n_neighbor_dofs_1d; ++b)
+                  {
+                    const double entry =
+                      derivative(neighbor_1d.basis[b],
+                                 this_1d.position[a],
+                                 this_1d.order[a]) /
+                      derivative(this_1d.basis[a],
+                                 this_1d.position[a],
+                                 this_1d.order[a]);
+                    if (std::abs(entry) > 1e-12)
+                      interpolation_1d(a, b) = entry;
+                  }
+
+              dof_indices.resize(fe->n_dofs_per_cell());
+              neighbor_dof_indices.resize(neighbor_fe->n_dofs_per_cell());
+              cell->get_dof_indices(dof_indices);
+              neighbor->get_dof_indices(neighbor_dof_indices);
+
+              const unsigned int n_face_dofs =
+                Utilities::pow(n_dofs_1d, dim - 1);
+              const unsigned int n_neighbor_face_dofs =
+                Utilities::pow(n_neighbor_dofs_1d, dim - 1);
+              for (unsigned int k = 0; k < n_orders; ++k)
+                {
+                  const unsigned int normal_index =
+                    (f % 2 == 0) ? k : fe->degree - fe->get_regularity() + k;
+                  const unsigned int neighbor_normal_index =
+                    (neighbor_face % 2 == 0) ?
+                      k :
+                      neighbor_fe->degree - neighbor_fe->get_regularity() + k;
+                  const double normal_factor =
+                    derivative(neighbor_1d.basis[neighbor_normal_index],
+                               neighbor_1d.position[neighbor_normal_index],
+                               k) /
+                    derivative(this_1d.basis[normal_index],
+                               this_1d.position[normal_index],
+                               k);
+
+                  for (unsigned int i = 0; i < n_face_dofs; ++i)
+                    {
+                      // lexicographic index of the degree of freedom on the
+                      // cell, with the tangential directions taken from i
+                      unsigned int index = 0;
+                      for (unsigned int d = 0, stride = 1, tangential = i;
+                           d < dim;
+                           ++d, stride *= n_dofs_1d)
+                        if (d == normal_direction)
+                          index += normal_index * stride;
+                        else
+                          {
+                            index += (tangential % n_dofs_1d) * stride;
+                            tangential /= n_dofs_1d;
+                          }
+                      const types::global_dof_index dof =
+                        dof_indices[this_1d.lexicographic_to_hierarchic[index]];
+
+                      // skip the degrees of freedom identified with the ones
+                      // of the neighbor and the ones constrained on another
+                      // face
+                      if (std::find(neighbor_dof_indices.begin(),
+                                    neighbor_dof_indices.end(),
+                                    dof) != neighbor_dof_indices.end() ||
+                          constraints.is_constrained(dof))
+                        continue;
+
+                      constraints.add_line(dof);
+                      for (unsigned int j = 0; j < n_neighbor_face_dofs; ++j)
+                        {
+                          double       entry          = normal_factor;
+                          unsigned int neighbor_index = 0;
+                          for (unsigned int d = 0,
+                                            stride              = 1,
+                                            this_tangential     = i,
+                                            neighbor_tangential = j;
+                               d < dim;
+                               ++d, stride *= n_neighbor_dofs_1d)
+                            if (d == normal_direction)
+                              neighbor_index += neighbor_normal_index * stride;
+                            else
+                              {
+                                const unsigned int a =
+                                  this_tangential % n_dofs_1d;
+                                const unsigned int b =
+                                  neighbor_tangential % n_neighbor_dofs_1d;
+                                entry *=
+                                  interpolation_1d(a, b) *
+                                  std::pow(extents[d],
+                                           static_cast<int>(
+                                             neighbor_1d.order[b]) -
+                                             static_cast<int>(this_1d.order[a]));
+                                neighbor_index += b * stride;
+                                this_tangential /= n_dofs_1d;
+                                neighbor_tangential /= n_neighbor_dofs_1d;
+                              }
+                          if (entry != 0.)
+                            constraints.add_entry(
+                              dof,
+                              neighbor_dof_indices
+                                [neighbor_1d.lexicographic_to_hierarchic
+                                   [neighbor_index]],
+                              entry);
+                        }
+                      constraints.set_inhomogeneity(dof, 0.);
+                    }
+                }
+            }
+        }
+    }
   } // namespace internal
 
 
@@ -1796,7 +2266,32 @@ namespace DoFTools
     // function. If all the FiniteElement or all elements in a FECollection
     // support the new face constraint matrix, the new code will be used.
     // Otherwise, the old implementation is used for the moment.
-    if (dof_handler.get_fe_collection().hp_constraints_are_implemented())
+    //
+    // FE_Hermite needs constraints of its own. It can be combined with
+    // elements without degrees of freedom, such as FE_Nothing, but not with
+    // any other element.
+    const hp::FECollection<dim, spacedim> &fe_collection =
+      dof_handler.get_fe_collection();
+    bool has_hermite_elements = false;
+    for (unsigned int i = 0; i < fe_collection.size(); ++i)
+      if (dynamic_cast<const FE_Hermite<dim, spacedim> *>(
+            &fe_collection[i]) != nullptr)
+        has_hermite_elements = true;
+
+    if (has_hermite_elements)
+      {
+        for (unsigned int i = 0; i < fe_collection.size(); ++i)
+          AssertThrow((dynamic_cast<const FE_Hermite<dim, spacedim> *>(
+                         &fe_collection[i]) != nullptr) ||
+                        (fe_collection[i].n_dofs_per_cell() == 0),
+                      ExcNotImplemented());
+
+        internal::make_hermite_hanging_node_constraints(dof_handler,
+                                                        constraints);
+        if (fe_collection.size() > 1)
+          internal::make_hermite_hp_constraints(dof_handler, constraints);
+      }
+    else if (fe_collection.hp_constraints_are_implemented())
       internal::make_hp_hanging_node_constraints(dof_handler, constraints);
     else
       internal::make_oldstyle_hanging_node_constraints(
@@ -1,1706 +1,3045 @@
-/**
- * Source code for Hermite basis functions.
- */
-
-#include <deal.II/base/template_constraints.h>
-#include <deal.II/base/table.h>
-#include <deal.II/base/quadrature.h>
-#include <deal.II/base/quadrature_lib.h>
-
-#include <deal.II/dofs/dof_tools.h>
-
-#include <deal.II/fe/fe_hermite.h>
-#include <deal.II/fe/fe_tools.h>
-#include <deal.II/fe/mapping_hermite.h>
-#include <deal.II/fe/fe_face.h>
-#include <deal.II/fe/fe_values.h>
-
-#include <deal.II/lac/dynamic_sparsity_pattern.h>
-#include <deal.II/lac/sparsity_pattern.h>
-#include <deal.II/lac/sparsity_tools.h>
-#include <deal.II/lac/sparse_matrix.h>
-#include <deal.II/lac/vector.h>
-#include <deal.II/lac/solver_control.h>
-#include <deal.II/lac/solver_cg.h>
-#include <deal.II/lac/sparse_direct.h>
-#include <deal.II/lac/precondition.h>
-
-#include <deal.II/numerics/matrix_tools.h>
-
-#include <cmath>
-#include <iterator>
-#include <memory>
-#include <sstream>
-#include <iostream>
-#include <algorithm>
-
-DEAL_II_NAMESPACE_OPEN
-
-namespace internal
-{
-  inline std::vector<unsigned int>
-  get_hermite_dpo_vector(const unsigned int dim,
-                         const unsigned int regularity,
-                         const unsigned int nodes)
-  {
-    std::vector<unsigned int> result(dim + 1);
-    unsigned int coeff1 = 1, coeff2 = Utilities::pow(regularity + 1, dim);
-    for (unsigned int i = 0; i <= dim; ++i)
-      {
-        result[i] = coeff1 * coeff2;
-        coeff1 *= nodes;
-        coeff2 /= regularity + 1;
-      }
-    return result;
-  }
-  
-  /**
-   * Renumbering function. Function needs different levels of for loop nesting
-   * for different values of dim, so different definitions are used for 
-   * simplicity.
-   */
-  template <int dim>
-  void
-  hermite_hierarchic_to_lexicographic_numbering(const unsigned int regularity,
-                                                const unsigned int nodes,
-                                                std::vector<unsigned int> &h2l);
-  
-  template<>
-  void
-  hermite_hierarchic_to_lexicographic_numbering<1>(const unsigned int regularity,
-                                                const unsigned int nodes,
-                                                std::vector<unsigned int> &h2l)
-  {
-        const unsigned int node_dofs_1d = regularity + 1;
-        
-        AssertDimension(h2l.size(), 2 * node_dofs_1d + nodes);
-        
-        unsigned int count = 0;
-        // Assign DOFs at vertices
-        for (unsigned int di = 0; di < 2; ++di)
-            for (unsigned int i = 0; i < node_dofs_1d; ++i, ++count)
-                h2l[i + di * node_dofs_1d] = i + di * (node_dofs_1d + nodes);
-            
-        // Assign DOFs on line if needed
-        for (unsigned int i = 0; i < nodes; ++i, ++count)
-            h2l[i + 2 * node_dofs_1d] = i + node_dofs_1d;
-        
-        AssertDimension(count, 2 * node_dofs_1d + nodes);
-  }
-  
-  template<>
-  void
-  hermite_hierarchic_to_lexicographic_numbering<2>(const unsigned int regularity,
-                                                const unsigned int nodes,
-                                                std::vector<unsigned int> &h2l)
-  {
-        const unsigned int node_dofs_1d = regularity + 1;
-        
-        const unsigned int dim_dofs_1d  = 2 * node_dofs_1d + nodes;
-        
-        AssertDimension(h2l.size(), dim_dofs_1d * dim_dofs_1d);
-        
-        unsigned int count = 0, offset = 0;
-        
-        // Assign DOFs at vertices
-        for (unsigned int di = 0; di < 2; ++di)
-            for (unsigned int dj = 0; dj < 2; ++dj)
-            {
-                for (unsigned int i = 0; i < node_dofs_1d; ++i)
-                    for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
-                        h2l[j + i * node_dofs_1d + offset] = 
-                            j + i * dim_dofs_1d + (dj + di * dim_dofs_1d) * (node_dofs_1d + nodes);
-                offset += node_dofs_1d * node_dofs_1d;
-            }
-                
-        if (nodes)
-        {
-            // Assign DOFs on edges
-            for (unsigned int i = 0; i < nodes; ++i)
-                for (unsigned int dj = 0; dj < 2; ++dj)
-                    for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
-                        h2l[j + (2 * i + dj) * node_dofs_1d + offset] =
-                            j + (i + node_dofs_1d) * dim_dofs_1d + dj * (node_dofs_1d +
-                            nodes);
-            offset += 2 * nodes * node_dofs_1d;
-            
-            for (unsigned int i = 0; i < nodes; ++i)
-                for (unsigned int di = 0; di < 2; ++di)
-                    for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
-                        h2l[j + (2 * i + di) * node_dofs_1d + offset] =
-                            i + j * dim_dofs_1d + di * (node_dofs_1d + nodes) * dim_dofs_1d +
-                            node_dofs_1d;
-            offset += 2 * nodes * node_dofs_1d;
-            
-            // Assign DOFs on face
-            for (unsigned int i = 0; i < nodes; ++i)
-                for (unsigned int j = 0; j < nodes; ++j, ++count)
-                    h2l[j + i * nodes + offset] =
-                        j + (i + node_dofs_1d) * dim_dofs_1d + node_dofs_1d;
-        }
-            
-        AssertDimension(count, dim_dofs_1d * dim_dofs_1d);
-  }  
-  
-  template<>
-  void
-  hermite_hierarchic_to_lexicographic_numbering<3>(const unsigned int regularity,
-                                                const unsigned int nodes,
-                                                std::vector<unsigned int> &h2l)
-  {
-        const unsigned int node_dofs_1d = regularity + 1;
-        const unsigned int node_dofs_2d = node_dofs_1d * node_dofs_1d;
-    
-        const unsigned int dim_dofs_1d  = 2 * node_dofs_1d + nodes;
-        const unsigned int dim_dofs_2d  = dim_dofs_1d * dim_dofs_1d;
-    
-        AssertDimension(h2l.size(), dim_dofs_2d * dim_dofs_1d);
-    
-        unsigned int offset = 0, count = 0;
-    
-        // Assign DOFs at nodes
-        for (unsigned int di = 0; di < 2; ++di)
-            for (unsigned int dj = 0; dj < 2; ++dj)
-                for (unsigned int dk = 0; dk < 2; ++dk)
-                {
-                    for (unsigned int i = 0; i < node_dofs_1d; ++i)
-                        for (unsigned int j = 0; j < node_dofs_1d; ++j)
-                            for (unsigned int k = 0; k < node_dofs_1d; ++k, ++count)
-                                h2l[k + j * node_dofs_1d + i * node_dofs_2d + offset] =
-                                    k + j * dim_dofs_1d + i * dim_dofs_2d +
-                                    (node_dofs_1d + nodes) *
-                                    (dk + dj * dim_dofs_1d + di * dim_dofs_2d);
-                    offset += node_dofs_1d * node_dofs_2d;
-                }
-                
-        if (nodes)
-        {
-            // Assign DOFs on edges
-            // edges parallel to z
-            for (unsigned int i = 0; i < nodes; ++i)
-                for (unsigned int dj = 0; dj < 2; ++dj)
-                    for (unsigned int dk = 0; dk < 2; ++dk)
-                    {
-                        for (unsigned int j = 0; j < node_dofs_1d; ++j)
-                            for (unsigned int k = 0; k < node_dofs_1d; ++k, ++count)
-                                h2l[k + j * node_dofs_1d + offset] =
-                                    k + j * dim_dofs_1d +
-                                    (i + node_dofs_1d) * dim_dofs_2d +
-                                    (node_dofs_1d + nodes) * (dk + dj * dim_dofs_1d);
-                        offset += node_dofs_2d;
-                    }
-                    
-            // edges parallel to y
-            for (unsigned int j = 0; j < nodes; ++j)
-                for (unsigned int di = 0; di < 2; ++di)
-                    for (unsigned int dk = 0; dk < 2; ++dk)
-                    {
-                        for (unsigned int i = 0; i < node_dofs_1d; ++i)
-                            for (unsigned int k = 0; k < node_dofs_1d; ++k, ++count)
-                                h2l[k + i * node_dofs_1d + offset] =
-                                    k + i * dim_dofs_2d +
-                                    (j + node_dofs_1d) * dim_dofs_1d +
-                                    (node_dofs_1d + nodes) * (dk + di * dim_dofs_2d);
-                        offset += node_dofs_2d;
-                    }
-                    
-            // edges parallel to x
-            for (unsigned int k = 0; k < nodes; ++k)
-                for (unsigned int di = 0; di < 2; ++di)
-                    for (unsigned int dj = 0; dj < 2; ++dj)
-                    {
-                        for (unsigned int i = 0; i < node_dofs_1d; ++i)
-                            for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
-                                h2l[j + i * node_dofs_1d + offset] =
-                                    j * dim_dofs_1d + i * dim_dofs_2d + k +
-                                    node_dofs_1d +
-                                    (node_dofs_1d + nodes) *
-                                    (dj * dim_dofs_1d + di * dim_dofs_2d);
-                        offset += node_dofs_2d;
-                    }
-                    
-            // Assign DOFs on faces
-            // faces normal to x
-            for (unsigned int i = 0; i < nodes; ++i)
-                for (unsigned int j = 0; j < nodes; ++j)
-                    for (unsigned int dk = 0; dk < 2; ++dk)
-                    {
-                        for (unsigned int k = 0; k < node_dofs_1d; ++k, ++count)
-                            h2l[k + offset] = k + (j + node_dofs_1d) * dim_dofs_1d +
-                                (i + node_dofs_1d) * dim_dofs_2d +
-                                (node_dofs_1d + nodes) * dk;
-                        offset += node_dofs_1d;
-                    }
-                    
-            // faces normal to y
-            for (unsigned int i = 0; i < nodes; ++i)
-                for (unsigned int k = 0; k < nodes; ++k)
-                    for (unsigned int dj = 0; dj < 2; ++dj)
-                    {
-                        for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
-                            h2l[j + offset] =
-                                j * dim_dofs_1d + k + node_dofs_1d +
-                                (i + node_dofs_1d) * dim_dofs_2d +
-                                (node_dofs_1d + nodes) * dj * dim_dofs_1d;
-                        offset += node_dofs_1d;
-                    }
-                    
-            // faces normal to z
-            for (unsigned int j = 0; j < nodes; ++j)
-                for (unsigned int k = 0; k < nodes; ++k)
-                    for (unsigned int di = 0; di < 2; ++di)
-                    {
-                        for (unsigned int i = 0; i < node_dofs_1d; ++i, ++count)
-                            h2l[i + offset] =
-                                i * dim_dofs_2d + k + node_dofs_1d +
-                                (j + node_dofs_1d) * dim_dofs_1d +
-                                (node_dofs_1d + nodes) * di * dim_dofs_2d;
-                        offset += node_dofs_1d;
-                    }
-                    
-            // Assign DOFs in cell
-            for (unsigned int i = 0; i < nodes; ++i)
-                for (unsigned int j = 0; j < nodes; ++j)
-                    for (unsigned int k = 0; k < nodes; ++k, ++count)
-                        h2l[k + (j + i * nodes) * nodes + offset] =
-                            k + node_dofs_1d + (j + node_dofs_1d) * dim_dofs_1d +
-                            (i + node_dofs_1d) * dim_dofs_2d;
-        }
-        
-        AssertDimension(count, dim_dofs_1d * dim_dofs_2d);
-  }
-          
-          
-  template <>
-  void
-  hermite_hierarchic_to_lexicographic_numbering<4>(const unsigned int regularity,
-                                                   const unsigned int nodes,
-                                                   std::vector<unsigned int> &h2l)
-  {
-        const unsigned int node_dofs_1d = regularity + 1;
-        const unsigned int node_dofs_2d = node_dofs_1d * node_dofs_1d;
-        const unsigned int node_dofs_3d = node_dofs_2d * node_dofs_1d;
-      
-        const unsigned int dim_dofs_1d  = 2 * node_dofs_1d + nodes;
-        const unsigned int dim_dofs_2d  = dim_dofs_1d * dim_dofs_1d;
-        const unsigned int dim_dofs_3d  = dim_dofs_2d * dim_dofs_1d;
-    
-        unsigned int       offset = 0, count = 0;
-    
-        AssertDimension(h2l.size(), dim_dofs_2d * dim_dofs_2d);
-
-        // Assign DOFs at nodes
-        for (unsigned int di = 0; di < 2; ++di)
-            for (unsigned int dj = 0; dj < 2; ++dj)
-                for (unsigned int dk = 0; dk < 2; ++dk)
-                    for (unsigned int dl = 0; dl < 2; ++dl)
-                    {
-                        for (unsigned int i = 0; i < node_dofs_1d; ++i)
-                            for (unsigned int j = 0; j < node_dofs_1d; ++j)
-                                for (unsigned int k = 0; k < node_dofs_1d; ++k)
-                                    for (unsigned int l = 0; l < node_dofs_1d; ++l, ++count)
-                                        h2l[l + k * node_dofs_1d + j * node_dofs_2d +
-                                            i * node_dofs_3d + offset] =
-                                                l + k * dim_dofs_1d + j * dim_dofs_2d +
-                                                i * dim_dofs_3d +
-                                                (node_dofs_1d + nodes) *
-                                                (dl + dk * dim_dofs_1d + dj * dim_dofs_2d +
-                                                di * dim_dofs_3d);
-                        offset += node_dofs_1d * node_dofs_3d;
-                    }
-                    
-        if (nodes)
-        {
-            Assert(false, ExcNotImplemented());
-            
-            // Assign DOFs on edges
-            // edges parallel to w
-            // edges parallel to z
-            // edges parallel to y
-            // edges parallel to x
-            
-            // Assign DOFs on 2D faces
-            // faces normal to xy
-            // faces normal to xz
-            // faces normal to xw
-            // faces normal to yz
-            // faces normal to yw
-            // faces normal to zw
-            
-            // Assign DOFs on 3D faces
-            // faces normal to x
-            // faces normal to y
-            // faces normal to z
-            // faces normal to w
-            
-            // Assign DOFs in cell
-        }
-
-        AssertDimension(count, dim_dofs_2d * dim_dofs_2d);
-  }
-
-  template <int dim>
-  inline std::vector<unsigned int>
-  hermite_hierarchic_to_lexicographic_numbering(
-    const unsigned int regularity,
-    const unsigned int nodes)
-  {
-    const std::vector<unsigned int> dpo =
-      get_hermite_dpo_vector(dim, regularity, nodes);
-    const dealii::FiniteElementData<dim> face_data(
-      dpo, 1, 2 * regularity + nodes + 1);
-    std::vector<unsigned int> renumbering(face_data.dofs_per_cell);
-    hermite_hierarchic_to_lexicographic_numbering<dim>(regularity,
-                                                       nodes,
-                                                       renumbering);
-    return renumbering;
-  }
-    
-  template <int dim>
-  inline std::vector<unsigned int>
-  hermite_lexicographic_to_hierarchic_numbering(
-    const unsigned int regularity,
-    const unsigned int nodes)
-  {    
-    return Utilities::invert_permutation(hermite_hierarchic_to_lexicographic_numbering<dim>(regularity,nodes));
-  }
-  
-  template <int dim>
-  inline std::vector<unsigned int>
-  hermite_face_lexicographic_to_hierarchic_numbering(
-    const unsigned int regularity,
-    const unsigned int nodes)
-  {
-    if (dim <= 1)
-      return std::vector<unsigned int>();
-    else
-      return hermite_lexicographic_to_hierarchic_numbering<dim - 1>(regularity, nodes);
-  }
-
-  template <int dim>
-  TensorProductPolynomials<dim>
-  get_hermite_polynomials(const unsigned int regularity)
-  {
-    TensorProductPolynomials<dim> poly_space(
-      Polynomials::HermiteMaxreg::generate_complete_basis(regularity));
-    std::vector<unsigned int> renumber =
-      internal::hermite_hierarchic_to_lexicographic_numbering<dim>(
-        regularity, 0);
-    poly_space.set_numbering(renumber);
-    return poly_space;
-  }
-  
-#if HERMITE_CUSTOM_FE_CLASS
-  template <int dim>
-  TensorProductPolynomials<dim>
-  get_hermite_polynomials(const unsigned int regularity, const unsigned int nodes)
-  {
-      TensorProductPolynomials<dim> poly_space(
-      Polynomials::HermiteCustomreg::generate_complete_basis(regularity, nodes));
-    std::vector<unsigned int> renumber =
-      internal::hermite_face_lexicographic_to_hierarchic_numbering<dim + 1>(
-        regularity, nodes);
-    poly_space.set_numbering(renumber);
-    return poly_space;
-  }
-#endif
-
-  inline unsigned int
-  binomial(const unsigned int n, const unsigned int i)
-  {
-    unsigned int C = 1, k = 1;
-    for (unsigned int j = n; j > i; --j)
-      {
-        C *= j;
-        C /= k++;
-      }
-    return C;
-  }
-  
-  template <int xdim, int xspacedim = xdim, typename xNumber = double>
-  class Rescaler
-  {
-  public:
-      void
-      rescale_fe_hermite_values(//Rescaler<dim, spacedim, Number> &                           rescaler,
-                                const FE_Hermite<xdim, xspacedim> &                           fe_herm,
-                                const typename MappingHermite<xdim, xspacedim>::InternalData &mapping_data,
-                                Table<2, xNumber> &                                          value_list);
-  
-      //TODO: Adapt these functions to work with DOFs assigned on edges, faces etc
-      template <int spacedim, typename Number>
-      void 
-      rescale_fe_hermite_values(Rescaler<1, spacedim, Number> &                           /*rescaler*/,
-                                const FE_Hermite<1, spacedim> &                           fe_herm,
-                                const typename MappingHermite<1, spacedim>::InternalData &mapping_data,
-                                Table<2, Number> &                                        value_list)
-      {
-          const unsigned int dofs = fe_herm.n_dofs_per_cell();
-          (void)dofs;
-          
-          AssertDimension(value_list.size(0), dofs);
-          
-          const unsigned int regularity = fe_herm.get_regularity();
-          const unsigned int nodes = 0;//fe_herm.n_nodes();
-          
-          AssertDimension(dofs, 2 * regularity + nodes + 2);
-          
-          const unsigned int q_points = value_list.size(1);
-          AssertIndexRange(q_points, mapping_data.quadrature_points.size() + 1);
-        
-          std::vector<unsigned int> l2h = hermite_lexicographic_to_hierarchic_numbering<1>(regularity, nodes);
-          
-          for (unsigned int q = 0; q < q_points; ++q)
-          {
-              double factor_1 = 1.0;
-            
-              for (unsigned int d1 = 0, d2 = regularity + nodes + 1; d2 < dofs; ++d1, ++d2)
-              {
-                  value_list(l2h[d1], q) *= factor_1;
-                  value_list(l2h[d2], q) *= factor_1; // This appears to be rescaled less than the above entries, by a factor of about factor_1
-                                                                 //  
-                  factor_1 *= mapping_data.cell_extents[0];     //   This seems to be reading the correct value for the cells, and calculating factor_1 correctly    
-              }
-          }
-      }
-      
-      template <int spacedim, typename Number>
-      void 
-      rescale_fe_hermite_values(Rescaler<2, spacedim, Number> &                           /*rescaler*/,
-                                const FE_Hermite<2, spacedim> &                           fe_herm,
-                                const typename MappingHermite<2, spacedim>::InternalData &mapping_data,
-                                Table<2, Number> &                                        value_list)
-      {
-          const unsigned int dofs = fe_herm.n_dofs_per_cell();
-          (void)dofs;
-          
-          AssertDimension(value_list.size(0), dofs);
-          
-          const unsigned int regularity = fe_herm.get_regularity();
-          const unsigned int nodes = 0;//fe_herm.n_nodes();
-          const unsigned int dofs_per_dim = 2 * regularity + nodes + 2;
-          
-          AssertDimension(dofs_per_dim * dofs_per_dim, dofs);
-          
-          const unsigned int q_points = value_list.size(1);
-          AssertIndexRange(q_points, mapping_data.quadrature_points.size() + 1);
-          
-          std::vector<unsigned int> l2h = hermite_lexicographic_to_hierarchic_numbering<2>(regularity, nodes);
-      
-          AssertDimension(l2h.size(), dofs);
-          
-          //Something is going wrong below. The rescaling factors appear to be correct, but dofs running in
-          //the x-direction are not rescaled properly, causing a factor 2 jump going from x- to x+ at each 
-          //cell boundary
-          FullMatrix<double> factors(dofs_per_dim, dofs_per_dim);
-          for (unsigned int q = 0; q < q_points; ++q)
-          {
-              //double factor_2 = 1.0;
-                    
-              for (unsigned int d3 = 0, d4 = regularity + nodes + 1; d4 < dofs_per_dim; ++d3, ++d4)
-              {
-                  //double factor_1 = factor_2;
-                
-                  for (unsigned int d1 = 0, d2 = regularity + nodes + 1; d2 < dofs_per_dim; ++d1, ++d2)
-                  {
-                      double factor_1 = std::pow(mapping_data.cell_extents[0], d1) * std::pow(mapping_data.cell_extents[1], d3);
-                      factors(d1,d3) = factor_1;
-                      factors(d2,d3) = factor_1;
-                      factors(d1,d4) = factor_1;
-                      factors(d2,d4) = factor_1;
-                      
-                      value_list(l2h[d1 + d3 * dofs_per_dim], q) *= factor_1;
-                      value_list(l2h[d2 + d3 * dofs_per_dim], q) *= factor_1;
-                      value_list(l2h[d1 + d4 * dofs_per_dim], q) *= factor_1;
-                      value_list(l2h[d2 + d4 * dofs_per_dim], q) *= factor_1;
-                            
-                      //factor_1 *= mapping_data.cell_extents[0];
-                  }
-                
-                  //factor_2 *= mapping_data.cell_extents[1];
-              }
-          }
-      }
-  
-      template <int spacedim, typename Number>
-      void
-      rescale_fe_hermite_values(Rescaler<3, spacedim, Number> &                           /*rescaler*/,
-                                const FE_Hermite<3, spacedim> &                           fe_herm,
-                                const typename MappingHermite<3, spacedim>::InternalData &mapping_data,
-                                Table<2, Number> &                                        value_list)
-      {
-          const unsigned int dofs = fe_herm.n_dofs_per_cell();
-          (void)dofs;
-          
-          AssertDimension(value_list.size(0), dofs);
-          
-          const unsigned int regularity = fe_herm.get_regularity();
-          const unsigned int nodes = 0;//fe_herm.n_nodes();
-          const unsigned int dofs_per_dim = 2 * regularity + nodes + 2;
-          
-          AssertDimension(dofs_per_dim * dofs_per_dim * dofs_per_dim, dofs);
-      
-          const unsigned int q_points = value_list.size(1);
-          AssertIndexRange(q_points, mapping_data.quadrature_points.size() + 1);
-          
-          std::vector<unsigned int> l2h = hermite_lexicographic_to_hierarchic_numbering<3>(regularity, nodes);
-          
-          for (unsigned int q = 0; q < q_points; ++q)
-          {
-              double factor_3 = 1.0;
-                    
-              for (unsigned int d5 = 0, d6 = regularity + nodes + 1; d6 < dofs_per_dim; ++d5, ++d6)
-              {
-                  double factor_2 = factor_3;
-
-                  for (unsigned int d3 = 0, d4 = regularity + nodes + 1; d4 < dofs_per_dim; ++d3, ++d4)
-                  {
-                      double factor_1 = factor_2;
-                        
-                      for (unsigned int d1 = 0, d2 = regularity + nodes + 1; d2 < dofs_per_dim; ++d1, ++d2)
-                      {
-                          value_list(l2h[d1 + d3 * dofs_per_dim + d5 * dofs_per_dim * dofs_per_dim], q) 
-                            *= factor_1;
-                          value_list(l2h[d2 + d3 * dofs_per_dim + d5 * dofs_per_dim * dofs_per_dim], q) 
-                            *= factor_1;
-                          value_list(l2h[d1 + d4 * dofs_per_dim + d5 * dofs_per_dim * dofs_per_dim], q) 
-                            *= factor_1;
-                          value_list(l2h[d2 + d4 * dofs_per_dim + d5 * dofs_per_dim * dofs_per_dim], q) 
-                            *= factor_1;
-                          value_list(l2h[d1 + d3 * dofs_per_dim + d6 * dofs_per_dim * dofs_per_dim], q) 
-                            *= factor_1;
-                          value_list(l2h[d2 + d3 * dofs_per_dim + d6 * dofs_per_dim * dofs_per_dim], q) 
-                            *= factor_1;
-                          value_list(l2h[d1 + d4 * dofs_per_dim + d6 * dofs_per_dim * dofs_per_dim], q) 
-                            *= factor_1;
-                          value_list(l2h[d2 + d4 * dofs_per_dim + d6 * dofs_per_dim * dofs_per_dim], q) 
-                            *= factor_1;
-                            
-                          factor_1 *= mapping_data.cell_extents[0];
-                      }
-                    
-                      factor_2 *= mapping_data.cell_extents[1];
-                  }
-                
-                  factor_3 *= mapping_data.cell_extents[2];
-              }
-          }
-      }
-  };
-}   //namespace internal
-  
-
-/*
- * Implementation structs for providing constraint matrices for hanging nodes
- */
-template <int xdim, int xspacedim>
-struct FE_Hermite<xdim, xspacedim>::Implementation
-{
-  static void
-  create_F_matrix(std::vector<double> &F_matrix, const unsigned int regularity)
-  {
-    const unsigned int        sz = regularity + 1;
-    std::vector<double>       bhalf_matrix(sz * sz);
-    std::vector<unsigned int> bzero_inv_matrix(sz * sz);
-    F_matrix.resize(sz * sz);
-    double       big_factor = 1, local_factor;
-    unsigned int min_ij, diag_value;
-    int          sign_1 = 1, sign_2, sign_3, temp;
-    for (unsigned int i = 0; i < sz; ++i)
-      {
-        big_factor *= 2;
-        bzero_inv_matrix[i + i * sz] = 1;
-        sign_2                       = sign_1;
-        for (unsigned int j = 0; j < i; ++j)
-          {
-            sign_3 = sign_2;
-            temp   = -sign_2 * internal::binomial(sz, i - j);
-            for (unsigned int k = j + 1; k < i; ++k)
-              {
-                sign_3 = -sign_3;
-                temp -= sign_3 * internal::binomial(sz, i - k) *
-                        bzero_inv_matrix[j + k * sz];
-              }
-            bzero_inv_matrix[j + i * sz] = temp;
-            sign_2                       = -sign_2;
-          }
-        sign_1 = -sign_1;
-      }
-    sign_1     = 1;
-    diag_value = 1;
-    for (unsigned int i = 0; i < sz; ++i)
-      {
-        local_factor = big_factor;
-        for (unsigned int j = 0; j < sz; ++j)
-          {
-            F_matrix[j + i * sz] = 0;
-            bzero_inv_matrix[i + j * sz] *= diag_value;
-            min_ij = (i < j) ? i : j;
-            temp = 0, sign_2 = 1;
-            for (unsigned int k = 0; k < min_ij; ++k)
-              {
-                temp += sign_2 * internal::binomial(j, k) *
-                        internal::binomial(sz, i - k);
-                sign_2 = -sign_2;
-              }
-            bhalf_matrix[j + i * sz] = sign_1 * local_factor * temp;
-            local_factor *= 2;
-          }
-        sign_1 = -sign_1;
-        big_factor *= 0.5;
-        diag_value *= 4;
-      }
-    for (unsigned int i = 0; i < sz; ++i)
-      for (unsigned int k = 0; k < sz; ++k)
-        for (unsigned int j = 0; j < sz; ++j)
-          F_matrix[j + i * sz] +=
-            bhalf_matrix[k + i * sz] * bzero_inv_matrix[j + k * sz];
-    big_factor = 1;
-    for (unsigned int i = 0; i < sz; ++i)
-      {
-        for (unsigned int j = 0; j < sz; ++j)
-          F_matrix[j + i * sz] *= big_factor;
-        big_factor *= i + 1;
-      }
-    return;
-  }
-  
-#if HERMITE_CUSTOM_FE_CLASS
-  static void
-  create_F_matrix(std::vector<double> &      F_matrix,
-                  const unsigned int         regularity,
-                  const unsigned int         nodes)
-  {
-      Assert(false, ExcNotImplemented());
-  }
-#endif
-
-  static inline void
-  create_G_matrix(std::vector<double> &      G_matrix,
-                  const std::vector<double> &F_matrix,
-                  const unsigned int         regularity)
-  {
-    const unsigned int sz = regularity + 1;
-    Assert(F_matrix.size() == sz * sz,
-           ExcMessage(
-             "Provided F_matrix has the wrong size for the regularity."));
-    G_matrix.resize(sz * sz);
-    int          sign_1, sign_2;
-    sign_1 = 1;
-    for (unsigned int i = 0; i < sz; ++i)
-      {
-        sign_2 = sign_1;
-        for (unsigned int j = 0; j < sz; ++j)
-          {
-            G_matrix[j + i * sz] = sign_2 * F_matrix[j + i * sz];
-            sign_2               = -sign_2;
-          }
-        sign_1 = -sign_1;
-      }
-    return;
-  }
-  
-#if HERMITE_CUSTOM_FE_CLASS
-  static inline void
-  create_G_matrix(std::vector<double> &      G_matrix,
-                  const std::vector<double> &F_matrix,
-                  const unsigned int         regularity,
-                  const unsigned int         nodes)
-  {
-      Assert(false, ExcNotImplemented());
-  }
-#endif
-
-  template <int spacedim>
-  static void
-  initialise_constraints(FE_Hermite<1, spacedim> &fe_hermite)
-  {
-    const unsigned int nodes = fe_hermite.nodes;
-    if (nodes == 0)
-    {
-        const unsigned int regularity = fe_hermite.regularity;
-        const unsigned int sz = regularity + 1;
-        
-        fe_hermite.interface_constraints.TableBase<2,double>::reinit(
-            fe_hermite.interface_constraints_size());
-        
-        for (unsigned int i = 0; i < sz; ++i)
-            fe_hermite.interface_constraints(i,i) =
-                std::pow(0.5, i);
-        //implement matching of function coefficients based on cell size here
-    }
-    else
-    {
-        Assert(false, ExcNotImplemented());
-    }
-  }
-
-  template <int spacedim>
-  static void
-  initialise_constraints(FE_Hermite<2, spacedim> &fe_hermite)   //This function probably needs to be rewritten
-  {
-    const unsigned int nodes = fe_hermite.nodes;
-    if (nodes == 0)
-    {    
-        const unsigned int  regularity = fe_hermite.regularity;
-        const unsigned int  sz         = regularity + 1;
-        std::vector<double> F_matrix(sz * sz), G_matrix(sz * sz);
-
-        create_F_matrix(F_matrix, regularity);
-        create_G_matrix(G_matrix, F_matrix, regularity);
-        std::vector<unsigned int> face_index_map =
-            internal::hermite_face_lexicographic_to_hierarchic_numbering<2>(
-            regularity, 0);
-        fe_hermite.interface_constraints.TableBase<2, double>::reinit(
-            fe_hermite.interface_constraints_size());
-        for (unsigned int i = 0; i < sz; ++i)
-            for (unsigned int j = 0; j < 2 * sz; ++j)
-                fe_hermite.interface_constraints(i, face_index_map[j]) =
-                  static_cast<double>(i == j);
-        for (unsigned int i = 0; i < sz; ++i)
-            for (unsigned int j = 0; j < sz; ++j)
-            {
-                fe_hermite.interface_constraints(sz + i, face_index_map[j]) =
-                  F_matrix[j + i * sz];
-                fe_hermite.interface_constraints(sz + i, face_index_map[sz + j]) =
-                  G_matrix[j + i * sz];
-            }
-        for (unsigned int i = 0; i < sz; ++i)
-            for (unsigned int j = 0; j < sz; ++j)
-            {
-                fe_hermite.interface_constraints(2 * sz + i, face_index_map[j]) =
-                  F_matrix[j + i * sz];
-                fe_hermite.interface_constraints(2 * sz + i, face_index_map[sz + j]) =
-                  G_matrix[j + i * sz];
-            }
-        for (unsigned int i = 0; i < sz; ++i)
-            for (unsigned int j = 0; j < 2 * sz; ++j)
-                fe_hermite.interface_constraints(3 * sz + i, face_index_map[j]) =
-                  (i + sz == j) ? 1 : 0;
-    }
-    else
-    {
-        Assert(false, ExcNotImplemented());
-    }
-    return;
-  }
-
-  template <int spacedim>
-  static void
-  initialise_constraints(FE_Hermite<3, spacedim> &fe_hermite)
-  {
-      const unsigned int nodes = fe_hermite.nodes;
-      if (nodes == 0)
-      {
-        const unsigned int  regularity = fe_hermite.regularity;
-        const unsigned int  sz         = regularity + 1;
-        const unsigned int  sz2        = sz * sz;
-        std::vector<double> F_matrix(sz * sz), G_matrix(sz * sz);
-        create_F_matrix(F_matrix, regularity);
-        create_G_matrix(G_matrix, F_matrix, regularity);
-        std::vector<unsigned int> face_index_map =
-          internal::hermite_face_lexicographic_to_hierarchic_numbering<3>(
-          regularity, 0);
-        fe_hermite.interface_constraints.TableBase<2, double>::reinit(
-          fe_hermite.interface_constraints_size());
-        unsigned int local_1, local_2;
-        double       entry_1, entry_2, entry_3, entry_4, temp;
-        for (unsigned int i = 0; i < sz2; ++i)
-            for (unsigned int j = 0; j < 4 * sz * sz; ++j)
-            {
-                entry_1 = static_cast<double>(i == j);
-                fe_hermite.interface_constraints(i, face_index_map[j])    = entry_1;
-                fe_hermite.interface_constraints(i + 3 * sz2,
-                                           face_index_map[j + sz2]) = entry_1;
-                fe_hermite.interface_constraints(i + 12 * sz2,
-                                           face_index_map[j + 2 * sz2]) =
-                  entry_1;
-                fe_hermite.interface_constraints(i + 15 * sz2,
-                                           face_index_map[j + 3 * sz2]) =
-                  entry_1;
-            }
-        for (unsigned int i = 0; i < sz; ++i)
-            for (unsigned int j = 0; j < sz; ++j)
-            {
-                entry_1 = F_matrix[j + i * sz];
-                entry_2 = G_matrix[j + i * sz];
-                for (unsigned int k = 0; k < sz; ++k)
-                    for (unsigned int l = 0; l < sz; ++l)
-                    {
-                        entry_4 = static_cast<double>(k == l);
-                        entry_3 = entry_1 * entry_4;
-                        entry_4 *= entry_2;
-                        local_1 = k + i * sz + 4 * sz2;
-                        local_2 = l + j * sz;
-                        fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                          entry_3;
-                        fe_hermite.interface_constraints(
-                          local_1, face_index_map[local_2 + 2 * sz2]) = entry_4;
-                        local_1 += 3 * sz2;
-                        local_2 += sz2;
-                        fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                          entry_3;
-                        fe_hermite.interface_constraints(
-                          local_1, face_index_map[local_2 + 2 * sz2]) = entry_4;
-                        local_1 += sz2;
-                        local_2 -= sz2;
-                        fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                          entry_3;
-                        fe_hermite.interface_constraints(
-                          local_1, face_index_map[local_2 + 2 * sz2]) = entry_4;
-                        local_1 += 3 * sz2;
-                        local_2 += sz2;
-                        fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                          entry_3;
-                        fe_hermite.interface_constraints(
-                        local_1, face_index_map[local_2 + 2 * sz2]) = entry_4;
-                    }
-            entry_1 = static_cast<double>(i == j);
-            for (unsigned int k = 0; k < sz; ++k)
-                for (unsigned int l = 0; l < sz; ++l)
-                {
-                    entry_3 = entry_1 * F_matrix[l + k * sz];
-                    entry_4 = entry_1 * G_matrix[l + k * sz];
-                    local_1 = k * i * sz + sz2;
-                    local_2 = l + j * sz;
-                    fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                        entry_3;
-                    fe_hermite.interface_constraints(
-                        local_1, face_index_map[local_2 + sz2]) = entry_4;
-                    local_1 += sz2;
-                    fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                      entry_3;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + sz2]) = entry_4;
-                    local_1 += 11 * sz2;
-                    local_2 += 2 * sz2;
-                    fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                      entry_3;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + sz2]) = entry_4;
-                    local_1 += sz2;
-                    fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                      entry_3;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + sz2]) = entry_4;
-                }
-            entry_1 = F_matrix[j + i * sz];
-            entry_3 = G_matrix[j + i * sz];
-            for (unsigned int k = 0; k < sz; ++k)
-                for (unsigned int l = 0; l < sz; ++l)
-                {
-                    temp    = G_matrix[l + k * sz];
-                    entry_2 = entry_1 * temp;
-                    entry_4 = entry_3 * temp;
-                    temp    = F_matrix[l + k * sz];
-                    entry_1 *= temp;
-                    entry_3 *= temp;
-                    local_1 = k + i * sz + 5 * sz2;
-                    local_2 = l + j * sz;
-                    fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                      entry_1;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + sz2]) = entry_2;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + 2 * sz2]) = entry_3;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + 3 * sz2]) = entry_4;
-                    local_1 += sz2;
-                    fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                      entry_1;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + sz2]) = entry_2;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + 2 * sz2]) = entry_3;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + 3 * sz2]) = entry_4;
-                    local_1 += 3 * sz2;
-                    fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                      entry_1;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + sz2]) = entry_2;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + 2 * sz2]) = entry_3;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + 3 * sz2]) = entry_4;
-                    local_1 += sz2;
-                    fe_hermite.interface_constraints(local_1,
-                                                 face_index_map[local_2]) =
-                      entry_1;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + sz2]) = entry_2;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + 2 * sz2]) = entry_3;
-                    fe_hermite.interface_constraints(
-                      local_1, face_index_map[local_2 + 3 * sz2]) = entry_4;
-                }
-            }
-        }
-        else
-        {
-            Assert(false, ExcNotImplemented());
-        }
-    return;
-  }
-};
-
-
-/*
- * Member functions for the Hermite class
- */
-//Constructors
-template <int dim, int spacedim>
-FE_Hermite<dim, spacedim>::FE_Hermite(const unsigned int reg)
-  : FE_Poly<dim, spacedim>(
-      internal::get_hermite_polynomials<dim>(reg),
-      FiniteElementData<dim>(internal::get_hermite_dpo_vector(dim, reg, 0),
-                             1,
-                             2 * reg + 1,
-                             (reg ? FiniteElementData<dim>::H2 :
-                                    FiniteElementData<dim>::H1)),
-      std::vector<bool>(Utilities::pow(2 * (reg + 1), dim), false),
-      std::vector<ComponentMask>(Utilities::pow(2 * (reg + 1), dim),
-                                 std::vector<bool>(1, true)))
-  , regularity(reg), nodes(0)
-{
-   /* std::vector<unsigned int> renumber =
-    internal::hermite_face_lexicographic_to_hierarchic_numbering<dim + 1>(
-      regularity, 0);
-    this->poly_space.set_numbering(renumber);*/
-}
-
-#if HERMITE_CUSTOM_FE_CLASS
-template <int dim, int spacedim>
-FE_Hermite<dim, spacedim>::FE_Hermite(const unsigned int reg, const unsigned int nodes)
-  : FE_Poly<dim, spacedim>(
-      internal::get_hermite_polynomials<dim>(reg, nodes),
-      FiniteElementData<dim>(internal::get_hermite_dpo_vector(dim, reg, nodes),
-                             1,
-                             nodes + 2 * reg + 1,
-                             (reg ? FiniteElementData<dim>::H2 :
-                                    FiniteElementData<dim>::H1)),
-      std::vector<bool>(Utilities::pow(nodes + 2 * reg + 2, dim), false),
-      std::vector<ComponentMask>(Utilities::pow(nodes + 2 * reg + 2, dim),
-                                 std::vector<bool>(1, true)))
-  , regularity(reg), nodes(nodes)
-{
-   /* std::vector<unsigned int> renumber =
-    internal::hermite_face_lexicographic_to_hierarchic_numbering<dim + 1>(
-      regularity, nodes);
-    this->poly_space.set_numbering(renumber);*/
-}
-#endif
-
-template <int dim, int spacedim>
-void
-FE_Hermite<dim, spacedim>::initialize_constraints()
-{
-  Implementation::initialise_constraints(*this);
-  return;
-}
-
-template <int dim, int spacedim>
-std::string
-FE_Hermite<dim, spacedim>::get_name() const
-{
-  std::ostringstream name_buffer;
-  name_buffer << "FE_Hermite<" << dim << "," << spacedim << ">("
-              << this->regularity << "," << this->nodes << ")";
-  return name_buffer.str();
-}
-
-template <int dim, int spacedim>
-std::unique_ptr<FiniteElement<dim, spacedim>>
-FE_Hermite<dim, spacedim>::clone() const
-{
-  return std::make_unique<FE_Hermite<dim, spacedim>>(*this);
-}
-
-
-template <int dim, int spacedim>
-void
-FE_Hermite<dim, spacedim>::fill_fe_values(
-  const typename Triangulation<dim, spacedim>::cell_iterator &,
-  const CellSimilarity::Similarity                         cell_similarity,
-  const Quadrature<dim> &                                  /*quadrature*/,
-  const Mapping<dim, spacedim> &                           mapping,
-  const typename Mapping<dim, spacedim>::InternalDataBase &mapping_internal,
-  const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
-                                                                     spacedim>
-    &                                                            /*mapping_data*/,
-  const typename FiniteElement<dim, spacedim>::InternalDataBase &fe_internal,
-  dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
-                                                                     spacedim>
-    &output_data) const
-{
-  // convert data object to internal
-  // data for this class. fails with
-  // an exception if that is not
-  // possible
-  Assert((dynamic_cast<const typename FE_Hermite<dim,spacedim>::InternalData *>(&fe_internal) != nullptr),
-         ExcInternalError());
-  const typename FE_Hermite<dim,spacedim>::InternalData &fe_data = static_cast<const typename FE_Hermite<dim,spacedim>::InternalData &>(fe_internal);
-  
-  Assert((dynamic_cast<const typename MappingHermite<dim, spacedim>::InternalData *>(&mapping_internal) != nullptr),
-         ExcInternalError());
-  const typename MappingHermite<dim, spacedim>::InternalData &mapping_internal_herm = static_cast<const typename MappingHermite<dim, spacedim>::InternalData &>(mapping_internal);
-
-  const UpdateFlags flags(fe_data.update_each);
-
-  // transform values gradients and higher derivatives. Values need to
-  // be rescaled according the the nodal derivative they correspond to
-  if ((flags & update_values) &&
-      (cell_similarity != CellSimilarity::translation))
-  {
-      internal::Rescaler<dim, spacedim, double> shape_fix;
-      for (unsigned int i=0; i<output_data.shape_values.size(0); ++i)
-        for (unsigned int q=0; q<output_data.shape_values.size(1); ++q)
-          output_data.shape_values(i, q) = fe_data.shape_values(i, q);
-      shape_fix.rescale_fe_hermite_values(shape_fix,
-                                          *this, 
-                                          mapping_internal_herm, 
-                                          output_data.shape_values);
-  }
-  
-  if ((flags & update_gradients) &&
-      (cell_similarity != CellSimilarity::translation))
-  {
-    for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-      mapping.transform(make_array_view(fe_data.shape_gradients, k),
-                        mapping_covariant,
-                        mapping_internal,
-                        make_array_view(output_data.shape_gradients, k));
-    
-    internal::Rescaler<dim, spacedim, Tensor<1,spacedim>> grad_fix;
-    grad_fix.rescale_fe_hermite_values(grad_fix, 
-                                       *this, 
-                                       mapping_internal_herm, 
-                                       output_data.shape_gradients);
-  }
-
-  if ((flags & update_hessians) &&
-      (cell_similarity != CellSimilarity::translation))
-    {
-      for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-        mapping.transform(make_array_view(fe_data.shape_hessians, k),
-                          mapping_covariant_gradient,
-                          mapping_internal,
-                          make_array_view(output_data.shape_hessians, k));
-  
-      internal::Rescaler<dim, spacedim, Tensor<2,spacedim>> hessian_fix;
-      hessian_fix.rescale_fe_hermite_values(hessian_fix, 
-                                            *this, 
-                                            mapping_internal_herm, 
-                                            output_data.shape_hessians);
-    }
-
-  if ((flags & update_3rd_derivatives) &&
-      (cell_similarity != CellSimilarity::translation))
-    {
-      for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
-                          mapping_covariant_hessian,
-                          mapping_internal,
-                          make_array_view(output_data.shape_3rd_derivatives,
-                                          k));
-  
-      internal::Rescaler<dim, spacedim, Tensor<3,spacedim>> third_dev_fix;
-      third_dev_fix.rescale_fe_hermite_values(third_dev_fix, 
-                                              *this, 
-                                              mapping_internal_herm, 
-                                              output_data.shape_3rd_derivatives);
-    }
-}
-//TODO: Create a fill_fe_face_values function for Hermite elements
-template <int dim, int spacedim>
-void
-FE_Hermite<dim, spacedim>::fill_fe_face_values(
-  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
-  const unsigned int                                          face_no,
-  const hp::QCollection<dim - 1> &                                 quadrature,
-  const Mapping<dim, spacedim> &                              mapping,
-  const typename Mapping<dim, spacedim>::InternalDataBase &   mapping_internal,
-  const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
-                                                                     spacedim>
-    &                                                            ,
-  const typename FiniteElement<dim, spacedim>::InternalDataBase &fe_internal,
-  dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
-                                                                     spacedim>
-    &output_data) const
-{
-  // convert data object to internal
-  // data for this class. fails with
-  // an exception if that is not
-  // possible
-  Assert((dynamic_cast<const typename FE_Hermite<dim,spacedim>::InternalData *>(&fe_internal) != nullptr), ExcInternalError());
-  const typename FE_Hermite<dim,spacedim>::InternalData &fe_data = static_cast<const typename FE_Hermite<dim,spacedim>::InternalData &>(fe_internal);
-  Assert((dynamic_cast<const typename MappingHermite<dim, spacedim>::InternalData *>(&mapping_internal) != nullptr), ExcInternalError());
-  const typename MappingHermite<dim, spacedim>::InternalData &mapping_internal_herm = static_cast<const typename MappingHermite<dim, spacedim>::InternalData &>(mapping_internal);
-  AssertDimension(quadrature.size(), 1U);
-
-  // offset determines which data set
-  // to take (all data sets for all
-  // faces are stored contiguously)
-
-  const typename QProjector<dim>::DataSetDescriptor offset =
-    QProjector<dim>::DataSetDescriptor::face(face_no,
-                                             cell->face_orientation(face_no),
-                                             cell->face_flip(face_no),
-                                             cell->face_rotation(face_no),
-                                             quadrature[0].size());
-
-  const UpdateFlags flags(fe_data.update_each);
-
-  // transform gradients and higher derivatives. we also have to copy
-  // the values (unlike in the case of fill_fe_values()) since
-  // we need to take into account the offsets
-  if (flags & update_values)
-  {
-    for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      for (unsigned int i = 0; i < quadrature[0].size(); ++i)
-        output_data.shape_values(k, i) = fe_data.shape_values[k][i + offset];
-      
-    internal::Rescaler<dim, spacedim, double> shape_face_fix;
-    shape_face_fix.rescale_fe_hermite_values(shape_face_fix,
-                                             *this, 
-                                             mapping_internal_herm, 
-                                             output_data.shape_values);
-  }
-
-  if (flags & update_gradients)
-  {
-    for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-      mapping.transform(
-        make_array_view(fe_data.shape_gradients, k, offset, quadrature[0].size()),
-        mapping_covariant,
-        mapping_internal,
-        make_array_view(output_data.shape_gradients, k));
-    
-    internal::Rescaler<dim, spacedim, Tensor<1,spacedim>> grad_face_fix;
-    grad_face_fix.rescale_fe_hermite_values(grad_face_fix,
-                                            *this, 
-                                            mapping_internal_herm, 
-                                            output_data.shape_gradients);
-  }
-
-  if (flags & update_hessians)
-    {
-      for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(
-          make_array_view(fe_data.shape_hessians, k, offset, quadrature[0].size()),
-          mapping_covariant_gradient,
-          mapping_internal,
-          make_array_view(output_data.shape_hessians, k));
-
-      internal::Rescaler<dim, spacedim, Tensor<2,spacedim>> hessian_face_fix;
-      hessian_face_fix.rescale_fe_hermite_values(hessian_face_fix,
-                                                 *this, 
-                                                 mapping_internal_herm, 
-                                                 output_data.shape_hessians);
-    }
-
-  if (flags & update_3rd_derivatives)
-    {
-      for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
-        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives,
-                                          k,
-                                          offset,
-                                          quadrature[0].size()),
-                          mapping_covariant_hessian,
-                          mapping_internal,
-                          make_array_view(output_data.shape_3rd_derivatives,
-                                          k));
-
-      internal::Rescaler<dim, spacedim, Tensor<3,spacedim>> shape_3rd_face_fix;
-      shape_3rd_face_fix.rescale_fe_hermite_values(shape_3rd_face_fix,
-                                                   *this, 
-                                                   mapping_internal_herm, 
-                                                   output_data.shape_3rd_derivatives);
-    }
-}
-
-
-//TODO: Implement partial grid refinement (ie hanging nodes)
-/*
-template <int dim, int spacedim>
-void FE_Hermite<dim, spacedim>::get_interpolation_matrix(const
-FiniteElement<dim, spacedim> &source, FullMatrix<double> &matrix) const
-{
-    const unsigned int dofs = this->dofs_per_cell;
-    const unsigned int source_dofs = source.dofs_per_cell;
-    Assert( matrix.m() == dofs, ExcDimensionMismatch(interpolation_matrix.m(),
-dofs)); Assert( matrix.n() == source_dofs,
-ExcDimensionMismatch(interpolation_matrix.n(), source_dofs));
-        // Evaluation must be performed by projection
-
-}
-*/
-
-namespace VectorTools
-{
-    // internal namespace for implement Hermite boundary projection methods
-    namespace internal
-    {
-        template <int dim, int spacedim = dim, typename Number = double>
-        void
-        get_constrained_hermite_boundary_dofs(const DoFHandler<dim, spacedim> &                                      dof_handler,
-                                              const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                                              const unsigned int                                                     position,
-                                              std::vector<types::global_dof_index> &                                 dof_to_boundary,
-                                              types::global_dof_index &                                              no_constrained_dofs)
-        {
-            AssertDimension(dof_handler.n_dofs(), dof_to_boundary.size());
-            std::fill_n(dof_to_boundary.begin(), dof_handler.n_dofs(), numbers::invalid_dof_index);
-            
-            //Create a look-up table for finding constrained dofs on all 4 or six faces of reference cell
-            //TODO: Rewrite so it doesn't assume dim <= 3
-            const unsigned int degree = dof_handler.get_fe().degree;
-            const unsigned int regularity = ((dim == 2) ? 
-                                             std::sqrt(dof_handler.get_fe().n_dofs_per_vertex()) : 
-                                             std::cbrt(dof_handler.get_fe().n_dofs_per_vertex()) ) - 1;
-            const unsigned int dofs_per_face = dof_handler.get_fe().n_dofs_per_face();
-            const unsigned int constrained_dofs_per_face = dofs_per_face / (regularity + 1);
-            
-            AssertDimension(dofs_per_face, (regularity + 1) * std::pow(degree + 1, dim - 1));
-            
-            std::vector<types::global_dof_index> dofs_on_face(dofs_per_face);
-            Table<2, double> constrained_to_local_indices(2 * dim, constrained_dofs_per_face);
-            
-            //Use knowledge of the local degree numbering for this version, saving expensive calls to reinit
-            const std::vector<unsigned int> l2h = dealii::internal::hermite_lexicographic_to_hierarchic_numbering<dim>(regularity, degree - 2*regularity - 1);
-            const auto test_cell = dof_handler.begin();
-
-            for (unsigned int d = 0, batch_size = 1; d < dim; ++d, batch_size *= degree+1)
-                for (unsigned int i = 0; i < constrained_dofs_per_face; ++i)
-                {
-                    const unsigned int local_index = i % batch_size;
-                    const unsigned int batch_index = i / batch_size;
-                    
-                    unsigned int index = local_index + (batch_index * (regularity + 1) + position) * batch_size;
-                    Assert(index < dofs_per_face, ExcDimensionMismatch(index, dofs_per_face));
-                
-                    test_cell->face(2*d)->get_dof_indices(dofs_on_face, test_cell->active_fe_index());
-                    constrained_to_local_indices(2*d, i) = l2h[index];//dofs_on_face[index];
-                
-                    test_cell->face(2*d + 1)->get_dof_indices(dofs_on_face, test_cell->active_fe_index());
-                    constrained_to_local_indices(2*d + 1,i) = l2h[index];//dofs_on_face[index];
-                }
-
-            std::set<types::boundary_id> selected_boundary_components;
-            for (auto i = boundary_functions.cbegin(); i != boundary_functions.cend(); ++i)
-                selected_boundary_components.insert(i->first);
-            
-            Assert(selected_boundary_components.find(numbers::internal_face_boundary_id) ==
-                    selected_boundary_components.end(), DoFTools::ExcInvalidBoundaryIndicator());
-            
-            no_constrained_dofs = 0;
-            
-            for (const auto &cell : dof_handler.active_cell_iterators())
-                for (const unsigned int f : cell->face_indices())
-                {
-                    AssertDimension(cell->get_fe().n_dofs_per_face(f), dofs_on_face.size());
-                    
-                    //Check if face is on selected boundary section
-                    if (selected_boundary_components.find(cell->face(f)->boundary_id()) !=
-                        selected_boundary_components.end())
-                    {
-                        cell->face(f)->get_dof_indices(dofs_on_face, cell->active_fe_index());
-                        
-                        for (unsigned int i = 0; i < constrained_dofs_per_face; ++i)
-                        {
-                            const types::global_dof_index index = dofs_on_face[constrained_to_local_indices(f, i)];
-                            Assert(index < dof_to_boundary.size(), ExcDimensionMismatch(index, dof_to_boundary.size()));
-                            
-                            if (dof_to_boundary[index] == numbers::invalid_dof_index)
-                                dof_to_boundary[index] = no_constrained_dofs++;
-                        }
-                    }
-                }
-            
-            Assert((no_constrained_dofs != dof_handler.n_boundary_dofs(boundary_functions)) || (regularity == 0),
-                   ExcInternalError());
-        }
-                                
-        
-        template <int dim, int spacedim = dim, typename Number = double>
-        void
-        do_hermite_direct_projection(const MappingHermite<dim, spacedim> &                             mapping_h,
-                                const DoFHandler<dim, spacedim> &                                      dof_handler,
-                                const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                                const Quadrature<dim - 1> &                                            quadrature,
-                                const unsigned int                                                     position,
-                                std::map<types::global_dof_index, Number> &                            boundary_values,
-                                std::vector<unsigned int>                                              component_mapping = {})
-        {
-            //Return immediately if no constraint functions are provided
-            if (boundary_functions.size() == 0) return;
-            
-            //For dim=1, the problem simplifies to interpolation at the boundaries
-            if (dim == 1)
-            {
-                Assert(component_mapping.size() == 0, ExcNotImplemented());
-                for (const auto &cell : dof_handler.active_cell_iterators())
-                {
-                    for (const unsigned int direction : GeometryInfo<dim>::face_indices())
-                    {
-                        if (cell->at_boundary(direction) &&
-                            boundary_functions.find(cell->face(direction)->boundary_id()) != boundary_functions.end())
-                        {
-                            const Function<spacedim, Number> & current_function =
-                                *boundary_functions.find(cell->face(direction)->boundary_id())->second;
-                                
-                            const FiniteElement<dim, spacedim> &fe_herm = dof_handler.get_fe();
-                            AssertDimension(fe_herm.n_components(), current_function.n_components);
-                            
-                            Vector<Number> boundary_value(fe_herm.n_components());
-                            if (boundary_value.size() == 1)
-                                boundary_value(0) = current_function.value(cell->vertex(direction));
-                            else
-                                current_function.vector_value(cell->vertex(direction), boundary_value);
-                            
-                            boundary_values[cell->vertex_dof_index(direction, position, cell->active_fe_index())] =
-                                boundary_value(fe_herm.face_system_to_component_index(position).first);
-                        }
-                    }
-                }
-                return;
-            }
-            
-            //dim=2 or higher, needs actual projection
-            if (component_mapping.size() == 0)
-            {
-                AssertDimension(dof_handler.get_fe().n_components(), boundary_functions.begin()->second->n_components);
-                component_mapping.resize(dof_handler.get_fe().n_components());
-                for (unsigned int i = 0; i < component_mapping.size(); ++i)
-                    component_mapping[i] = i;
-            }
-            else AssertDimension(component_mapping.size(), dof_handler.get_fe().n_components());
-            
-            std::vector<types::global_dof_index> dof_to_boundary_mapping(dof_handler.n_dofs(), numbers::invalid_dof_index);
-            types::global_dof_index next_boundary_index;
-            
-            get_constrained_hermite_boundary_dofs(dof_handler, boundary_functions, position, dof_to_boundary_mapping, next_boundary_index);
-            
-            SparsityPattern sparsity;
-            {
-                DynamicSparsityPattern dsp(next_boundary_index, next_boundary_index);
-                DoFTools::make_boundary_sparsity_pattern(dof_handler,
-                                                         boundary_functions,
-                                                         dof_to_boundary_mapping,
-                                                         dsp);
-            
-                sparsity.copy_from(dsp);
-            }
-            
-            //Assert mesh is not partially refined
-            //TODO: Add functionality on partially refined meshes
-            int level = -1;
-            for (const auto &cell : dof_handler.active_cell_iterators())
-                for (auto f : cell->face_indices())
-                {
-                    if (cell->at_boundary(f))
-                    {
-                        if (level == -1) level = cell->level();
-                        else Assert(level == cell->level(),
-                                    ExcMessage("The mesh you use in projecting boundary values "
-                                               "has hanging nodes at the boundary. This would require "
-                                               "dealing with hanging node constraints when solving "
-                                               "the linear system on the boundary, but this is not "
-                                               "currently implemented."));
-                    }
-                }
-            
-            // make mass matrix and right hand side
-            SparseMatrix<Number> mass_matrix(sparsity);
-            Vector<Number>       rhs(sparsity.n_rows());
-            Vector<Number>       boundary_projection(rhs.size());
-            
-            MatrixCreator::create_boundary_mass_matrix(mapping_h,
-                                                       dof_handler,
-                                                       quadrature,
-                                                       mass_matrix,
-                                                       boundary_functions,
-                                                       rhs,
-                                                       dof_to_boundary_mapping,
-                                                       static_cast<const Function<spacedim, Number> *>(nullptr),
-                                                       component_mapping);
-
-      if (rhs.norm_sqr() < 1e-8)
-        boundary_projection = 0;
-      else
-        {
-          // Allow for a maximum of 5*n steps to reduce the residual by 10^-12.
-          // n steps may not be sufficient, since roundoff errors may accumulate
-          // for badly conditioned matrices
-          /*
-            ReductionControl control(5 * rhs.size(), 0., 1e-12, false, false);
-          GrowingVectorMemory<Vector<Number>> memory;
-          SolverCG<Vector<Number>>            cg(control, memory);
-
-          PreconditionSSOR<SparseMatrix<Number>> prec;
-          prec.initialize(mass_matrix, 1.2);
-
-          cg.solve(mass_matrix, boundary_projection, rhs, prec);
-          deallog << "Number of CG iterations in project boundary values: " << control.last_step() << std::endl;
-          */
-          SparseDirectUMFPACK mass_inv;
-          mass_inv.initialize(mass_matrix);
-          mass_inv.vmult(boundary_projection, rhs);
-        }
-      // fill in boundary values
-      for (unsigned int i = 0; i < dof_to_boundary_mapping.size(); ++i)
-        if (dof_to_boundary_mapping[i] != numbers::invalid_dof_index)
-          {
-            AssertIsFinite(boundary_projection(dof_to_boundary_mapping[i]));
-
-            // this dof is on one of the
-            // interesting boundary parts
-            //
-            // remember: i is the global dof
-            // number, dof_to_boundary_mapping[i]
-            // is the number on the boundary and
-            // thus in the solution vector
-            boundary_values[i] =
-              boundary_projection(dof_to_boundary_mapping[i]);
-          }
-        }
-    }   //namespace internal
-    
-    template <int dim, int spacedim, typename Number>
-    void
-    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
-                            const DoFHandler<dim, spacedim> &                                      dof_handler,
-                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                            const Quadrature<dim - 1> &                                            quadrature,
-                            const HermiteBoundaryType                                              projection_mode,
-                            std::map<types::global_dof_index, Number> &                            boundary_values,
-                            std::vector<unsigned int>                                              component_mapping)
-    {
-        //This version implements projected values directly, so it's necessary to check that this is possible
-        const bool check_mode = (projection_mode == HermiteBoundaryType::hermite_dirichlet) ||
-                                (projection_mode == HermiteBoundaryType::hermite_neumann) ||
-                                (projection_mode == HermiteBoundaryType::hermite_2nd_derivative);
-        Assert(check_mode, ExcNotImplemented());
-        (void)check_mode;
-        
-        unsigned int position = 0;
-        switch(projection_mode)
-        {
-            case HermiteBoundaryType::hermite_dirichlet:
-                position = 0;
-                break;
-            case HermiteBoundaryType::hermite_neumann:
-                Assert(dof_handler.get_fe().degree > 2, ExcDimensionMismatch(dof_handler.get_fe().degree, 3));
-                position = 1;
-                break;
-            case HermiteBoundaryType::hermite_2nd_derivative:
-                Assert(dof_handler.get_fe().degree > 4, ExcDimensionMismatch(dof_handler.get_fe().degree, 5));
-                position = 2;
-                break;
-            default:
-                Assert(false, ExcInternalError());
-        }
-        
-        internal::do_hermite_direct_projection(mapping_h, dof_handler, boundary_functions, quadrature, position, boundary_values, component_mapping);
-    }
-    
-    template <int dim, int spacedim, typename Number>
-    void
-    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
-                            const DoFHandler<dim, spacedim> &                                      dof_handler,
-                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                            const Quadrature<dim - 1> &                                            quadrature,
-                            std::map<types::global_dof_index, Number> &                            boundary_values,
-                            std::vector<unsigned int>                                              component_mapping)
-    {
-        internal::do_hermite_direct_projection(mapping_h, dof_handler, boundary_functions, quadrature, 0, boundary_values, component_mapping);
-    }
-    
-    template <int dim, int spacedim, typename Number>
-    void
-    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
-                            const DoFHandler<dim, spacedim> &                                      dof_handler,
-                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                            const Quadrature<dim - 1> &                                            quadrature,
-                            const HermiteBoundaryType                                              projection_mode,
-                            AffineConstraints<Number>                                              constraints,
-                            std::vector<unsigned int>                                              component_mapping)
-    {
-        Assert(false, ExcNotImplemented());
-    }
-    
-    template <int dim, int spacedim, typename Number>
-    void
-    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
-                            const DoFHandler<dim, spacedim> &                                      dof_handler,
-                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
-                            const Quadrature<dim - 1> &                                            quadrature,
-                            AffineConstraints<Number>                                              constraints,
-                            std::vector<unsigned int>                                              component_mapping)
-    {
-        Assert(false, ExcNotImplemented());
-    }
-    
-    template <int dim, typename VectorType, int spacedim> void
-    project(const MappingHermite<dim, spacedim> &                     mapping,
-            const DoFHandler<dim, spacedim> &                         dof,
-            const AffineConstraints<typename VectorType::value_type> &constraints,
-            const Quadrature<dim> &                                   quadrature,
-            const Function<spacedim, typename VectorType::value_type> &function,
-            VectorType &                                               vec,
-            const bool                 enforce_zero_boundary,
-            const Quadrature<dim - 1> &q_boundary,
-            const bool                 project_to_boundary_first)
-    {
-        using number = typename VectorType::value_type;
-        Assert((dynamic_cast<const FE_Hermite<dim, spacedim>*>( &dof.get_fe() ) != nullptr),
-               ExcMessage("The project function with the MappingHermite mapping class "
-                          "should only be used with a DoF handler associated with an "
-                          "FE_Hermite object with the same dim and spacedim as the mapping."));
-        Assert(dof.get_fe(0).n_components() == function.n_components,
-               ExcDimensionMismatch(dof.get_fe(0).n_components(),
-                                    function.n_components));
-        Assert(vec.size() == dof.n_dofs(),
-               ExcDimensionMismatch(vec.size(), dof.n_dofs()));
-        
-        // make up boundary values
-        std::map<types::global_dof_index, number> boundary_values;
-        const std::vector<types::boundary_id> active_boundary_ids = dof.get_triangulation().get_boundary_ids();
-        
-        if (enforce_zero_boundary)
-        {
-            std::map<types::boundary_id, const Function<spacedim, number>*> boundary;
-            for (const auto it : active_boundary_ids)
-                boundary.emplace(std::make_pair(it, nullptr));
-            
-            const std::map<types::boundary_id, const Function<spacedim, number>* > new_boundary = 
-                static_cast<const std::map<types::boundary_id, const Function<spacedim, number>*>>(boundary);
-            
-            std::vector<types::global_dof_index> dof_to_boundary(dof.n_dofs(), numbers::invalid_dof_index);
-            types::global_dof_index end_boundary_dof = 0;
-            
-            internal::get_constrained_hermite_boundary_dofs(dof, new_boundary, 0, dof_to_boundary, end_boundary_dof);
-            
-            if (end_boundary_dof != 0)            
-                for (types::global_dof_index i = 0; i < dof.n_dofs(); ++i)
-                    if (dof_to_boundary[i] != numbers::invalid_dof_index)
-                        boundary_values.emplace(std::make_pair(i, 0));
-        }
-        else if (project_to_boundary_first)
-        {
-            std::map<types::boundary_id, const Function<spacedim, number>*> boundary_function;
-            for (const auto it : active_boundary_ids)
-                boundary_function.emplace(std::make_pair(it, &function));
-            //TODO: Why is this line causing bugs when the previous one works fine?! ARGH!
-            const std::map<types::boundary_id, const Function<spacedim, number>* > new_boundary_2 =
-                static_cast<const std::map< types::boundary_id, const Function<spacedim, number>* >>(boundary_function);
-            
-            project_boundary_values<dim, spacedim, number>(mapping,
-                                                           dof,
-                                                           new_boundary_2,
-                                                           q_boundary,
-                                                           HermiteBoundaryType::hermite_dirichlet,
-                                                           boundary_values);
-        }
-        
-        // check if constraints are compatible (see below)
-        bool constraints_are_compatible = true;
-        for (const auto &value : boundary_values)
-            if (constraints.is_constrained(value.first))
-                if ((constraints.get_constraint_entries(value.first)->size() > 0) &&
-                    (constraints.get_inhomogeneity(value.first) != value.second))
-                    constraints_are_compatible = false;
-                
-        // set up mass matrix and right hand side
-        Vector<number>  vec_result(dof.n_dofs());
-        SparsityPattern sparsity;
-        
-        {
-            DynamicSparsityPattern dsp(dof.n_dofs(), dof.n_dofs());
-            DoFTools::make_sparsity_pattern(dof,
-                                            dsp,
-                                            constraints,
-                                            !constraints_are_compatible);
-
-            sparsity.copy_from(dsp);
-        }
-        
-        SparseMatrix<number> mass_matrix(sparsity);
-        Vector<number>       tmp(mass_matrix.n());
-
-        // If the constraints object does not conflict with the given boundary
-        // values (i.e., it either does not contain boundary values or it contains
-        // the same as boundary_values), we can let it call
-        // distribute_local_to_global straight away, otherwise we need to first
-        // interpolate the boundary values and then condense the matrix and vector
-        if (constraints_are_compatible)
-        {
-            const Function<spacedim, number> *dummy = nullptr;
-            MatrixCreator::create_mass_matrix(mapping,
-                                              dof,
-                                              quadrature,
-                                              mass_matrix,
-                                              function,
-                                              tmp,
-                                              dummy,
-                                              constraints);
-            
-            if (boundary_values.size() > 0)
-                MatrixTools::apply_boundary_values(boundary_values, mass_matrix, vec_result, tmp, true);
-        }
-        else
-        {
-            // create mass matrix and rhs at once, which is faster.
-            MatrixCreator::create_mass_matrix(mapping, dof, quadrature, mass_matrix, function, tmp);
-            MatrixTools::apply_boundary_values(boundary_values, mass_matrix, vec_result, tmp, true);
-            constraints.condense(mass_matrix, tmp);
-        }
-
-        // Allow for a maximum of 5*n steps to reduce the residual by 10^-12. n
-        // steps may not be sufficient, since roundoff errors may accumulate for
-        // badly conditioned matrices
-        /*
-        ReductionControl control(5 * tmp.size(), 1e-8, 1e-8, false, false);
-        GrowingVectorMemory<Vector<number>> memory;
-        SolverCG<Vector<number>>            cg(control, memory);
-
-        PreconditionSSOR<SparseMatrix<number>> prec;
-        prec.initialize(mass_matrix, 1.2);
-
-        cg.solve(mass_matrix, vec_result, tmp, prec);
-        */
-        
-        SparseDirectUMFPACK eggmans_announcement;
-        eggmans_announcement.initialize(mass_matrix);
-        eggmans_announcement.vmult(vec_result, tmp);
-        
-        constraints.distribute(vec_result);
-
-        // copy vec_result into vec. we can't use vec itself above, since
-        // it may be of another type than Vector<double> and that wouldn't
-        // necessarily go together with the matrix and other functions
-        for (unsigned int i = 0; i < vec.size(); ++i)
-            ::dealii::internal::ElementAccess<VectorType>::set(vec_result(i),
-                                                               i,
-                                                               vec);
-    }
-} //namespace VectorTools
-
-
-
-
-//Explicit instantiations
-#include "fe_hermite.inst.in"
-
-DEAL_II_NAMESPACE_CLOSE
+/**
+ * Source code for Hermite basis functions.
+ */
+
+#include <deal.II/base/template_constraints.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/work_stream.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_tools.h>
+#include <deal.II/fe/mapping_hermite.h>
+#include <deal.II/fe/fe_face.h>
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/identity_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/sparse_direct.h>
+#include <deal.II/lac/precondition.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/numerics/matrix_tools.h>
+
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace internal
+{
+  inline std::vector<unsigned int>
+  get_hermite_dpo_vector(const unsigned int dim,
+                         const unsigned int regularity,
+                         const unsigned int nodes)
+  {
+    std::vector<unsigned int> result(dim + 1);
+    unsigned int coeff1 = 1, coeff2 = Utilities::pow(regularity + 1, dim);
+    for (unsigned int i = 0; i <= dim; ++i)
+      {
+        result[i] = coeff1 * coeff2;
+        coeff1 *= nodes;
+        coeff2 /= regularity + 1;
+      }
+    return result;
+  }
+
+  /**
+   * Renumbering function. Function needs different levels of for loop nesting
+   * for different values of dim, so different definitions are used for
+   * simplicity.
+   */
+  template <int dim>
+  void
+  hermite_hierarchic_to_lexicographic_numbering(const unsigned int regularity,
+                                                const unsigned int nodes,
+                                                std::vector<unsigned int> &h2l);
+
+  template<>
+  void
+  hermite_hierarchic_to_lexicographic_numbering<1>(const unsigned int regularity,
+                                                const unsigned int nodes,
+                                                std::vector<unsigned int> &h2l)
+  {
+        const unsigned int node_dofs_1d = regularity + 1;
+
+        AssertDimension(h2l.size(), 2 * node_dofs_1d + nodes);
+
+        unsigned int count = 0;
+        // Assign DOFs at vertices
+        for (unsigned int di = 0; di < 2; ++di)
+            for (unsigned int i = 0; i < node_dofs_1d; ++i, ++count)
+                h2l[i + di * node_dofs_1d] = i + di * (node_dofs_1d + nodes);
+
+        // Assign DOFs on line if needed
+        for (unsigned int i = 0; i < nodes; ++i, ++count)
+            h2l[i + 2 * node_dofs_1d] = i + node_dofs_1d;
+
+        AssertDimension(count, 2 * node_dofs_1d + nodes);
+  }
+
+  template<>
+  void
+  hermite_hierarchic_to_lexicographic_numbering<2>(const unsigned int regularity,
+                                                const unsigned int nodes,
+                                                std::vector<unsigned int> &h2l)
+  {
+        const unsigned int node_dofs_1d = regularity + 1;
+
+        const unsigned int dim_dofs_1d  = 2 * node_dofs_1d + nodes;
+
+        AssertDimension(h2l.size(), dim_dofs_1d * dim_dofs_1d);
+
+        unsigned int count = 0, offset = 0;
+
+        // Assign DOFs at vertices
+        for (unsigned int di = 0; di < 2; ++di)
+            for (unsigned int dj = 0; dj < 2; ++dj)
+            {
+                for (unsigned int i = 0; i < node_dofs_1d; ++i)
+                    for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
+                        h2l[j + i * node_dofs_1d + offset] =
+                            j + i * dim_dofs_1d + (dj + di * dim_dofs_1d) * (node_dofs_1d + nodes);
+                offset += node_dofs_1d * node_dofs_1d;
+            }
+
+        if (nodes)
+        {
+            // Assign DOFs on edges, all DOFs of one edge after the other
+            for (unsigned int dj = 0; dj < 2; ++dj)
+                for (unsigned int i = 0; i < nodes; ++i)
+                    for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
+                        h2l[j + (i + dj * nodes) * node_dofs_1d + offset] =
+                            j + (i + node_dofs_1d) * dim_dofs_1d + dj * (node_dofs_1d +
+                            nodes);
+            offset += 2 * nodes * node_dofs_1d;
+
+            for (unsigned int di = 0; di < 2; ++di)
+                for (unsigned int i = 0; i < nodes; ++i)
+                    for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
+                        h2l[j + (i + di * nodes) * node_dofs_1d + offset] =
+                            i + j * dim_dofs_1d + di * (node_dofs_1d + nodes) * dim_dofs_1d +
+                            node_dofs_1d;
+            offset += 2 * nodes * node_dofs_1d;
+
+            // Assign DOFs on face
+            for (unsigned int i = 0; i < nodes; ++i)
+                for (unsigned int j = 0; j < nodes; ++j, ++count)
+                    h2l[j + i * nodes + offset] =
+                        j + (i + node_dofs_1d) * dim_dofs_1d + node_dofs_1d;
+        }
+
+        AssertDimension(count, dim_dofs_1d * dim_dofs_1d);
+  }
+
+  template<>
+  void
+  hermite_hierarchic_to_lexicographic_numbering<3>(const unsigned int regularity,
+                                                const unsigned int nodes,
+                                                std::vector<unsigned int> &h2l)
+  {
+        const unsigned int node_dofs_1d = regularity + 1;
+        const unsigned int node_dofs_2d = node_dofs_1d * node_dofs_1d;
+
+        const unsigned int dim_dofs_1d  = 2 * node_dofs_1d + nodes;
+        const unsigned int dim_dofs_2d  = dim_dofs_1d * dim_dofs_1d;
+
+        AssertDimension(h2l.size(), dim_dofs_2d * dim_dofs_1d);
+
+        unsigned int offset = 0, count = 0;
+
+        // Assign DOFs at nodes
+        for (unsigned int di = 0; di < 2; ++di)
+            for (unsigned int dj = 0; dj < 2; ++dj)
+                for (unsigned int dk = 0; dk < 2; ++dk)
+                {
+                    for (unsigned int i = 0; i < node_dofs_1d; ++i)
+                        for (unsigned int j = 0; j < node_dofs_1d; ++j)
+                            for (unsigned int k = 0; k < node_dofs_1d; ++k, ++count)
+                                h2l[k + j * node_dofs_1d + i * node_dofs_2d + offset] =
+                                    k + j * dim_dofs_1d + i * dim_dofs_2d +
+                                    (node_dofs_1d + nodes) *
+                                    (dk + dj * dim_dofs_1d + di * dim_dofs_2d);
+                    offset += node_dofs_1d * node_dofs_2d;
+                }
+
+        if (nodes)
+        {
+            // Assign DOFs on edges, in the order of the lines of the
+            // reference cell: the edges parallel to y and to x in the planes
+            // z=0 and z=1, then the edges parallel to z. On each edge, the
+            // derivatives in the directions normal to it run fastest
+            const unsigned int right = node_dofs_1d + nodes;
+            for (unsigned int di = 0; di < 2; ++di)
+            {
+                // edges parallel to y
+                for (unsigned int dk = 0; dk < 2; ++dk)
+                    for (unsigned int j = 0; j < nodes; ++j)
+                        for (unsigned int i = 0; i < node_dofs_1d; ++i)
+                            for (unsigned int k = 0; k < node_dofs_1d; ++k, ++count)
+                                h2l[count] = k + right * dk +
+                                             (j + node_dofs_1d) * dim_dofs_1d +
+                                             (i + right * di) * dim_dofs_2d;
+
+                // edges parallel to x
+                for (unsigned int dj = 0; dj < 2; ++dj)
+                    for (unsigned int k = 0; k < nodes; ++k)
+                        for (unsigned int i = 0; i < node_dofs_1d; ++i)
+                            for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
+                                h2l[count] = k + node_dofs_1d +
+                                             (j + right * dj) * dim_dofs_1d +
+                                             (i + right * di) * dim_dofs_2d;
+            }
+
+            // edges parallel to z
+            for (unsigned int dj = 0; dj < 2; ++dj)
+                for (unsigned int dk = 0; dk < 2; ++dk)
+                    for (unsigned int i = 0; i < nodes; ++i)
+                        for (unsigned int j = 0; j < node_dofs_1d; ++j)
+                            for (unsigned int k = 0; k < node_dofs_1d; ++k, ++count)
+                                h2l[count] = k + right * dk +
+                                             (j + right * dj) * dim_dofs_1d +
+                                             (i + node_dofs_1d) * dim_dofs_2d;
+
+            // Assign DOFs on faces, in the order of the faces of the
+            // reference cell. On each face, the derivative in the normal
+            // direction runs fastest
+            // faces normal to x
+            for (unsigned int dk = 0; dk < 2; ++dk)
+                for (unsigned int i = 0; i < nodes; ++i)
+                    for (unsigned int j = 0; j < nodes; ++j)
+                        for (unsigned int k = 0; k < node_dofs_1d; ++k, ++count)
+                            h2l[count] = k + right * dk +
+                                         (j + node_dofs_1d) * dim_dofs_1d +
+                                         (i + node_dofs_1d) * dim_dofs_2d;
+
+            // faces normal to y
+            for (unsigned int dj = 0; dj < 2; ++dj)
+                for (unsigned int i = 0; i < nodes; ++i)
+                    for (unsigned int k = 0; k < nodes; ++k)
+                        for (unsigned int j = 0; j < node_dofs_1d; ++j, ++count)
+                            h2l[count] = k + node_dofs_1d +
+                                         (j + right * dj) * dim_dofs_1d +
+                                         (i + node_dofs_1d) * dim_dofs_2d;
+
+            // faces normal to z
+            for (unsigned int di = 0; di < 2; ++di)
+                for (unsigned int j = 0; j < nodes; ++j)
+                    for (unsigned int k = 0; k < nodes; ++k)
+                        for (unsigned int i = 0; i < node_dofs_1d; ++i, ++count)
+                            h2l[count] = k + node_dofs_1d +
+                                         (j + node_dofs_1d) * dim_dofs_1d +
+                                         (i + right * di) * dim_dofs_2d;
+
+            // Assign DOFs in cell
+            for (unsigned int i = 0; i < nodes; ++i)
+                for (unsigned int j = 0; j < nodes; ++j)
+                    for (unsigned int k = 0; k < nodes; ++k, ++count)
+                        h2l[count] = k + node_dofs_1d + (j + node_dofs_1d) * dim_dofs_1d +
+                                     (i + node_dofs_1d) * dim_dofs_2d;
+        }
+
+        AssertDimension(count, dim_dofs_1d * dim_dofs_2d);
+  }
+
+
+  template <>
+  void
+  hermite_hierarchic_to_lexicographic_numbering<4>(const unsigned int regularity,
+                                                   const unsigned int nodes,
+                                                   std::vector<unsigned int> &h2l)
+  {
+        const unsigned int node_dofs_1d = regularity + 1;
+        const unsigned int node_dofs_2d = node_dofs_1d * node_dofs_1d;
+        const unsigned int node_dofs_3d = node_dofs_2d * node_dofs_1d;
+
+        const unsigned int dim_dofs_1d  = 2 * node_dofs_1d + nodes;
+        const unsigned int dim_dofs_2d  = dim_dofs_1d * dim_dofs_1d;
+        const unsigned int dim_dofs_3d  = dim_dofs_2d * dim_dofs_1d;
+
+        unsigned int       offset = 0, count = 0;
+
+        AssertDimension(h2l.size(), dim_dofs_2d * dim_dofs_2d);
+
+        // Assign DOFs at nodes
+        for (unsigned int di = 0; di < 2; ++di)
+            for (unsigned int dj = 0; dj < 2; ++dj)
+                for (unsigned int dk = 0; dk < 2; ++dk)
+                    for (unsigned int dl = 0; dl < 2; ++dl)
+                    {
+                        for (unsigned int i = 0; i < node_dofs_1d; ++i)
+                            for (unsigned int j = 0; j < node_dofs_1d; ++j)
+                                for (unsigned int k = 0; k < node_dofs_1d; ++k)
+                                    for (unsigned int l = 0; l < node_dofs_1d; ++l, ++count)
+                                        h2l[l + k * node_dofs_1d + j * node_dofs_2d +
+                                            i * node_dofs_3d + offset] =
+                                                l + k * dim_dofs_1d + j * dim_dofs_2d +
+                                                i * dim_dofs_3d +
+                                                (node_dofs_1d + nodes) *
+                                                (dl + dk * dim_dofs_1d + dj * dim_dofs_2d +
+                                                di * dim_dofs_3d);
+                        offset += node_dofs_1d * node_dofs_3d;
+                    }
+
+        if (nodes)
+        {
+            Assert(false, ExcNotImplemented());
+
+            // Assign DOFs on edges
+            // edges parallel to w
+            // edges parallel to z
+            // edges parallel to y
+            // edges parallel to x
+
+            // Assign DOFs on 2D faces
+            // faces normal to xy
+            // faces normal to xz
+            // faces normal to xw
+            // faces normal to yz
+            // faces normal to yw
+            // faces normal to zw
+
+            // Assign DOFs on 3D faces
+            // faces normal to x
+            // faces normal to y
+            // faces normal to z
+            // faces normal to w
+
+            // Assign DOFs in cell
+        }
+
+        AssertDimension(count, dim_dofs_2d * dim_dofs_2d);
+  }
+
+  template <int dim>
+  inline std::vector<unsigned int>
+  hermite_hierarchic_to_lexicographic_numbering(
+    const unsigned int regularity,
+    const unsigned int nodes)
+  {
+    const std::vector<unsigned int> dpo =
+      get_hermite_dpo_vector(dim, regularity, nodes);
+    const dealii::FiniteElementData<dim> face_data(
+      dpo, 1, 2 * regularity + nodes + 1);
+    std::vector<unsigned int> renumbering(face_data.dofs_per_cell);
+    hermite_hierarchic_to_lexicographic_numbering<dim>(regularity,
+                                                       nodes,
+                                                       renumbering);
+    return renumbering;
+  }
+
+  template <int dim>
+  inline std::vector<unsigned int>
+  hermite_lexicographic_to_hierarchic_numbering(
+    const unsigned int regularity,
+    const unsigned int nodes)
+  {
+    return Utilities::invert_permutation(hermite_hierarchic_to_lexicographic_numbering<dim>(regularity,nodes));
+  }
+
+  template <int dim>
+  inline std::vector<unsigned int>
+  hermite_face_lexicographic_to_hierarchic_numbering(
+    const unsigned int regularity,
+    const unsigned int nodes)
+  {
+    if (dim <= 1)
+      return std::vector<unsigned int>();
+    else
+      return hermite_lexicographic_to_hierarchic_numbering<dim - 1>(regularity, nodes);
+  }
+
+  /**
+   * One-dimensional basis of FE_Hermite: the maximum regularity basis for
+   * @p nodes equal to zero, and the custom regularity basis of degree
+   * 2*regularity+1+nodes otherwise.
+   */
+  inline std::vector<Polynomials::Polynomial<double>>
+  get_hermite_polynomials_1d(const unsigned int regularity,
+                             const unsigned int nodes)
+  {
+    if (nodes == 0)
+      return Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+    else
+      return Polynomials::HermiteCustomreg::generate_complete_basis(
+        2 * regularity + 1 + nodes, regularity);
+  }
+
+  template <int dim>
+  TensorProductPolynomials<dim>
+  get_hermite_polynomials(const unsigned int regularity,
+                          const unsigned int nodes)
+  {
+    TensorProductPolynomials<dim> poly_space(
+      get_hermite_polynomials_1d(regularity, nodes));
+    std::vector<unsigned int> renumber =
+      internal::hermite_hierarchic_to_lexicographic_numbering<dim>(
+        regularity, nodes);
+    poly_space.set_numbering(renumber);
+    return poly_space;
+  }
+
+  /**
+   * Identities between the degrees of freedom of two FE_Hermite elements on
+   * an object whose degrees of freedom are the derivatives of order up to
+   * the regularity in @p n_directions directions, repeated for each of
+   * @p n_points points. The derivatives are numbered lexicographically with
+   * the first direction running fastest, followed by the point.
+   */
+  inline std::vector<std::pair<unsigned int, unsigned int>>
+  hermite_dof_identities(const unsigned int regularity,
+                         const unsigned int other_regularity,
+                         const unsigned int n_directions,
+                         const unsigned int n_points)
+  {
+    const unsigned int n_orders = std::min(regularity, other_regularity) + 1;
+    const unsigned int n_this_dofs =
+      Utilities::pow(regularity + 1, n_directions);
+    const unsigned int n_other_dofs =
+      Utilities::pow(other_regularity + 1, n_directions);
+    const unsigned int n_common_dofs = Utilities::pow(n_orders, n_directions);
+
+    std::vector<std::pair<unsigned int, unsigned int>> identities;
+    for (unsigned int point = 0; point < n_points; ++point)
+      for (unsigned int i = 0; i < n_common_dofs; ++i)
+        {
+          unsigned int this_index = 0, other_index = 0;
+          unsigned int this_stride = 1, other_stride = 1;
+          for (unsigned int d = 0, index = i; d < n_directions;
+               ++d, index /= n_orders)
+            {
+              this_index += (index % n_orders) * this_stride;
+              other_index += (index % n_orders) * other_stride;
+              this_stride *= regularity + 1;
+              other_stride *= other_regularity + 1;
+            }
+          identities.emplace_back(this_index + point * n_this_dofs,
+                                  other_index + point * n_other_dofs);
+        }
+    return identities;
+  }
+
+
+
+  /**
+   * Multiply each row of @p value_list, i.e. the values of one shape
+   * function at all quadrature points, by the corresponding entry of
+   * @p dof_rescaling.
+   */
+  template <typename Number>
+  inline void
+  apply_hermite_dof_rescaling(const std::vector<double> &dof_rescaling,
+                              Table<2, Number> &         value_list)
+  {
+    AssertDimension(value_list.size(0), dof_rescaling.size());
+
+    for (unsigned int i = 0; i < dof_rescaling.size(); ++i)
+      {
+        const double factor = dof_rescaling[i];
+        for (Number &value : make_array_view(value_list, i))
+          value *= factor;
+      }
+  }
+
+
+
+  /**
+   * Binomial coefficient as a floating point number, to avoid overflow of
+   * the intermediate factorials.
+   */
+  inline double
+  hermite_binomial(const unsigned int n, const unsigned int k)
+  {
+    if (k > n)
+      return 0.;
+    double result = 1.;
+    for (unsigned int i = 1; i <= std::min(k, n - k); ++i)
+      result = result * (n + 1 - i) / i;
+    return result;
+  }
+
+
+
+  /**
+   * Coefficients of the 1D Hermite basis of maximal regularity in the
+   * Bernstein basis $B_j(x) = \binom{n}{j} x^j (1-x)^{n-j}$ of degree
+   * $n = 2q+1$, one basis function per column in lexicographic order.
+   *
+   * The basis function of order $m$ at $x=0$ is
+   * $4^m (1-x)^{q+1} \sum_{i=m}^{q} c_i x^i$, where the coefficients $c_i$
+   * are determined by the lower triangular matrix returned by
+   * Polynomials::HermiteMaxreg::hermite_to_bernstein_matrix(). Expanding
+   * $(1-x)^{q+1} x^i$ in the Bernstein basis gives the coefficients below.
+   * The functions at $x=1$ are the mirror images $(-1)^m f_m(1-x)$, i.e.,
+   * their Bernstein coefficients are the ones at $x=0$ in reverse order.
+   */
+  inline FullMatrix<double>
+  hermite_bernstein_coefficients(const unsigned int regularity)
+  {
+    const unsigned int       degree = 2 * regularity + 1;
+    const FullMatrix<double> B =
+      Polynomials::HermiteMaxreg::hermite_to_bernstein_matrix(regularity);
+
+    FullMatrix<double>  coefficients(degree + 1, degree + 1);
+    std::vector<double> c(regularity + 1);
+    for (unsigned int m = 0; m <= regularity; ++m)
+      {
+        std::fill(c.begin(), c.end(), 0.);
+        c[m] = 1.;
+        for (unsigned int i = m + 1; i <= regularity; ++i)
+          for (unsigned int j = 0; j < i; ++j)
+            c[i] -= B(i, j) * c[j];
+
+        const double sign  = (m % 2 == 0) ? 1. : -1.;
+        const double scale = Utilities::pow(4, m);
+        for (unsigned int j = m; j <= regularity; ++j)
+          {
+            double value = 0.;
+            for (unsigned int i = m; i <= j; ++i)
+              value += c[i] * hermite_binomial(regularity - i, j - i);
+            value *= scale / hermite_binomial(degree, j);
+
+            coefficients(j, m)                            = value;
+            coefficients(degree - j, regularity + 1 + m) = sign * value;
+          }
+      }
+    return coefficients;
+  }
+
+
+
+  /**
+   * Subdivision matrix of the de Casteljau algorithm, mapping the Bernstein
+   * coefficients of a polynomial of the given @p degree on the unit interval
+   * to the ones of its restriction to the left (@p child = 0) or right
+   * (@p child = 1) half, expressed in the coordinates of that half.
+   */
+  inline FullMatrix<double>
+  bernstein_subdivision_matrix(const unsigned int degree,
+                               const unsigned int child)
+  {
+    FullMatrix<double> subdivision(degree + 1, degree + 1);
+    for (unsigned int i = 0; i <= degree; ++i)
+      if (child == 0)
+        for (unsigned int j = 0; j <= i; ++j)
+          subdivision(i, j) =
+            hermite_binomial(i, j) / Utilities::pow(2, i);
+      else
+        for (unsigned int j = i; j <= degree; ++j)
+          subdivision(i, j) = hermite_binomial(degree - i, j - i) /
+                              Utilities::pow(2, degree - i);
+    return subdivision;
+  }
+
+
+
+  /**
+   * Matrix mapping the Bernstein coefficients of a polynomial of the given
+   * @p degree to its derivatives of order up to @p regularity at $x=0$ and
+   * $x=1$, in the lexicographic order of the 1D Hermite degrees of freedom.
+   * The derivatives only involve forward (or backward) differences of the
+   * first (or last) coefficients.
+   */
+  inline FullMatrix<double>
+  bernstein_end_point_derivatives(const unsigned int degree,
+                                  const unsigned int regularity)
+  {
+    FullMatrix<double> derivatives(2 * regularity + 2, degree + 1);
+    double             factor = 1.;
+    for (unsigned int m = 0; m <= regularity; ++m)
+      {
+        for (unsigned int j = 0; j <= m; ++j)
+          {
+            const double weight =
+              factor * hermite_binomial(m, j) * ((m - j) % 2 == 0 ? 1. : -1.);
+            derivatives(m, j) = weight;
+            derivatives(regularity + 1 + m, degree - m + j) = weight;
+          }
+        factor *= degree - m;
+      }
+    return derivatives;
+  }
+
+
+
+  /**
+   * Evaluation of the shape functions of FE_Hermite with maximal regularity
+   * for a regularity known at compile time. The coefficients of the
+   * $2q+2$ polynomials of the 1D basis are copied into fixed-size arrays
+   * once, such that the Horner scheme for the values and the first three
+   * derivatives runs over loops of compile-time length. The shape functions
+   * are formed as tensor products of these 1D values, which avoids the
+   * runtime-sized loops and temporary vectors of
+   * TensorProductPolynomials::evaluate() at every quadrature point.
+   */
+  template <int dim, int regularity>
+  class HermiteKernel
+  {
+  public:
+    static constexpr unsigned int n_polynomials = 2 * regularity + 2;
+
+    HermiteKernel()
+    {
+      for (unsigned int i = 0; i < n_polynomials; ++i)
+        {
+          const std::vector<double> c =
+            Polynomials::HermiteMaxreg::hermite_poly_coeffs_maxreg(regularity,
+                                                                   i);
+          AssertDimension(c.size(), n_polynomials);
+          std::copy(c.begin(), c.end(), coefficients[i].begin());
+        }
+    }
+
+    /**
+     * Compute the values and the first three derivatives of all 1D basis
+     * polynomials at @p x.
+     */
+    void
+    evaluate_1d(
+      const double                                       x,
+      std::array<std::array<double, 4>, n_polynomials> &values) const
+    {
+      for (unsigned int i = 0; i < n_polynomials; ++i)
+        {
+          const std::array<double, n_polynomials> &c = coefficients[i];
+
+          double v0 = c[n_polynomials - 1], v1 = 0., v2 = 0., v3 = 0.;
+          for (int j = n_polynomials - 2; j >= 0; --j)
+            {
+              v3 = v3 * x + v2;
+              v2 = v2 * x + v1;
+              v1 = v1 * x + v0;
+              v0 = v0 * x + c[j];
+            }
+          values[i] = {{v0, v1, 2. * v2, 6. * v3}};
+        }
+    }
+
+    /**
+     * Fill the shape function tables of @p data selected by
+     * @p update_flags at all points of @p quadrature. The shape functions
+     * are numbered by @p numbering as in
+     * TensorProductPolynomials::get_numbering().
+     */
+    template <typename InternalData>
+    void
+    fill_shape_tables(const Quadrature<dim> &          quadrature,
+                      const std::vector<unsigned int> &numbering,
+                      const UpdateFlags                update_flags,
+                      InternalData &                   data) const
+    {
+      AssertDimension(numbering.size(), Utilities::pow(n_polynomials, dim));
+
+      std::array<std::array<std::array<double, 4>, n_polynomials>, dim>
+                                    values_1d;
+      std::array<unsigned int, dim> indices;
+
+      // product of the 1D derivatives of the given orders in each direction
+      const auto product = [&](const std::array<unsigned int, dim> &orders) {
+        double result = values_1d[0][indices[0]][orders[0]];
+        for (unsigned int d = 1; d < dim; ++d)
+          result *= values_1d[d][indices[d]][orders[d]];
+        return result;
+      };
+
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          for (unsigned int d = 0; d < dim; ++d)
+            evaluate_1d(quadrature.point(q)[d], values_1d[d]);
+
+          for (unsigned int k = 0; k < numbering.size(); ++k)
+            {
+              unsigned int index = numbering[k];
+              for (unsigned int d = 0; d < dim; ++d, index /= n_polynomials)
+                indices[d] = index % n_polynomials;
+
+              std::array<unsigned int, dim> orders{};
+              if (update_flags & update_values)
+                data.shape_values[k][q] = product(orders);
+
+              if (update_flags & update_gradients)
+                for (unsigned int e = 0; e < dim; ++e)
+                  {
+                    orders[e]                     = 1;
+                    data.shape_gradients[k][q][e] = product(orders);
+                    orders[e]                     = 0;
+                  }
+
+              if (update_flags & update_hessians)
+                for (unsigned int e1 = 0; e1 < dim; ++e1)
+                  for (unsigned int e2 = e1; e2 < dim; ++e2)
+                    {
+                      ++orders[e1];
+                      ++orders[e2];
+                      data.shape_hessians[k][q][e1][e2] = product(orders);
+                      data.shape_hessians[k][q][e2][e1] =
+                        data.shape_hessians[k][q][e1][e2];
+                      orders[e1] = orders[e2] = 0;
+                    }
+
+              if (update_flags & update_3rd_derivatives)
+                for (unsigned int e1 = 0; e1 < dim; ++e1)
+                  for (unsigned int e2 = 0; e2 < dim; ++e2)
+                    for (unsigned int e3 = 0; e3 < dim; ++e3)
+                      {
+                        ++orders[e1];
+                        ++orders[e2];
+                        ++orders[e3];
+                        data.shape_3rd_derivatives[k][q][e1][e2][e3] =
+                          product(orders);
+                        orders[e1] = orders[e2] = orders[e3] = 0;
+                      }
+            }
+        }
+    }
+
+  private:
+    std::array<std::array<double, n_polynomials>, n_polynomials> coefficients;
+  };
+
+
+
+  /**
+   * Fill the shape function tables of @p data with HermiteKernel if a
+   * specialization for @p regularity is compiled in. Return @p false
+   * otherwise, in which case the caller needs to evaluate the polynomial
+   * space.
+   */
+  template <int dim, typename InternalData>
+  bool
+  fill_hermite_shape_tables(const unsigned int               regularity,
+                            const Quadrature<dim> &          quadrature,
+                            const std::vector<unsigned int> &numbering,
+                            const UpdateFlags                update_flags,
+                            InternalData &                   data)
+  {
+    switch (regularity)
+      {
+        case 0:
+          {
+            static const HermiteKernel<dim, 0> kernel;
+            kernel.fill_shape_tables(quadrature, numbering, update_flags, data);
+            return true;
+          }
+        case 1:
+          {
+            static const HermiteKernel<dim, 1> kernel;
+            kernel.fill_shape_tables(quadrature, numbering, update_flags, data);
+            return true;
+          }
+        case 2:
+          {
+            static const HermiteKernel<dim, 2> kernel;
+            kernel.fill_shape_tables(quadrature, numbering, update_flags, data);
+            return true;
+          }
+        case 3:
+          {
+            static const HermiteKernel<dim, 3> kernel;
+            kernel.fill_shape_tables(quadrature, numbering, update_flags, data);
+            return true;
+          }
+        default:
+          return false;
+      }
+  }
+}   //namespace internal
+
+
+/*
+ * Member functions for the Hermite class
+ */
+//Constructors
+template <int dim, int spacedim>
+FE_Hermite<dim, spacedim>::FE_Hermite(const unsigned int reg)
+  : FE_Hermite<dim, spacedim>(reg, 0)
+{}
+
+
+
+template <int dim, int spacedim>
+FE_Hermite<dim, spacedim>::FE_Hermite(const unsigned int reg,
+                                      const unsigned int nodes)
+  : FE_Poly<dim, spacedim>(
+      internal::get_hermite_polynomials<dim>(reg, nodes),
+      FiniteElementData<dim>(internal::get_hermite_dpo_vector(dim, reg, nodes),
+                             1,
+                             2 * reg + 1 + nodes,
+                             (reg ? FiniteElementData<dim>::H2 :
+                                    FiniteElementData<dim>::H1)),
+      std::vector<bool>(Utilities::pow(2 * reg + 2 + nodes, dim), false),
+      std::vector<ComponentMask>(Utilities::pow(2 * reg + 2 + nodes, dim),
+                                 std::vector<bool>(1, true)))
+  , regularity(reg), nodes(nodes)
+{
+  initialize_embedding();
+  initialize_matrices_1d();
+  initialize_face_support();
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::initialize_embedding()
+{
+  if (this->nodes > 0)
+    {
+      initialize_embedding_custom();
+      return;
+    }
+
+  const unsigned int degree    = 2 * this->regularity + 1;
+  const unsigned int n_dofs_1d = degree + 1;
+
+  // Work in the Bernstein basis: the Hermite basis functions are expanded
+  // in it, the de Casteljau algorithm subdivides them onto the two halves of
+  // the interval, and the derivatives at the end points of the halves are
+  // finite differences of the subdivided coefficients
+  const FullMatrix<double> coefficients =
+    internal::hermite_bernstein_coefficients(this->regularity);
+  const FullMatrix<double> derivatives =
+    internal::bernstein_end_point_derivatives(degree, this->regularity);
+
+  // The degree of freedom of order m at an end point of an interval is the
+  // m-th derivative of the function there, divided by the m-th derivative of
+  // the basis function belonging to it. The derivatives on the children are
+  // taken in the coordinates of the parent, which gives a factor 2^m
+  FullMatrix<double> dof_values(n_dofs_1d, n_dofs_1d);
+  derivatives.mmult(dof_values, coefficients);
+  std::vector<double> normalization(n_dofs_1d);
+  for (unsigned int end = 0; end < 2; ++end)
+    for (unsigned int m = 0; m <= this->regularity; ++m)
+      {
+        const unsigned int i = end * (this->regularity + 1) + m;
+        normalization[i]     = Utilities::pow(2, m) / dof_values(i, i);
+      }
+
+  FullMatrix<double> subdivided(n_dofs_1d, n_dofs_1d);
+  for (unsigned int child = 0; child < 2; ++child)
+    {
+      internal::bernstein_subdivision_matrix(degree, child)
+        .mmult(subdivided, coefficients);
+      prolongation_1d[child].reinit(n_dofs_1d, n_dofs_1d);
+      derivatives.mmult(prolongation_1d[child], subdivided);
+      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+        for (unsigned int k = 0; k < n_dofs_1d; ++k)
+          prolongation_1d[child](i, k) *= normalization[i];
+
+      // The restriction picks the degrees of freedom at the vertex the
+      // parent shares with the child, which are the derivatives at the same
+      // point and hence identical for parent and child
+      restriction_1d[child].reinit(n_dofs_1d, n_dofs_1d);
+      for (unsigned int m = 0; m <= this->regularity; ++m)
+        {
+          const unsigned int i = child * (this->regularity + 1) + m;
+          restriction_1d[child](i, i) = 1.;
+        }
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::initialize_embedding_custom()
+{
+  const unsigned int degree       = this->degree;
+  const unsigned int n_dofs_1d    = degree + 1;
+  const unsigned int right_offset = this->regularity + this->nodes + 1;
+
+  const std::vector<Polynomials::Polynomial<double>> basis =
+    internal::get_hermite_polynomials_1d(this->regularity, this->nodes);
+  const std::vector<Point<1>> interpolation_nodes =
+    Polynomials::HermiteCustomreg::create_chebyshevgausslobatto_nodes(
+      this->nodes);
+
+  // Position and derivative order of the degree of freedom belonging to
+  // each 1D basis function: derivatives at the end points of the interval,
+  // and values at the interpolation nodes in between
+  std::vector<double>       position(n_dofs_1d);
+  std::vector<unsigned int> order(n_dofs_1d, 0);
+  for (unsigned int m = 0; m <= this->regularity; ++m)
+    {
+      position[m]                = 0.;
+      order[m]                   = m;
+      position[m + right_offset] = 1.;
+      order[m + right_offset]    = m;
+    }
+  for (unsigned int i = 0; i < this->nodes; ++i)
+    position[this->regularity + 1 + i] = interpolation_nodes[i](0);
+
+  // The degree of freedom j of a function is its derivative of order m_j
+  // at its position, divided by the one of basis function j
+  std::vector<double> derivatives(this->regularity + 1);
+  std::vector<double> normalization(n_dofs_1d);
+  for (unsigned int j = 0; j < n_dofs_1d; ++j)
+    {
+      basis[j].value(position[j], derivatives);
+      normalization[j] = 1. / derivatives[order[j]];
+    }
+
+  for (unsigned int child = 0; child < 2; ++child)
+    {
+      // The derivatives on the children are taken in the coordinates of the
+      // parent, as for the maximum regularity element
+      prolongation_1d[child].reinit(n_dofs_1d, n_dofs_1d);
+      for (unsigned int k = 0; k < n_dofs_1d; ++k)
+        for (unsigned int j = 0; j < n_dofs_1d; ++j)
+          {
+            basis[k].value(0.5 * (position[j] + child), derivatives);
+            prolongation_1d[child](j, k) =
+              derivatives[order[j]] * normalization[j];
+          }
+
+      // The restriction picks the degrees of freedom at the vertex the
+      // parent shares with the child, and evaluates the child at the
+      // interpolation nodes of the parent that lie in it. Child shape
+      // functions of derivative order m are scaled by the child size 2^-m
+      restriction_1d[child].reinit(n_dofs_1d, n_dofs_1d);
+      for (unsigned int m = 0; m <= this->regularity; ++m)
+        {
+          const unsigned int i = child * right_offset + m;
+          restriction_1d[child](i, i) = 1.;
+        }
+      for (unsigned int i = this->regularity + 1; i < right_offset; ++i)
+        if ((position[i] < 0.5) == (child == 0))
+          for (unsigned int k = 0; k < n_dofs_1d; ++k)
+            restriction_1d[child](i, k) =
+              basis[k].value(2. * position[i] - child) *
+              std::pow(0.5, order[k]) * normalization[i];
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::initialize_matrices_1d()
+{
+  const unsigned int n_dofs_1d = this->degree + 1;
+
+  const std::vector<Polynomials::Polynomial<double>> basis =
+    internal::get_hermite_polynomials_1d(this->regularity, this->nodes);
+  const QGauss<1> quadrature(n_dofs_1d);
+
+  // The products of two basis functions are polynomials of degree 2p, which
+  // Gauss quadrature with p+1 points integrates exactly
+  Table<2, double>    values(n_dofs_1d, quadrature.size());
+  Table<2, double>    gradients(n_dofs_1d, quadrature.size());
+  std::vector<double> derivatives(2);
+  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+    for (unsigned int q = 0; q < quadrature.size(); ++q)
+      {
+        basis[i].value(quadrature.point(q)[0], derivatives);
+        values(i, q)    = derivatives[0];
+        gradients(i, q) = derivatives[1];
+      }
+
+  mass_matrix_1d.reinit(n_dofs_1d, n_dofs_1d);
+  laplace_matrix_1d.reinit(n_dofs_1d, n_dofs_1d);
+  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+    for (unsigned int j = 0; j < n_dofs_1d; ++j)
+      for (unsigned int q = 0; q < quadrature.size(); ++q)
+        {
+          mass_matrix_1d(i, j) +=
+            values(i, q) * values(j, q) * quadrature.weight(q);
+          laplace_matrix_1d(i, j) +=
+            gradients(i, q) * gradients(j, q) * quadrature.weight(q);
+        }
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::initialize_face_support()
+{
+  // Of the 1D basis functions, only the one of the value at an end point is
+  // nonzero there, so a shape function has support on a face if its
+  // lexicographic index in the normal direction is the one of the value on
+  // that side
+  const unsigned int n_dofs_1d    = this->degree + 1;
+  const unsigned int right_offset = this->degree - this->regularity;
+  const std::vector<unsigned int> lexicographic =
+    this->get_poly_space_numbering();
+
+  face_support.reinit(this->n_dofs_per_cell(),
+                      GeometryInfo<dim>::faces_per_cell);
+  for (unsigned int i = 0; i < this->n_dofs_per_cell(); ++i)
+    for (const unsigned int f : GeometryInfo<dim>::face_indices())
+      {
+        const unsigned int stride = Utilities::pow(n_dofs_1d, f / 2);
+        face_support(i, f) = ((lexicographic[i] / stride) % n_dofs_1d ==
+                              ((f % 2 == 0) ? 0 : right_offset));
+      }
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::assemble_tensor_product(
+  const std::array<FullMatrix<double>, 2> &matrices_1d,
+  const unsigned int                       child,
+  const RefinementCase<dim> &              refinement_case,
+  FullMatrix<double> &                     matrix) const
+{
+  const unsigned int n_dofs_1d = this->degree + 1;
+
+  // Find the 1D matrix to use in each direction. The position of the center
+  // of the child within the parent cell tells which half of the parent the
+  // child covers in a direction, or that the cell is not refined in it, in
+  // which case the 1D matrix is the identity
+  Point<dim> center;
+  for (unsigned int d = 0; d < dim; ++d)
+    center[d] = 0.5;
+  const Point<dim> child_center =
+    GeometryInfo<dim>::child_to_cell_coordinates(center,
+                                                 child,
+                                                 refinement_case);
+  const FullMatrix<double> identity(IdentityMatrix{n_dofs_1d});
+  std::array<const FullMatrix<double> *, dim> factors;
+  for (unsigned int d = 0; d < dim; ++d)
+    if (std::abs(child_center[d] - 0.5) < 1e-12)
+      factors[d] = &identity;
+    else
+      factors[d] = &matrices_1d[child_center[d] > 0.5 ? 1 : 0];
+
+  // Expand the Kronecker product in the numbering of the shape functions
+  const std::vector<unsigned int> &hierarchic_to_lexicographic =
+    static_cast<const TensorProductPolynomials<dim> &>(*this->poly_space)
+      .get_numbering();
+  const unsigned int n_dofs = this->n_dofs_per_cell();
+  Table<2, unsigned int> lexicographic_index(n_dofs, dim);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    for (unsigned int d = 0, index = hierarchic_to_lexicographic[i]; d < dim;
+         ++d, index /= n_dofs_1d)
+      lexicographic_index(i, d) = index % n_dofs_1d;
+
+  matrix.reinit(n_dofs, n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    for (unsigned int j = 0; j < n_dofs; ++j)
+      {
+        double entry = 1.;
+        for (unsigned int d = 0; d < dim && entry != 0.; ++d)
+          entry *= (*factors[d])(lexicographic_index(i, d),
+                                 lexicographic_index(j, d));
+        matrix(i, j) = entry;
+      }
+}
+
+
+
+template <int dim, int spacedim>
+const FullMatrix<double> &
+FE_Hermite<dim, spacedim>::get_prolongation_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  AssertIndexRange(refinement_case,
+                   RefinementCase<dim>::isotropic_refinement + 1);
+  Assert(refinement_case != RefinementCase<dim>::no_refinement,
+         ExcMessage(
+           "Prolongation matrices are only available for refined cells!"));
+  AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
+
+  // initialization upon first request
+  if (this->prolongation[refinement_case - 1][child].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      // if matrix got updated while waiting for the lock
+      if (this->prolongation[refinement_case - 1][child].n() ==
+          this->n_dofs_per_cell())
+        return this->prolongation[refinement_case - 1][child];
+
+      FullMatrix<double> prolongate;
+      assemble_tensor_product(prolongation_1d,
+                              child,
+                              refinement_case,
+                              prolongate);
+
+      // swap matrices
+      prolongate.swap(const_cast<FullMatrix<double> &>(
+        this->prolongation[refinement_case - 1][child]));
+    }
+
+  // finally return the matrix
+  return this->prolongation[refinement_case - 1][child];
+}
+
+
+
+template <int dim, int spacedim>
+const FullMatrix<double> &
+FE_Hermite<dim, spacedim>::get_restriction_matrix(
+  const unsigned int         child,
+  const RefinementCase<dim> &refinement_case) const
+{
+  AssertIndexRange(refinement_case,
+                   RefinementCase<dim>::isotropic_refinement + 1);
+  Assert(refinement_case != RefinementCase<dim>::no_refinement,
+         ExcMessage(
+           "Restriction matrices are only available for refined cells!"));
+  AssertIndexRange(child, GeometryInfo<dim>::n_children(refinement_case));
+
+  // initialization upon first request
+  if (this->restriction[refinement_case - 1][child].n() == 0)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+
+      // if matrix got updated while waiting for the lock...
+      if (this->restriction[refinement_case - 1][child].n() ==
+          this->n_dofs_per_cell())
+        return this->restriction[refinement_case - 1][child];
+
+      FullMatrix<double> my_restriction;
+      assemble_tensor_product(restriction_1d,
+                              child,
+                              refinement_case,
+                              my_restriction);
+
+      // swap the just computed restriction matrix into the
+      // element of the vector stored in the base class
+      my_restriction.swap(const_cast<FullMatrix<double> &>(
+        this->restriction[refinement_case - 1][child]));
+    }
+
+  return this->restriction[refinement_case - 1][child];
+}
+
+
+
+template <int dim, int spacedim>
+const FullMatrix<double> &
+FE_Hermite<dim, spacedim>::get_prolongation_matrix_1d(
+  const unsigned int child) const
+{
+  AssertIndexRange(child, 2);
+  return prolongation_1d[child];
+}
+
+
+
+template <int dim, int spacedim>
+const FullMatrix<double> &
+FE_Hermite<dim, spacedim>::get_restriction_matrix_1d(
+  const unsigned int child) const
+{
+  AssertIndexRange(child, 2);
+  return restriction_1d[child];
+}
+
+
+
+template <int dim, int spacedim>
+const FullMatrix<double> &
+FE_Hermite<dim, spacedim>::get_mass_matrix_1d() const
+{
+  return mass_matrix_1d;
+}
+
+
+
+template <int dim, int spacedim>
+const FullMatrix<double> &
+FE_Hermite<dim, spacedim>::get_laplace_matrix_1d() const
+{
+  return laplace_matrix_1d;
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::compute_matrices_1d(
+  const double        extent,
+  FullMatrix<double> &mass_matrix,
+  FullMatrix<double> &laplace_matrix) const
+{
+  Assert(extent > 0.,
+         ExcMessage("The extent of the interval must be positive."));
+  const unsigned int n_dofs_1d    = this->degree + 1;
+  const unsigned int right_offset = this->regularity + this->nodes + 1;
+
+  // Scaling of the 1D basis functions as in compute_dof_rescaling()
+  std::vector<double> factors(n_dofs_1d, 1.);
+  double              factor = 1.;
+  for (unsigned int j = 0; j <= this->regularity; ++j)
+    {
+      factors[j]                = factor;
+      factors[j + right_offset] = factor;
+      factor *= extent;
+    }
+
+  mass_matrix.reinit(n_dofs_1d, n_dofs_1d);
+  laplace_matrix.reinit(n_dofs_1d, n_dofs_1d);
+  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+    for (unsigned int j = 0; j < n_dofs_1d; ++j)
+      {
+        const double scaling = factors[i] * factors[j];
+        mass_matrix(i, j)    = mass_matrix_1d(i, j) * scaling * extent;
+        laplace_matrix(i, j) = laplace_matrix_1d(i, j) * scaling / extent;
+      }
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::compute_dof_rescaling(
+  const Tensor<1, dim> &cell_extents,
+  std::vector<double> & dof_rescaling) const
+{
+  const unsigned int dofs_per_dim = 2 * this->regularity + this->nodes + 2;
+  const unsigned int right_offset = this->regularity + this->nodes + 1;
+
+  // Tabulate the scaling of each 1D basis function in each direction. The
+  // functions belonging to the j-th derivative at either end of the interval
+  // scale with h^j, the functions at interior nodes are not rescaled
+  Table<2, double> factors_1d(dim, dofs_per_dim);
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      for (unsigned int i = 0; i < dofs_per_dim; ++i)
+        factors_1d(d, i) = 1.;
+
+      double factor = 1.;
+      for (unsigned int j = 0; j <= this->regularity; ++j)
+        {
+          factors_1d(d, j)                = factor;
+          factors_1d(d, j + right_offset) = factor;
+          factor *= cell_extents[d];
+        }
+    }
+
+  // The scaling of each shape function is the product of the 1D factors of
+  // the tensor product it is built from
+  const std::vector<unsigned int> &hierarchic_to_lexicographic =
+    static_cast<const TensorProductPolynomials<dim> &>(*this->poly_space)
+      .get_numbering();
+  dof_rescaling.resize(this->n_dofs_per_cell());
+  for (unsigned int i = 0; i < this->n_dofs_per_cell(); ++i)
+    {
+      double       factor = 1.;
+      unsigned int index  = hierarchic_to_lexicographic[i];
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          factor *= factors_1d(d, index % dofs_per_dim);
+          index /= dofs_per_dim;
+        }
+      dof_rescaling[i] = factor;
+    }
+}
+
+template <int dim, int spacedim>
+bool
+FE_Hermite<dim, spacedim>::has_support_on_face(
+  const unsigned int shape_index,
+  const unsigned int face_index) const
+{
+  AssertIndexRange(shape_index, this->n_dofs_per_cell());
+  AssertIndexRange(face_index, GeometryInfo<dim>::faces_per_cell);
+
+  return face_support(shape_index, face_index);
+}
+
+
+
+template <int dim, int spacedim>
+std::string
+FE_Hermite<dim, spacedim>::get_name() const
+{
+  std::ostringstream name_buffer;
+  name_buffer << "FE_Hermite<" << dim << "," << spacedim << ">("
+              << this->regularity << "," << this->nodes << ")";
+  return name_buffer.str();
+}
+
+
+
+template <int dim, int spacedim>
+bool
+FE_Hermite<dim, spacedim>::hp_constraints_are_implemented() const
+{
+  return true;
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<std::pair<unsigned int, unsigned int>>
+FE_Hermite<dim, spacedim>::hp_vertex_dof_identities(
+  const FiniteElement<dim, spacedim> &fe_other) const
+{
+  if (const FE_Hermite<dim, spacedim> *fe_herm_other =
+        dynamic_cast<const FE_Hermite<dim, spacedim> *>(&fe_other))
+    return internal::hermite_dof_identities(this->regularity,
+                                            fe_herm_other->regularity,
+                                            dim,
+                                            1);
+  else if (dynamic_cast<const FE_Nothing<dim, spacedim> *>(&fe_other) !=
+           nullptr)
+    {
+      // the FE_Nothing has no degrees of freedom, so there are no
+      // equivalencies to be recorded
+      return {};
+    }
+  else
+    {
+      Assert(false, ExcNotImplemented());
+      return {};
+    }
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<std::pair<unsigned int, unsigned int>>
+FE_Hermite<dim, spacedim>::hp_line_dof_identities(
+  const FiniteElement<dim, spacedim> &fe_other) const
+{
+  if (const FE_Hermite<dim, spacedim> *fe_herm_other =
+        dynamic_cast<const FE_Hermite<dim, spacedim> *>(&fe_other))
+    {
+      // the interpolation nodes of elements with different numbers of nodes
+      // do not coincide in general
+      if (this->nodes != fe_herm_other->nodes)
+        return {};
+      return internal::hermite_dof_identities(this->regularity,
+                                              fe_herm_other->regularity,
+                                              dim - 1,
+                                              this->nodes);
+    }
+  else if (dynamic_cast<const FE_Nothing<dim, spacedim> *>(&fe_other) !=
+           nullptr)
+    return {};
+  else
+    {
+      Assert(false, ExcNotImplemented());
+      return {};
+    }
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<std::pair<unsigned int, unsigned int>>
+FE_Hermite<dim, spacedim>::hp_quad_dof_identities(
+  const FiniteElement<dim, spacedim> &fe_other,
+  const unsigned int                  face_no) const
+{
+  (void)face_no;
+  Assert(dim == 3, ExcImpossibleInDim(dim));
+
+  if (const FE_Hermite<dim, spacedim> *fe_herm_other =
+        dynamic_cast<const FE_Hermite<dim, spacedim> *>(&fe_other))
+    {
+      if (this->nodes != fe_herm_other->nodes)
+        return {};
+      return internal::hermite_dof_identities(this->regularity,
+                                              fe_herm_other->regularity,
+                                              1,
+                                              this->nodes * this->nodes);
+    }
+  else if (dynamic_cast<const FE_Nothing<dim, spacedim> *>(&fe_other) !=
+           nullptr)
+    return {};
+  else
+    {
+      Assert(false, ExcNotImplemented());
+      return {};
+    }
+}
+
+
+
+template <int dim, int spacedim>
+FiniteElementDomination::Domination
+FE_Hermite<dim, spacedim>::compare_for_domination(
+  const FiniteElement<dim, spacedim> &fe_other,
+  const unsigned int                  codim) const
+{
+  Assert(codim <= dim, ExcImpossibleInDim(dim));
+  (void)codim;
+
+  if (const FE_Hermite<dim, spacedim> *fe_herm_other =
+        dynamic_cast<const FE_Hermite<dim, spacedim> *>(&fe_other))
+    {
+      if (this->degree < fe_herm_other->degree)
+        return FiniteElementDomination::this_element_dominates;
+      else if (this->degree == fe_herm_other->degree)
+        return FiniteElementDomination::either_element_can_dominate;
+      else
+        return FiniteElementDomination::other_element_dominates;
+    }
+  else if (const FE_Nothing<dim, spacedim> *fe_nothing =
+             dynamic_cast<const FE_Nothing<dim, spacedim> *>(&fe_other))
+    {
+      if (fe_nothing->is_dominating())
+        return FiniteElementDomination::other_element_dominates;
+      else
+        // the FE_Nothing has no degrees of freedom and it is typically used
+        // in a context where we don't require any continuity along the
+        // interface
+        return FiniteElementDomination::no_requirements;
+    }
+
+  Assert(false, ExcNotImplemented());
+  return FiniteElementDomination::neither_element_dominates;
+}
+
+
+
+template <int dim, int spacedim>
+std::unique_ptr<FiniteElement<dim, spacedim>>
+FE_Hermite<dim, spacedim>::clone() const
+{
+  return std::make_unique<FE_Hermite<dim, spacedim>>(*this);
+}
+
+
+template <int dim, int spacedim>
+std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>
+FE_Hermite<dim, spacedim>::get_data(
+  const UpdateFlags update_flags,
+  const Mapping<dim, spacedim> & /*mapping*/,
+  const Quadrature<dim> &quadrature,
+  dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                     spacedim>
+    & /*output_data*/) const
+{
+  std::unique_ptr<typename FiniteElement<dim, spacedim>::InternalDataBase>
+        data_ptr   = std::make_unique<InternalData>();
+  auto &data       = dynamic_cast<InternalData &>(*data_ptr);
+  data.update_each = this->requires_update_flags(update_flags);
+
+  const unsigned int n_q_points = quadrature.size();
+  const unsigned int n_dofs     = this->n_dofs_per_cell();
+
+  std::vector<double>         values(update_flags & update_values ? n_dofs : 0);
+  std::vector<Tensor<1, dim>> grads(update_flags & update_gradients ? n_dofs :
+                                                                      0);
+  std::vector<Tensor<2, dim>> grad_grads(
+    update_flags & update_hessians ? n_dofs : 0);
+  std::vector<Tensor<3, dim>> third_derivatives(
+    update_flags & update_3rd_derivatives ? n_dofs : 0);
+  std::vector<Tensor<4, dim>>
+    fourth_derivatives; // won't be needed, so leave empty
+
+  // unlike FE_Poly, the shape values are always stored in the scratch
+  // arrays, even on cells, since they have to be rescaled according to the
+  // size of every cell we visit
+  if (update_flags & update_values)
+    data.shape_values.reinit(n_dofs, n_q_points);
+
+  if (update_flags & update_gradients)
+    data.shape_gradients.reinit(n_dofs, n_q_points);
+
+  if (update_flags & update_hessians)
+    data.shape_hessians.reinit(n_dofs, n_q_points);
+
+  if (update_flags & update_3rd_derivatives)
+    data.shape_3rd_derivatives.reinit(n_dofs, n_q_points);
+
+  // use the kernels with compile-time regularity where available and fall
+  // back to the general polynomial space otherwise
+  const bool filled_by_kernel =
+    this->nodes == 0 &&
+    (update_flags & (update_values | update_gradients | update_hessians |
+                     update_3rd_derivatives)) &&
+    internal::fill_hermite_shape_tables<dim>(
+      this->regularity,
+      quadrature,
+      static_cast<const TensorProductPolynomials<dim> &>(*this->poly_space)
+        .get_numbering(),
+      update_flags,
+      data);
+
+  if (!filled_by_kernel &&
+      (update_flags & (update_values | update_gradients | update_hessians |
+                       update_3rd_derivatives)))
+    for (unsigned int i = 0; i < n_q_points; ++i)
+      {
+        this->poly_space->evaluate(quadrature.point(i),
+                                   values,
+                                   grads,
+                                   grad_grads,
+                                   third_derivatives,
+                                   fourth_derivatives);
+
+        if (update_flags & update_values)
+          for (unsigned int k = 0; k < n_dofs; ++k)
+            data.shape_values[k][i] = values[k];
+
+        if (update_flags & update_gradients)
+          for (unsigned int k = 0; k < n_dofs; ++k)
+            data.shape_gradients[k][i] = grads[k];
+
+        if (update_flags & update_hessians)
+          for (unsigned int k = 0; k < n_dofs; ++k)
+            data.shape_hessians[k][i] = grad_grads[k];
+
+        if (update_flags & update_3rd_derivatives)
+          for (unsigned int k = 0; k < n_dofs; ++k)
+            data.shape_3rd_derivatives[k][i] = third_derivatives[k];
+      }
+
+  data.dof_rescaling.resize(n_dofs, 1.);
+  data.rescaled_jacobian     = DerivativeForm<1, dim, spacedim>();
+  data.face_data_offset      = numbers::invalid_unsigned_int;
+
+  return data_ptr;
+}
+
+
+
+template <int dim, int spacedim>
+bool
+FE_Hermite<dim, spacedim>::update_dof_rescaling(
+  const typename MappingHermite<dim, spacedim>::InternalData &mapping_data,
+  const InternalData &                                        data) const
+{
+  // only exact matches are accepted, so that reusing the factors gives
+  // bit-for-bit the same result as recomputing them. get_data() initializes
+  // the stored Jacobian to zero, which no real cell has, so the first cell
+  // is always set up. the extents alone do not suffice since the gradients
+  // also depend on the directions of the edges
+  bool same_jacobian = true;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    if (mapping_data.jacobian[d] != data.rescaled_jacobian[d])
+      same_jacobian = false;
+  if (same_jacobian)
+    return false;
+  data.rescaled_jacobian = mapping_data.jacobian;
+
+  compute_dof_rescaling(mapping_data.cell_extents, data.dof_rescaling);
+
+  return true;
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::fill_fe_values(
+  const typename Triangulation<dim, spacedim>::cell_iterator &,
+  const CellSimilarity::Similarity                         cell_similarity,
+  const Quadrature<dim> &                                  /*quadrature*/,
+  const Mapping<dim, spacedim> &                           mapping,
+  const typename Mapping<dim, spacedim>::InternalDataBase &mapping_internal,
+  const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
+                                                                     spacedim>
+    &                                                            /*mapping_data*/,
+  const typename FiniteElement<dim, spacedim>::InternalDataBase &fe_internal,
+  dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                     spacedim>
+    &output_data) const
+{
+  // convert data object to internal
+  // data for this class. fails with
+  // an exception if that is not
+  // possible
+  Assert((dynamic_cast<const typename FE_Hermite<dim,spacedim>::InternalData *>(&fe_internal) != nullptr),
+         ExcInternalError());
+  const typename FE_Hermite<dim,spacedim>::InternalData &fe_data = static_cast<const typename FE_Hermite<dim,spacedim>::InternalData &>(fe_internal);
+
+  Assert((dynamic_cast<const typename MappingHermite<dim, spacedim>::InternalData *>(&mapping_internal) != nullptr),
+         ExcInternalError());
+  const typename MappingHermite<dim, spacedim>::InternalData &mapping_internal_herm = static_cast<const typename MappingHermite<dim, spacedim>::InternalData &>(mapping_internal);
+
+  const UpdateFlags flags(fe_data.update_each);
+
+  // nothing changes for a translated cell, so all tables can be kept
+  if (cell_similarity == CellSimilarity::translation)
+    return;
+
+  // the rescaling factors only depend on the cell extents, so compute them
+  // once for all quadrature points. MappingHermite is affine, so a cell with
+  // the same Jacobian as the previous one is a translation of it even if
+  // FEValues did not detect this (e.g. because similarity detection is
+  // switched off with several threads), and the output tables are still
+  // valid
+  if (!update_dof_rescaling(mapping_internal_herm, fe_data))
+    return;
+
+  // transform values gradients and higher derivatives. Values need to
+  // be rescaled according the the nodal derivative they correspond to
+  if (flags & update_values)
+    for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
+      {
+        const double factor = fe_data.dof_rescaling[k];
+        for (unsigned int q = 0; q < output_data.shape_values.size(1); ++q)
+          output_data.shape_values(k, q) = factor * fe_data.shape_values(k, q);
+      }
+
+  if (flags & update_gradients)
+  {
+    for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
+      mapping.transform(make_array_view(fe_data.shape_gradients, k),
+                        mapping_covariant,
+                        mapping_internal,
+                        make_array_view(output_data.shape_gradients, k));
+
+    internal::apply_hermite_dof_rescaling(fe_data.dof_rescaling,
+                                          output_data.shape_gradients);
+  }
+
+  if (flags & update_hessians)
+    {
+      for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
+        mapping.transform(make_array_view(fe_data.shape_hessians, k),
+                          mapping_covariant_gradient,
+                          mapping_internal,
+                          make_array_view(output_data.shape_hessians, k));
+
+      internal::apply_hermite_dof_rescaling(fe_data.dof_rescaling,
+                                            output_data.shape_hessians);
+    }
+
+  if (flags & update_3rd_derivatives)
+    {
+      for (unsigned int k = 0; k < this->n_dofs_per_cell(); ++k)
+        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives, k),
+                          mapping_covariant_hessian,
+                          mapping_internal,
+                          make_array_view(output_data.shape_3rd_derivatives,
+                                          k));
+
+      internal::apply_hermite_dof_rescaling(fe_data.dof_rescaling,
+                                            output_data.shape_3rd_derivatives);
+    }
+}
+
+
+
+template <int dim, int spacedim>
+void
+FE_Hermite<dim, spacedim>::fill_fe_face_values(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const unsigned int                                          face_no,
+  const hp::QCollection<dim - 1> &                                 quadrature,
+  const Mapping<dim, spacedim> &                              mapping,
+  const typename Mapping<dim, spacedim>::InternalDataBase &   mapping_internal,
+  const dealii::internal::FEValuesImplementation::MappingRelatedData<dim,
+                                                                     spacedim>
+    &                                                            ,
+  const typename FiniteElement<dim, spacedim>::InternalDataBase &fe_internal,
+  dealii::internal::FEValuesImplementation::FiniteElementRelatedData<dim,
+                                                                     spacedim>
+    &output_data) const
+{
+  // convert data object to internal
+  // data for this class. fails with
+  // an exception if that is not
+  // possible
+  Assert((dynamic_cast<const typename FE_Hermite<dim,spacedim>::InternalData *>(&fe_internal) != nullptr), ExcInternalError());
+  const typename FE_Hermite<dim,spacedim>::InternalData &fe_data = static_cast<const typename FE_Hermite<dim,spacedim>::InternalData &>(fe_internal);
+  Assert((dynamic_cast<const typename MappingHermite<dim, spacedim>::InternalData *>(&mapping_internal) != nullptr), ExcInternalError());
+  const typename MappingHermite<dim, spacedim>::InternalData &mapping_internal_herm = static_cast<const typename MappingHermite<dim, spacedim>::InternalData &>(mapping_internal);
+  AssertDimension(quadrature.size(), 1U);
+
+  // offset determines which data set
+  // to take (all data sets for all
+  // faces are stored contiguously)
+
+  const typename QProjector<dim>::DataSetDescriptor offset =
+    QProjector<dim>::DataSetDescriptor::face(face_no,
+                                             cell->face_orientation(face_no),
+                                             cell->face_flip(face_no),
+                                             cell->face_rotation(face_no),
+                                             quadrature[0].size());
+
+  const UpdateFlags flags(fe_data.update_each);
+
+  // the output tables only depend on the Jacobian and on which face's
+  // data set is used, so there is nothing to do if both are the same as for
+  // the previous call
+  const bool new_extents =
+    update_dof_rescaling(mapping_internal_herm, fe_data);
+  if (!new_extents && (fe_data.face_data_offset == offset))
+    return;
+  fe_data.face_data_offset = offset;
+
+  // transform gradients and higher derivatives. we also have to copy
+  // the values (unlike in the case of fill_fe_values()) since
+  // we need to take into account the offsets
+  if (flags & update_values)
+    for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+      {
+        const double factor = fe_data.dof_rescaling[k];
+        for (unsigned int i = 0; i < quadrature[0].size(); ++i)
+          output_data.shape_values(k, i) =
+            factor * fe_data.shape_values[k][i + offset];
+      }
+
+  if (flags & update_gradients)
+  {
+    for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+      mapping.transform(
+        make_array_view(fe_data.shape_gradients, k, offset, quadrature[0].size()),
+        mapping_covariant,
+        mapping_internal,
+        make_array_view(output_data.shape_gradients, k));
+
+    internal::apply_hermite_dof_rescaling(fe_data.dof_rescaling,
+                                          output_data.shape_gradients);
+  }
+
+  if (flags & update_hessians)
+    {
+      for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+        mapping.transform(
+          make_array_view(fe_data.shape_hessians, k, offset, quadrature[0].size()),
+          mapping_covariant_gradient,
+          mapping_internal,
+          make_array_view(output_data.shape_hessians, k));
+
+      internal::apply_hermite_dof_rescaling(fe_data.dof_rescaling,
+                                            output_data.shape_hessians);
+    }
+
+  if (flags & update_3rd_derivatives)
+    {
+      for (unsigned int k = 0; k < this->dofs_per_cell; ++k)
+        mapping.transform(make_array_view(fe_data.shape_3rd_derivatives,
+                                          k,
+                                          offset,
+                                          quadrature[0].size()),
+                          mapping_covariant_hessian,
+                          mapping_internal,
+                          make_array_view(output_data.shape_3rd_derivatives,
+                                          k));
+
+      internal::apply_hermite_dof_rescaling(fe_data.dof_rescaling,
+                                            output_data.shape_3rd_derivatives);
+    }
+}
+
+
+
+template <int dim, typename Number>
+TensorProductMatrixHermite<dim, Number>::TensorProductMatrixHermite(
+  const FE_Hermite<dim> &fe,
+  const Tensor<1, dim> & cell_extents,
+  const Number           mass_factor,
+  const Number           laplace_factor)
+{
+  reinit(fe, cell_extents, mass_factor, laplace_factor);
+}
+
+
+
+template <int dim, typename Number>
+void
+TensorProductMatrixHermite<dim, Number>::reinit(
+  const FE_Hermite<dim> &fe,
+  const Tensor<1, dim> & cell_extents,
+  const Number           mass_factor,
+  const Number           laplace_factor)
+{
+  const unsigned int n_dofs_1d = fe.degree + 1;
+  is_mass_matrix               = (laplace_factor == Number());
+  Assert(!is_mass_matrix || mass_factor != Number(),
+         ExcMessage("The matrix must not be zero."));
+
+  FullMatrix<double> mass, laplace;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      fe.compute_matrices_1d(cell_extents[d], mass, laplace);
+
+      this->mass_matrix[d].reinit(n_dofs_1d, n_dofs_1d);
+      this->derivative_matrix[d].reinit(n_dofs_1d, n_dofs_1d);
+      for (unsigned int i = 0; i < n_dofs_1d; ++i)
+        for (unsigned int j = 0; j < n_dofs_1d; ++j)
+          {
+            this->mass_matrix[d](i, j) = mass(i, j);
+            this->derivative_matrix[d](i, j) =
+              mass_factor / Number(dim) * mass(i, j) +
+              laplace_factor * laplace(i, j);
+          }
+
+      if (is_mass_matrix)
+        {
+          // The inverse is the Kronecker product of the inverse 1D mass
+          // matrices, with the factor distributed over the directions
+          mass.gauss_jordan();
+          const double scaling =
+            std::pow(static_cast<double>(mass_factor), -1. / dim);
+          inverse_mass_matrix[d].reinit(n_dofs_1d, n_dofs_1d);
+          for (unsigned int i = 0; i < n_dofs_1d; ++i)
+            for (unsigned int j = 0; j < n_dofs_1d; ++j)
+              inverse_mass_matrix[d](i, j) = mass(i, j) * scaling;
+        }
+      else
+        {
+          this->eigenvectors[d].reinit(n_dofs_1d, n_dofs_1d);
+          this->eigenvalues[d].resize(n_dofs_1d);
+          internal::TensorProductMatrix::spectral_assembly<Number>(
+            &(this->mass_matrix[d](0, 0)),
+            &(this->derivative_matrix[d](0, 0)),
+            n_dofs_1d,
+            n_dofs_1d,
+            this->eigenvalues[d].begin(),
+            &(this->eigenvectors[d](0, 0)));
+        }
+    }
+}
+
+
+
+template <int dim, typename Number>
+void
+TensorProductMatrixHermite<dim, Number>::apply_inverse(
+  const ArrayView<Number> &      dst_view,
+  const ArrayView<const Number> &src_view) const
+{
+  if (!is_mass_matrix)
+    {
+      TensorProductMatrixSymmetricSumBase<dim, Number>::apply_inverse(
+        dst_view, src_view);
+      return;
+    }
+
+  AssertDimension(dst_view.size(), this->n());
+  AssertDimension(src_view.size(), this->m());
+  std::lock_guard<std::mutex> lock(this->mutex);
+  const unsigned int          n = inverse_mass_matrix[0].n_rows();
+  tmp_array.resize_fast(Utilities::fixed_power<dim>(n));
+  internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                   dim,
+                                   0,
+                                   0,
+                                   Number>
+                eval(AlignedVector<Number>(),
+         AlignedVector<Number>(),
+         AlignedVector<Number>(),
+         n,
+         n);
+  Number *      t   = tmp_array.begin();
+  const Number *src = src_view.data();
+  Number *      dst = dst_view.data();
+
+  // The 1D inverses are symmetric, so it does not matter whether the
+  // evaluator contracts over their rows or columns
+  if (dim == 1)
+    eval.template apply<0, false, false>(&inverse_mass_matrix[0](0, 0),
+                                         src,
+                                         dst);
+  else if (dim == 2)
+    {
+      eval.template apply<0, false, false>(&inverse_mass_matrix[0](0, 0),
+                                           src,
+                                           t);
+      eval.template apply<1, false, false>(&inverse_mass_matrix[1](0, 0),
+                                           t,
+                                           dst);
+    }
+  else if (dim == 3)
+    {
+      eval.template apply<0, false, false>(&inverse_mass_matrix[0](0, 0),
+                                           src,
+                                           dst);
+      eval.template apply<1, false, false>(&inverse_mass_matrix[1](0, 0),
+                                           dst,
+                                           t);
+      eval.template apply<2, false, false>(&inverse_mass_matrix[2](0, 0),
+                                           t,
+                                           dst);
+    }
+  else
+    Assert(false, ExcNotImplemented());
+}
+
+
+namespace VectorTools
+{
+    // internal namespace for implement Hermite boundary projection methods
+    namespace internal
+    {
+        /*
+         * Find the degrees of freedom with derivative order position on the
+         * parts of the boundary given by the keys of boundary_functions, and
+         * number them in the order in which they are found. The result only
+         * holds the boundary degrees of freedom, so its size does not depend
+         * on the total number of degrees of freedom. Only the boundary faces
+         * of cells that are not artificial are visited, and the cells are
+         * processed in parallel with WorkStream. The copier is called in the
+         * order of the cells, so the numbering does not depend on the number
+         * of threads.
+         */
+        template <int dim, int spacedim = dim, typename Number = double>
+        void
+        collect_constrained_hermite_boundary_dofs(const DoFHandler<dim, spacedim> &                                      dof_handler,
+                                                  const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                                                  const unsigned int                                                     position,
+                                                  std::map<types::global_dof_index, types::global_dof_index> &           dof_to_boundary)
+        {
+            dof_to_boundary.clear();
+
+            Assert(boundary_functions.find(numbers::internal_face_boundary_id) == boundary_functions.end(),
+                   DoFTools::ExcInvalidBoundaryIndicator());
+
+            const FE_Hermite<dim, spacedim> *fe_herm =
+                dynamic_cast<const FE_Hermite<dim, spacedim>*>(&dof_handler.get_fe());
+            Assert(fe_herm != nullptr, ExcInternalError());
+
+            //Create a look-up table for finding constrained dofs on all faces of the reference cell.
+            //These are the dofs on the face with derivative order position in the normal direction,
+            //which is read off the lexicographic index of the corresponding cell dof
+            const unsigned int degree = fe_herm->degree;
+            const unsigned int regularity = fe_herm->get_regularity();
+            const unsigned int dofs_per_dim = degree + 1;
+            const unsigned int right_offset = degree - regularity;
+            const unsigned int dofs_per_face = fe_herm->n_dofs_per_face();
+            const unsigned int constrained_dofs_per_face = Utilities::pow(dofs_per_dim, dim - 1);
+
+            AssertDimension(dofs_per_face, (regularity + 1) * constrained_dofs_per_face);
+
+            Table<2, unsigned int> constrained_to_local_indices(2 * dim, constrained_dofs_per_face);
+
+            //Use knowledge of the local degree numbering for this version, saving expensive calls to reinit
+            const std::vector<unsigned int> h2l = fe_herm->get_poly_space_numbering();
+
+            for (const unsigned int f : GeometryInfo<dim>::face_indices())
+            {
+                const unsigned int stride = Utilities::pow(dofs_per_dim, f / 2);
+                const unsigned int normal_index = (f % 2 == 0) ? position : right_offset + position;
+
+                unsigned int count = 0;
+                for (unsigned int i = 0; i < dofs_per_face; ++i)
+                    if ((h2l[fe_herm->face_to_cell_index(i, f)] / stride) % dofs_per_dim == normal_index)
+                        constrained_to_local_indices(f, count++) = i;
+                AssertDimension(count, constrained_dofs_per_face);
+            }
+
+            struct ScratchData
+            {
+                std::vector<types::global_dof_index> dofs_on_face;
+            };
+
+            //Hanging nodes on the selected boundary would have to be constrained in the boundary
+            //mass matrix, which is not implemented. They only occur in 3D, on the lines of boundary
+            //faces that are refined from the neighboring cell along the boundary
+            if (dim == 3)
+                for (const auto &cell : dof_handler.active_cell_iterators())
+                    if (!cell->is_artificial() && cell->at_boundary())
+                        for (const unsigned int f : cell->face_indices())
+                            if (cell->face(f)->at_boundary() &&
+                                boundary_functions.find(cell->face(f)->boundary_id()) != boundary_functions.end())
+                                for (unsigned int l = 0; l < cell->face(f)->n_lines(); ++l)
+                                    AssertThrow(!cell->face(f)->line(l)->has_children(), ExcNotImplemented());
+
+            using CopyData = std::vector<types::global_dof_index>;
+
+            auto worker = [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+                              ScratchData &                                                   scratch,
+                              CopyData &                                                      copy_data)
+            {
+                copy_data.clear();
+                if (cell->is_artificial() || !cell->at_boundary())
+                    return;
+
+                for (const unsigned int f : cell->face_indices())
+                    //Check if face is on selected boundary section
+                    if (cell->face(f)->at_boundary() &&
+                        boundary_functions.find(cell->face(f)->boundary_id()) != boundary_functions.end())
+                    {
+                        cell->face(f)->get_dof_indices(scratch.dofs_on_face, cell->active_fe_index());
+                        for (unsigned int i = 0; i < constrained_dofs_per_face; ++i)
+                            copy_data.push_back(scratch.dofs_on_face[constrained_to_local_indices(f, i)]);
+                    }
+            };
+
+            auto copier = [&](const CopyData &copy_data)
+            {
+                for (const types::global_dof_index index : copy_data)
+                    dof_to_boundary.emplace(index, dof_to_boundary.size());
+            };
+
+            WorkStream::run(dof_handler.begin_active(),
+                            dof_handler.end(),
+                            worker,
+                            copier,
+                            ScratchData{std::vector<types::global_dof_index>(dofs_per_face)},
+                            CopyData());
+
+            Assert((dof_to_boundary.size() != dof_handler.n_boundary_dofs(boundary_functions)) || (regularity == 0) ||
+                   (dynamic_cast<const parallel::TriangulationBase<dim, spacedim>*>(&dof_handler.get_triangulation()) != nullptr),
+                   ExcInternalError());
+        }
+
+
+
+        /*
+         * Map the projection mode of the boundary values onto the derivative
+         * order of the degrees of freedom that are constrained.
+         */
+        template <int dim, int spacedim>
+        unsigned int
+        get_hermite_boundary_position(const HermiteBoundaryType         projection_mode,
+                                      const FiniteElement<dim, spacedim> &fe)
+        {
+            //This version implements projected values directly, so it's necessary to check that this is possible
+            const bool check_mode = (projection_mode == HermiteBoundaryType::hermite_dirichlet) ||
+                                    (projection_mode == HermiteBoundaryType::hermite_neumann) ||
+                                    (projection_mode == HermiteBoundaryType::hermite_2nd_derivative);
+            Assert(check_mode, ExcNotImplemented());
+            (void)check_mode;
+
+            //The derivatives at the vertices are only degrees of freedom up to the regularity,
+            //independently of the number of interpolation nodes
+            const FE_Hermite<dim, spacedim> *fe_herm = dynamic_cast<const FE_Hermite<dim, spacedim>*>(&fe);
+            Assert(fe_herm != nullptr, ExcInternalError());
+            const unsigned int regularity = fe_herm->get_regularity();
+            (void)regularity;
+
+            unsigned int position = 0;
+            switch(projection_mode)
+            {
+                case HermiteBoundaryType::hermite_dirichlet:
+                    position = 0;
+                    break;
+                case HermiteBoundaryType::hermite_neumann:
+                    Assert(regularity > 0, ExcDimensionMismatch(regularity, 1));
+                    position = 1;
+                    break;
+                case HermiteBoundaryType::hermite_2nd_derivative:
+                    Assert(regularity > 1, ExcDimensionMismatch(regularity, 2));
+                    position = 2;
+                    break;
+                default:
+                    Assert(false, ExcInternalError());
+            }
+            return position;
+        }
+
+
+
+        /*
+         * Assemble the mass matrix of the boundary degrees of freedom given by
+         * dof_to_boundary, see collect_constrained_hermite_boundary_dofs().
+         * The faces are visited directly and the boundary numbers are looked
+         * up in dof_to_boundary, so no table over all degrees of freedom is
+         * needed.
+         */
+        template <int dim, int spacedim, typename Number>
+        void
+        assemble_hermite_boundary_mass_matrix(const MappingHermite<dim, spacedim> &                             mapping_h,
+                                              const DoFHandler<dim, spacedim> &                                      dof_handler,
+                                              const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                                              const Quadrature<dim - 1> &                                            quadrature,
+                                              const std::map<types::global_dof_index, types::global_dof_index> &     dof_to_boundary,
+                                              SparsityPattern &                                                      sparsity,
+                                              SparseMatrix<Number> &                                                 mass_matrix)
+        {
+            AssertDimension(dof_handler.get_fe().n_components(), 1);
+
+            const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+            std::vector<types::global_dof_index> local_dof_indices(fe.n_dofs_per_cell());
+
+            //Cell-local indices and boundary numbers of the boundary degrees of freedom on a face
+            std::vector<std::pair<unsigned int, types::global_dof_index>> boundary_dofs_on_face;
+            const auto is_selected_face = [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+                                              const unsigned int                                              f)
+            {
+                return !cell->is_artificial() && cell->at_boundary(f) &&
+                       boundary_functions.find(cell->face(f)->boundary_id()) != boundary_functions.end();
+            };
+            const auto collect_boundary_dofs_on_face = [&](const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
+                                                           const unsigned int                                              f)
+            {
+                cell->get_dof_indices(local_dof_indices);
+                boundary_dofs_on_face.clear();
+                for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+                    if (fe.has_support_on_face(i, f))
+                    {
+                        const auto boundary_index = dof_to_boundary.find(local_dof_indices[i]);
+                        if (boundary_index != dof_to_boundary.end())
+                            boundary_dofs_on_face.emplace_back(i, boundary_index->second);
+                    }
+            };
+
+            {
+                DynamicSparsityPattern dsp(dof_to_boundary.size(), dof_to_boundary.size());
+                for (const auto &cell : dof_handler.active_cell_iterators())
+                    for (const unsigned int f : cell->face_indices())
+                        if (is_selected_face(cell, f))
+                        {
+                            collect_boundary_dofs_on_face(cell, f);
+                            for (const auto &dof_i : boundary_dofs_on_face)
+                                for (const auto &dof_j : boundary_dofs_on_face)
+                                    dsp.add(dof_i.second, dof_j.second);
+                        }
+                sparsity.copy_from(dsp);
+            }
+            mass_matrix.reinit(sparsity);
+
+            //The right hand side is assembled separately, see assemble_hermite_boundary_rhs()
+            FEFaceValues<dim, spacedim> fe_face_values(mapping_h,
+                                                       fe,
+                                                       quadrature,
+                                                       update_values | update_JxW_values);
+            for (const auto &cell : dof_handler.active_cell_iterators())
+                for (const unsigned int f : cell->face_indices())
+                    if (is_selected_face(cell, f))
+                    {
+                        fe_face_values.reinit(cell, f);
+                        collect_boundary_dofs_on_face(cell, f);
+                        for (const auto &dof_i : boundary_dofs_on_face)
+                            for (const auto &dof_j : boundary_dofs_on_face)
+                            {
+                                Number sum = 0;
+                                for (const unsigned int q : fe_face_values.quadrature_point_indices())
+                                    sum += fe_face_values.shape_value(dof_i.first, q) *
+                                           fe_face_values.shape_value(dof_j.first, q) *
+                                           fe_face_values.JxW(q);
+                                mass_matrix.add(dof_i.second, dof_j.second, sum);
+                            }
+                    }
+        }
+
+
+
+        /*
+         * Assemble the right hand side of the projection onto the boundary
+         * degrees of freedom given by dof_to_boundary. Shape functions of
+         * degrees of freedom that do not lie on a face vanish on it, so all
+         * degrees of freedom of the cell can be tested.
+         */
+        template <int dim, int spacedim, typename Number>
+        void
+        assemble_hermite_boundary_rhs(const MappingHermite<dim, spacedim> &                             mapping_h,
+                                      const DoFHandler<dim, spacedim> &                                      dof_handler,
+                                      const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                                      const Quadrature<dim - 1> &                                            quadrature,
+                                      const std::map<types::global_dof_index, types::global_dof_index> &     dof_to_boundary,
+                                      Vector<Number> &                                                       rhs)
+        {
+            AssertDimension(dof_handler.get_fe().n_components(), 1);
+            rhs = 0;
+
+            const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+            FEFaceValues<dim, spacedim> fe_face_values(mapping_h,
+                                                       fe,
+                                                       quadrature,
+                                                       update_values | update_JxW_values | update_quadrature_points);
+
+            std::vector<types::global_dof_index> local_dof_indices(fe.n_dofs_per_cell());
+            std::vector<Number>                  function_values(quadrature.size());
+
+            for (const auto &cell : dof_handler.active_cell_iterators())
+                for (const unsigned int f : cell->face_indices())
+                {
+                    if (cell->is_artificial() || !cell->at_boundary(f)) continue;
+
+                    const auto function = boundary_functions.find(cell->face(f)->boundary_id());
+                    if (function == boundary_functions.end()) continue;
+
+                    fe_face_values.reinit(cell, f);
+                    function->second->value_list(fe_face_values.get_quadrature_points(), function_values);
+                    cell->get_dof_indices(local_dof_indices);
+
+                    for (const unsigned int i : fe_face_values.dof_indices())
+                    {
+                        const auto boundary_index = dof_to_boundary.find(local_dof_indices[i]);
+                        if (boundary_index == dof_to_boundary.end()) continue;
+
+                        Number sum = 0;
+                        for (const unsigned int q : fe_face_values.quadrature_point_indices())
+                            sum += function_values[q] * fe_face_values.shape_value(i, q) * fe_face_values.JxW(q);
+                        rhs(boundary_index->second) += sum;
+                    }
+                }
+        }
+
+
+
+        /*
+         * Boundary projection for triangulations that are distributed over
+         * several processes. The boundary mass matrix is not assembled
+         * globally: the cell matrices of the boundary faces of the locally
+         * owned cells are kept, restricted to the boundary degrees of
+         * freedom, and applied to a LinearAlgebra::distributed::Vector over
+         * all degrees of freedom. The remaining locally owned degrees of
+         * freedom are decoupled by identity rows with zero right hand side,
+         * and the system is solved with CG preconditioned by the diagonal.
+         * The values are returned for all locally relevant boundary degrees
+         * of freedom, including the vertex derivatives shared with ghost
+         * cells.
+         */
+        template <int dim, int spacedim, typename Number>
+        void
+        do_hermite_distributed_boundary_projection(const MappingHermite<dim, spacedim> &                             mapping_h,
+                                                   const DoFHandler<dim, spacedim> &                                      dof_handler,
+                                                   const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                                                   const Quadrature<dim - 1> &                                            quadrature,
+                                                   const unsigned int                                                     position,
+                                                   std::map<types::global_dof_index, Number> &                            boundary_values)
+        {
+            AssertDimension(dof_handler.get_fe().n_components(), 1);
+
+            std::map<types::global_dof_index, types::global_dof_index> dof_to_boundary;
+            collect_constrained_hermite_boundary_dofs(dof_handler, boundary_functions, position, dof_to_boundary);
+
+            IndexSet locally_relevant_dofs;
+            DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+
+            using VectorType = LinearAlgebra::distributed::Vector<Number>;
+            VectorType rhs(dof_handler.locally_owned_dofs(), locally_relevant_dofs, dof_handler.get_communicator());
+            VectorType boundary_projection(rhs), diagonal(rhs);
+
+            //Face matrices, restricted to the boundary degrees of freedom of the face
+            struct FaceMatrix
+            {
+                std::vector<types::global_dof_index> dof_indices;
+                FullMatrix<Number>                   matrix;
+            };
+            std::vector<FaceMatrix> face_matrices;
+
+            const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+            FEFaceValues<dim, spacedim> fe_face_values(mapping_h,
+                                                       fe,
+                                                       quadrature,
+                                                       update_values | update_JxW_values | update_quadrature_points);
+
+            std::vector<types::global_dof_index> local_dof_indices(fe.n_dofs_per_cell());
+            std::vector<unsigned int>            boundary_dofs_on_cell;
+            std::vector<Number>                  function_values(quadrature.size());
+
+            for (const auto &cell : dof_handler.active_cell_iterators())
+                if (cell->is_locally_owned() && cell->at_boundary())
+                    for (const unsigned int f : cell->face_indices())
+                    {
+                        if (!cell->at_boundary(f)) continue;
+
+                        const auto function = boundary_functions.find(cell->face(f)->boundary_id());
+                        if (function == boundary_functions.end()) continue;
+
+                        fe_face_values.reinit(cell, f);
+                        function->second->value_list(fe_face_values.get_quadrature_points(), function_values);
+                        cell->get_dof_indices(local_dof_indices);
+
+                        boundary_dofs_on_cell.clear();
+                        for (const unsigned int i : fe_face_values.dof_indices())
+                            if (dof_to_boundary.find(local_dof_indices[i]) != dof_to_boundary.end())
+                                boundary_dofs_on_cell.push_back(i);
+
+                        FaceMatrix face_matrix;
+                        face_matrix.matrix.reinit(boundary_dofs_on_cell.size(), boundary_dofs_on_cell.size());
+                        for (unsigned int i = 0; i < boundary_dofs_on_cell.size(); ++i)
+                        {
+                            const unsigned int index_i = boundary_dofs_on_cell[i];
+                            face_matrix.dof_indices.push_back(local_dof_indices[index_i]);
+
+                            Number rhs_value = 0;
+                            for (const unsigned int q : fe_face_values.quadrature_point_indices())
+                            {
+                                const Number weighted_value = fe_face_values.shape_value(index_i, q) * fe_face_values.JxW(q);
+                                rhs_value += function_values[q] * weighted_value;
+                                for (unsigned int j = 0; j < boundary_dofs_on_cell.size(); ++j)
+                                    face_matrix.matrix(i, j) += weighted_value *
+                                                                fe_face_values.shape_value(boundary_dofs_on_cell[j], q);
+                            }
+                            rhs(local_dof_indices[index_i]) += rhs_value;
+                            diagonal(local_dof_indices[index_i]) += face_matrix.matrix(i, i);
+                        }
+                        face_matrices.push_back(std::move(face_matrix));
+                    }
+            rhs.compress(VectorOperation::add);
+            diagonal.compress(VectorOperation::add);
+
+            //Locally owned degrees of freedom away from the boundary get an identity row
+            for (unsigned int i = 0; i < diagonal.locally_owned_size(); ++i)
+                diagonal.local_element(i) = (diagonal.local_element(i) == Number(0.)) ?
+                                            Number(1.) : Number(1.) / diagonal.local_element(i);
+
+            DiagonalMatrix<VectorType> preconditioner;
+            preconditioner.get_vector().swap(diagonal);
+
+            //Unmarked degrees of freedom are the ones with an identity row
+            std::vector<bool> is_boundary_dof(rhs.locally_owned_size(), false);
+            for (const auto &dof : dof_to_boundary)
+                if (dof_handler.locally_owned_dofs().is_element(dof.first))
+                    is_boundary_dof[dof_handler.locally_owned_dofs().index_within_set(dof.first)] = true;
+
+            struct BoundaryMassOperator
+            {
+                void
+                vmult(VectorType &dst, const VectorType &src) const
+                {
+                    src.update_ghost_values();
+                    dst = 0;
+                    Vector<Number> local_src, local_dst;
+                    for (const FaceMatrix &face_matrix : *face_matrices)
+                    {
+                        local_src.reinit(face_matrix.dof_indices.size());
+                        local_dst.reinit(face_matrix.dof_indices.size());
+                        for (unsigned int i = 0; i < face_matrix.dof_indices.size(); ++i)
+                            local_src(i) = src(face_matrix.dof_indices[i]);
+                        face_matrix.matrix.vmult(local_dst, local_src);
+                        for (unsigned int i = 0; i < face_matrix.dof_indices.size(); ++i)
+                            dst(face_matrix.dof_indices[i]) += local_dst(i);
+                    }
+                    dst.compress(VectorOperation::add);
+                    src.zero_out_ghost_values();
+
+                    for (unsigned int i = 0; i < dst.locally_owned_size(); ++i)
+                        if (!(*is_boundary_dof)[i])
+                            dst.local_element(i) = src.local_element(i);
+                }
+
+                const std::vector<FaceMatrix> *face_matrices;
+                const std::vector<bool> *      is_boundary_dof;
+            };
+
+            const BoundaryMassOperator boundary_mass{&face_matrices, &is_boundary_dof};
+
+            ReductionControl control(5 * rhs.size(), 0., 1e-12, false, false);
+            SolverCG<VectorType> cg(control);
+            cg.solve(boundary_mass, boundary_projection, rhs, preconditioner);
+
+            // fill in boundary values of all locally relevant boundary dofs
+            boundary_projection.update_ghost_values();
+            for (const auto &dof : dof_to_boundary)
+            {
+                AssertIsFinite(boundary_projection(dof.first));
+                boundary_values[dof.first] = boundary_projection(dof.first);
+            }
+        }
+
+
+
+        template <int dim, int spacedim = dim, typename Number = double>
+        void
+        do_hermite_direct_projection(const MappingHermite<dim, spacedim> &                             mapping_h,
+                                const DoFHandler<dim, spacedim> &                                      dof_handler,
+                                const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                                const Quadrature<dim - 1> &                                            quadrature,
+                                const unsigned int                                                     position,
+                                std::map<types::global_dof_index, Number> &                            boundary_values,
+                                std::vector<unsigned int>                                              component_mapping = {})
+        {
+            //Return immediately if no constraint functions are provided
+            if (boundary_functions.size() == 0) return;
+
+            //For dim=1, the problem simplifies to interpolation at the boundaries
+            if (dim == 1)
+            {
+                Assert(component_mapping.size() == 0, ExcNotImplemented());
+                for (const auto &cell : dof_handler.active_cell_iterators())
+                {
+                    for (const unsigned int direction : GeometryInfo<dim>::face_indices())
+                    {
+                        if (cell->at_boundary(direction) &&
+                            boundary_functions.find(cell->face(direction)->boundary_id()) != boundary_functions.end())
+                        {
+                            const Function<spacedim, Number> & current_function =
+                                *boundary_functions.find(cell->face(direction)->boundary_id())->second;
+
+                            const FiniteElement<dim, spacedim> &fe_herm = dof_handler.get_fe();
+                            AssertDimension(fe_herm.n_components(), current_function.n_components);
+
+                            Vector<Number> boundary_value(fe_herm.n_components());
+                            if (boundary_value.size() == 1)
+                                boundary_value(0) = current_function.value(cell->vertex(direction));
+                            else
+                                current_function.vector_value(cell->vertex(direction), boundary_value);
+
+                            boundary_values[cell->vertex_dof_index(direction, position, cell->active_fe_index())] =
+                                boundary_value(fe_herm.face_system_to_component_index(position).first);
+                        }
+                    }
+                }
+                return;
+            }
+
+            //On distributed meshes, no process holds the whole boundary mass matrix
+            if (dynamic_cast<const parallel::TriangulationBase<dim, spacedim>*>(&dof_handler.get_triangulation()) != nullptr)
+            {
+                do_hermite_distributed_boundary_projection(mapping_h, dof_handler, boundary_functions, quadrature, position, boundary_values);
+                return;
+            }
+
+            //dim=2 or higher, needs actual projection. The mass matrix does not depend on the
+            //component mapping, which only selects the component of the boundary functions
+            if (component_mapping.size() == 0)
+            {
+                AssertDimension(dof_handler.get_fe().n_components(), boundary_functions.begin()->second->n_components);
+            }
+            else AssertDimension(component_mapping.size(), dof_handler.get_fe().n_components());
+            (void)component_mapping;
+
+            std::map<types::global_dof_index, types::global_dof_index> dof_to_boundary;
+            collect_constrained_hermite_boundary_dofs(dof_handler, boundary_functions, position, dof_to_boundary);
+
+            // make mass matrix and right hand side
+            SparsityPattern      sparsity;
+            SparseMatrix<Number> mass_matrix;
+            Vector<Number>       rhs(dof_to_boundary.size());
+            Vector<Number>       boundary_projection(rhs.size());
+
+            assemble_hermite_boundary_mass_matrix(mapping_h,
+                                                  dof_handler,
+                                                  boundary_functions,
+                                                  quadrature,
+                                                  dof_to_boundary,
+                                                  sparsity,
+                                                  mass_matrix);
+            assemble_hermite_boundary_rhs(mapping_h, dof_handler, boundary_functions, quadrature, dof_to_boundary, rhs);
+
+      if (rhs.norm_sqr() < 1e-8)
+        boundary_projection = 0;
+      else
+        {
+#ifdef DEAL_II_WITH_UMFPACK
+          SparseDirectUMFPACK mass_inv;
+          mass_inv.initialize(mass_matrix);
+          mass_inv.vmult(boundary_projection, rhs);
+#else
+          // Allow for a maximum of 20*n steps to reduce the residual by 10^-15.
+          // n steps may not be sufficient, since roundoff errors may accumulate
+          // for badly conditioned matrices. The mass matrices of the elements
+          // with interior nodes are badly conditioned, so a reduction by
+          // 10^-12 would leave errors of the order of 10^-6 in the solution
+          ReductionControl control(20 * rhs.size(), 0., 1e-15, false, false);
+          GrowingVectorMemory<Vector<Number>> memory;
+          SolverCG<Vector<Number>>            cg(control, memory);
+
+          PreconditionSSOR<SparseMatrix<Number>> prec;
+          prec.initialize(mass_matrix, 1.2);
+
+          cg.solve(mass_matrix, boundary_projection, rhs, prec);
+#endif
+        }
+      // fill in boundary values
+      for (const auto &dof : dof_to_boundary)
+          {
+            AssertIsFinite(boundary_projection(dof.second));
+
+            // this dof is on one of the
+            // interesting boundary parts
+            //
+            // remember: dof.first is the global dof
+            // number, dof.second is the number on
+            // the boundary and thus in the solution
+            // vector
+            boundary_values[dof.first] = boundary_projection(dof.second);
+          }
+        }
+
+
+
+        /*
+         * Fallback for vector types without a matrix-free implementation,
+         * which tells project() to assemble and solve a sparse mass matrix.
+         */
+        template <int dim, int spacedim, typename Number, typename VectorType>
+        bool
+        do_hermite_matrix_free_projection(const MappingHermite<dim, spacedim> &,
+                                          const DoFHandler<dim, spacedim> &,
+                                          const AffineConstraints<Number> &,
+                                          const std::map<types::global_dof_index, Number> &,
+                                          const Quadrature<dim> &,
+                                          const Function<spacedim, Number> &,
+                                          VectorType &)
+        {
+            return false;
+        }
+
+
+
+        /*
+         * Matrix-free projection onto an FE_Hermite space. The mass matrix is
+         * applied with FEEvaluation and inverted with a CG solver, so that
+         * no sparse matrix needs to be assembled. The solver is preconditioned
+         * with the diagonal of the mass matrix: the shape functions of the
+         * derivative degrees of freedom scale like h^k on a cell of extent h,
+         * and the diagonal takes this scaling out of the condition number.
+         * As MappingHermite is affine, the diagonal is a tensor product of
+         * the diagonal of the 1D mass matrix on the reference cell, scaled by
+         * the volume of the cell and the edge lengths, and is computed
+         * directly from the Jacobian.
+         */
+        template <int dim, typename Number>
+        bool
+        do_hermite_matrix_free_projection(const MappingHermite<dim, dim> &            mapping,
+                                          const DoFHandler<dim, dim> &                dof_handler,
+                                          const AffineConstraints<Number> &           user_constraints,
+                                          const std::map<types::global_dof_index, Number> &boundary_values,
+                                          const Quadrature<dim> &                     quadrature,
+                                          const Function<dim, Number> &               function,
+                                          LinearAlgebra::distributed::Vector<Number> &vec)
+        {
+            AssertDimension(dof_handler.get_fe_collection().size(), 1);
+            AssertDimension(dof_handler.get_fe().n_components(), 1);
+            const FE_Hermite<dim, dim> *fe_herm =
+                dynamic_cast<const FE_Hermite<dim, dim>*>(&dof_handler.get_fe());
+            Assert(fe_herm != nullptr, ExcInternalError());
+
+            const unsigned int degree = fe_herm->degree;
+
+            //Boundary values enter as inhomogeneous constraints. Constraints
+            //given by the user take precedence, e.g. hanging nodes on the boundary
+            IndexSet locally_relevant_dofs;
+            DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+            AffineConstraints<Number> boundary_constraints(locally_relevant_dofs);
+            for (const auto &boundary_value : boundary_values)
+                if (locally_relevant_dofs.is_element(boundary_value.first))
+                {
+                    boundary_constraints.add_line(boundary_value.first);
+                    boundary_constraints.set_inhomogeneity(boundary_value.first, boundary_value.second);
+                }
+            boundary_constraints.close();
+            boundary_constraints.merge(user_constraints, AffineConstraints<Number>::right_object_wins, true);
+            boundary_constraints.close();
+            const AffineConstraints<Number> &constraints = boundary_values.empty() ? user_constraints : boundary_constraints;
+
+            typename MatrixFree<dim, Number>::AdditionalData additional_data;
+            additional_data.tasks_parallel_scheme =
+                MatrixFree<dim, Number>::AdditionalData::partition_color;
+            additional_data.mapping_update_flags =
+                (update_values | update_JxW_values | update_quadrature_points);
+            std::shared_ptr<MatrixFree<dim, Number>> matrix_free(new MatrixFree<dim, Number>());
+            //MatrixFree needs a tensor product quadrature, use a Gauss formula that
+            //integrates the mass matrix exactly if the given one is not
+            const Quadrature<1> quadrature_1d = quadrature.is_tensor_product() ?
+                                                quadrature.get_tensor_basis()[0] :
+                                                QGauss<1>(degree + 1);
+            matrix_free->reinit(mapping, dof_handler, constraints, quadrature_1d, additional_data);
+
+            using MatrixType = MatrixFreeOperators::MassOperator<dim, -1, 0, 1, LinearAlgebra::distributed::Vector<Number>>;
+            MatrixType mass_matrix;
+            mass_matrix.initialize(matrix_free);
+
+            LinearAlgebra::distributed::Vector<Number> work_result, rhs, inhomogeneities;
+            matrix_free->initialize_dof_vector(work_result);
+            matrix_free->initialize_dof_vector(rhs);
+            matrix_free->initialize_dof_vector(inhomogeneities);
+            constraints.distribute(inhomogeneities);
+            inhomogeneities *= -1.;
+            inhomogeneities.update_ghost_values();
+
+            //Right hand side, including the contribution of inhomogeneous constraints
+            FEEvaluation<dim, -1, 0, 1, Number> phi(*matrix_free);
+            for (unsigned int cell = 0; cell < matrix_free->n_cell_batches(); ++cell)
+            {
+                phi.reinit(cell);
+                phi.read_dof_values_plain(inhomogeneities);
+                phi.evaluate(EvaluationFlags::values);
+                for (unsigned int q = 0; q < phi.n_q_points; ++q)
+                {
+                    const Point<dim, VectorizedArray<Number>> p = phi.quadrature_point(q);
+                    VectorizedArray<Number> function_value = phi.get_value(q);
+                    for (unsigned int v = 0; v < matrix_free->n_active_entries_per_cell_batch(cell); ++v)
+                    {
+                        Point<dim> p_lane;
+                        for (unsigned int d = 0; d < dim; ++d)
+                            p_lane[d] = p[d][v];
+                        function_value[v] += function.value(p_lane);
+                    }
+                    phi.submit_value(function_value, q);
+                }
+                phi.integrate(EvaluationFlags::values);
+                phi.distribute_local_to_global(rhs);
+            }
+            rhs.compress(VectorOperation::add);
+
+            //Diagonal of the 1D mass matrix on the reference cell
+            const std::vector<Polynomials::Polynomial<double>> basis_1d =
+                dealii::internal::get_hermite_polynomials_1d(fe_herm->get_regularity(), fe_herm->n_nodes());
+            const QGauss<1> exact_quadrature_1d(degree + 1);
+            std::vector<double> mass_diagonal_1d(basis_1d.size(), 0.);
+            for (unsigned int i = 0; i < basis_1d.size(); ++i)
+                for (unsigned int q = 0; q < exact_quadrature_1d.size(); ++q)
+                    mass_diagonal_1d[i] += Utilities::fixed_power<2>(basis_1d[i].value(exact_quadrature_1d.point(q)[0])) *
+                                           exact_quadrature_1d.weight(q);
+
+            const auto &shape_info = matrix_free->get_shape_info();
+            const std::vector<unsigned int> &lexicographic = shape_info.lexicographic_numbering;
+            const std::vector<unsigned int> &derivative_order = shape_info.derivative_order_1d;
+            const unsigned int n_dofs_1d = derivative_order.size();
+            AssertDimension(n_dofs_1d, basis_1d.size());
+
+            LinearAlgebra::distributed::Vector<Number> inverse_diagonal;
+            matrix_free->initialize_dof_vector(inverse_diagonal);
+            std::vector<types::global_dof_index> local_dof_indices(fe_herm->n_dofs_per_cell());
+            for (const auto &cell : dof_handler.active_cell_iterators())
+                if (cell->is_locally_owned())
+                {
+                    cell->get_dof_indices(local_dof_indices);
+                    const DerivativeForm<1, dim, dim> jacobian =
+                        MappingHermite<dim, dim>::compute_jacobian(cell);
+                    const DerivativeForm<1, dim, dim> edges = jacobian.transpose();
+                    for (unsigned int i = 0; i < lexicographic.size(); ++i)
+                    {
+                        double entry = std::abs(jacobian.determinant());
+                        for (unsigned int d = 0, index = i; d < dim; ++d, index /= n_dofs_1d)
+                        {
+                            const double h = edges[d].norm();
+                            entry *= mass_diagonal_1d[index % n_dofs_1d] *
+                                     std::pow(h, 2 * derivative_order[index % n_dofs_1d]);
+                        }
+                        inverse_diagonal(local_dof_indices[lexicographic[i]]) += entry;
+                    }
+                }
+            inverse_diagonal.compress(VectorOperation::add);
+            for (unsigned int i = 0; i < inverse_diagonal.locally_owned_size(); ++i)
+                inverse_diagonal.local_element(i) =
+                    (inverse_diagonal.local_element(i) == Number(0.)) ?
+                    Number(1.) : Number(1.) / inverse_diagonal.local_element(i);
+            for (const unsigned int i : matrix_free->get_constrained_dofs())
+                inverse_diagonal.local_element(i) = Number(1.);
+
+            DiagonalMatrix<LinearAlgebra::distributed::Vector<Number>> preconditioner;
+            preconditioner.get_vector().swap(inverse_diagonal);
+
+            //The diagonal is a weak preconditioner for high regularity and cells of
+            //different sizes, for which CG needs considerably more than n steps
+            ReductionControl control(20 * rhs.size(), 0., 1e-12, false, false);
+            SolverCG<LinearAlgebra::distributed::Vector<Number>> cg(control);
+            cg.solve(mass_matrix, work_result, rhs, preconditioner);
+            work_result += inhomogeneities;
+            constraints.distribute(work_result);
+
+            for (const types::global_dof_index i : dof_handler.locally_owned_dofs())
+                vec(i) = work_result(i);
+            vec.compress(VectorOperation::insert);
+
+            return true;
+        }
+    }   //namespace internal
+
+    template <int dim, int spacedim, typename Number>
+    void
+    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
+                            const DoFHandler<dim, spacedim> &                                      dof_handler,
+                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                            const Quadrature<dim - 1> &                                            quadrature,
+                            const HermiteBoundaryType                                              projection_mode,
+                            std::map<types::global_dof_index, Number> &                            boundary_values,
+                            std::vector<unsigned int>                                              component_mapping)
+    {
+        const unsigned int position = internal::get_hermite_boundary_position(projection_mode, dof_handler.get_fe());
+
+        internal::do_hermite_direct_projection(mapping_h, dof_handler, boundary_functions, quadrature, position, boundary_values, component_mapping);
+    }
+
+    template <int dim, int spacedim, typename Number>
+    void
+    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
+                            const DoFHandler<dim, spacedim> &                                      dof_handler,
+                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                            const Quadrature<dim - 1> &                                            quadrature,
+                            std::map<types::global_dof_index, Number> &                            boundary_values,
+                            std::vector<unsigned int>                                              component_mapping)
+    {
+        internal::do_hermite_direct_projection(mapping_h, dof_handler, boundary_functions, quadrature, 0, boundary_values, component_mapping);
+    }
+
+    template <int dim, int spacedim, typename Number>
+    void
+    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
+                            const DoFHandler<dim, spacedim> &                                      dof_handler,
+                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                            const Quadrature<dim - 1> &                                            quadrature,
+                            const HermiteBoundaryType                                              projection_mode,
+                            AffineConstraints<Number>                                              constraints,
+                            std::vector<unsigned int>                                              component_mapping)
+    {
+        Assert(false, ExcNotImplemented());
+    }
+
+    template <int dim, int spacedim, typename Number>
+    void
+    project_boundary_values(const MappingHermite<dim, spacedim> &                                  mapping_h,
+                            const DoFHandler<dim, spacedim> &                                      dof_handler,
+                            const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+                            const Quadrature<dim - 1> &                                            quadrature,
+                            AffineConstraints<Number>                                              constraints,
+                            std::vector<unsigned int>                                              component_mapping)
+    {
+        Assert(false, ExcNotImplemented());
+    }
+
+    template <int dim, typename VectorType, int spacedim> void
+    project(const MappingHermite<dim, spacedim> &                     mapping,
+            const DoFHandler<dim, spacedim> &                         dof,
+            const AffineConstraints<typename VectorType::value_type> &constraints,
+            const Quadrature<dim> &                                   quadrature,
+            const Function<spacedim, typename VectorType::value_type> &function,
+            VectorType &                                               vec,
+            const bool                 enforce_zero_boundary,
+            const Quadrature<dim - 1> &q_boundary,
+            const bool                 project_to_boundary_first)
+    {
+        using number = typename VectorType::value_type;
+        Assert((dynamic_cast<const FE_Hermite<dim, spacedim>*>( &dof.get_fe() ) != nullptr),
+               ExcMessage("The project function with the MappingHermite mapping class "
+                          "should only be used with a DoF handler associated with an "
+                          "FE_Hermite object with the same dim and spacedim as the mapping."));
+        Assert(dof.get_fe(0).n_components() == function.n_components,
+               ExcDimensionMismatch(dof.get_fe(0).n_components(),
+                                    function.n_components));
+        Assert(vec.size() == dof.n_dofs(),
+               ExcDimensionMismatch(vec.size(), dof.n_dofs()));
+
+        // make up boundary values
+        std::map<types::global_dof_index, number> boundary_values;
+        const std::vector<types::boundary_id> active_boundary_ids = dof.get_triangulation().get_boundary_ids();
+
+        if (enforce_zero_boundary)
+        {
+            std::map<types::boundary_id, const Function<spacedim, number>*> boundary;
+            for (const auto it : active_boundary_ids)
+                boundary.emplace(std::make_pair(it, nullptr));
+
+            const std::map<types::boundary_id, const Function<spacedim, number>* > new_boundary =
+                static_cast<const std::map<types::boundary_id, const Function<spacedim, number>*>>(boundary);
+
+            std::map<types::global_dof_index, types::global_dof_index> dof_to_boundary;
+            internal::collect_constrained_hermite_boundary_dofs(dof, new_boundary, 0, dof_to_boundary);
+
+            for (const auto &boundary_dof : dof_to_boundary)
+                boundary_values.emplace(std::make_pair(boundary_dof.first, 0));
+        }
+        else if (project_to_boundary_first)
+        {
+            std::map<types::boundary_id, const Function<spacedim, number>*> boundary_function;
+            for (const auto it : active_boundary_ids)
+                boundary_function.emplace(std::make_pair(it, &function));
+            //TODO: Why is this line causing bugs when the previous one works fine?! ARGH!
+            const std::map<types::boundary_id, const Function<spacedim, number>* > new_boundary_2 =
+                static_cast<const std::map< types::boundary_id, const Function<spacedim, number>* >>(boundary_function);
+
+            project_boundary_values<dim, spacedim, number>(mapping,
+                                                           dof,
+                                                           new_boundary_2,
+                                                           q_boundary,
+                                                           HermiteBoundaryType::hermite_dirichlet,
+                                                           boundary_values);
+        }
+
+        // Distributed vectors are projected with a matrix-free operator and
+        // an iterative solver, see do_hermite_matrix_free_projection()
+        if (internal::do_hermite_matrix_free_projection(mapping, dof, constraints, boundary_values, quadrature, function, vec))
+            return;
+
+        Assert((dynamic_cast<const parallel::TriangulationBase<dim, spacedim>*>(&dof.get_triangulation()) == nullptr),
+               ExcMessage("On distributed meshes, the project function with the MappingHermite "
+                          "mapping class needs a LinearAlgebra::distributed::Vector, which is "
+                          "projected without assembling a global matrix."));
+
+        // check if constraints are compatible (see below)
+        bool constraints_are_compatible = true;
+        for (const auto &value : boundary_values)
+            if (constraints.is_constrained(value.first))
+                if ((constraints.get_constraint_entries(value.first)->size() > 0) &&
+                    (constraints.get_inhomogeneity(value.first) != value.second))
+                    constraints_are_compatible = false;
+
+        // set up mass matrix and right hand side
+        Vector<number>  vec_result(dof.n_dofs());
+        SparsityPattern sparsity;
+
+        {
+            DynamicSparsityPattern dsp(dof.n_dofs(), dof.n_dofs());
+            DoFTools::make_sparsity_pattern(dof,
+                                            dsp,
+                                            constraints,
+                                            !constraints_are_compatible);
+
+            sparsity.copy_from(dsp);
+        }
+
+        SparseMatrix<number> mass_matrix(sparsity);
+        Vector<number>       tmp(mass_matrix.n());
+
+        // If the constraints object does not conflict with the given boundary
+        // values (i.e., it either does not contain boundary values or it contains
+        // the same as boundary_values), we can let it call
+        // distribute_local_to_global straight away, otherwise we need to first
+        // interpolate the boundary values and then condense the matrix and vector
+        if (constraints_are_compatible)
+        {
+            const Function<spacedim, number> *dummy = nullptr;
+            MatrixCreator::create_mass_matrix(mapping,
+                                              dof,
+                                              quadrature,
+                                              mass_matrix,
+                                              function,
+                                              tmp,
+                                              dummy,
+                                              constraints);
+
+            if (boundary_values.size() > 0)
+                MatrixTools::apply_boundary_values(boundary_values, mass_matrix, vec_result, tmp, true);
+        }
+        else
+        {
+            // create mass matrix and rhs at once, which is faster.
+            MatrixCreator::create_mass_matrix(mapping, dof, quadrature, mass_matrix, function, tmp);
+            MatrixTools::apply_boundary_values(boundary_values, mass_matrix, vec_result, tmp, true);
+            constraints.condense(mass_matrix, tmp);
+        }
+
+#ifdef DEAL_II_WITH_UMFPACK
+        SparseDirectUMFPACK eggmans_announcement;
+        eggmans_announcement.initialize(mass_matrix);
+        eggmans_announcement.vmult(vec_result, tmp);
+#else
+        // Allow for a maximum of 5*n steps to reduce the residual by 10^-12. n
+        // steps may not be sufficient, since roundoff errors may accumulate for
+        // badly conditioned matrices
+        ReductionControl control(5 * tmp.size(), 0., 1e-12, false, false);
+        GrowingVectorMemory<Vector<number>> memory;
+        SolverCG<Vector<number>>            cg(control, memory);
+
+        PreconditionSSOR<SparseMatrix<number>> prec;
+        prec.initialize(mass_matrix, 1.2);
+
+        cg.solve(mass_matrix, vec_result, tmp, prec);
+#endif
+
+        constraints.distribute(vec_result);
+
+        // copy vec_result into vec. we can't use vec itself above, since
+        // it may be of another type than Vector<double> and that wouldn't
+        // necessarily go together with the matrix and other functions
+        for (unsigned int i = 0; i < vec.size(); ++i)
+            ::dealii::internal::ElementAccess<VectorType>::set(vec_result(i),
+                                                               i,
+                                                               vec);
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    void
+    HermiteProjector<dim, spacedim, Number>::FactorizedMassMatrix::factorize()
+    {
+#ifdef DEAL_II_WITH_UMFPACK
+        direct_solver.initialize(matrix);
+#else
+        preconditioner.initialize(matrix, 1.2);
+#endif
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    void
+    HermiteProjector<dim, spacedim, Number>::FactorizedMassMatrix::solve(Vector<Number> &      dst,
+                                                                        const Vector<Number> &src) const
+    {
+#ifdef DEAL_II_WITH_UMFPACK
+        direct_solver.vmult(dst, src);
+#else
+        // Allow for a maximum of 5*n steps to reduce the residual by 10^-12,
+        // see project()
+        ReductionControl control(5 * src.size(), 0., 1e-12, false, false);
+        GrowingVectorMemory<Vector<Number>> memory;
+        SolverCG<Vector<Number>>            cg(control, memory);
+
+        dst = 0;
+        cg.solve(matrix, dst, src, preconditioner);
+#endif
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    HermiteProjector<dim, spacedim, Number>::HermiteProjector(const MappingHermite<dim, spacedim> &mapping,
+                                                              const DoFHandler<dim, spacedim> &    dof_handler,
+                                                              const AffineConstraints<Number> &    constraints,
+                                                              const Quadrature<dim> &              quadrature,
+                                                              const Quadrature<dim - 1> &          face_quadrature)
+      : mapping(&mapping)
+      , dof_handler(&dof_handler)
+      , constraints(&constraints)
+      , quadrature(quadrature)
+      , face_quadrature(face_quadrature)
+      , mass_matrix_is_assembled(false)
+      , boundary_position(numbers::invalid_unsigned_int)
+    {
+        Assert((dynamic_cast<const FE_Hermite<dim, spacedim>*>( &dof_handler.get_fe() ) != nullptr),
+               ExcMessage("The HermiteProjector class should only be used with a DoF "
+                          "handler associated with an FE_Hermite object."));
+        Assert(constraints.has_inhomogeneities() == false,
+               ExcMessage("The HermiteProjector class only supports homogeneous constraints."));
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    void
+    HermiteProjector<dim, spacedim, Number>::project(const Function<spacedim, Number> &function,
+                                                     Vector<Number> &                  vec)
+    {
+        AssertDimension(vec.size(), dof_handler->n_dofs());
+
+        std::vector<Vector<Number>> vectors(1);
+        project(std::vector<const Function<spacedim, Number>*>(1, &function), vectors);
+        vec.swap(vectors[0]);
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    void
+    HermiteProjector<dim, spacedim, Number>::project(const std::vector<const Function<spacedim, Number>*> &functions,
+                                                     std::vector<Vector<Number>> &                           vectors)
+    {
+        Assert((dynamic_cast<const parallel::TriangulationBase<dim, spacedim>*>(&dof_handler->get_triangulation()) == nullptr),
+               ExcMessage("On distributed meshes, use VectorTools::project with a "
+                          "LinearAlgebra::distributed::Vector instead."));
+
+        if (!mass_matrix_is_assembled)
+        {
+            DynamicSparsityPattern dsp(dof_handler->n_dofs(), dof_handler->n_dofs());
+            DoFTools::make_sparsity_pattern(*dof_handler, dsp, *constraints, false);
+            mass_matrix.sparsity.copy_from(dsp);
+            mass_matrix.matrix.reinit(mass_matrix.sparsity);
+
+            MatrixCreator::create_mass_matrix(*mapping, *dof_handler, quadrature, mass_matrix.matrix,
+                                              static_cast<const Function<spacedim, Number> *>(nullptr), *constraints);
+            mass_matrix.factorize();
+            mass_matrix_is_assembled = true;
+        }
+
+        // assemble all right hand sides in one loop over the cells
+        const FiniteElement<dim, spacedim> &fe = dof_handler->get_fe();
+        FEValues<dim, spacedim> fe_values(*mapping, fe, quadrature, update_values | update_JxW_values | update_quadrature_points);
+
+        std::vector<Vector<Number>> rhs(functions.size(), Vector<Number>(dof_handler->n_dofs()));
+        Vector<Number>                       cell_rhs(fe.n_dofs_per_cell());
+        std::vector<Number>                  function_values(quadrature.size());
+        std::vector<types::global_dof_index> local_dof_indices(fe.n_dofs_per_cell());
+
+        for (const auto &cell : dof_handler->active_cell_iterators())
+        {
+            fe_values.reinit(cell);
+            cell->get_dof_indices(local_dof_indices);
+
+            for (unsigned int f = 0; f < functions.size(); ++f)
+            {
+                AssertDimension(functions[f]->n_components, 1);
+                functions[f]->value_list(fe_values.get_quadrature_points(), function_values);
+
+                cell_rhs = 0;
+                for (const unsigned int q : fe_values.quadrature_point_indices())
+                {
+                    const Number weighted_value = function_values[q] * fe_values.JxW(q);
+                    for (const unsigned int i : fe_values.dof_indices())
+                        cell_rhs(i) += weighted_value * fe_values.shape_value(i, q);
+                }
+                constraints->distribute_local_to_global(cell_rhs, local_dof_indices, rhs[f]);
+            }
+        }
+
+        vectors.resize(functions.size());
+        for (unsigned int f = 0; f < functions.size(); ++f)
+        {
+            vectors[f].reinit(dof_handler->n_dofs());
+            mass_matrix.solve(vectors[f], rhs[f]);
+            constraints->distribute(vectors[f]);
+        }
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    void
+    HermiteProjector<dim, spacedim, Number>::project_boundary_values(
+        const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+        const HermiteBoundaryType                                              projection_mode,
+        std::map<types::global_dof_index, Number> &                            boundary_values)
+    {
+        const unsigned int position = internal::get_hermite_boundary_position(projection_mode, dof_handler->get_fe());
+
+        //In 1D the boundary values are interpolated, there is no matrix to keep.
+        //On distributed meshes, the matrix is only ever applied face by face.
+        if (dim == 1 || boundary_functions.size() == 0 ||
+            dynamic_cast<const parallel::TriangulationBase<dim, spacedim>*>(&dof_handler->get_triangulation()) != nullptr)
+        {
+            internal::do_hermite_direct_projection(*mapping, *dof_handler, boundary_functions, face_quadrature, position, boundary_values);
+            return;
+        }
+
+        assemble_boundary_mass_matrix(boundary_functions, position);
+
+        Vector<Number> rhs(boundary_mass_matrix.matrix.m());
+        Vector<Number> boundary_projection(rhs.size());
+        internal::assemble_hermite_boundary_rhs(*mapping, *dof_handler, boundary_functions, face_quadrature, dof_to_boundary, rhs);
+
+        if (rhs.norm_sqr() >= 1e-8)
+            boundary_mass_matrix.solve(boundary_projection, rhs);
+
+        for (const auto &dof : dof_to_boundary)
+        {
+            AssertIsFinite(boundary_projection(dof.second));
+            boundary_values[dof.first] = boundary_projection(dof.second);
+        }
+    }
+
+
+
+    template <int dim, int spacedim, typename Number>
+    void
+    HermiteProjector<dim, spacedim, Number>::assemble_boundary_mass_matrix(
+        const std::map<types::boundary_id, const Function<spacedim, Number>*> &boundary_functions,
+        const unsigned int                                                     position)
+    {
+        std::set<types::boundary_id> selected_boundary_ids;
+        for (const auto &boundary_function : boundary_functions)
+            selected_boundary_ids.insert(boundary_function.first);
+
+        //Keep the factorization if the same degrees of freedom are projected again
+        if (selected_boundary_ids == boundary_ids && position == boundary_position)
+            return;
+
+        internal::collect_constrained_hermite_boundary_dofs(*dof_handler, boundary_functions, position, dof_to_boundary);
+
+        internal::assemble_hermite_boundary_mass_matrix(*mapping,
+                                                        *dof_handler,
+                                                        boundary_functions,
+                                                        face_quadrature,
+                                                        dof_to_boundary,
+                                                        boundary_mass_matrix.sparsity,
+                                                        boundary_mass_matrix.matrix);
+        boundary_mass_matrix.factorize();
+
+        boundary_ids      = selected_boundary_ids;
+        boundary_position = position;
+    }
+} //namespace VectorTools
+
+
+
+
+//Explicit instantiations
+#include "fe_hermite.inst.in"
+
+DEAL_II_NAMESPACE_CLOSE
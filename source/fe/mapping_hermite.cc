@@ -4,6 +4,7 @@
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/tensor.h>
 
 #include <deal.II/dofs/dof_accessor.h>
@@ -30,6 +31,8 @@ template <int dim, int spacedim>
 MappingHermite<dim, spacedim>::InternalData::InternalData(
   const Quadrature<dim> &q)
   : cell_extents(numbers::signaling_nan<Tensor<1, dim>>())
+  , jacobian(numbers::signaling_nan<DerivativeForm<1, dim, spacedim>>())
+  , covariant(numbers::signaling_nan<DerivativeForm<1, dim, spacedim>>())
   , volume_element(numbers::signaling_nan<double>())
   , quadrature_points(q.get_points())
 {}
@@ -42,6 +45,8 @@ MappingHermite<dim, spacedim>::InternalData::memory_consumption() const
 {
   return (Mapping<dim, spacedim>::InternalDataBase::memory_consumption() +
           MemoryConsumption::memory_consumption(cell_extents) +
+          MemoryConsumption::memory_consumption(jacobian) +
+          MemoryConsumption::memory_consumption(covariant) +
           MemoryConsumption::memory_consumption(volume_element) +
           MemoryConsumption::memory_consumption(quadrature_points));
 }
@@ -171,15 +176,19 @@ MappingHermite<dim, spacedim>::update_cell_extents(
   const CellSimilarity::Similarity                            cell_similarity,
   const InternalData &                                        data) const
 {
-  // Compute start point and sizes
-  // along axes.  Strange vertex
-  // numbering makes this complicated
-  // again.
   if (cell_similarity != CellSimilarity::translation)
     {
-      const Point<dim> &start = cell->vertex(0);
-      for (unsigned int i = 0, j = 1; i < dim; ++i, j *= 2)
-          data.cell_extents[i] = start.distance(cell->vertex(j));
+      data.jacobian  = compute_jacobian(cell);
+      data.covariant = data.jacobian.covariant_form();
+      // the determinant is the volume element of the cell
+      data.volume_element = data.jacobian.determinant();
+
+      // the cell extents are the lengths of the edges from vertex 0, i.e.,
+      // of the columns of the Jacobian
+      const DerivativeForm<1, spacedim, dim> edges =
+        data.jacobian.transpose();
+      for (unsigned int d = 0; d < dim; ++d)
+        data.cell_extents[d] = edges[d].norm();
     }
 }
 
@@ -276,12 +285,9 @@ MappingHermite<dim, spacedim>::transform_quadrature_points(
   const Point<dim> &start = cell->vertex(0);
 
   for (unsigned int i = 0; i < quadrature_points.size(); ++i)
-    {
-      quadrature_points[i] = start;
-      for (unsigned int d = 0; d < dim; ++d)
-        quadrature_points[i](d) +=
-          data.cell_extents[d] * data.quadrature_points[i + offset](d);
-    }
+    quadrature_points[i] =
+      start +
+      apply_transformation(data.jacobian, data.quadrature_points[i + offset]);
 }
 
 
@@ -293,13 +299,17 @@ MappingHermite<dim, spacedim>::maybe_update_normal_vectors(
   const InternalData &         data,
   std::vector<Tensor<1, dim>> &normal_vectors) const
 {
-  // compute normal vectors. All normals on a face have the same value.
+  // compute normal vectors. All normals on a face have the same value, the
+  // unit normal vector of the reference cell pushed forward with the
+  // covariant transformation
   if (data.update_each & update_normal_vectors)
     {
       Assert(face_no < GeometryInfo<dim>::faces_per_cell, ExcInternalError());
+      const Tensor<1, dim> normal = apply_transformation(
+        data.covariant, GeometryInfo<dim>::unit_normal_vector[face_no]);
       std::fill(normal_vectors.begin(),
                 normal_vectors.end(),
-                GeometryInfo<dim>::unit_normal_vector[face_no]);
+                normal / normal.norm());
     }
 }
 
@@ -380,29 +390,19 @@ MappingHermite<dim, spacedim>::fill_fe_values(
                                       data,
                                       output_data.quadrature_points);
 
-  // compute Jacobian determinant. all values are equal and are the
-  // product of the local lengths in each coordinate direction
-  if (data.update_each & (update_JxW_values | update_volume_elements))
+  // the Jacobian determinant is the same at all quadrature points
+  if (data.update_each & update_JxW_values)
     if (cell_similarity != CellSimilarity::translation)
-      {
-        double J = data.cell_extents[0];
-        for (unsigned int d = 1; d < dim; ++d)
-          J *= data.cell_extents[d];
-        data.volume_element = J;
-        if (data.update_each & update_JxW_values)
-          for (unsigned int i = 0; i < output_data.JxW_values.size(); ++i)
-            output_data.JxW_values[i] = J * quadrature.weight(i);
-      }
+      for (unsigned int i = 0; i < output_data.JxW_values.size(); ++i)
+        output_data.JxW_values[i] = data.volume_element * quadrature.weight(i);
+
   // "compute" Jacobian at the quadrature points, which are all the
   // same
   if (data.update_each & update_jacobians)
     if (cell_similarity != CellSimilarity::translation)
-      for (unsigned int i = 0; i < output_data.jacobians.size(); ++i)
-        {
-          output_data.jacobians[i] = DerivativeForm<1, dim, spacedim>();
-          for (unsigned int j = 0; j < dim; ++j)
-            output_data.jacobians[i][j][j] = data.cell_extents[j];
-        }
+      std::fill(output_data.jacobians.begin(),
+                output_data.jacobians.end(),
+                data.jacobian);
 
   maybe_update_jacobian_derivatives(data, cell_similarity, output_data);
 
@@ -410,12 +410,9 @@ MappingHermite<dim, spacedim>::fill_fe_values(
   // all the same
   if (data.update_each & update_inverse_jacobians)
     if (cell_similarity != CellSimilarity::translation)
-      for (unsigned int i = 0; i < output_data.inverse_jacobians.size(); ++i)
-        {
-          output_data.inverse_jacobians[i] = Tensor<2, dim>();
-          for (unsigned int j = 0; j < dim; ++j)
-            output_data.inverse_jacobians[i][j][j] = 1. / data.cell_extents[j];
-        }
+      std::fill(output_data.inverse_jacobians.begin(),
+                output_data.inverse_jacobians.end(),
+                data.covariant.transpose());
 
   return cell_similarity;
 }
@@ -451,12 +448,14 @@ MappingHermite<dim, spacedim>::fill_fe_face_values(
 
   maybe_update_normal_vectors(face_no, data, output_data.normal_vectors);
 
-  // first compute Jacobian determinant, which is simply the product
-  // of the local lengths since the jacobian is diagonal
-  double J = 1.;
-  for (unsigned int d = 0; d < dim; ++d)
-    if (d != GeometryInfo<dim>::unit_normal_direction[face_no])
-      J *= data.cell_extents[d];
+  // the surface element is the volume element times the length of the
+  // unit normal vector of the reference cell pushed forward with the
+  // covariant transformation
+  const double J =
+    data.volume_element *
+    apply_transformation(data.covariant,
+                         GeometryInfo<dim>::unit_normal_vector[face_no])
+      .norm();
 
   if (data.update_each & update_JxW_values)
     for (unsigned int i = 0; i < output_data.JxW_values.size(); ++i)
@@ -466,31 +465,17 @@ MappingHermite<dim, spacedim>::fill_fe_face_values(
     for (unsigned int i = 0; i < output_data.boundary_forms.size(); ++i)
       output_data.boundary_forms[i] = J * output_data.normal_vectors[i];
 
-  if (data.update_each & update_volume_elements)
-    {
-      J = data.cell_extents[0];
-      for (unsigned int d = 1; d < dim; ++d)
-        J *= data.cell_extents[d];
-      data.volume_element = J;
-    }
-
   if (data.update_each & update_jacobians)
-    for (unsigned int i = 0; i < output_data.jacobians.size(); ++i)
-      {
-        output_data.jacobians[i] = DerivativeForm<1, dim, spacedim>();
-        for (unsigned int d = 0; d < dim; ++d)
-          output_data.jacobians[i][d][d] = data.cell_extents[d];
-      }
+    std::fill(output_data.jacobians.begin(),
+              output_data.jacobians.end(),
+              data.jacobian);
 
   maybe_update_jacobian_derivatives(data, CellSimilarity::none, output_data);
 
   if (data.update_each & update_inverse_jacobians)
-    for (unsigned int i = 0; i < output_data.inverse_jacobians.size(); ++i)
-      {
-        output_data.inverse_jacobians[i] = DerivativeForm<1, dim, spacedim>();
-        for (unsigned int d = 0; d < dim; ++d)
-          output_data.inverse_jacobians[i][d][d] = 1. / data.cell_extents[d];
-      }
+    std::fill(output_data.inverse_jacobians.begin(),
+              output_data.inverse_jacobians.end(),
+              data.covariant.transpose());
 }
 
 
@@ -519,12 +504,14 @@ MappingHermite<dim, spacedim>::fill_fe_subface_values(
 
   maybe_update_normal_vectors(face_no, data, output_data.normal_vectors);
 
-  // first compute Jacobian determinant, which is simply the product
-  // of the local lengths since the jacobian is diagonal
-  double J = 1.;
-  for (unsigned int d = 0; d < dim; ++d)
-    if (d != GeometryInfo<dim>::unit_normal_direction[face_no])
-      J *= data.cell_extents[d];
+  // the surface element is the volume element times the length of the
+  // unit normal vector of the reference cell pushed forward with the
+  // covariant transformation
+  const double J =
+    data.volume_element *
+    apply_transformation(data.covariant,
+                         GeometryInfo<dim>::unit_normal_vector[face_no])
+      .norm();
 
   if (data.update_each & update_JxW_values)
     {
@@ -544,31 +531,56 @@ MappingHermite<dim, spacedim>::fill_fe_subface_values(
     for (unsigned int i = 0; i < output_data.boundary_forms.size(); ++i)
       output_data.boundary_forms[i] = J * output_data.normal_vectors[i];
 
-  if (data.update_each & update_volume_elements)
-    {
-      J = data.cell_extents[0];
-      for (unsigned int d = 1; d < dim; ++d)
-        J *= data.cell_extents[d];
-      data.volume_element = J;
-    }
-
   if (data.update_each & update_jacobians)
-    for (unsigned int i = 0; i < output_data.jacobians.size(); ++i)
-      {
-        output_data.jacobians[i] = DerivativeForm<1, dim, spacedim>();
-        for (unsigned int d = 0; d < dim; ++d)
-          output_data.jacobians[i][d][d] = data.cell_extents[d];
-      }
+    std::fill(output_data.jacobians.begin(),
+              output_data.jacobians.end(),
+              data.jacobian);
 
   maybe_update_jacobian_derivatives(data, CellSimilarity::none, output_data);
 
   if (data.update_each & update_inverse_jacobians)
-    for (unsigned int i = 0; i < output_data.inverse_jacobians.size(); ++i)
-      {
-        output_data.inverse_jacobians[i] = DerivativeForm<1, spacedim, dim>();
-        for (unsigned int d = 0; d < dim; ++d)
-          output_data.inverse_jacobians[i][d][d] = 1. / data.cell_extents[d];
-      }
+    std::fill(output_data.inverse_jacobians.begin(),
+              output_data.inverse_jacobians.end(),
+              data.covariant.transpose());
+}
+
+
+
+template <int dim, int spacedim>
+void
+MappingHermite<dim, spacedim>::fill_mapping_data_for_generic_points(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<dim>> &                         unit_points,
+  const UpdateFlags                                           update_flags,
+  internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+    &output_data) const
+{
+  if (update_flags == update_default)
+    return;
+
+  Assert(update_flags & update_inverse_jacobians ||
+           update_flags & update_jacobians ||
+           update_flags & update_quadrature_points,
+         ExcNotImplemented());
+
+  output_data.initialize(unit_points.size(), update_flags);
+
+  const DerivativeForm<1, dim, spacedim> jacobian = compute_jacobian(cell);
+
+  if (update_flags & update_quadrature_points)
+    for (unsigned int i = 0; i < unit_points.size(); ++i)
+      output_data.quadrature_points[i] =
+        cell->vertex(0) + apply_transformation(jacobian, unit_points[i]);
+
+  if (update_flags & update_jacobians)
+    std::fill(output_data.jacobians.begin(),
+              output_data.jacobians.end(),
+              jacobian);
+
+  if (update_flags & update_inverse_jacobians)
+    std::fill(output_data.inverse_jacobians.begin(),
+              output_data.inverse_jacobians.end(),
+              jacobian.covariant_form().transpose());
 }
 
 
@@ -595,8 +607,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_covariant_transformation"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d = 0; d < dim; ++d)
-              output[i][d] = input[i][d] / data.cell_extents[d];
+            output[i] = apply_transformation(data.covariant, input[i]);
           return;
         }
 
@@ -607,8 +618,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_contravariant_transformation"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d = 0; d < dim; ++d)
-              output[i][d] = input[i][d] * data.cell_extents[d];
+            output[i] = apply_transformation(data.jacobian, input[i]);
           return;
         }
       case mapping_piola:
@@ -621,9 +631,8 @@ MappingHermite<dim, spacedim>::transform(
                    "update_volume_elements"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d = 0; d < dim; ++d)
-              output[i][d] =
-                input[i][d] * data.cell_extents[d] / data.volume_element;
+            output[i] = apply_transformation(data.jacobian, input[i]) /
+                        data.volume_element;
           return;
         }
       default:
@@ -642,103 +651,12 @@ MappingHermite<dim, spacedim>::transform(
   const ArrayView<Tensor<2, spacedim>> &                   output) const
 {
   AssertDimension(input.size(), output.size());
-  Assert(dynamic_cast<const InternalData *>(&mapping_data) != nullptr,
-         ExcInternalError());
-  const InternalData &data = static_cast<const InternalData &>(mapping_data);
-
-  switch (mapping_kind)
-    {
-      case mapping_covariant:
-        {
-          Assert(data.update_each & update_covariant_transformation,
-                 typename FEValuesBase<dim>::ExcAccessToUninitializedField(
-                   "update_covariant_transformation"));
-
-          for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] / data.cell_extents[d2];
-          return;
-        }
-
-      case mapping_contravariant:
-        {
-          Assert(data.update_each & update_contravariant_transformation,
-                 typename FEValuesBase<dim>::ExcAccessToUninitializedField(
-                   "update_contravariant_transformation"));
-
-          for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] * data.cell_extents[d2];
-          return;
-        }
-
-      case mapping_covariant_gradient:
-        {
-          Assert(data.update_each & update_covariant_transformation,
-                 typename FEValuesBase<dim>::ExcAccessToUninitializedField(
-                   "update_covariant_transformation"));
-
-          for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] / data.cell_extents[d2] /
-                                    data.cell_extents[d1];
-          return;
-        }
-
-      case mapping_contravariant_gradient:
-        {
-          Assert(data.update_each & update_contravariant_transformation,
-                 typename FEValuesBase<dim>::ExcAccessToUninitializedField(
-                   "update_contravariant_transformation"));
-
-          for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] * data.cell_extents[d2] /
-                                    data.cell_extents[d1];
-          return;
-        }
-
-      case mapping_piola:
-        {
-          Assert(data.update_each & update_contravariant_transformation,
-                 typename FEValuesBase<dim>::ExcAccessToUninitializedField(
-                   "update_contravariant_transformation"));
-          Assert(data.update_each & update_volume_elements,
-                 typename FEValuesBase<dim>::ExcAccessToUninitializedField(
-                   "update_volume_elements"));
-
-          for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] * data.cell_extents[d2] /
-                                    data.volume_element;
-          return;
-        }
-
-      case mapping_piola_gradient:
-        {
-          Assert(data.update_each & update_contravariant_transformation,
-                 typename FEValuesBase<dim>::ExcAccessToUninitializedField(
-                   "update_contravariant_transformation"));
-          Assert(data.update_each & update_volume_elements,
-                 typename FEValuesBase<dim>::ExcAccessToUninitializedField(
-                   "update_volume_elements"));
 
-          for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] * data.cell_extents[d2] /
-                                    data.cell_extents[d1] / data.volume_element;
-          return;
-        }
+  std::vector<Tensor<2, dim>> tensors(input.size());
+  for (unsigned int i = 0; i < input.size(); ++i)
+    tensors[i] = input[i];
 
-      default:
-        Assert(false, ExcNotImplemented());
-    }
+  transform(make_array_view(tensors), mapping_kind, mapping_data, output);
 }
 
 
@@ -756,6 +674,9 @@ MappingHermite<dim, spacedim>::transform(
          ExcInternalError());
   const InternalData &data = static_cast<const InternalData &>(mapping_data);
 
+  const Tensor<2, dim> jacobian  = data.jacobian;
+  const Tensor<2, dim> covariant = data.covariant;
+
   switch (mapping_kind)
     {
       case mapping_covariant:
@@ -765,9 +686,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_covariant_transformation"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] / data.cell_extents[d2];
+            output[i] = input[i] * transpose(covariant);
           return;
         }
 
@@ -778,9 +697,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_contravariant_transformation"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] * data.cell_extents[d2];
+            output[i] = input[i] * transpose(jacobian);
           return;
         }
 
@@ -791,10 +708,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_covariant_transformation"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] / data.cell_extents[d2] /
-                                    data.cell_extents[d1];
+            output[i] = covariant * input[i] * transpose(covariant);
           return;
         }
 
@@ -805,10 +719,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_contravariant_transformation"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] * data.cell_extents[d2] /
-                                    data.cell_extents[d1];
+            output[i] = covariant * input[i] * transpose(jacobian);
           return;
         }
 
@@ -822,10 +733,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_volume_elements"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] * data.cell_extents[d2] /
-                                    data.volume_element;
+            output[i] = input[i] * transpose(jacobian) / data.volume_element;
           return;
         }
 
@@ -839,10 +747,8 @@ MappingHermite<dim, spacedim>::transform(
                    "update_volume_elements"));
 
           for (unsigned int i = 0; i < output.size(); ++i)
-            for (unsigned int d1 = 0; d1 < dim; ++d1)
-              for (unsigned int d2 = 0; d2 < dim; ++d2)
-                output[i][d1][d2] = input[i][d1][d2] * data.cell_extents[d2] /
-                                    data.cell_extents[d1] / data.volume_element;
+            output[i] = covariant * input[i] * transpose(jacobian) /
+                        data.volume_element;
           return;
         }
 
@@ -853,6 +759,37 @@ MappingHermite<dim, spacedim>::transform(
 
 
 
+namespace
+{
+  /**
+   * Contract the first index of the rank-3 tensor @p input with @p first
+   * and the other two with @p second, i.e., compute
+   * $\sum_{IJK} A_{iI} B_{jJ} B_{kK} T_{IJK}$.
+   */
+  template <int dim>
+  Tensor<3, dim>
+  transform_rank3(const Tensor<2, dim> &first,
+                  const Tensor<2, dim> &second,
+                  const Tensor<3, dim> &input)
+  {
+    Tensor<3, dim> result;
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int J = 0; J < dim; ++J)
+        for (unsigned int K = 0; K < dim; ++K)
+          {
+            double tmp = 0.;
+            for (unsigned int I = 0; I < dim; ++I)
+              tmp += first[i][I] * input[I][J][K];
+            for (unsigned int j = 0; j < dim; ++j)
+              for (unsigned int k = 0; k < dim; ++k)
+                result[i][j][k] += second[j][J] * second[k][K] * tmp;
+          }
+    return result;
+  }
+} // namespace
+
+
+
 template <int dim, int spacedim>
 void
 MappingHermite<dim, spacedim>::transform(
@@ -874,15 +811,11 @@ MappingHermite<dim, spacedim>::transform(
                  typename FEValuesBase<dim>::ExcAccessToUninitializedField(
                    "update_covariant_transformation"));
 
+          const Tensor<2, dim> covariant = data.covariant;
           for (unsigned int q = 0; q < output.size(); ++q)
-            for (unsigned int i = 0; i < spacedim; ++i)
-              for (unsigned int j = 0; j < spacedim; ++j)
-                for (unsigned int k = 0; k < spacedim; ++k)
-                  {
-                    output[q][i][j][k] = input[q][i][j][k] /
-                                         data.cell_extents[j] /
-                                         data.cell_extents[k];
-                  }
+            output[q] = transform_rank3(Tensor<2, dim>(unit_symmetric_tensor<dim>()),
+                                        covariant,
+                                        Tensor<3, dim>(input[q]));
           return;
         }
       default:
@@ -905,6 +838,9 @@ MappingHermite<dim, spacedim>::transform(
          ExcInternalError());
   const InternalData &data = static_cast<const InternalData &>(mapping_data);
 
+  const Tensor<2, dim> jacobian  = data.jacobian;
+  const Tensor<2, dim> covariant = data.covariant;
+
   switch (mapping_kind)
     {
       case mapping_contravariant_hessian:
@@ -917,14 +853,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_contravariant_transformation"));
 
           for (unsigned int q = 0; q < output.size(); ++q)
-            for (unsigned int i = 0; i < spacedim; ++i)
-              for (unsigned int j = 0; j < spacedim; ++j)
-                for (unsigned int k = 0; k < spacedim; ++k)
-                  {
-                    output[q][i][j][k] =
-                      input[q][i][j][k] * data.cell_extents[i] /
-                      data.cell_extents[j] / data.cell_extents[k];
-                  }
+            output[q] = transform_rank3(jacobian, covariant, input[q]);
           return;
         }
 
@@ -935,15 +864,7 @@ MappingHermite<dim, spacedim>::transform(
                    "update_covariant_transformation"));
 
           for (unsigned int q = 0; q < output.size(); ++q)
-            for (unsigned int i = 0; i < spacedim; ++i)
-              for (unsigned int j = 0; j < spacedim; ++j)
-                for (unsigned int k = 0; k < spacedim; ++k)
-                  {
-                    output[q][i][j][k] =
-                      input[q][i][j][k] / data.cell_extents[i] /
-                      data.cell_extents[j] / data.cell_extents[k];
-                  }
-
+            output[q] = transform_rank3(covariant, covariant, input[q]);
           return;
         }
 
@@ -960,16 +881,8 @@ MappingHermite<dim, spacedim>::transform(
                    "update_volume_elements"));
 
           for (unsigned int q = 0; q < output.size(); ++q)
-            for (unsigned int i = 0; i < spacedim; ++i)
-              for (unsigned int j = 0; j < spacedim; ++j)
-                for (unsigned int k = 0; k < spacedim; ++k)
-                  {
-                    output[q][i][j][k] =
-                      input[q][i][j][k] * data.cell_extents[i] /
-                      data.volume_element / data.cell_extents[j] /
-                      data.cell_extents[k];
-                  }
-
+            output[q] = transform_rank3(jacobian, covariant, input[q]) /
+                        data.volume_element;
           return;
         }
 
@@ -986,18 +899,7 @@ MappingHermite<dim, spacedim>::transform_unit_to_real_cell(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell,
   const Point<dim> &                                          p) const
 {
-  std::vector<Tensor<1, spacedim>>   axes(dim);
-  const Point<spacedim> start = cell->vertex(0);
-  
-  for (unsigned int i = 0; i < spacedim; ++i)
-      for (unsigned int j = 0, k = 1; j < dim; ++j, k *= 2)
-          axes[j][i] = cell->vertex(k)(i) - start(i);
-
-  Point<spacedim> p_real = cell->vertex(0);
-  for (unsigned int d = 0; d < dim; ++d)
-    p_real += axes[d] * p(d);
-
-  return p_real;
+  return cell->vertex(0) + apply_transformation(compute_jacobian(cell), p);
 }
 
 
@@ -1008,35 +910,47 @@ MappingHermite<dim, spacedim>::transform_real_to_unit_cell(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell,
   const Point<spacedim> &                                     p) const
 {
-    std::vector<Tensor<1,spacedim>>   axes(dim);
-    Tensor<1,dim> lengths;
-    
-    const Point<spacedim> &start = cell->vertex(0);
-    
-    for (unsigned int j = 0, k = 1; j < dim; ++j, k *= 2)
+  // the transpose of the covariant form is the (left) inverse of the
+  // Jacobian, which also covers the case spacedim > dim
+  return Point<dim>(
+    apply_transformation(compute_jacobian(cell).covariant_form().transpose(),
+                         p - cell->vertex(0)));
+}
+
+
+
+template <int dim, int spacedim>
+DerivativeForm<1, dim, spacedim>
+MappingHermite<dim, spacedim>::compute_jacobian(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+{
+  // the columns of the Jacobian are the edges from vertex 0 to its
+  // neighbors in the coordinate directions of the reference cell
+  DerivativeForm<1, dim, spacedim> jacobian;
+  const Point<spacedim> &          start = cell->vertex(0);
+  for (unsigned int d = 0; d < dim; ++d)
     {
-        for (unsigned int i = 0; i < spacedim; ++i)
-            axes[j][i] = cell->vertex(k)(i) - start(i);
-        
-        lengths[j] = start.distance(cell->vertex(k));
+      const Tensor<1, spacedim> edge = cell->vertex(1U << d) - start;
+      for (unsigned int i = 0; i < spacedim; ++i)
+        jacobian[i][d] = edge[i];
     }
-  
-    Point<spacedim> real = p;
-    Point<dim> reference;
-    
-    real -= start;
-    
-    double dot;
-    
-    for (unsigned int j = 0; j < dim; ++j)
+
+#ifdef DEBUG
+  // the remaining vertices must be the ones of a parallelogram or
+  // parallelepiped
+  for (const unsigned int v : cell->vertex_indices())
     {
-        dot = 0;
-        for (unsigned int i = 0; i < spacedim; ++i)
-            dot += axes[j][i] * real(i);
-        reference(j) = dot / lengths[j];
+      Point<spacedim> vertex = start;
+      for (unsigned int d = 0; d < dim; ++d)
+        if (v & (1U << d))
+          vertex += cell->vertex(1U << d) - start;
+      Assert(vertex.distance(cell->vertex(v)) <= 1e-12 * cell->diameter(),
+             ExcMessage("MappingHermite can only be used on cells that are "
+                        "parallelograms or parallelepipeds."));
     }
-    
-    return reference;
+#endif
+
+  return jacobian;
 }
 
 
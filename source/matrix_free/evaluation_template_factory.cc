@@ -23,6 +23,14 @@ DEAL_II_NAMESPACE_OPEN
 #  define SPLIT_INSTANTIATIONS_INDEX 0
 #endif
 
+#ifdef DEAL_II_COMPONENT_MATRIX_FREE_HIGH_DEGREE
+// the classes with the kernels for high degrees, which the functions
+// instantiated here forward to, are instantiated in
+// evaluation_template_factory_high_degree.cc
+#  define FE_EVAL_FACTORY_HIGH_DEGREE_INSTANTIATION extern template
+#  include "evaluation_template_factory_high_degree.inst"
+#endif
+
 #include "evaluation_template_factory.inst"
 
 DEAL_II_NAMESPACE_CLOSE
@@ -18,6 +18,7 @@
 
 #include <deal.II/dofs/dof_tools.h>
 
+#include <deal.II/fe/fe_hermite.h>
 #include <deal.II/fe/fe_tools.h>
 
 #include <deal.II/matrix_free/shape_info.h>
@@ -585,7 +586,9 @@ namespace internal
                        const FiniteElement<1> &       fe,
                        const dealii::DoFHandler<dim> &dof_handler)
     {
-      // currently, we have only FE_Q and FE_DGQ type elements implemented
+      // currently, we have only FE_Q and FE_DGQ type elements implemented,
+      // plus FE_Hermite with several degrees of freedom per vertex
+      const bool is_hermite = dynamic_cast<const FE_Hermite<1> *>(&fe);
       elem_info.n_components = dof_handler.get_fe().element_multiplicity(0);
       AssertDimension(Utilities::fixed_power<dim>(fe.n_dofs_per_cell()) *
                         elem_info.n_components,
@@ -593,31 +596,30 @@ namespace internal
       AssertDimension(fe.degree, dof_handler.get_fe().degree);
       elem_info.fe_degree             = fe.degree;
       elem_info.element_is_continuous = fe.n_dofs_per_vertex() > 0;
-      Assert(fe.n_dofs_per_vertex() < 2, ExcNotImplemented());
+      elem_info.n_joint_dofs_1d       = fe.n_dofs_per_vertex();
+      Assert(fe.n_dofs_per_vertex() < 2 || is_hermite, ExcNotImplemented());
 
       // step 1.2: get renumbering of 1D basis functions to lexicographic
       // numbers. The distinction according to fe.n_dofs_per_vertex() is to
       // support both continuous and discontinuous bases.
       std::vector<unsigned int> renumbering(fe.n_dofs_per_cell());
       {
-        AssertIndexRange(fe.n_dofs_per_vertex(), 2);
-        renumbering[0] = 0;
+        const unsigned int n_dofs_per_vertex = fe.n_dofs_per_vertex();
+        for (unsigned int i = 0; i < n_dofs_per_vertex; ++i)
+          renumbering[i] = i;
         for (unsigned int i = 0; i < fe.n_dofs_per_line(); ++i)
-          renumbering[i + fe.n_dofs_per_vertex()] =
-            GeometryInfo<1>::vertices_per_cell * fe.n_dofs_per_vertex() + i;
-        if (fe.n_dofs_per_vertex() > 0)
-          renumbering[fe.n_dofs_per_cell() - fe.n_dofs_per_vertex()] =
-            fe.n_dofs_per_vertex();
+          renumbering[i + n_dofs_per_vertex] =
+            GeometryInfo<1>::vertices_per_cell * n_dofs_per_vertex + i;
+        for (unsigned int i = 0; i < n_dofs_per_vertex; ++i)
+          renumbering[fe.n_dofs_per_cell() - n_dofs_per_vertex + i] =
+            n_dofs_per_vertex + i;
       }
 
       // step 1.3: create a dummy 1D quadrature formula to extract the
       // lexicographic numbering for the elements
-      Assert(fe.n_dofs_per_vertex() == 0 || fe.n_dofs_per_vertex() == 1,
-             ExcNotImplemented());
       const unsigned int shift = fe.n_dofs_per_cell() - fe.n_dofs_per_vertex();
       const unsigned int n_child_dofs_1d =
-        (fe.n_dofs_per_vertex() > 0 ? (2 * fe.n_dofs_per_cell() - 1) :
-                                      (2 * fe.n_dofs_per_cell()));
+        2 * fe.n_dofs_per_cell() - fe.n_dofs_per_vertex();
 
       elem_info.n_child_cell_dofs =
         elem_info.n_components * Utilities::fixed_power<dim>(n_child_dofs_1d);
@@ -637,6 +639,20 @@ namespace internal
             elem_info
               .prolongation_matrix_1d[i * n_child_dofs_1d + j + c * shift] =
               fe.get_prolongation_matrix(c)(renumbering[j], renumbering[i]);
+
+      // step 1.5: the degrees of freedom of FE_Hermite are derivatives in
+      // real space, so the transfer needs to know their order in order to
+      // rescale them by the size of the parent cell. The degrees of freedom
+      // of the children repeat the pattern of a vertex followed by the
+      // interpolation nodes of a custom regularity element, which are values
+      elem_info.derivative_order_1d.clear();
+      if (is_hermite)
+        {
+          elem_info.derivative_order_1d.resize(n_child_dofs_1d);
+          for (unsigned int i = 0; i < n_child_dofs_1d; ++i)
+            elem_info.derivative_order_1d[i] =
+              (i % shift < fe.n_dofs_per_vertex()) ? i % shift : 0;
+        }
     }
 
 
@@ -710,16 +726,28 @@ namespace internal
       // element step 1.1: create a 1D copy of the finite element from FETools
       // where we substitute the template argument
       AssertDimension(dof_handler.get_fe().n_base_elements(), 1);
-      std::string fe_name = dof_handler.get_fe().base_element(0).get_name();
-      {
-        const std::size_t template_starts = fe_name.find_first_of('<');
-        Assert(fe_name[template_starts + 1] ==
-                 (dim == 1 ? '1' : (dim == 2 ? '2' : '3')),
-               ExcInternalError());
-        fe_name[template_starts + 1] = '1';
-      }
-      const std::unique_ptr<FiniteElement<1>> fe(
-        FETools::get_fe_by_name<1, 1>(fe_name));
+      std::unique_ptr<FiniteElement<1>> fe;
+      if (const auto fe_hermite = dynamic_cast<const FE_Hermite<dim> *>(
+            &dof_handler.get_fe().base_element(0)))
+        {
+          // FETools does not know about FE_Hermite, so create the 1D element
+          // directly
+          fe = std::make_unique<FE_Hermite<1>>(fe_hermite->get_regularity(),
+                                               fe_hermite->n_nodes());
+        }
+      else
+        {
+          std::string fe_name =
+            dof_handler.get_fe().base_element(0).get_name();
+          {
+            const std::size_t template_starts = fe_name.find_first_of('<');
+            Assert(fe_name[template_starts + 1] ==
+                     (dim == 1 ? '1' : (dim == 2 ? '2' : '3')),
+                   ExcInternalError());
+            fe_name[template_starts + 1] = '1';
+          }
+          fe = FETools::get_fe_by_name<1, 1>(fe_name);
+        }
 
       setup_element_info(elem_info, *fe, dof_handler);
 
@@ -1002,11 +1030,17 @@ namespace internal
           touch_count.compress(VectorOperation::add);
           touch_count.update_ghost_values();
 
-          std::vector<unsigned int> degree_to_3(n_child_dofs_1d);
-          degree_to_3[0] = 0;
-          for (unsigned int i = 1; i < n_child_dofs_1d - 1; ++i)
-            degree_to_3[i] = 1;
-          degree_to_3.back() = 2;
+          // the degrees of freedom at the two end points of the 1D line,
+          // of which there can be several for FE_Hermite, and the ones in
+          // between
+          const unsigned int n_end_dofs_1d =
+            std::max(fe->n_dofs_per_vertex(), 1U);
+          std::vector<unsigned int> degree_to_3(n_child_dofs_1d, 1);
+          for (unsigned int i = 0; i < n_end_dofs_1d; ++i)
+            {
+              degree_to_3[i]                       = 0;
+              degree_to_3[n_child_dofs_1d - 1 - i] = 2;
+            }
 
           // we only store 3^dim weights because all dofs on a line have the
           // same valence, and all dofs on a quad have the same valence.
@@ -43,6 +43,7 @@ template <int dim, typename Number>
 MGTransferMatrixFree<dim, Number>::MGTransferMatrixFree()
   : fe_degree(0)
   , element_is_continuous(false)
+  , n_joint_dofs_1d(0)
   , n_components(0)
   , n_child_cell_dofs(0)
 {}
@@ -54,6 +55,7 @@ MGTransferMatrixFree<dim, Number>::MGTransferMatrixFree(
   const MGConstrainedDoFs &mg_c)
   : fe_degree(0)
   , element_is_continuous(false)
+  , n_joint_dofs_1d(0)
   , n_components(0)
   , n_child_cell_dofs(0)
 {
@@ -80,8 +82,11 @@ MGTransferMatrixFree<dim, Number>::clear()
     LinearAlgebra::distributed::Vector<Number>>::clear();
   fe_degree             = 0;
   element_is_continuous = false;
+  n_joint_dofs_1d       = 0;
   n_components          = 0;
   n_child_cell_dofs     = 0;
+  derivative_order_1d.clear();
+  parent_cell_extents.clear();
   level_dof_indices.clear();
   parent_child_connect.clear();
   dirichlet_indices.clear();
@@ -146,8 +151,10 @@ MGTransferMatrixFree<dim, Number>::build(
   // unpack element info data
   fe_degree             = elem_info.fe_degree;
   element_is_continuous = elem_info.element_is_continuous;
+  n_joint_dofs_1d       = elem_info.n_joint_dofs_1d;
   n_components          = elem_info.n_components;
   n_child_cell_dofs     = elem_info.n_child_cell_dofs;
+  derivative_order_1d   = elem_info.derivative_order_1d;
 
   // duplicate and put into vectorized array
   prolongation_matrix_1d.resize(elem_info.prolongation_matrix_1d.size());
@@ -179,6 +186,42 @@ MGTransferMatrixFree<dim, Number>::build(
         }
     }
 
+  // for FE_Hermite, collect the extents of the parent cells in the same
+  // order as setup_transfer() enumerates the locally owned parent cells.
+  // Unused lanes get extent one to keep the rescaling well-defined
+  parent_cell_extents.clear();
+  if (!derivative_order_1d.empty())
+    {
+      const Triangulation<dim> &tria = dof_handler.get_triangulation();
+      parent_cell_extents.resize(n_levels - 1);
+      for (unsigned int level = 1; level < n_levels; ++level)
+        {
+          parent_cell_extents[level - 1].resize(
+            ((n_owned_level_cells[level - 1] + vec_size - 1) / vec_size) *
+              dim,
+            VectorizedArray<Number>(1.));
+
+          unsigned int counter = 0;
+          if (level - 1 < tria.n_levels())
+            for (const auto &cell : tria.cell_iterators_on_level(level - 1))
+              if (cell->has_children() &&
+                  (tria.locally_owned_subdomain() ==
+                     numbers::invalid_subdomain_id ||
+                   cell->level_subdomain_id() ==
+                     tria.locally_owned_subdomain()))
+                {
+                  AssertIndexRange(counter, n_owned_level_cells[level - 1]);
+                  for (unsigned int d = 0; d < dim; ++d)
+                    parent_cell_extents[level - 1]
+                                       [(counter / vec_size) * dim + d]
+                                       [counter % vec_size] =
+                      cell->vertex(0).distance(cell->vertex(1 << d));
+                  ++counter;
+                }
+          AssertDimension(counter, n_owned_level_cells[level - 1]);
+        }
+    }
+
   evaluation_data.resize(n_child_cell_dofs);
 }
 
@@ -240,8 +283,12 @@ MGTransferMatrixFree<dim, Number>::prolongate_and_add(
   src_vec.update_ghost_values();
   // the implementation in do_prolongate_add is templated in the degree of the
   // element (for efficiency reasons), so we need to find the appropriate
-  // kernel here...
-  if (fe_degree == 0)
+  // kernel here. The kernels with fixed degree assume one joint degree of
+  // freedom in the center of the 1D line, so FE_Hermite uses the general
+  // one...
+  if (n_joint_dofs_1d > 1)
+    do_prolongate_add<-1>(to_level, dst_vec, src_vec);
+  else if (fe_degree == 0)
     do_prolongate_add<0>(to_level, dst_vec, src_vec);
   else if (fe_degree == 1)
     do_prolongate_add<1>(to_level, dst_vec, src_vec);
@@ -318,7 +365,9 @@ MGTransferMatrixFree<dim, Number>::restrict_and_add(
 
   src_vec.update_ghost_values();
 
-  if (fe_degree == 0)
+  if (n_joint_dofs_1d > 1)
+    do_restrict_add<-1>(from_level, dst_vec, src_vec);
+  else if (fe_degree == 0)
     do_restrict_add<0>(from_level, dst_vec, src_vec);
   else if (fe_degree == 1)
     do_restrict_add<1>(from_level, dst_vec, src_vec);
@@ -360,31 +409,84 @@ namespace
   void
   weight_dofs_on_child(const VectorizedArray<Number> *weights,
                        const unsigned int             n_components,
-                       const unsigned int             fe_degree,
+                       const unsigned int             n_child_dofs_1d,
+                       const unsigned int             n_joint_dofs_1d,
                        VectorizedArray<Number> *      data)
   {
-    Assert(fe_degree > 0, ExcNotImplemented());
-    Assert(fe_degree < 100, ExcNotImplemented());
-    const int loop_length = degree != -1 ? 2 * degree + 1 : 2 * fe_degree + 1;
+    Assert(n_child_dofs_1d > 1, ExcNotImplemented());
+    Assert(n_child_dofs_1d < 100, ExcNotImplemented());
+    const int loop_length = degree != -1 ? 2 * degree + 1 : n_child_dofs_1d;
+    const int n_end_dofs  = degree != -1 ? 1 : n_joint_dofs_1d;
     unsigned int degree_to_3[100];
-    degree_to_3[0] = 0;
-    for (int i = 1; i < loop_length - 1; ++i)
+    for (int i = 0; i < loop_length; ++i)
       degree_to_3[i] = 1;
-    degree_to_3[loop_length - 1] = 2;
+    for (int i = 0; i < n_end_dofs; ++i)
+      {
+        degree_to_3[i]                   = 0;
+        degree_to_3[loop_length - 1 - i] = 2;
+      }
     for (unsigned int c = 0; c < n_components; ++c)
       for (int k = 0; k < (dim > 2 ? loop_length : 1); ++k)
         for (int j = 0; j < (dim > 1 ? loop_length : 1); ++j)
           {
             const unsigned int shift = 9 * degree_to_3[k] + 3 * degree_to_3[j];
-            data[0] *= weights[shift];
-            // loop bound as int avoids compiler warnings in case loop_length
-            // == 1 (polynomial degree 0)
-            for (int i = 1; i < loop_length - 1; ++i)
-              data[i] *= weights[shift + 1];
-            data[loop_length - 1] *= weights[shift + 2];
+            for (int i = 0; i < loop_length; ++i)
+              data[i] *= weights[shift + degree_to_3[i]];
             data += loop_length;
           }
   }
+
+
+
+  // For FE_Hermite, multiply the degrees of freedom in @p data, given in
+  // lexicographic order with @p n_dofs_1d entries per direction, by the
+  // cell extents to the power of the order of the derivative they
+  // represent, or by the inverse of that if @p inverse is set
+  template <int dim, typename Number>
+  void
+  scale_by_cell_extents(const std::vector<unsigned int> &derivative_order_1d,
+                        const unsigned int               n_dofs_1d,
+                        const VectorizedArray<Number> *  cell_extents,
+                        const bool                       inverse,
+                        const unsigned int               n_components,
+                        VectorizedArray<Number> *        data)
+  {
+    AssertIndexRange(n_dofs_1d, derivative_order_1d.size() + 1);
+    constexpr unsigned int max_order = 8;
+
+    VectorizedArray<Number> powers[dim][max_order];
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        const VectorizedArray<Number> base =
+          inverse ? Number(1.) / cell_extents[d] : cell_extents[d];
+        powers[d][0] = Number(1.);
+        for (unsigned int k = 1; k < max_order; ++k)
+          powers[d][k] = powers[d][k - 1] * base;
+      }
+
+    for (unsigned int c = 0; c < n_components; ++c)
+      for (unsigned int k = 0; k < (dim > 2 ? n_dofs_1d : 1); ++k)
+        for (unsigned int j = 0; j < (dim > 1 ? n_dofs_1d : 1); ++j)
+          {
+            VectorizedArray<Number> factor_jk = Number(1.);
+            if (dim > 1)
+              {
+                AssertIndexRange(derivative_order_1d[j], max_order);
+                factor_jk *= powers[dim > 1 ? 1 : 0][derivative_order_1d[j]];
+              }
+            if (dim > 2)
+              {
+                AssertIndexRange(derivative_order_1d[k], max_order);
+                factor_jk *= powers[dim > 2 ? 2 : 0][derivative_order_1d[k]];
+              }
+            for (unsigned int i = 0; i < n_dofs_1d; ++i)
+              {
+                AssertIndexRange(derivative_order_1d[i], max_order);
+                data[i] *= factor_jk * powers[0][derivative_order_1d[i]];
+              }
+            data += n_dofs_1d;
+          }
+  }
 } // namespace
 
 
@@ -399,7 +501,7 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
 {
   const unsigned int vec_size        = VectorizedArray<Number>::size();
   const unsigned int degree_size     = (degree > -1 ? degree : fe_degree) + 1;
-  const unsigned int n_child_dofs_1d = 2 * degree_size - element_is_continuous;
+  const unsigned int n_child_dofs_1d = 2 * degree_size - n_joint_dofs_1d;
   const unsigned int n_scalar_cell_dofs =
     Utilities::fixed_power<dim>(n_child_dofs_1d);
   constexpr unsigned int three_to_dim = Utilities::pow(3, dim);
@@ -442,7 +544,7 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
           const unsigned int shift =
             internal::MGTransfer::compute_shift_within_children<dim>(
               parent_child_connect[to_level - 1][cell + v].second,
-              fe_degree + 1 - element_is_continuous,
+              fe_degree + 1 - n_joint_dofs_1d,
               fe_degree);
           const unsigned int *indices =
             &level_dof_indices[to_level - 1]
@@ -469,6 +571,17 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
             }
         }
 
+      // the 1D embedding matrix of FE_Hermite refers to a parent cell of
+      // unit size, so scale the derivatives to that size
+      if (!derivative_order_1d.empty())
+        scale_by_cell_extents<dim, Number>(
+          derivative_order_1d,
+          degree_size,
+          &parent_cell_extents[to_level - 1][(cell / vec_size) * dim],
+          false,
+          n_components,
+          evaluation_data.begin());
+
       AssertDimension(prolongation_matrix_1d.size(),
                       degree_size * n_child_dofs_1d);
       // perform tensorized operation
@@ -492,11 +605,20 @@ MGTransferMatrixFree<dim, Number>::do_prolongate_add(
                                                    evaluation_data.begin() +
                                                      c * n_scalar_cell_dofs,
                                                    fe_degree + 1,
-                                                   2 * fe_degree + 1);
+                                                   n_child_dofs_1d);
+          if (!derivative_order_1d.empty())
+            scale_by_cell_extents<dim, Number>(
+              derivative_order_1d,
+              n_child_dofs_1d,
+              &parent_cell_extents[to_level - 1][(cell / vec_size) * dim],
+              true,
+              n_components,
+              evaluation_data.begin());
           weight_dofs_on_child<dim, degree, Number>(
             &weights_on_refined[to_level - 1][(cell / vec_size) * three_to_dim],
             n_components,
-            fe_degree,
+            n_child_dofs_1d,
+            n_joint_dofs_1d,
             evaluation_data.begin());
         }
       else
@@ -544,7 +666,7 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
 {
   const unsigned int vec_size        = VectorizedArray<Number>::size();
   const unsigned int degree_size     = (degree > -1 ? degree : fe_degree) + 1;
-  const unsigned int n_child_dofs_1d = 2 * degree_size - element_is_continuous;
+  const unsigned int n_child_dofs_1d = 2 * degree_size - n_joint_dofs_1d;
   const unsigned int n_scalar_cell_dofs =
     Utilities::fixed_power<dim>(n_child_dofs_1d);
   constexpr unsigned int three_to_dim = Utilities::pow(3, dim);
@@ -578,8 +700,17 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
             &weights_on_refined[from_level - 1]
                                [(cell / vec_size) * three_to_dim],
             n_components,
-            fe_degree,
+            n_child_dofs_1d,
+            n_joint_dofs_1d,
             evaluation_data.data());
+          if (!derivative_order_1d.empty())
+            scale_by_cell_extents<dim, Number>(
+              derivative_order_1d,
+              n_child_dofs_1d,
+              &parent_cell_extents[from_level - 1][(cell / vec_size) * dim],
+              true,
+              n_components,
+              evaluation_data.data());
           for (unsigned int c = 0; c < n_components; ++c)
             internal::FEEvaluationImplBasisChange<
               internal::evaluate_general,
@@ -598,7 +729,15 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
                                                         Utilities::fixed_power<
                                                           dim>(degree_size),
                                                     fe_degree + 1,
-                                                    2 * fe_degree + 1);
+                                                    n_child_dofs_1d);
+          if (!derivative_order_1d.empty())
+            scale_by_cell_extents<dim, Number>(
+              derivative_order_1d,
+              degree_size,
+              &parent_cell_extents[from_level - 1][(cell / vec_size) * dim],
+              false,
+              n_components,
+              evaluation_data.data());
         }
       else
         {
@@ -629,7 +768,7 @@ MGTransferMatrixFree<dim, Number>::do_restrict_add(
           const unsigned int shift =
             internal::MGTransfer::compute_shift_within_children<dim>(
               parent_child_connect[from_level - 1][cell + v].second,
-              fe_degree + 1 - element_is_continuous,
+              fe_degree + 1 - n_joint_dofs_1d,
               fe_degree);
           AssertIndexRange(
             parent_child_connect[from_level - 1][cell + v].first *
@@ -678,6 +817,8 @@ MGTransferMatrixFree<dim, Number>::memory_consumption() const
   memory += MemoryConsumption::memory_consumption(prolongation_matrix_1d);
   memory += MemoryConsumption::memory_consumption(evaluation_data);
   memory += MemoryConsumption::memory_consumption(weights_on_refined);
+  memory += MemoryConsumption::memory_consumption(derivative_order_1d);
+  memory += MemoryConsumption::memory_consumption(parent_cell_extents);
   memory += MemoryConsumption::memory_consumption(dirichlet_indices);
   return memory;
 }
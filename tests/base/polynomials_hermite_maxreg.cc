@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test the basis of Polynomials::HermiteMaxreg up to the highest admissible
+ * regularity. The coefficients are computed in exact integer arithmetic and
+ * cached, so the derivatives of order up to the regularity at both end
+ * points must vanish for all but one basis function, whose derivative is
+ * k! 4^k, and the coefficients must be integers.
+ */
+
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int regularity)
+{
+  const std::vector<Polynomials::Polynomial<double>> basis =
+    Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+
+  double              conditions_error = 0.;
+  std::vector<double> derivatives(regularity + 1);
+  for (unsigned int i = 0; i < basis.size(); ++i)
+    {
+      const std::vector<double> coefficients =
+        Polynomials::HermiteMaxreg::hermite_poly_coeffs_maxreg(regularity, i);
+
+      for (unsigned int side = 0; side < 2; ++side)
+        {
+          basis[i].value(side, derivatives);
+          double factor = 1.;
+          for (unsigned int m = 0; m <= regularity; ++m)
+            {
+              // magnitude of the terms summed up for the derivative of
+              // order m at x=1, to scale the tolerance
+              double scale = 1.;
+              for (unsigned int j = m; j < coefficients.size(); ++j)
+                {
+                  double falling_factorial = 1.;
+                  for (unsigned int l = 0; l < m; ++l)
+                    falling_factorial *= j - l;
+                  scale += std::abs(coefficients[j]) * falling_factorial;
+                }
+
+              const bool   is_dof   = (i == side * (regularity + 1) + m);
+              const double expected = is_dof ? factor : 0.;
+              conditions_error =
+                std::max(conditions_error,
+                         std::abs(derivatives[m] - expected) / scale);
+              factor *= 4. * (m + 1);
+            }
+        }
+    }
+
+  // the coefficients are integers, which are exactly represented as double,
+  // and repeated requests are served from the cache
+  unsigned int n_non_integer = 0, n_cache_mismatches = 0;
+  for (unsigned int i = 0; i < basis.size(); ++i)
+    {
+      const std::vector<double> coefficients =
+        Polynomials::HermiteMaxreg::hermite_poly_coeffs_maxreg(regularity, i);
+      for (const double c : coefficients)
+        if (c != std::round(c))
+          ++n_non_integer;
+      if (coefficients !=
+          Polynomials::HermiteMaxreg::hermite_poly_coeffs_maxreg(regularity, i))
+        ++n_cache_mismatches;
+    }
+
+  deallog << "regularity=" << regularity << ", coefficients of basis 0:";
+  for (const double c :
+       Polynomials::HermiteMaxreg::hermite_poly_coeffs_maxreg(regularity, 0))
+    deallog << ' ' << static_cast<long long>(c);
+  deallog << std::endl;
+  deallog << "error of the conditions at the end points: "
+          << filter_out_small_numbers(conditions_error, 1e-12)
+          << ", non-integer coefficients: " << n_non_integer
+          << ", mismatches with the cache: " << n_cache_mismatches
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  for (unsigned int regularity = 0; regularity < 8; ++regularity)
+    test(regularity);
+
+  return 0;
+}
@@ -0,0 +1,326 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test FE_Hermite with MappingHermite on a structured mesh that is sheared
+ * and rotated as a whole, so that all cells are parallelograms or
+ * parallelepipeds with the same edge directions. The edge directions have
+ * unit length, so the degrees of freedom of a polynomial in the coordinates
+ * along the edges are its derivatives in these coordinates. The finite
+ * element function must reproduce the values, gradients and hessians of the
+ * polynomial, and the projection with the matrix-free and the sparse matrix
+ * path must return its degrees of freedom. The volume, the boundary normals
+ * and the inverse of the mapping are checked as well.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// matrix whose columns are the unit edge directions of the cells
+template <int dim>
+Tensor<2, dim>
+edge_directions()
+{
+  Tensor<2, dim> result;
+  if (dim == 2)
+    {
+      result[0][0] = 1.;
+      result[1][0] = 0.3;
+      result[0][1] = -0.4;
+      result[1][1] = 1.;
+    }
+  else if (dim == 3)
+    {
+      result[0][0] = 1.;
+      result[1][0] = 0.2;
+      result[2][0] = 0.1;
+      result[0][1] = 0.3;
+      result[1][1] = 1.;
+      result[0][2] = -0.1;
+      result[1][2] = 0.2;
+      result[2][2] = 1.;
+    }
+  const Tensor<2, dim> columns = transpose(result);
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int e = 0; e < dim; ++e)
+      result[e][d] /= columns[d].norm();
+  return result;
+}
+
+
+
+// product of 1D polynomials in the coordinates along the edges
+template <int dim>
+class ProductPolynomial : public Function<dim>
+{
+public:
+  ProductPolynomial(
+    const std::vector<Polynomials::Polynomial<double>> &polynomials)
+    : polynomials(polynomials)
+    , inverse_directions(invert(edge_directions<dim>()))
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    const Point<dim> xi(inverse_directions * p);
+    double           result = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      result *= polynomials[d].value(xi[d]);
+    return result;
+  }
+
+  virtual Tensor<1, dim>
+  gradient(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    const Point<dim>    xi(inverse_directions * p);
+    Tensor<1, dim>      result;
+    std::vector<double> derivatives(2);
+    for (unsigned int e = 0; e < dim; ++e)
+      result[e] = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        polynomials[d].value(xi[d], derivatives);
+        for (unsigned int e = 0; e < dim; ++e)
+          result[e] *= derivatives[d == e ? 1 : 0];
+      }
+    return transpose(inverse_directions) * result;
+  }
+
+  virtual SymmetricTensor<2, dim>
+  hessian(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    const Point<dim>    xi(inverse_directions * p);
+    Tensor<2, dim>      result;
+    std::vector<double> derivatives(3);
+    for (unsigned int e = 0; e < dim; ++e)
+      for (unsigned int f = 0; f < dim; ++f)
+        result[e][f] = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        polynomials[d].value(xi[d], derivatives);
+        for (unsigned int e = 0; e < dim; ++e)
+          for (unsigned int f = 0; f < dim; ++f)
+            result[e][f] *= derivatives[(d == e ? 1 : 0) + (d == f ? 1 : 0)];
+      }
+    return symmetrize(transpose(inverse_directions) * result *
+                      inverse_directions);
+  }
+
+private:
+  const std::vector<Polynomials::Polynomial<double>> polynomials;
+  const Tensor<2, dim>                               inverse_directions;
+};
+
+
+
+// degrees of freedom of a product of 1D polynomials of the degree of the
+// element at the point with edge coordinates xi, see
+// hanging_nodes_hermite.cc
+template <int dim>
+double
+vertex_dof_value(
+  const std::vector<Polynomials::Polynomial<double>> &polynomials,
+  const Point<dim> &                                   xi,
+  const unsigned int                                   regularity,
+  const unsigned int                                   vertex_dof)
+{
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+
+  double              result = 1.;
+  unsigned int        index  = vertex_dof;
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int d = 0; d < dim; ++d, index /= regularity + 1)
+    {
+      const unsigned int m = index % (regularity + 1);
+      polynomials[d].value(xi[d], values);
+      basis_1d[m].value(0., basis_values);
+      result *= values[m] / basis_values[m];
+    }
+  return result;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  double                           volume = 1.;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+      volume *= p2[d];
+    }
+
+  const Tensor<2, dim> directions = edge_directions<dim>();
+  Triangulation<dim>   tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+  GridTools::transform(
+    [&](const Point<dim> &p) { return Point<dim>(directions * p); }, tr);
+  volume *= determinant(directions);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(fe.degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+  const ProductPolynomial<dim> function(polynomials);
+
+  const Tensor<2, dim> inverse_directions = invert(directions);
+  Vector<double>       solution(dof.n_dofs());
+  for (const auto &cell : dof.active_cell_iterators())
+    for (const unsigned int v : cell->vertex_indices())
+      for (unsigned int i = 0; i < fe.n_dofs_per_vertex(); ++i)
+        solution(cell->vertex_dof_index(v, i)) =
+          vertex_dof_value(polynomials,
+                           Point<dim>(inverse_directions * cell->vertex(v)),
+                           regularity,
+                           i);
+
+  const QGauss<dim> quadrature(fe.degree + 1);
+  FEValues<dim>     fe_values(mapping,
+                              fe,
+                              quadrature,
+                              update_values | update_gradients |
+                                update_hessians | update_quadrature_points |
+                                update_JxW_values);
+  std::vector<double>         values(quadrature.size());
+  std::vector<Tensor<1, dim>> gradients(quadrature.size());
+  std::vector<Tensor<2, dim>> hessians(quadrature.size());
+  double values_error = 0., gradients_error = 0., hessians_error = 0.,
+         mapping_error = 0., computed_volume = 0.;
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+      fe_values.get_function_hessians(solution, hessians);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        {
+          const Point<dim> &p = fe_values.quadrature_point(q);
+          values_error =
+            std::max(values_error, std::abs(values[q] - function.value(p)));
+          gradients_error = std::max(gradients_error,
+                                     (gradients[q] - function.gradient(p))
+                                       .norm());
+          hessians_error =
+            std::max(hessians_error,
+                     (hessians[q] - Tensor<2, dim>(function.hessian(p)))
+                       .norm());
+          mapping_error =
+            std::max(mapping_error,
+                     mapping.transform_real_to_unit_cell(cell, p)
+                       .distance(quadrature.point(q)));
+          computed_volume += fe_values.JxW(q);
+        }
+    }
+
+  // the integral of the normal vector over the boundary vanishes
+  const QGauss<dim - 1> face_quadrature(2);
+  FEFaceValues<dim>     fe_face_values(mapping,
+                                   fe,
+                                   face_quadrature,
+                                   update_normal_vectors | update_JxW_values);
+  Tensor<1, dim>        normal_integral;
+  for (const auto &cell : dof.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      if (cell->at_boundary(f))
+        {
+          fe_face_values.reinit(cell, f);
+          for (const unsigned int q : fe_face_values.quadrature_point_indices())
+            normal_integral +=
+              fe_face_values.normal_vector(q) * fe_face_values.JxW(q);
+        }
+
+  // projection with the matrix-free and the sparse matrix path
+  AffineConstraints<double> constraints;
+  constraints.close();
+  LinearAlgebra::distributed::Vector<double> projection_matrix_free(
+    dof.n_dofs());
+  Vector<double> projection_sparse(dof.n_dofs());
+  VectorTools::project(
+    mapping, dof, constraints, quadrature, function, projection_matrix_free);
+  VectorTools::project(
+    mapping, dof, constraints, quadrature, function, projection_sparse);
+  double projection_error = 0.;
+  for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+    projection_error =
+      std::max({projection_error,
+                std::abs(projection_matrix_free(i) - solution(i)),
+                std::abs(projection_sparse(i) - solution(i))});
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", volume: " << computed_volume << std::endl;
+  deallog << "errors of values: " << filter_out_small_numbers(values_error, 1e-10)
+          << ", gradients: " << filter_out_small_numbers(gradients_error, 1e-9)
+          << ", hessians: " << filter_out_small_numbers(hessians_error, 1e-8)
+          << std::endl;
+  deallog << "errors of inverse mapping: "
+          << filter_out_small_numbers(mapping_error, 1e-12) << ", volume: "
+          << filter_out_small_numbers(computed_volume - volume, 1e-12)
+          << ", integral of normals: "
+          << filter_out_small_numbers(normal_integral.norm(), 1e-12)
+          << ", projection: " << filter_out_small_numbers(projection_error, 1e-8)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<2>(0);
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+
+  return 0;
+}
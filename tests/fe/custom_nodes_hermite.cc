@@ -0,0 +1,360 @@
+/*
+ * Test FE_Hermite with interpolation nodes in the interior of the cell
+ * (custom regularity). The degrees of freedom are set to the derivatives of
+ * a polynomial of the degree of the element at the vertices and to its
+ * values at the interpolation nodes, on a mesh with cells of different
+ * sizes and aspect ratios, so the finite element function must reproduce
+ * the polynomial. The same degrees of freedom on a cell and its children
+ * check the prolongation and restriction matrices, and the boundary
+ * projection must recover the degrees of freedom on the boundary. Finally,
+ * an arbitrary finite element function must be continuous across the faces
+ * between neighboring cells, together with its derivatives up to the
+ * regularity, which requires neighbors to agree on the numbering of the
+ * degrees of freedom on shared edges and faces.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// product of 1D polynomials, one per direction
+template <int dim>
+class ProductPolynomial : public Function<dim>
+{
+public:
+  ProductPolynomial(
+    const std::vector<Polynomials::Polynomial<double>> &polynomials)
+    : polynomials(polynomials)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double result = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      result *= polynomials[d].value(p[d]);
+    return result;
+  }
+
+  virtual Tensor<1, dim>
+  gradient(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    Tensor<1, dim>      result;
+    std::vector<double> derivatives(2);
+    for (unsigned int e = 0; e < dim; ++e)
+      result[e] = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      {
+        polynomials[d].value(p[d], derivatives);
+        for (unsigned int e = 0; e < dim; ++e)
+          result[e] *= (d == e ? derivatives[1] : derivatives[0]);
+      }
+    return result;
+  }
+
+private:
+  const std::vector<Polynomials::Polynomial<double>> polynomials;
+};
+
+
+
+// degrees of freedom of the product of 1D polynomials on the box with the
+// given lower corner and extents: the derivatives at the end points of the
+// 1D intervals and the values at the interpolation nodes, divided by the
+// ones of the 1D basis function on the unit interval
+template <int dim>
+Vector<double>
+cell_dof_values(const FE_Hermite<dim> &                             fe,
+                const std::vector<Polynomials::Polynomial<double>> &polynomials,
+                const Point<dim> &                                  lower,
+                const Tensor<1, dim> &                              extents)
+{
+  const unsigned int regularity = fe.get_regularity();
+  const unsigned int n_dofs_1d  = fe.degree + 1;
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    Polynomials::HermiteCustomreg::generate_complete_basis(fe.degree,
+                                                           regularity);
+  const std::vector<Point<1>> nodes =
+    Polynomials::HermiteCustomreg::create_chebyshevgausslobatto_nodes(
+      fe.n_nodes());
+
+  std::vector<double>       position(n_dofs_1d);
+  std::vector<unsigned int> order(n_dofs_1d, 0);
+  for (unsigned int m = 0; m <= regularity; ++m)
+    {
+      position[m]                         = 0.;
+      order[m]                            = m;
+      position[fe.degree - regularity + m] = 1.;
+      order[fe.degree - regularity + m]    = m;
+    }
+  for (unsigned int i = 0; i < fe.n_nodes(); ++i)
+    position[regularity + 1 + i] = nodes[i](0);
+
+  const std::vector<unsigned int> numbering = fe.get_poly_space_numbering();
+  Vector<double>      result(fe.n_dofs_per_cell());
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+    {
+      double value = 1.;
+      for (unsigned int d = 0, index = numbering[i]; d < dim;
+           ++d, index /= n_dofs_1d)
+        {
+          const unsigned int a = index % n_dofs_1d;
+          polynomials[d].value(lower[d] + position[a] * extents[d], values);
+          basis_1d[a].value(position[a], basis_values);
+          value *= values[order[a]] / basis_values[order[a]];
+        }
+      result(i) = value;
+    }
+  return result;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity, const unsigned int nodes)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity, nodes);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  deallog << fe.get_name() << ", degree=" << fe.degree
+          << ", dofs per cell=" << fe.n_dofs_per_cell() << std::endl;
+
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(fe.degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+  const ProductPolynomial<dim> function(polynomials);
+
+  // set the degrees of freedom cell by cell, the ones shared between cells
+  // must coincide
+  Vector<double>                       solution(dof.n_dofs());
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      cell->get_dof_indices(dof_indices);
+      const Vector<double> local_values =
+        cell_dof_values(fe,
+                        polynomials,
+                        cell->vertex(0),
+                        cell->vertex(GeometryInfo<dim>::vertices_per_cell - 1) -
+                          cell->vertex(0));
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        solution(dof_indices[i]) = local_values(i);
+    }
+
+  const QGauss<dim> quadrature(fe.degree + 1);
+  FEValues<dim>     fe_values(mapping,
+                              fe,
+                              quadrature,
+                              update_values | update_gradients |
+                                update_quadrature_points);
+  std::vector<double>         values(quadrature.size());
+  std::vector<Tensor<1, dim>> gradients(quadrature.size());
+  double                      values_error = 0., gradients_error = 0.;
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        {
+          const Point<dim> &p = fe_values.quadrature_point(q);
+          values_error =
+            std::max(values_error, std::abs(values[q] - function.value(p)));
+          gradients_error = std::max(gradients_error,
+                                     (gradients[q] - function.gradient(p))
+                                       .norm());
+        }
+    }
+
+  // embedding of the unit cell into its children and back
+  Tensor<1, dim> unit_extents, child_extents;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      unit_extents[d]  = 1.;
+      child_extents[d] = 0.5;
+    }
+  const Vector<double> parent_values =
+    cell_dof_values(fe, polynomials, Point<dim>(), unit_extents);
+  Vector<double> restricted(fe.n_dofs_per_cell()),
+    child_result(fe.n_dofs_per_cell());
+  double prolongation_error = 0.;
+  for (unsigned int c = 0; c < GeometryInfo<dim>::max_children_per_cell; ++c)
+    {
+      const Vector<double> child_values =
+        cell_dof_values(fe,
+                        polynomials,
+                        0.5 * GeometryInfo<dim>::unit_cell_vertex(c),
+                        child_extents);
+      fe.get_prolongation_matrix(c).vmult(child_result, parent_values);
+      child_result -= child_values;
+      prolongation_error =
+        std::max(prolongation_error, child_result.linfty_norm());
+
+      fe.get_restriction_matrix(c).vmult_add(restricted, child_values);
+    }
+  restricted -= parent_values;
+
+  // boundary projection of the values
+  std::map<types::boundary_id, const Function<dim> *> boundary_functions;
+  boundary_functions[0] = &function;
+  std::map<types::global_dof_index, double> boundary_values;
+  VectorTools::project_boundary_values(
+    mapping,
+    dof,
+    boundary_functions,
+    QGauss<dim - 1>(fe.degree + 1),
+    VectorTools::HermiteBoundaryType::hermite_dirichlet,
+    boundary_values);
+  double boundary_error = 0.;
+  for (const auto &entry : boundary_values)
+    boundary_error =
+      std::max(boundary_error, std::abs(entry.second - solution(entry.first)));
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", nodes=" << nodes
+          << ", values: " << (values_error < 1e-10 ? "OK" : "FAILED")
+          << ", gradients: " << (gradients_error < 1e-9 ? "OK" : "FAILED")
+          << ", prolongation: "
+          << (prolongation_error < 1e-10 ? "OK" : "FAILED")
+          << ", restriction: "
+          << (restricted.linfty_norm() < 1e-10 ? "OK" : "FAILED")
+          << ", boundary: " << (boundary_error < 1e-9 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+// evaluate a random finite element function from both sides of each interior
+// face and report the largest jump of the values and gradients
+template <int dim>
+void
+test_continuity(const unsigned int regularity, const unsigned int nodes)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity, nodes);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  Vector<double> solution(dof.n_dofs());
+  for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+    solution(i) = random_value<double>();
+
+  const QGauss<dim - 1> quadrature(fe.degree + 1);
+  const UpdateFlags     flags =
+    update_values | update_gradients | update_quadrature_points;
+  FEFaceValues<dim> fe_face_values(mapping, fe, quadrature, flags);
+  FEFaceValues<dim> fe_face_values_neighbor(mapping, fe, quadrature, flags);
+
+  std::vector<double>         values(quadrature.size()),
+    values_neighbor(quadrature.size());
+  std::vector<Tensor<1, dim>> gradients(quadrature.size()),
+    gradients_neighbor(quadrature.size());
+  double points_error = 0., values_jump = 0., gradients_jump = 0.;
+  for (const auto &cell : dof.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      if (!cell->at_boundary(f))
+        {
+          fe_face_values.reinit(cell, f);
+          fe_face_values_neighbor.reinit(cell->neighbor(f),
+                                         cell->neighbor_of_neighbor(f));
+          fe_face_values.get_function_values(solution, values);
+          fe_face_values_neighbor.get_function_values(solution,
+                                                      values_neighbor);
+          fe_face_values.get_function_gradients(solution, gradients);
+          fe_face_values_neighbor.get_function_gradients(solution,
+                                                         gradients_neighbor);
+          for (const unsigned int q : fe_face_values.quadrature_point_indices())
+            {
+              points_error =
+                std::max(points_error,
+                         fe_face_values.quadrature_point(q).distance(
+                           fe_face_values_neighbor.quadrature_point(q)));
+              values_jump =
+                std::max(values_jump, std::abs(values[q] - values_neighbor[q]));
+              gradients_jump =
+                std::max(gradients_jump,
+                         (gradients[q] - gradients_neighbor[q]).norm());
+            }
+        }
+  AssertThrow(points_error < 1e-12, ExcInternalError());
+
+  // the gradient is only continuous for elements of regularity one or more
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", nodes=" << nodes << ", continuity of values: "
+          << (values_jump < 1e-10 ? "OK" : "FAILED");
+  if (regularity > 0)
+    deallog << ", continuity of gradients: "
+            << (gradients_jump < 1e-9 ? "OK" : "FAILED");
+  deallog << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<1>(0, 1);
+  test<1>(1, 1);
+  test<1>(1, 2);
+  test<2>(0, 2);
+  test<2>(1, 1);
+  test<2>(2, 1);
+  test<3>(1, 1);
+
+  test_continuity<2>(0, 2);
+  test_continuity<2>(1, 2);
+  test_continuity<2>(1, 3);
+  test_continuity<3>(0, 2);
+  test_continuity<3>(1, 2);
+
+  return 0;
+}
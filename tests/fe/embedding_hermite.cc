@@ -0,0 +1,155 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test the prolongation and restriction matrices of FE_Hermite, which are
+ * assembled upon first request as tensor products of 1D matrices computed
+ * from the Bernstein representation of the basis. The degrees of freedom of
+ * a polynomial in the finite element space on the reference cell are
+ * prolongated to the children for all refinement cases and compared against
+ * the exact values, and restricted back to the parent.
+ */
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+
+#include <deal.II/fe/fe_hermite.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// degrees of freedom of a product of 1D polynomials of the degree of the
+// element, see hanging_nodes_hermite.cc
+template <int dim>
+double
+vertex_dof_value(
+  const std::vector<Polynomials::Polynomial<double>> &polynomials,
+  const Point<dim> &                                   p,
+  const unsigned int                                   regularity,
+  const unsigned int                                   vertex_dof)
+{
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+
+  double              result = 1.;
+  unsigned int        index  = vertex_dof;
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int d = 0; d < dim; ++d, index /= regularity + 1)
+    {
+      const unsigned int m = index % (regularity + 1);
+      polynomials[d].value(p[d], values);
+      basis_1d[m].value(0., basis_values);
+      result *= values[m] / basis_values[m];
+    }
+  return result;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  FE_Hermite<dim> fe(regularity);
+
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(fe.degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+
+  const unsigned int dofs_per_vertex = fe.n_dofs_per_vertex();
+
+  Vector<double> parent_values(fe.n_dofs_per_cell());
+  for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+    for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+      parent_values(v * dofs_per_vertex + i) =
+        vertex_dof_value(polynomials,
+                         GeometryInfo<dim>::unit_cell_vertex(v),
+                         regularity,
+                         i);
+
+  double prolongation_error = 0., restriction_error = 0.;
+  for (unsigned int ref_case = RefinementCase<dim>::cut_x;
+       ref_case <= RefinementCase<dim>::isotropic_refinement;
+       ++ref_case)
+    for (unsigned int c = 0;
+         c < GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case));
+         ++c)
+      {
+        // the derivatives on the child are taken with respect to the
+        // coordinates of the parent
+        Vector<double> child_values(fe.n_dofs_per_cell());
+        for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+          for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+            child_values(v * dofs_per_vertex + i) = vertex_dof_value(
+              polynomials,
+              GeometryInfo<dim>::child_to_cell_coordinates(
+                GeometryInfo<dim>::unit_cell_vertex(v),
+                c,
+                RefinementCase<dim>(ref_case)),
+              regularity,
+              i);
+
+        Vector<double> result(fe.n_dofs_per_cell());
+        fe.get_prolongation_matrix(c, RefinementCase<dim>(ref_case))
+          .vmult(result, parent_values);
+        result -= child_values;
+        prolongation_error =
+          std::max(prolongation_error,
+                   result.linfty_norm() / child_values.linfty_norm());
+
+        const FullMatrix<double> &restriction =
+          fe.get_restriction_matrix(c, RefinementCase<dim>(ref_case));
+        restriction.vmult(result, child_values);
+        for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+          if (restriction(i, i) != 0.)
+            restriction_error =
+              std::max(restriction_error,
+                       std::abs(result(i) - parent_values(i)) /
+                         parent_values.linfty_norm());
+      }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", relative errors of prolongation: "
+          << filter_out_small_numbers(prolongation_error, 1e-10)
+          << ", restriction: "
+          << filter_out_small_numbers(restriction_error, 1e-10) << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  for (unsigned int regularity = 0; regularity < 4; ++regularity)
+    test<1>(regularity);
+  for (unsigned int regularity = 0; regularity < 4; ++regularity)
+    test<2>(regularity);
+  for (unsigned int regularity = 0; regularity < 3; ++regularity)
+    test<3>(regularity);
+
+  return 0;
+}
@@ -0,0 +1,145 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test that the shape function tables computed by FE_Hermite are correct
+ * when an FEValues or FEFaceValues object is reused on consecutive cells.
+ * FE_Hermite skips the rescaling of the shape functions if the cell has
+ * the same size as the previous one, so the results are compared against
+ * freshly created objects on a mesh with cells of different sizes.
+ */
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+// the largest differences of the values, gradients and Hessians of the shape
+// functions between the two objects
+template <int dim>
+std::array<double, 3>
+compare_values(const FEValuesBase<dim> &fe_1, const FEValuesBase<dim> &fe_2)
+{
+  std::array<double, 3> difference = {{0., 0., 0.}};
+  for (unsigned int i = 0; i < fe_1.dofs_per_cell; ++i)
+    for (unsigned int q = 0; q < fe_1.n_quadrature_points; ++q)
+      {
+        difference[0] =
+          std::max(difference[0],
+                   std::abs(fe_1.shape_value(i, q) - fe_2.shape_value(i, q)));
+        difference[1] =
+          std::max(difference[1],
+                   (fe_1.shape_grad(i, q) - fe_2.shape_grad(i, q)).norm());
+        difference[2] = std::max(
+          difference[2],
+          (fe_1.shape_hessian(i, q) - fe_2.shape_hessian(i, q)).norm());
+      }
+  return difference;
+}
+
+
+
+void
+print_difference(const std::string &name, const std::array<double, 3> &difference)
+{
+  deallog << name << ": " << filter_out_small_numbers(difference[0], 1e-12)
+          << ' ' << filter_out_small_numbers(difference[1], 1e-10) << ' '
+          << filter_out_small_numbers(difference[2], 1e-8) << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  Triangulation<dim> tr;
+  GridGenerator::hyper_cube(tr);
+  tr.refine_global(2);
+  tr.begin_active()->set_refine_flag();
+  tr.execute_coarsening_and_refinement();
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  QGauss<dim>         quadrature(regularity + 2);
+  QGauss<dim - 1>     face_quadrature(regularity + 2);
+  const UpdateFlags   flags = update_values | update_gradients | update_hessians;
+
+  FEValues<dim>     fe_values(mapping, fe, quadrature, flags);
+  FEFaceValues<dim> fe_face_values(mapping, fe, face_quadrature, flags);
+
+  std::array<double, 3> cell_difference = {{0., 0., 0.}},
+                        face_difference = {{0., 0., 0.}};
+  double sum_of_gradients = 0.;
+  for (const auto &cell : tr.active_cell_iterators())
+    {
+      FEValues<dim> fresh_values(mapping, fe, quadrature, flags);
+      fe_values.reinit(cell);
+      fresh_values.reinit(cell);
+      const std::array<double, 3> difference =
+        compare_values(fe_values, fresh_values);
+      for (unsigned int d = 0; d < 3; ++d)
+        cell_difference[d] = std::max(cell_difference[d], difference[d]);
+      for (unsigned int i = 0; i < fe_values.dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+          sum_of_gradients += fe_values.shape_grad(i, q).norm_square();
+
+      for (const unsigned int f : cell->face_indices())
+        {
+          FEFaceValues<dim> fresh_face_values(mapping,
+                                              fe,
+                                              face_quadrature,
+                                              flags);
+          fe_face_values.reinit(cell, f);
+          fresh_face_values.reinit(cell, f);
+          const std::array<double, 3> difference =
+            compare_values(fe_face_values, fresh_face_values);
+          for (unsigned int d = 0; d < 3; ++d)
+            face_difference[d] = std::max(face_difference[d], difference[d]);
+        }
+    }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", sum of squared gradients: " << sum_of_gradients << std::endl;
+  print_difference("difference of values, gradients, Hessians on cells",
+                        cell_difference);
+  print_difference("difference of values, gradients, Hessians on faces",
+                        face_difference);
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<2>(0);
+  test<2>(1);
+  test<2>(2);
+  test<3>(0);
+  test<3>(1);
+
+  return 0;
+}
@@ -0,0 +1,183 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test the hanging node constraints and the embedding matrices of
+ * FE_Hermite. The degrees of freedom of a polynomial in the finite element
+ * space are set to its derivatives at the vertices on a locally refined
+ * mesh with anisotropic cells. The hanging node constraints must leave these
+ * values unchanged, interpolation from a parent cell to its children must
+ * reproduce them on the children, and interpolation from the children to
+ * the parent must reproduce them on the parent.
+ */
+
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// degrees of freedom of a product of 1D polynomials of the degree of the
+// element: the derivatives with the orders given by the index of the degree
+// of freedom at a vertex, normalized by the corresponding derivatives of the
+// 1D Hermite basis
+template <int dim>
+double
+vertex_dof_value(
+  const std::vector<Polynomials::Polynomial<double>> &polynomials,
+  const Point<dim> &                                   p,
+  const unsigned int                                   regularity,
+  const unsigned int                                   vertex_dof)
+{
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+
+  double              result = 1.;
+  unsigned int        index  = vertex_dof;
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int d = 0; d < dim; ++d, index /= regularity + 1)
+    {
+      const unsigned int m = index % (regularity + 1);
+      polynomials[d].value(p[d], values);
+      basis_1d[m].value(0., basis_values);
+      result *= values[m] / basis_values[m];
+    }
+  return result;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5 + 0.25 * d, 1.0};
+      p2[d]         = 1.5 + 0.25 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+  tr.refine_global(1);
+  tr.begin_active()->set_refine_flag();
+  tr.execute_coarsening_and_refinement();
+
+  FE_Hermite<dim> fe(regularity);
+  DoFHandler<dim> dof(tr);
+  dof.distribute_dofs(fe);
+
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(fe.degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+
+  const unsigned int dofs_per_vertex = fe.n_dofs_per_vertex();
+
+  Vector<double> exact(dof.n_dofs());
+  for (const auto &cell : dof.active_cell_iterators())
+    for (const unsigned int v : cell->vertex_indices())
+      for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+        exact(cell->vertex_dof_index(v, i)) =
+          vertex_dof_value(polynomials, cell->vertex(v), regularity, i);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+
+  Vector<double> constrained(exact);
+  constraints.distribute(constrained);
+  constrained -= exact;
+  const double constraints_error =
+    constrained.linfty_norm() / exact.linfty_norm();
+
+  // interpolate from the parent cell to the children and back
+  double         prolongation_error = 0., restriction_error = 0.;
+  Vector<double> local_parent(fe.n_dofs_per_cell()),
+    local_exact(fe.n_dofs_per_cell());
+  for (const auto &cell : dof.cell_iterators())
+    if (cell->has_children())
+      {
+        for (const unsigned int v : cell->vertex_indices())
+          for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+            local_exact(v * dofs_per_vertex + i) =
+              vertex_dof_value(polynomials, cell->vertex(v), regularity, i);
+
+        cell->get_interpolated_dof_values(exact, local_parent);
+        local_parent -= local_exact;
+        restriction_error =
+          std::max(restriction_error,
+                   local_parent.linfty_norm() / local_exact.linfty_norm());
+
+        Vector<double> prolongated(dof.n_dofs());
+        cell->set_dof_values_by_interpolation(local_exact, prolongated);
+        for (unsigned int c = 0; c < cell->n_children(); ++c)
+          if (cell->child(c)->is_active())
+            for (const unsigned int v : cell->vertex_indices())
+              for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+                {
+                  const types::global_dof_index index =
+                    cell->child(c)->vertex_dof_index(v, i);
+                  prolongation_error =
+                    std::max(prolongation_error,
+                             std::abs(prolongated(index) - exact(index)) /
+                               exact.linfty_norm());
+                }
+      }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", constraints: " << constraints.n_constraints()
+          << ", relative errors of constraints: "
+          << filter_out_small_numbers(constraints_error, 1e-10)
+          << ", prolongation: "
+          << filter_out_small_numbers(prolongation_error, 1e-10)
+          << ", restriction: "
+          << filter_out_small_numbers(restriction_error, 1e-10) << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<2>(0);
+  test<2>(1);
+  test<2>(2);
+  test<3>(0);
+  test<3>(1);
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test VectorTools::HermiteProjector, which keeps the factorization of the
+ * mass matrices between projections. A time dependent function is projected
+ * at several times, one at a time and in a batch, and its boundary values
+ * are projected with changing projection modes. The results are compared
+ * against VectorTools::project and VectorTools::project_boundary_values,
+ * which assemble the matrices on every call.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class TravellingWave : public Function<dim>
+{
+public:
+  TravellingWave(const double time)
+    : Function<dim>(1, time)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double result = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      result *= std::sin(p[d] - (d + 1.) * this->get_time());
+    return result;
+  }
+};
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  const QGauss<dim>     quadrature(fe.degree + 1);
+  const QGauss<dim - 1> face_quadrature(fe.degree + 1);
+
+  VectorTools::HermiteProjector<dim> projector(
+    mapping, dof, constraints, quadrature, face_quadrature);
+
+  TravellingWave<dim>              wave(0.);
+  std::vector<TravellingWave<dim>> waves;
+  for (unsigned int step = 0; step < 3; ++step)
+    waves.emplace_back(0.1 * step);
+
+  deallog << "dim=" << dim << ", regularity=" << regularity << std::endl;
+
+  std::vector<const Function<dim> *> batch;
+  for (const auto &w : waves)
+    batch.push_back(&w);
+  std::vector<Vector<double>> batch_result;
+  projector.project(batch, batch_result);
+
+  for (unsigned int step = 0; step < waves.size(); ++step)
+    {
+      wave.set_time(0.1 * step);
+
+      Vector<double> reference(dof.n_dofs()), result(dof.n_dofs());
+      VectorTools::project(
+        mapping, dof, constraints, quadrature, wave, reference);
+      projector.project(wave, result);
+
+      result -= reference;
+      batch_result[step] -= reference;
+
+      std::map<types::boundary_id, const Function<dim> *> boundary_functions;
+      for (const types::boundary_id id : tr.get_boundary_ids())
+        boundary_functions[id] = &wave;
+
+      const VectorTools::HermiteBoundaryType mode =
+        (regularity > 0 && step == 1) ?
+          VectorTools::HermiteBoundaryType::hermite_neumann :
+          VectorTools::HermiteBoundaryType::hermite_dirichlet;
+
+      std::map<types::global_dof_index, double> reference_values,
+        boundary_values;
+      VectorTools::project_boundary_values(
+        mapping, dof, boundary_functions, face_quadrature, mode, reference_values);
+      projector.project_boundary_values(boundary_functions,
+                                        mode,
+                                        boundary_values);
+
+      AssertDimension(boundary_values.size(), reference_values.size());
+      double boundary_error = 0.;
+      for (const auto &value : reference_values)
+        {
+          AssertThrow(boundary_values.find(value.first) !=
+                        boundary_values.end(),
+                      ExcInternalError());
+          boundary_error =
+            std::max(boundary_error,
+                     std::abs(boundary_values[value.first] - value.second));
+        }
+
+      deallog << "time=" << wave.get_time()
+              << ", norm of projection: " << reference.l2_norm()
+              << ", relative errors of project: "
+              << filter_out_small_numbers(result.linfty_norm() /
+                                            reference.linfty_norm(),
+                                          1e-8)
+              << ", batch: "
+              << filter_out_small_numbers(batch_result[step].linfty_norm() /
+                                            reference.linfty_norm(),
+                                          1e-8)
+              << ", boundary values: " << boundary_values.size()
+              << ", error: " << filter_out_small_numbers(boundary_error, 1e-8)
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<1>(1);
+  test<2>(0);
+  test<2>(1);
+  test<3>(1);
+
+  return 0;
+}
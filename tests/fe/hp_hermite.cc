@@ -0,0 +1,261 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test FE_Hermite elements of different regularity and number of
+ * interpolation nodes in an hp::FECollection, arranged in a checkerboard
+ * pattern on a mesh with cells of different sizes. A polynomial of the
+ * lowest degree in the collection must be left unchanged by the hp
+ * constraints, and a random vector must be continuous across the faces
+ * between different elements after distributing the constraints, including
+ * its gradient if all elements are continuously differentiable.
+ */
+
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/fe_values.h>
+#include <deal.II/hp/mapping_collection.h>
+#include <deal.II/hp/q_collection.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// degrees of freedom of the product of 1D polynomials on the box with the
+// given lower corner and extents, see tests/fe/custom_nodes_hermite.cc
+template <int dim>
+Vector<double>
+cell_dof_values(const FE_Hermite<dim> &                             fe,
+                const std::vector<Polynomials::Polynomial<double>> &polynomials,
+                const Point<dim> &                                  lower,
+                const Tensor<1, dim> &                              extents)
+{
+  const unsigned int regularity = fe.get_regularity();
+  const unsigned int n_dofs_1d  = fe.degree + 1;
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    (fe.n_nodes() == 0) ?
+      Polynomials::HermiteMaxreg::generate_complete_basis(regularity) :
+      Polynomials::HermiteCustomreg::generate_complete_basis(fe.degree,
+                                                             regularity);
+  const std::vector<Point<1>> nodes =
+    (fe.n_nodes() == 0) ?
+      std::vector<Point<1>>() :
+      Polynomials::HermiteCustomreg::create_chebyshevgausslobatto_nodes(
+        fe.n_nodes());
+
+  std::vector<double>       position(n_dofs_1d);
+  std::vector<unsigned int> order(n_dofs_1d, 0);
+  for (unsigned int m = 0; m <= regularity; ++m)
+    {
+      position[m]                          = 0.;
+      order[m]                             = m;
+      position[fe.degree - regularity + m] = 1.;
+      order[fe.degree - regularity + m]    = m;
+    }
+  for (unsigned int i = 0; i < fe.n_nodes(); ++i)
+    position[regularity + 1 + i] = nodes[i](0);
+
+  const std::vector<unsigned int> numbering = fe.get_poly_space_numbering();
+  Vector<double>      result(fe.n_dofs_per_cell());
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+    {
+      double value = 1.;
+      for (unsigned int d = 0, index = numbering[i]; d < dim;
+           ++d, index /= n_dofs_1d)
+        {
+          const unsigned int a = index % n_dofs_1d;
+          polynomials[d].value(lower[d] + position[a] * extents[d], values);
+          basis_1d[a].value(position[a], basis_values);
+          value *= values[order[a]] / basis_values[order[a]];
+        }
+      result(i) = value;
+    }
+  return result;
+}
+
+
+
+template <int dim>
+void
+test(const std::vector<std::pair<unsigned int, unsigned int>> &elements)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  hp::FECollection<dim> fe_collection;
+  unsigned int          min_degree     = numbers::invalid_unsigned_int;
+  unsigned int          min_regularity = numbers::invalid_unsigned_int;
+  for (const auto &element : elements)
+    {
+      const FE_Hermite<dim> fe(element.first, element.second);
+      fe_collection.push_back(fe);
+      min_degree     = std::min(min_degree, fe.degree);
+      min_regularity = std::min(min_regularity, element.first);
+    }
+
+  // checkerboard pattern of the elements
+  DoFHandler<dim> dof(tr);
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      unsigned int index = 0;
+      for (unsigned int d = 0; d < dim; ++d)
+        index += static_cast<unsigned int>(cell->center()[d] > 0.5) +
+                 static_cast<unsigned int>(cell->center()[d] > 0.75 + 0.1 * d);
+      cell->set_active_fe_index(index % fe_collection.size());
+    }
+  dof.distribute_dofs(fe_collection);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof, constraints);
+  constraints.close();
+
+  deallog << "dim=" << dim << ", elements:";
+  for (unsigned int i = 0; i < fe_collection.size(); ++i)
+    deallog << ' ' << fe_collection[i].get_name();
+  deallog << std::endl;
+
+  // the polynomial of the lowest degree, set cell by cell
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(min_degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+
+  Vector<double>                       solution(dof.n_dofs());
+  std::vector<types::global_dof_index> dof_indices;
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      const auto &fe = dynamic_cast<const FE_Hermite<dim> &>(cell->get_fe());
+      dof_indices.resize(fe.n_dofs_per_cell());
+      cell->get_dof_indices(dof_indices);
+      const Vector<double> local_values =
+        cell_dof_values(fe,
+                        polynomials,
+                        cell->vertex(0),
+                        cell->vertex(GeometryInfo<dim>::vertices_per_cell - 1) -
+                          cell->vertex(0));
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        solution(dof_indices[i]) = local_values(i);
+    }
+  Vector<double> distributed(solution);
+  constraints.distribute(distributed);
+  distributed -= solution;
+
+  // jumps of a random vector across the faces between different elements
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = random_value<double>();
+  constraints.distribute(solution);
+
+  hp::MappingCollection<dim> mapping(MappingHermite<dim>{});
+  hp::QCollection<dim - 1>   quadrature(QGauss<dim - 1>(min_degree + 1));
+  const UpdateFlags          update_flags =
+    update_values | update_gradients | update_quadrature_points;
+  hp::FEFaceValues<dim> fe_values(mapping,
+                                  fe_collection,
+                                  quadrature,
+                                  update_flags);
+  hp::FEFaceValues<dim> neighbor_values(mapping,
+                                        fe_collection,
+                                        quadrature,
+                                        update_flags);
+  std::vector<double>         values(quadrature[0].size()),
+    other_values(quadrature[0].size());
+  std::vector<Tensor<1, dim>> gradients(quadrature[0].size()),
+    other_gradients(quadrature[0].size());
+  double values_jump = 0., gradients_jump = 0., points_distance = 0.;
+  for (const auto &cell : dof.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      if (!cell->at_boundary(f) &&
+          cell->neighbor(f)->active_fe_index() != cell->active_fe_index())
+        {
+          fe_values.reinit(cell, f);
+          neighbor_values.reinit(cell->neighbor(f), cell->neighbor_face_no(f));
+          const FEFaceValues<dim> &face_values =
+            fe_values.get_present_fe_values();
+          const FEFaceValues<dim> &other_face_values =
+            neighbor_values.get_present_fe_values();
+          face_values.get_function_values(solution, values);
+          other_face_values.get_function_values(solution, other_values);
+          face_values.get_function_gradients(solution, gradients);
+          other_face_values.get_function_gradients(solution, other_gradients);
+          for (const unsigned int q : face_values.quadrature_point_indices())
+            {
+              points_distance =
+                std::max(points_distance,
+                         face_values.quadrature_point(q).distance(
+                           other_face_values.quadrature_point(q)));
+              values_jump =
+                std::max(values_jump, std::abs(values[q] - other_values[q]));
+              gradients_jump =
+                std::max(gradients_jump,
+                         (gradients[q] - other_gradients[q]).norm());
+            }
+        }
+  AssertThrow(points_distance < 1e-12, ExcInternalError());
+
+  deallog << "dofs=" << dof.n_dofs()
+          << ", constraints=" << constraints.n_constraints()
+          << ", change of the polynomial: "
+          << filter_out_small_numbers(distributed.linfty_norm(), 1e-10)
+          << ", jump of values: " << filter_out_small_numbers(values_jump, 1e-10);
+  if (min_regularity > 0)
+    deallog << ", gradients: " << filter_out_small_numbers(gradients_jump, 1e-9);
+  deallog << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<2>({{0, 0}, {1, 0}});
+  test<2>({{1, 0}, {2, 0}});
+  test<2>({{1, 0}, {1, 1}, {2, 0}});
+  test<2>({{1, 2}, {2, 0}});
+  test<3>({{0, 0}, {1, 0}});
+  test<3>({{1, 0}, {1, 1}});
+
+  return 0;
+}
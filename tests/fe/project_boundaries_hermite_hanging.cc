@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test VectorTools::project_boundary_values with FE_Hermite on adaptively
+ * refined meshes. In 2D, hanging nodes never lie on the boundary, so the
+ * trace of a polynomial of the degree of the element must be recovered
+ * exactly on all boundary faces. In 3D, the boundary faces next to a
+ * refined face have a hanging node on their edge, which is not supported.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class CubicFunction : public Function<dim>
+{
+public:
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double result = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      result *= 0.5 + p[d] * (1. - p[d] * (0.3 + (d + 1) * p[d]));
+    return result;
+  }
+};
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  Triangulation<dim> tr;
+  GridGenerator::hyper_cube(tr);
+  tr.refine_global(2);
+  tr.begin_active()->set_refine_flag();
+  tr.execute_coarsening_and_refinement();
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  const CubicFunction<dim>                            function;
+  std::map<types::boundary_id, const Function<dim> *> boundary_functions;
+  boundary_functions[0] = &function;
+  std::map<types::global_dof_index, double> boundary_values;
+
+  const QGauss<dim - 1> quadrature(fe.degree + 1);
+  try
+    {
+      VectorTools::project_boundary_values(
+        mapping,
+        dof,
+        boundary_functions,
+        quadrature,
+        VectorTools::HermiteBoundaryType::hermite_dirichlet,
+        boundary_values);
+    }
+  catch (const ExceptionBase &e)
+    {
+      deallog << "dim=" << dim << ", regularity=" << regularity << ": "
+              << e.get_exc_name() << std::endl;
+      return;
+    }
+
+  Vector<double> solution(dof.n_dofs());
+  for (const auto &entry : boundary_values)
+    solution(entry.first) = entry.second;
+
+  // the degrees of freedom without a normal derivative determine the trace
+  FEFaceValues<dim>   fe_face_values(mapping,
+                                   fe,
+                                   quadrature,
+                                   update_values | update_quadrature_points);
+  std::vector<double> values(quadrature.size());
+  double              error = 0.;
+  for (const auto &cell : dof.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      if (cell->at_boundary(f))
+        {
+          fe_face_values.reinit(cell, f);
+          fe_face_values.get_function_values(solution, values);
+          for (const unsigned int q : fe_face_values.quadrature_point_indices())
+            error = std::max(error,
+                             std::abs(values[q] - function.value(
+                                                    fe_face_values
+                                                      .quadrature_point(q))));
+        }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", boundary values: " << boundary_values.size()
+          << ", error on the boundary: "
+          << filter_out_small_numbers(error, 1e-10) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+
+  return 0;
+}
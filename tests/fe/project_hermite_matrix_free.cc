@@ -0,0 +1,196 @@
+/*
+ * Test the matrix-free path of VectorTools::project with MappingHermite,
+ * which is taken for LinearAlgebra::distributed::Vector. A polynomial in the
+ * finite element space is projected on a mesh with cells of different
+ * sizes and aspect ratios, so the result must match its derivatives at the
+ * vertices. With interpolation nodes inside the cells, the projected
+ * function must match the polynomial at the quadrature points instead. The
+ * result is also compared against the sparse matrix path taken for
+ * Vector<double>.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// degrees of freedom of a product of 1D polynomials of the degree of the
+// element, see hanging_nodes_hermite.cc
+template <int dim>
+double
+vertex_dof_value(
+  const std::vector<Polynomials::Polynomial<double>> &polynomials,
+  const Point<dim> &                                   p,
+  const unsigned int                                   regularity,
+  const unsigned int                                   vertex_dof)
+{
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+
+  double              result = 1.;
+  unsigned int        index  = vertex_dof;
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int d = 0; d < dim; ++d, index /= regularity + 1)
+    {
+      const unsigned int m = index % (regularity + 1);
+      polynomials[d].value(p[d], values);
+      basis_1d[m].value(0., basis_values);
+      result *= values[m] / basis_values[m];
+    }
+  return result;
+}
+
+
+
+template <int dim>
+class ProductPolynomial : public Function<dim>
+{
+public:
+  ProductPolynomial(
+    const std::vector<Polynomials::Polynomial<double>> &polynomials)
+    : polynomials(polynomials)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double result = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      result *= polynomials[d].value(p[d]);
+    return result;
+  }
+
+private:
+  const std::vector<Polynomials::Polynomial<double>> polynomials;
+};
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity, const unsigned int nodes = 0)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity, nodes);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(fe.degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  const QGauss<dim> quadrature(fe.degree + 1);
+
+  LinearAlgebra::distributed::Vector<double> projected(dof.n_dofs());
+  VectorTools::project(mapping,
+                       dof,
+                       constraints,
+                       quadrature,
+                       ProductPolynomial<dim>(polynomials),
+                       projected);
+
+  Vector<double> projected_sparse(dof.n_dofs());
+  VectorTools::project(mapping,
+                       dof,
+                       constraints,
+                       quadrature,
+                       ProductPolynomial<dim>(polynomials),
+                       projected_sparse);
+
+  bool matrix_free_ok = true, sparse_ok = true;
+  if (nodes == 0)
+    {
+      Vector<double> exact(dof.n_dofs());
+      for (const auto &cell : dof.active_cell_iterators())
+        for (const unsigned int v : cell->vertex_indices())
+          for (unsigned int i = 0; i < fe.n_dofs_per_vertex(); ++i)
+            exact(cell->vertex_dof_index(v, i)) =
+              vertex_dof_value(polynomials, cell->vertex(v), regularity, i);
+      for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+        if (std::abs(projected(i) - exact(i)) > 1e-8 * exact.linfty_norm())
+          matrix_free_ok = false;
+    }
+  else
+    {
+      const ProductPolynomial<dim> function(polynomials);
+      FEValues<dim>                fe_values(mapping,
+                                  fe,
+                                  quadrature,
+                                  update_values | update_quadrature_points);
+      std::vector<double>          values(quadrature.size());
+      for (const auto &cell : dof.active_cell_iterators())
+        {
+          fe_values.reinit(cell);
+          fe_values.get_function_values(projected, values);
+          for (const unsigned int q : fe_values.quadrature_point_indices())
+            if (std::abs(values[q] -
+                         function.value(fe_values.quadrature_point(q))) > 1e-8)
+              matrix_free_ok = false;
+        }
+    }
+  for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+    if (std::abs(projected_sparse(i) - projected(i)) >
+        1e-8 * projected.linfty_norm())
+      sparse_ok = false;
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", nodes=" << nodes
+          << ", matrix-free: " << (matrix_free_ok ? "OK" : "FAILED")
+          << ", sparse: " << (sparse_ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<1>(1);
+  test<1>(2);
+  test<2>(0);
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+  test<2>(1, 1);
+  test<2>(1, 2);
+  test<3>(0, 2);
+
+  return 0;
+}
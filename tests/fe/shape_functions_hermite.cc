@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test the shape function tables of FE_Hermite, which are filled with
+ * kernels for a regularity known at compile time for regularity 0 to 3 and
+ * with the general polynomial space otherwise. The values and the first
+ * three derivatives computed by FEValues on the unit cell, where no
+ * rescaling takes place, are compared against the ones of the polynomial
+ * space returned by FE_Poly::shape_value() and related functions.
+ */
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  Triangulation<dim> tr;
+  GridGenerator::hyper_cube(tr);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  const QGauss<dim> quadrature(fe.degree + 1);
+  FEValues<dim>     fe_values(mapping,
+                              fe,
+                              quadrature,
+                              update_values | update_gradients |
+                                update_hessians | update_3rd_derivatives);
+  fe_values.reinit(dof.begin_active());
+
+  double values_error = 0., gradients_error = 0., hessians_error = 0.,
+         third_derivatives_error = 0., sum_of_values = 0.;
+  for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+    for (unsigned int q = 0; q < quadrature.size(); ++q)
+      {
+        const Point<dim> &p = quadrature.point(q);
+        sum_of_values += fe_values.shape_value(i, q) * fe_values.shape_value(i, q);
+        values_error =
+          std::max(values_error,
+                   std::abs(fe_values.shape_value(i, q) - fe.shape_value(i, p)));
+        gradients_error =
+          std::max(gradients_error,
+                   (fe_values.shape_grad(i, q) - fe.shape_grad(i, p)).norm());
+        hessians_error = std::max(
+          hessians_error,
+          (fe_values.shape_hessian(i, q) - fe.shape_grad_grad(i, p)).norm());
+        third_derivatives_error =
+          std::max(third_derivatives_error,
+                   (fe_values.shape_3rd_derivative(i, q) -
+                    fe.shape_3rd_derivative(i, p))
+                     .norm());
+      }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", sum of squared values: " << sum_of_values << std::endl;
+  deallog << "errors of values: "
+          << filter_out_small_numbers(values_error, 1e-10)
+          << ", gradients: " << filter_out_small_numbers(gradients_error, 1e-10)
+          << ", hessians: " << filter_out_small_numbers(hessians_error, 1e-8)
+          << ", 3rd derivatives: "
+          << filter_out_small_numbers(third_derivatives_error, 1e-7)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  for (unsigned int regularity = 0; regularity < 5; ++regularity)
+    test<1>(regularity);
+  for (unsigned int regularity = 0; regularity < 5; ++regularity)
+    test<2>(regularity);
+  for (unsigned int regularity = 0; regularity < 4; ++regularity)
+    test<3>(regularity);
+
+  return 0;
+}
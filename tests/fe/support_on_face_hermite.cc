@@ -0,0 +1,201 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test FE_Hermite::has_support_on_face() against the values of the shape
+ * functions on the faces of the reference cell, and check that the boundary
+ * mass matrix of MatrixCreator, which only assembles the shape functions
+ * with support on a face, agrees with the one assembled from all shape
+ * functions of the cell.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/matrix_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test_support(const unsigned int regularity, const unsigned int nodes)
+{
+  const FE_Hermite<dim> fe(regularity, nodes);
+  const QGauss<dim>     quadrature(fe.degree + 1);
+
+  unsigned int n_mismatches = 0;
+  unsigned int n_supported  = 0;
+  for (const unsigned int f : GeometryInfo<dim>::face_indices())
+    for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+      {
+        // move the quadrature points onto the face
+        double max_value = 0.;
+        for (unsigned int q = 0; q < quadrature.size(); ++q)
+          {
+            Point<dim> p = quadrature.point(q);
+            p[f / 2]     = f % 2;
+            max_value    = std::max(max_value, std::abs(fe.shape_value(i, p)));
+          }
+        if ((max_value > 1e-12) != fe.has_support_on_face(i, f))
+          ++n_mismatches;
+        if (fe.has_support_on_face(i, f))
+          ++n_supported;
+      }
+
+  deallog << fe.get_name() << ", supported dofs per face: "
+          << n_supported / GeometryInfo<dim>::faces_per_cell << " of "
+          << fe.n_dofs_per_face() << ", mismatches with the shape values: "
+          << n_mismatches << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_boundary_mass_matrix(const unsigned int regularity)
+{
+  Point<dim> p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    p2[d] = 1. + 0.5 * d;
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(
+    tr, std::vector<unsigned int>(dim, 3), Point<dim>(), p2);
+
+  const MappingHermite<dim> mapping;
+  const FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>           dof(tr);
+  dof.distribute_dofs(fe);
+
+  const Functions::ConstantFunction<dim> function(1.);
+  std::map<types::boundary_id, const Function<dim> *> boundary_functions;
+  boundary_functions[0] = &function;
+
+  std::vector<types::global_dof_index> dof_to_boundary_mapping;
+  DoFTools::map_dof_to_boundary_indices(dof,
+                                        {types::boundary_id(0)},
+                                        dof_to_boundary_mapping);
+  const types::global_dof_index n_boundary_dofs = dof.n_boundary_dofs();
+
+  DynamicSparsityPattern dsp(n_boundary_dofs, n_boundary_dofs);
+  DoFTools::make_boundary_sparsity_pattern(dof,
+                                           boundary_functions,
+                                           dof_to_boundary_mapping,
+                                           dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  SparseMatrix<double> matrix(sparsity);
+  Vector<double>       rhs(n_boundary_dofs);
+
+  const QGauss<dim - 1> quadrature(fe.degree + 1);
+  MatrixCreator::create_boundary_mass_matrix(mapping,
+                                             dof,
+                                             quadrature,
+                                             matrix,
+                                             boundary_functions,
+                                             rhs,
+                                             dof_to_boundary_mapping);
+
+  // assemble the same matrix from all shape functions of the cell
+  FullMatrix<double> reference(n_boundary_dofs, n_boundary_dofs);
+  Vector<double>     reference_rhs(n_boundary_dofs);
+  FEFaceValues<dim>  fe_values(mapping,
+                              fe,
+                              quadrature,
+                              update_values | update_JxW_values);
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  for (const auto &cell : dof.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      if (cell->at_boundary(f))
+        {
+          fe_values.reinit(cell, f);
+          cell->get_dof_indices(dof_indices);
+          for (const unsigned int i : fe_values.dof_indices())
+            {
+              const types::global_dof_index row =
+                dof_to_boundary_mapping[dof_indices[i]];
+              if (row == numbers::invalid_dof_index)
+                continue;
+              for (const unsigned int q : fe_values.quadrature_point_indices())
+                {
+                  reference_rhs(row) +=
+                    fe_values.shape_value(i, q) * fe_values.JxW(q);
+                  for (const unsigned int j : fe_values.dof_indices())
+                    if (dof_to_boundary_mapping[dof_indices[j]] !=
+                        numbers::invalid_dof_index)
+                      reference(row, dof_to_boundary_mapping[dof_indices[j]]) +=
+                        fe_values.shape_value(i, q) *
+                        fe_values.shape_value(j, q) * fe_values.JxW(q);
+                }
+            }
+        }
+
+  double error = 0.;
+  for (unsigned int i = 0; i < n_boundary_dofs; ++i)
+    {
+      error = std::max(error, std::abs(rhs(i) - reference_rhs(i)));
+      for (unsigned int j = 0; j < n_boundary_dofs; ++j)
+        error = std::max(error, std::abs(matrix.el(i, j) - reference(i, j)));
+    }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", norm of boundary mass matrix: " << matrix.frobenius_norm()
+          << ", of right hand side: " << rhs.l2_norm()
+          << ", difference to the full assembly: "
+          << filter_out_small_numbers(error, 1e-12) << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test_support<1>(0, 0);
+  test_support<1>(2, 1);
+  test_support<2>(0, 0);
+  test_support<2>(1, 0);
+  test_support<2>(2, 0);
+  test_support<2>(1, 2);
+  test_support<3>(1, 0);
+  test_support<3>(1, 1);
+
+  test_boundary_mass_matrix<2>(0);
+  test_boundary_mass_matrix<2>(1);
+  test_boundary_mass_matrix<2>(2);
+  test_boundary_mass_matrix<3>(1);
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test TensorProductMatrixHermite for a linear combination of the mass and
+ * Laplace matrices of FE_Hermite on an axis-parallel cell, as in
+ * tensor_product_matrix_hermite_01.cc. The inverse is computed by the fast
+ * diagonalization method, which needs LAPACK.
+ */
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int regularity, const unsigned int nodes)
+{
+  Point<dim>     p1, p2;
+  Tensor<1, dim> extents;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      p1[d]      = 0.2 * d - 0.3;
+      extents[d] = 0.7 + 0.3 * d;
+      p2[d]      = p1[d] + extents[d];
+    }
+  Triangulation<dim> tr;
+  GridGenerator::hyper_rectangle(tr, p1, p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity, nodes);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  // the matrix in lexicographic numbering
+  const unsigned int              n_dofs    = fe.n_dofs_per_cell();
+  const std::vector<unsigned int> numbering = fe.get_poly_space_numbering();
+  const QGauss<dim>               quadrature(fe.degree + 1);
+  FEValues<dim>                   fe_values(mapping,
+                                            fe,
+                                            quadrature,
+                                            update_values | update_gradients |
+                                              update_JxW_values);
+  fe_values.reinit(dof.begin_active());
+  const double       mass_factor = 2.5, laplace_factor = 0.4;
+  FullMatrix<double> cell_matrix(n_dofs, n_dofs);
+  for (const unsigned int q : fe_values.quadrature_point_indices())
+    for (unsigned int i = 0; i < n_dofs; ++i)
+      for (unsigned int j = 0; j < n_dofs; ++j)
+        cell_matrix(numbering[i], numbering[j]) +=
+          (mass_factor * fe_values.shape_value(i, q) *
+             fe_values.shape_value(j, q) +
+           laplace_factor * fe_values.shape_grad(i, q) *
+             fe_values.shape_grad(j, q)) *
+          fe_values.JxW(q);
+
+  TensorProductMatrixHermite<dim> matrix(fe,
+                                         extents,
+                                         mass_factor,
+                                         laplace_factor);
+
+  Vector<double> src(n_dofs), dst(n_dofs), reference(n_dofs),
+    inverse(n_dofs);
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    src(i) = random_value<double>();
+
+  matrix.vmult(make_array_view(dst), make_array_view(std::as_const(src)));
+  cell_matrix.vmult(reference, src);
+  reference -= dst;
+  const double vmult_error = reference.l2_norm() / dst.l2_norm();
+
+  matrix.apply_inverse(make_array_view(inverse),
+                       make_array_view(std::as_const(dst)));
+  inverse -= src;
+  const double inverse_error = inverse.l2_norm() / src.l2_norm();
+
+  deallog << "dim=" << dim << ", " << fe.get_name()
+          << ", norm of product: " << dst.l2_norm()
+          << ", relative errors of vmult: "
+          << filter_out_small_numbers(vmult_error, 1e-12)
+          << ", inverse: " << filter_out_small_numbers(inverse_error, 1e-9)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<1>(0, 0);
+  test<1>(2, 0);
+  test<2>(0, 0);
+  test<2>(1, 0);
+  test<2>(2, 0);
+  test<2>(1, 1);
+  test<3>(1, 0);
+  test<3>(0, 2);
+
+  return 0;
+}
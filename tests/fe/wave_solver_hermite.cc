@@ -234,6 +234,9 @@ test_wave_solver(const double initial_time, const unsigned int regularity)
     std::map<types::boundary_id, const Function<dim>*> boundary_functions;
     boundary_functions.emplace(std::make_pair(0U, &wave));
     if (dim == 1) boundary_functions.emplace(std::make_pair(1U, &wave));
+    
+    //The boundary mass matrix is factorized once and reused in every time step
+    VectorTools::HermiteProjector<dim> boundary_projector(mapping_h, dof, constraints, quadrature, face_quadrature);
 
     SparseDirectUMFPACK mass_inv;
     
@@ -250,12 +253,9 @@ test_wave_solver(const double initial_time, const unsigned int regularity)
     sol_next = 0;
     
     wave.update_time(dt);
-    VectorTools::project_boundary_values(mapping_h,
-                                         dof,
-                                         boundary_functions,
-                                         face_quadrature,
-                                         VectorTools::HermiteBoundaryType::hermite_dirichlet,
-                                         boundary_values);
+    boundary_projector.project_boundary_values(boundary_functions,
+                                               VectorTools::HermiteBoundaryType::hermite_dirichlet,
+                                               boundary_values);
     
     mass_solve.copy_from(mass);
     MatrixTools::apply_boundary_values(boundary_values, mass_solve, sol_next, temp, true);
@@ -281,12 +281,9 @@ test_wave_solver(const double initial_time, const unsigned int regularity)
         sol_next = 0;
         
         wave.update_time(dt);
-        VectorTools::project_boundary_values(mapping_h,
-                                             dof,
-                                             boundary_functions,
-                                             face_quadrature,
-                                             VectorTools::HermiteBoundaryType::hermite_dirichlet,
-                                             boundary_values);
+        boundary_projector.project_boundary_values(boundary_functions,
+                                                   VectorTools::HermiteBoundaryType::hermite_dirichlet,
+                                                   boundary_values);
         
         mass_solve.copy_from(mass);
         MatrixTools::apply_boundary_values(boundary_values, mass_solve, sol_next, temp, true);
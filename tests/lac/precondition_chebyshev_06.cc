@@ -0,0 +1,323 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test the Chebyshev polynomials of the fourth kind and their optimized
+// variant in PreconditionChebyshev against the formulation with the
+// residual given by Lottes (2022), both for the fused vector updates with
+// DiagonalMatrix and for a generic preconditioner. Also check that step() is
+// consistent with vmult(), print the damping of a low and a high frequency
+// for all polynomial types, and check that the optimized coefficients reduce
+// the smoothing bound of the error polynomial for all degrees.
+
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+
+class DiagonalMatrixManual
+{
+public:
+  void
+  reinit(const SparseMatrix<double> &matrix)
+  {
+    diagonal.reinit(matrix.m());
+    for (unsigned int i = 0; i < matrix.m(); ++i)
+      diagonal(i) = 1. / matrix.diag_element(i);
+  }
+
+  typename Vector<double>::size_type
+  m() const
+  {
+    return diagonal.size();
+  }
+
+  void
+  vmult(Vector<double> &dst, const Vector<double> &src) const
+  {
+    dst = src;
+    dst.scale(diagonal);
+  }
+
+private:
+  Vector<double> diagonal;
+};
+
+
+
+// the fourth-kind Chebyshev smoother in the form of Lottes (2022), with the
+// increments weighted by beta in the optimized case
+void
+apply_reference(const SparseMatrix<double> &matrix,
+                const bool                  optimal,
+                const unsigned int          degree,
+                const double                max_eigenvalue,
+                Vector<double> &            solution,
+                const Vector<double> &      rhs)
+{
+  const auto beta = [&](const unsigned int i) {
+    return optimal ? internal::PreconditionChebyshevImplementation::
+                       optimal_fourth_kind_coefficient(degree, i) :
+                     1.;
+  };
+
+  Vector<double> residual(rhs.size()), update(rhs.size()), tmp(rhs.size());
+  matrix.residual(residual, solution, rhs);
+  for (unsigned int i = 0; i < rhs.size(); ++i)
+    update(i) =
+      4. / (3. * max_eigenvalue) * residual(i) / matrix.diag_element(i);
+  solution.add(beta(0), update);
+  for (unsigned int k = 1; k < degree; ++k)
+    {
+      matrix.vmult(tmp, update);
+      residual -= tmp;
+      for (unsigned int i = 0; i < rhs.size(); ++i)
+        update(i) = (2. * k - 1.) / (2. * k + 3.) * update(i) +
+                    (8. * k + 4.) / ((2. * k + 3.) * max_eigenvalue) *
+                      residual(i) / matrix.diag_element(i);
+      solution.add(beta(k), update);
+    }
+}
+
+
+
+template <typename PreconditionerType>
+void
+check(const SparseMatrix<double> &                matrix,
+      const std::shared_ptr<PreconditionerType> &preconditioner)
+{
+  using ChebyshevType = PreconditionChebyshev<SparseMatrix<double>,
+                                              Vector<double>,
+                                              PreconditionerType>;
+  using PolynomialType =
+    typename ChebyshevType::AdditionalData::PolynomialType;
+
+  const unsigned int size = matrix.m();
+
+  Vector<double> rhs(size), initial(size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      rhs(i)     = random_value<double>();
+      initial(i) = random_value<double>();
+    }
+
+  for (const bool optimal : {false, true})
+    for (unsigned int degree = 1; degree <= 16; ++degree)
+      {
+        typename ChebyshevType::AdditionalData data;
+        data.degree              = degree;
+        data.polynomial_type     = optimal ?
+                                     PolynomialType::fourth_kind_optimal :
+                                     PolynomialType::fourth_kind;
+        data.eig_cg_n_iterations = 0;
+        data.max_eigenvalue      = 2.;
+        data.preconditioner      = preconditioner;
+
+        ChebyshevType prec;
+        prec.initialize(matrix, data);
+
+        // vmult starts from a zero initial guess
+        Vector<double> result(size), reference(size);
+        prec.vmult(result, rhs);
+        apply_reference(matrix, optimal, degree, 2., reference, rhs);
+        reference -= result;
+        const double error_vmult = reference.linfty_norm();
+
+        // step with a nonzero initial guess
+        result    = initial;
+        reference = initial;
+        prec.step(result, rhs);
+        apply_reference(matrix, optimal, degree, 2., reference, rhs);
+        reference -= result;
+        const double error_step = reference.linfty_norm();
+
+        deallog << (optimal ? "optimal     " : "fourth kind ")
+                << "degree " << degree << ": vmult "
+                << (error_vmult < 1e-12 ? "OK" : "FAILED") << ", step "
+                << (error_step < 1e-12 ? "OK" : "FAILED") << std::endl;
+      }
+}
+
+
+
+void
+print_damping(const SparseMatrix<double> &matrix)
+{
+  using ChebyshevType =
+    PreconditionChebyshev<SparseMatrix<double>, Vector<double>>;
+  using PolynomialType = ChebyshevType::AdditionalData::PolynomialType;
+
+  const unsigned int size = matrix.m();
+
+  for (const auto type : {PolynomialType::first_kind,
+                          PolynomialType::fourth_kind,
+                          PolynomialType::fourth_kind_optimal})
+    for (unsigned int degree = 1; degree < 5; ++degree)
+      {
+        ChebyshevType::AdditionalData data;
+        data.degree              = degree;
+        data.smoothing_range     = 10.;
+        data.polynomial_type     = type;
+        data.eig_cg_n_iterations = 0;
+        data.max_eigenvalue      = 2.;
+
+        ChebyshevType prec;
+        prec.initialize(matrix, data);
+
+        // the error propagation applied to the eigenvectors of the lowest
+        // and the highest frequency, which have eigenvalues close to zero
+        // and two, respectively
+        deallog << "type " << static_cast<int>(type) << " degree " << degree
+                << " damping:";
+        for (const unsigned int mode : {1U, size})
+          {
+            Vector<double> error(size), zero(size);
+            for (unsigned int i = 0; i < size; ++i)
+              error(i) = std::sin(numbers::PI * mode * (i + 1) / (size + 1));
+            const double norm = error.l2_norm();
+            prec.step(error, zero);
+            deallog << " " << error.l2_norm() / norm;
+          }
+        deallog << std::endl;
+      }
+}
+
+
+
+using ChebyshevType =
+  PreconditionChebyshev<SparseMatrix<double>, Vector<double>>;
+
+
+
+// evaluate the error propagation polynomial p of the smoother on all
+// eigenvectors of the Jacobi-preconditioned 1D Laplacian, whose normalized
+// eigenvalues x = lambda / 2 densely fill (0, 1), and compute the smoothing
+// bound max_x x p(x)^2 / (1 - p(x)^2) that the coefficients of the optimized
+// fourth-kind polynomials minimize
+double
+compute_smoothing_bound(
+  const SparseMatrix<double> &                         matrix,
+  const ChebyshevType::AdditionalData::PolynomialType type,
+  const unsigned int                                   degree)
+{
+  const unsigned int size = matrix.m();
+
+  ChebyshevType::AdditionalData data;
+  data.degree              = degree;
+  data.polynomial_type     = type;
+  data.eig_cg_n_iterations = 0;
+  data.max_eigenvalue      = 2.;
+
+  ChebyshevType prec;
+  prec.initialize(matrix, data);
+
+  double bound = 0.;
+  for (unsigned int mode = 1; mode <= size; ++mode)
+    {
+      Vector<double> eigenvector(size), error(size), zero(size);
+      for (unsigned int i = 0; i < size; ++i)
+        eigenvector(i) = std::sin(numbers::PI * mode * (i + 1) / (size + 1));
+      error = eigenvector;
+      prec.step(error, zero);
+
+      const double p = (error * eigenvector) / (eigenvector * eigenvector);
+      const double x = 0.5 * (1. - std::cos(numbers::PI * mode / (size + 1)));
+      bound          = std::max(bound, x * p * p / (1. - p * p));
+    }
+  return bound;
+}
+
+
+
+void
+check_smoothing_bound(const SparseMatrix<double> &matrix)
+{
+  using PolynomialType = ChebyshevType::AdditionalData::PolynomialType;
+
+  for (unsigned int degree = 1; degree <= 16; ++degree)
+    {
+      const double bound_fourth_kind =
+        compute_smoothing_bound(matrix, PolynomialType::fourth_kind, degree);
+      const double bound_optimal =
+        compute_smoothing_bound(matrix,
+                                PolynomialType::fourth_kind_optimal,
+                                degree);
+      deallog << "degree " << degree
+              << " smoothing bound fourth kind: " << bound_fourth_kind
+              << " optimal: " << bound_optimal << std::endl;
+      AssertThrow(bound_optimal < bound_fourth_kind, ExcInternalError());
+    }
+}
+
+
+
+void
+make_laplace_matrix(const unsigned int    size,
+                    SparsityPattern &     sparsity,
+                    SparseMatrix<double> &matrix)
+{
+  DynamicSparsityPattern dsp(size, size);
+  for (unsigned int i = 0; i < size; ++i)
+    for (unsigned int j = (i > 0 ? i - 1 : 0); j < std::min(i + 2, size); ++j)
+      dsp.add(i, j);
+  sparsity.copy_from(dsp);
+  matrix.reinit(sparsity);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      matrix.set(i, i, 2.);
+      if (i > 0)
+        matrix.set(i, i - 1, -1.);
+      if (i + 1 < size)
+        matrix.set(i, i + 1, -1.);
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  // the 1D Laplacian with Dirichlet boundary conditions
+  SparsityPattern      sparsity;
+  SparseMatrix<double> matrix;
+  make_laplace_matrix(40, sparsity, matrix);
+
+  auto jacobi = std::make_shared<DiagonalMatrix<Vector<double>>>();
+  jacobi->get_vector().reinit(matrix.m());
+  jacobi->get_vector() = 0.5;
+  check(matrix, jacobi);
+
+  auto jacobi_manual = std::make_shared<DiagonalMatrixManual>();
+  jacobi_manual->reinit(matrix);
+  check(matrix, jacobi_manual);
+  print_damping(matrix);
+
+  // a finer mesh to sample the error polynomial more densely
+  SparsityPattern      fine_sparsity;
+  SparseMatrix<double> fine_matrix;
+  make_laplace_matrix(200, fine_sparsity, fine_matrix);
+  check_smoothing_bound(fine_matrix);
+
+  return 0;
+}
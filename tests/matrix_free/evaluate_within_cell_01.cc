@@ -0,0 +1,166 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that the evaluation and integration of a single cell with the
+// kernels vectorized within the cell (EvaluatorTensorProductWithinCell)
+// gives the same result as the scalar evaluation with the usual kernels, both
+// for the even-odd decomposition and for the general kernels
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/matrix_free/evaluation_kernels.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include "../tests.h"
+
+
+template <int                                        dim,
+          int                                        fe_degree,
+          int                                        n_q_points_1d,
+          internal::MatrixFreeFunctions::ElementType type =
+            internal::MatrixFreeFunctions::tensor_symmetric>
+void
+test()
+{
+  const unsigned int n_components = 2;
+
+  internal::MatrixFreeFunctions::ShapeInfo<double> shape_info;
+  shape_info.reinit(QGauss<1>(n_q_points_1d), FE_Q<dim>(fe_degree));
+
+  const unsigned int n_dofs     = shape_info.dofs_per_component_on_cell;
+  const unsigned int n_q_points = shape_info.n_q_points;
+
+  using EvalDefault =
+    internal::FEEvaluationImpl<type, dim, fe_degree, n_q_points_1d, double>;
+  using EvalWithinCell = internal::
+    FEEvaluationImpl<type, dim, fe_degree, n_q_points_1d, double, true>;
+
+  const EvaluationFlags::EvaluationFlags flags =
+    EvaluationFlags::values | EvaluationFlags::gradients |
+    EvaluationFlags::hessians;
+
+  AlignedVector<double> dofs(n_components * n_dofs);
+  for (double &entry : dofs)
+    entry = random_value<double>();
+
+  AlignedVector<double> values(n_components * n_q_points),
+    gradients(n_components * dim * n_q_points),
+    hessians(n_components * dim * (dim + 1) / 2 * n_q_points),
+    values_ref(values.size()), gradients_ref(gradients.size()),
+    hessians_ref(hessians.size()),
+    scratch(4 * std::max(n_dofs, n_q_points));
+
+  EvalDefault::evaluate(n_components,
+                        flags,
+                        shape_info,
+                        dofs.data(),
+                        values_ref.data(),
+                        gradients_ref.data(),
+                        hessians_ref.data(),
+                        scratch.data());
+  EvalWithinCell::evaluate(n_components,
+                           flags,
+                           shape_info,
+                           dofs.data(),
+                           values.data(),
+                           gradients.data(),
+                           hessians.data(),
+                           scratch.data());
+
+  const auto max_difference = [](const AlignedVector<double> &a,
+                                 const AlignedVector<double> &b) {
+    double difference = 0., norm = 0.;
+    for (unsigned int i = 0; i < a.size(); ++i)
+      {
+        difference = std::max(difference, std::abs(a[i] - b[i]));
+        norm       = std::max(norm, std::abs(b[i]));
+      }
+    return difference / norm;
+  };
+
+  const double error_evaluate =
+    std::max(max_difference(values, values_ref),
+             std::max(max_difference(gradients, gradients_ref),
+                      max_difference(hessians, hessians_ref)));
+
+  // integrate the same quadrature data, once overwriting and once adding
+  // into the values at the degrees of freedom
+  for (unsigned int i = 0; i < values.size(); ++i)
+    values[i] = random_value<double>();
+  for (unsigned int i = 0; i < gradients.size(); ++i)
+    gradients[i] = random_value<double>();
+  for (unsigned int i = 0; i < hessians.size(); ++i)
+    hessians[i] = random_value<double>();
+  values_ref    = values;
+  gradients_ref = gradients;
+  hessians_ref  = hessians;
+
+  AlignedVector<double> dofs_ref(dofs.size());
+  for (const bool add_into_values_array : {false, true})
+    {
+      for (unsigned int i = 0; i < dofs.size(); ++i)
+        dofs[i] = dofs_ref[i] = 1.;
+      EvalDefault::integrate(n_components,
+                             flags,
+                             shape_info,
+                             dofs_ref.data(),
+                             values_ref.data(),
+                             gradients_ref.data(),
+                             hessians_ref.data(),
+                             scratch.data(),
+                             add_into_values_array);
+      EvalWithinCell::integrate(n_components,
+                                flags,
+                                shape_info,
+                                dofs.data(),
+                                values.data(),
+                                gradients.data(),
+                                hessians.data(),
+                                scratch.data(),
+                                add_into_values_array);
+      deallog << "dim=" << dim << " degree=" << fe_degree
+              << " n_q_points_1d=" << n_q_points_1d << " evaluate: "
+              << (error_evaluate < 1e-13 ? "OK" : "FAILED")
+              << ", integrate with add=" << add_into_values_array << ": "
+              << (max_difference(dofs, dofs_ref) < 1e-13 ? "OK" : "FAILED")
+              << std::endl;
+    }
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test<1, 3, 4>();
+  test<2, 1, 2>();
+  test<2, 3, 4>();
+  test<2, 5, 7>();
+  test<2, 8, 9>();
+  test<3, 2, 3>();
+  test<3, 4, 6>();
+  test<3, 7, 8>();
+  test<3, 8, 8>();
+
+  deallog.push("general");
+  test<2, 4, 6, internal::MatrixFreeFunctions::tensor_general>();
+  test<3, 5, 6, internal::MatrixFreeFunctions::tensor_general>();
+  deallog.pop();
+}
@@ -0,0 +1,132 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Compare FEEvaluation with the polynomial degree only known at run time
+// (template argument fe_degree=-1) against FEEvaluation with the degree
+// given as template argument for degrees 8 to 10, which are above
+// FE_EVAL_FACTORY_DEGREE_MAX. If the library is configured with
+// DEAL_II_COMPONENT_MATRIX_FREE_HIGH_DEGREE, the former runs through the
+// precompiled kernels for high degrees, otherwise through the generic
+// fallback. Both must give the same result as the templated kernels.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+
+// mass and Laplace operator, evaluated with the given template arguments of
+// FEEvaluation
+template <int dim, int fe_degree, int n_q_points_1d>
+void
+cell_operation(const MatrixFree<dim, double> &              data,
+               Vector<double> &                             dst,
+               const Vector<double> &                       src,
+               const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  FEEvaluation<dim, fe_degree, n_q_points_1d, 1, double> phi(data);
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values(src);
+      phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        {
+          phi.submit_value(phi.get_value(q), q);
+          phi.submit_gradient(phi.get_gradient(q), q);
+        }
+      phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, int fe_degree, int n_q_points_1d>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  GridTools::distort_random(0.2, tria);
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags =
+    update_values | update_gradients | update_JxW_values;
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(dof,
+                     constraints,
+                     QGauss<1>(n_q_points_1d),
+                     additional_data);
+
+  Vector<double> src(dof.n_dofs()), result(dof.n_dofs()),
+    reference(dof.n_dofs());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  matrix_free.cell_loop(&cell_operation<dim, fe_degree, n_q_points_1d>,
+                        reference,
+                        src,
+                        true);
+  matrix_free.cell_loop(&cell_operation<dim, -1, 0>, result, src, true);
+
+  result -= reference;
+  deallog << "dim=" << dim << ", degree=" << fe_degree
+          << ", n_q_points_1d=" << n_q_points_1d
+          << ", norm of result: " << reference.l2_norm()
+          << ", relative difference: "
+          << filter_out_small_numbers(result.l2_norm() / reference.l2_norm(),
+                                      1e-12)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 8, 9>();
+  test<2, 8, 13>();
+  test<2, 9, 10>();
+  test<2, 10, 11>();
+  test<2, 10, 12>();
+  test<3, 8, 9>();
+}
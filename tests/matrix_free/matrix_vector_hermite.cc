@@ -0,0 +1,197 @@
+/*
+ * Test the matrix-free evaluation of FE_Hermite. The degrees of freedom of
+ * FE_Hermite are derivatives at the vertices, so FEEvaluation needs to
+ * rescale them by powers of the cell extents. The result of a matrix-free
+ * operator with mass, Laplace and biharmonic terms is compared against the
+ * product with a matrix assembled with FEValues and MappingHermite on a
+ * mesh with cells of different sizes and aspect ratios. FEFaceEvaluation
+ * does not support the rescaling and must throw an exception also in release
+ * mode.
+ */
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+cell_operation(const MatrixFree<dim, double> &              data,
+               Vector<double> &                             dst,
+               const Vector<double> &                       src,
+               const std::pair<unsigned int, unsigned int> &cell_range)
+{
+  FEEvaluation<dim, -1, 0, 1, double> phi(data);
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values(src);
+      phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients |
+                   EvaluationFlags::hessians);
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        {
+          phi.submit_value(10. * phi.get_value(q), q);
+          phi.submit_gradient(phi.get_gradient(q), q);
+          phi.submit_hessian(phi.get_hessian(q), q);
+        }
+      phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients |
+                    EvaluationFlags::hessians);
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+  QGauss<1> quadrature(fe.degree + 1);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags =
+    update_values | update_gradients | update_hessians;
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(mapping, dof, constraints, quadrature, additional_data);
+
+  DynamicSparsityPattern dsp(dof.n_dofs());
+  DoFTools::make_sparsity_pattern(dof, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  SparseMatrix<double> matrix(sparsity);
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          QGauss<dim>(fe.degree + 1),
+                          update_values | update_gradients | update_hessians |
+                            update_JxW_values);
+  FullMatrix<double> cell_matrix(fe.n_dofs_per_cell(), fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> local_dof_indices(fe.n_dofs_per_cell());
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell_matrix = 0;
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (const unsigned int i : fe_values.dof_indices())
+          for (const unsigned int j : fe_values.dof_indices())
+            cell_matrix(i, j) +=
+              (10. * fe_values.shape_value(i, q) * fe_values.shape_value(j, q) +
+               fe_values.shape_grad(i, q) * fe_values.shape_grad(j, q) +
+               scalar_product(fe_values.shape_hessian(i, q),
+                              fe_values.shape_hessian(j, q))) *
+              fe_values.JxW(q);
+      cell->get_dof_indices(local_dof_indices);
+      constraints.distribute_local_to_global(cell_matrix,
+                                             local_dof_indices,
+                                             matrix);
+    }
+
+  Vector<double> src(dof.n_dofs()), dst(dof.n_dofs()), ref(dof.n_dofs());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  matrix.vmult(ref, src);
+  matrix_free.cell_loop(&cell_operation<dim>, dst, src, true);
+
+  dst -= ref;
+  deallog << "dim=" << dim << ", regularity=" << regularity << ", error: "
+          << (dst.linfty_norm() < 1e-10 * ref.linfty_norm() ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_faces()
+{
+  Triangulation<dim> tr;
+  GridGenerator::hyper_cube(tr);
+  tr.refine_global(1);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(1);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags                = update_values;
+  additional_data.mapping_update_flags_inner_faces    = update_values;
+  additional_data.mapping_update_flags_boundary_faces = update_values;
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(
+    mapping, dof, constraints, QGauss<1>(fe.degree + 1), additional_data);
+
+  Vector<double> src(dof.n_dofs());
+  FEFaceEvaluation<dim, -1, 0, 1, double> phi(matrix_free, true);
+  phi.reinit(0);
+  try
+    {
+      phi.read_dof_values(src);
+      deallog << "dim=" << dim << ", face evaluation: not rejected"
+              << std::endl;
+    }
+  catch (const ExceptionBase &)
+    {
+      deallog << "dim=" << dim << ", face evaluation: rejected" << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<1>(1);
+  test<1>(2);
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+
+  test_faces<2>();
+
+  return 0;
+}
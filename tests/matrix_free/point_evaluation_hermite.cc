@@ -0,0 +1,157 @@
+/*
+ * Test FEPointEvaluation with FE_Hermite and MappingHermite, which takes the
+ * fast tensor product path and rescales the degrees of freedom with the
+ * cell extents. Values and gradients of a random finite element function at
+ * arbitrary points, and the integration of values and gradients at these
+ * points, are compared against FEValues on a mesh with cells of different
+ * sizes and aspect ratios. Any other mapping would skip the rescaling, so
+ * FE_Hermite together with MappingQ must be rejected.
+ */
+
+#include <deal.II/base/quadrature.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  Vector<double> solution(dof.n_dofs());
+  for (unsigned int i = 0; i < dof.n_dofs(); ++i)
+    solution(i) = random_value<double>();
+
+  std::vector<Point<dim>> unit_points(5);
+  for (Point<dim> &p : unit_points)
+    for (unsigned int d = 0; d < dim; ++d)
+      p[d] = random_value<double>();
+
+  FEPointEvaluation<1, dim> evaluator(mapping,
+                                      fe,
+                                      update_values | update_gradients);
+  FEValues<dim>             fe_values(mapping,
+                                      fe,
+                                      Quadrature<dim>(unit_points),
+                                      update_values | update_gradients);
+
+  std::vector<double> solution_values(fe.n_dofs_per_cell()),
+    integrated(fe.n_dofs_per_cell());
+
+  bool evaluate_ok = true, integrate_ok = true;
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      evaluator.reinit(cell, unit_points);
+
+      cell->get_dof_values(solution,
+                           solution_values.begin(),
+                           solution_values.end());
+      evaluator.evaluate(solution_values,
+                         EvaluationFlags::values | EvaluationFlags::gradients);
+
+      std::vector<double>         values(unit_points.size());
+      std::vector<Tensor<1, dim>> gradients(unit_points.size());
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+
+      for (unsigned int q = 0; q < unit_points.size(); ++q)
+        {
+          if (std::abs(evaluator.get_value(q) - values[q]) >
+                1e-10 * std::max(1., std::abs(values[q])) ||
+              (evaluator.get_gradient(q) - gradients[q]).norm() >
+                1e-10 * std::max(1., gradients[q].norm()))
+            evaluate_ok = false;
+        }
+
+      // test the integration with the values and gradients computed above
+      for (unsigned int q = 0; q < unit_points.size(); ++q)
+        {
+          evaluator.submit_value(values[q], q);
+          evaluator.submit_gradient(gradients[q], q);
+        }
+      evaluator.integrate(integrated,
+                          EvaluationFlags::values | EvaluationFlags::gradients);
+      for (unsigned int i = 0; i < fe.n_dofs_per_cell(); ++i)
+        {
+          double reference = 0.;
+          for (unsigned int q = 0; q < unit_points.size(); ++q)
+            reference += fe_values.shape_value(i, q) * values[q] +
+                         fe_values.shape_grad(i, q) * gradients[q];
+          if (std::abs(integrated[i] - reference) >
+              1e-10 * std::max(1., std::abs(reference)))
+            integrate_ok = false;
+        }
+    }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", evaluate: " << (evaluate_ok ? "OK" : "FAILED")
+          << ", integrate: " << (integrate_ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+void
+test_mapping_q()
+{
+  try
+    {
+      FEPointEvaluation<1, 2> evaluator(MappingQ<2>(1),
+                                        FE_Hermite<2>(1),
+                                        update_values);
+      deallog << "MappingQ: not rejected" << std::endl;
+    }
+  catch (const ExceptionBase &)
+    {
+      deallog << "MappingQ: rejected" << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<1>(1);
+  test<1>(2);
+  test<2>(0);
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+
+  test_mapping_q();
+
+  return 0;
+}
@@ -0,0 +1,282 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test PreconditionVertexPatch: on a mesh of 2^dim anisotropic cells with
+// Dirichlet boundary, the only vertex patch contains all unknowns, so one
+// application of the smoother must solve the system exactly. Then use the
+// additive and multiplicative variants as multigrid smoothers for
+// increasing polynomial degrees, where the iteration counts should stay
+// almost constant.
+
+
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/operators.h>
+#include <deal.II/matrix_free/precondition_vertex_patch.h>
+
+#include <deal.II/multigrid/mg_coarse.h>
+#include <deal.II/multigrid/mg_constrained_dofs.h>
+#include <deal.II/multigrid/mg_matrix.h>
+#include <deal.II/multigrid/mg_smoother.h>
+#include <deal.II/multigrid/mg_transfer_matrix_free.h>
+#include <deal.II/multigrid/multigrid.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+template <int dim, int fe_degree>
+using LevelMatrixType =
+  MatrixFreeOperators::LaplaceOperator<dim, fe_degree, fe_degree + 1, 1>;
+
+
+
+template <int dim, int fe_degree>
+void
+test_exact()
+{
+  // cells of different sizes in each direction
+  Triangulation<dim>               tria;
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p1, p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.3 + 0.1 * d, 0.5 + 0.2 * d};
+      p2[d]         = step_sizes[d][0] + step_sizes[d][1];
+    }
+  GridGenerator::subdivided_hyper_rectangle(tria, step_sizes, p1, p2);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(FE_Q<dim>(fe_degree));
+  AffineConstraints<double> constraints;
+  DoFTools::make_zero_boundary_constraints(dof_handler, constraints);
+  constraints.close();
+
+  auto matrix_free = std::make_shared<MatrixFree<dim, double>>();
+  matrix_free->reinit(MappingQ1<dim>(),
+                      dof_handler,
+                      constraints,
+                      QGauss<1>(fe_degree + 1),
+                      typename MatrixFree<dim, double>::AdditionalData());
+
+  // the Helmholtz operator -Delta u + 0.5 u
+  LevelMatrixType<dim, fe_degree>                   laplace;
+  MatrixFreeOperators::MassOperator<dim, fe_degree> mass;
+  laplace.initialize(matrix_free);
+  mass.initialize(matrix_free);
+
+  using SmootherType =
+    PreconditionVertexPatch<dim, LevelMatrixType<dim, fe_degree>>;
+  typename SmootherType::AdditionalData data;
+  data.variant = SmootherType::AdditionalData::SmootherVariant::additive;
+  data.mass_coefficient = 0.5;
+  SmootherType smoother;
+  smoother.initialize(laplace, data);
+
+  VectorType src, dst, tmp, mass_part;
+  matrix_free->initialize_dof_vector(src);
+  matrix_free->initialize_dof_vector(dst);
+  matrix_free->initialize_dof_vector(tmp);
+  matrix_free->initialize_dof_vector(mass_part);
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    if (constraints.is_constrained(i) == false)
+      src.local_element(i) = random_value<double>();
+
+  // compute the residual src - (A + 0.5 M) dst
+  smoother.vmult(dst, src);
+  laplace.vmult(tmp, dst);
+  mass.vmult(mass_part, dst);
+  tmp.add(0.5, mass_part);
+  tmp.sadd(-1., 1., src);
+  for (const unsigned int i : matrix_free->get_constrained_dofs())
+    tmp.local_element(i) = 0.;
+
+  deallog << "dim=" << dim << " degree=" << fe_degree
+          << " patches: " << smoother.n_patches()
+          << ", residual after one application: "
+          << (tmp.linfty_norm() < 1e-10 * src.linfty_norm() ? "OK" :
+                                                              "FAILED")
+          << std::endl;
+}
+
+
+
+template <typename MatrixType>
+class MGCoarseIterative : public MGCoarseGridBase<VectorType>
+{
+public:
+  void
+  initialize(const MatrixType &matrix)
+  {
+    coarse_matrix = &matrix;
+  }
+
+  virtual void
+  operator()(const unsigned int,
+             VectorType &      dst,
+             const VectorType &src) const override
+  {
+    ReductionControl solver_control(1e4, 1e-50, 1e-10, false, false);
+    SolverCG<VectorType> solver_coarse(solver_control);
+    solver_coarse.solve(*coarse_matrix, dst, src, PreconditionIdentity());
+  }
+
+  const MatrixType *coarse_matrix;
+};
+
+
+
+template <int dim, int fe_degree>
+void
+test_multigrid(const bool multiplicative)
+{
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(6 - dim);
+
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(FE_Q<dim>(fe_degree));
+  dof.distribute_mg_dofs();
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_zero_boundary_constraints(dof, constraints);
+  constraints.close();
+
+  MGConstrainedDoFs mg_constrained_dofs;
+  mg_constrained_dofs.initialize(dof);
+  mg_constrained_dofs.make_zero_boundary_constraints(dof, {0});
+
+  const MappingQ1<dim> mapping;
+
+  auto fine_level_data = std::make_shared<MatrixFree<dim, double>>();
+  fine_level_data->reinit(mapping,
+                          dof,
+                          constraints,
+                          QGauss<1>(fe_degree + 1),
+                          typename MatrixFree<dim, double>::AdditionalData());
+  LevelMatrixType<dim, fe_degree> fine_matrix;
+  fine_matrix.initialize(fine_level_data);
+
+  const unsigned int max_level = tria.n_global_levels() - 1;
+  MGLevelObject<LevelMatrixType<dim, fe_degree>> mg_matrices(0, max_level);
+  for (unsigned int level = 0; level <= max_level; ++level)
+    {
+      typename MatrixFree<dim, double>::AdditionalData additional_data;
+      additional_data.mg_level = level;
+
+      AffineConstraints<double> level_constraints;
+      level_constraints.add_lines(
+        mg_constrained_dofs.get_boundary_indices(level));
+      level_constraints.close();
+
+      auto level_data = std::make_shared<MatrixFree<dim, double>>();
+      level_data->reinit(mapping,
+                         dof,
+                         level_constraints,
+                         QGauss<1>(fe_degree + 1),
+                         additional_data);
+      mg_matrices[level].initialize(level_data, mg_constrained_dofs, level);
+    }
+
+  MGTransferMatrixFree<dim, double> mg_transfer(mg_constrained_dofs);
+  mg_transfer.build(dof);
+
+  MGCoarseIterative<LevelMatrixType<dim, fe_degree>> mg_coarse;
+  mg_coarse.initialize(mg_matrices[0]);
+
+  // the additive variant is damped by the number of patches around each
+  // unknown
+  using SmootherType =
+    PreconditionVertexPatch<dim, LevelMatrixType<dim, fe_degree>>;
+  typename SmootherType::AdditionalData smoother_data;
+  smoother_data.variant =
+    multiplicative ?
+      SmootherType::AdditionalData::SmootherVariant::multiplicative :
+      SmootherType::AdditionalData::SmootherVariant::additive;
+  smoother_data.relaxation = multiplicative ? 1. : 1. / (1 << dim);
+  MGSmootherPrecondition<LevelMatrixType<dim, fe_degree>,
+                         SmootherType,
+                         VectorType>
+    mg_smoother;
+  mg_smoother.initialize(mg_matrices, smoother_data);
+
+  mg::Matrix<VectorType> mg_matrix(mg_matrices);
+  Multigrid<VectorType>  mg(
+    mg_matrix, mg_coarse, mg_transfer, mg_smoother, mg_smoother);
+  PreconditionMG<dim, VectorType, MGTransferMatrixFree<dim, double>>
+    preconditioner(dof, mg, mg_transfer);
+
+  VectorType rhs, solution;
+  fine_matrix.initialize_dof_vector(rhs);
+  fine_matrix.initialize_dof_vector(solution);
+  rhs = 1.;
+  constraints.set_zero(rhs);
+
+  ReductionControl     control(100, 1e-14, 1e-8, false, false);
+  SolverCG<VectorType> solver(control);
+  solver.solve(fine_matrix, solution, rhs, preconditioner);
+
+  deallog << "dim=" << dim << " degree=" << fe_degree
+          << " patches on finest level: "
+          << mg_smoother.smoothers[max_level].n_patches()
+          << ", colors: " << mg_smoother.smoothers[max_level].n_colors()
+          << ", CG iterations: " << control.last_step() << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_multigrid_all_degrees(const bool multiplicative)
+{
+  deallog.push(multiplicative ? "multiplicative" : "additive");
+  test_multigrid<dim, 2>(multiplicative);
+  test_multigrid<dim, 3>(multiplicative);
+  test_multigrid<dim, 4>(multiplicative);
+  deallog.pop();
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_exact<2, 1>();
+  test_exact<2, 3>();
+  test_exact<3, 2>();
+
+  test_multigrid_all_degrees<2>(false);
+  test_multigrid_all_degrees<2>(true);
+  test_multigrid_all_degrees<3>(true);
+
+  return 0;
+}
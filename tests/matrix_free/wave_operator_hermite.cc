@@ -0,0 +1,205 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test MatrixFreeOperators::HermiteWaveOperator with
+ * TimeStepping::LowStorageRungeKutta for the standing wave
+ * u = cos(pi x_1) ... cos(pi x_d) cos(pi sqrt(d) t) on the unit cube, which
+ * satisfies homogeneous Neumann conditions, on a mesh with cells of
+ * different sizes. The inverse mass matrix applied to the right hand side
+ * of the L2 projection must give the projection, and the solution at the
+ * final time must be close to the exact one.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/time_stepping.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/hermite_wave_operator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class StandingWave : public Function<dim>
+{
+public:
+  StandingWave(const double time)
+    : Function<dim>(1, time)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double result = std::cos(numbers::PI * std::sqrt(dim) * this->get_time());
+    for (unsigned int d = 0; d < dim; ++d)
+      result *= std::cos(numbers::PI * p[d]);
+    return result;
+  }
+};
+
+
+
+template <int dim>
+double
+l2_error(const MappingHermite<dim> &                       mapping,
+         const DoFHandler<dim> &                           dof,
+         const Function<dim> &                             function,
+         const LinearAlgebra::distributed::Vector<double> &vector)
+{
+  const QGauss<dim>   quadrature(dof.get_fe().degree + 2);
+  FEValues<dim>       fe_values(mapping,
+                          dof.get_fe(),
+                          quadrature,
+                          update_values | update_quadrature_points |
+                            update_JxW_values);
+  std::vector<double> values(quadrature.size());
+  double              error = 0.;
+  for (const auto &cell : dof.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values.get_function_values(vector, values);
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        error += Utilities::fixed_power<2>(
+                   values[q] - function.value(fe_values.quadrature_point(q))) *
+                 fe_values.JxW(q);
+    }
+  return std::sqrt(error);
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.25, 0.125, 0.125, 0.25, 0.25};
+      p2[d]         = 1.;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  using BlockVectorType = LinearAlgebra::distributed::BlockVector<double>;
+  MatrixFreeOperators::HermiteWaveOperator<dim> wave_operator;
+  wave_operator.reinit(mapping, dof, constraints, QGauss<1>(fe.degree + 1));
+
+  // the inverse mass matrix applied to the right hand side of the L2
+  // projection must return the projection
+  StandingWave<dim>                          function(0.);
+  LinearAlgebra::distributed::Vector<double> rhs, projection, result;
+  wave_operator.initialize_dof_vector(rhs);
+  wave_operator.initialize_dof_vector(projection);
+  wave_operator.initialize_dof_vector(result);
+  VectorTools::project(mapping,
+                       dof,
+                       constraints,
+                       QGauss<dim>(fe.degree + 1),
+                       function,
+                       projection);
+  {
+    const QGauss<dim>                    quadrature(fe.degree + 1);
+    FEValues<dim>                        fe_values(mapping,
+                            fe,
+                            quadrature,
+                            update_values | update_quadrature_points |
+                              update_JxW_values);
+    std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+    for (const auto &cell : dof.active_cell_iterators())
+      {
+        fe_values.reinit(cell);
+        cell->get_dof_indices(dof_indices);
+        for (const unsigned int q : fe_values.quadrature_point_indices())
+          for (const unsigned int i : fe_values.dof_indices())
+            rhs(dof_indices[i]) +=
+              fe_values.shape_value(i, q) *
+              function.value(fe_values.quadrature_point(q)) * fe_values.JxW(q);
+      }
+  }
+  // both are iterative solutions with a mass matrix whose condition number
+  // grows quickly with the regularity, so they only agree to about 1e-6
+  wave_operator.apply_inverse_mass(result, rhs);
+  result -= projection;
+  const double inverse_error = result.linfty_norm() / projection.linfty_norm();
+
+  // integrate in time
+  BlockVectorType solution;
+  wave_operator.initialize_dof_vector(solution);
+  solution.block(0) = projection;
+
+  TimeStepping::LowStorageRungeKutta<BlockVectorType> integrator(
+    TimeStepping::LOW_STORAGE_RK_STAGE5_ORDER4);
+  const double       final_time = 0.4;
+  const unsigned int n_steps    = 50 * fe.degree;
+  const double       time_step  = final_time / n_steps;
+  double             time       = 0.;
+  for (unsigned int step = 0; step < n_steps; ++step)
+    time =
+      wave_operator.evolve_one_time_step(integrator, time, time_step, solution);
+
+  function.set_time(time);
+  const double error = l2_error(mapping, dof, function, solution.block(0));
+
+  std::ostringstream error_string;
+  error_string << std::scientific << std::setprecision(2) << error;
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", error of inverse mass: "
+          << filter_out_small_numbers(inverse_error, 1e-6)
+          << ", mass iterations: " << wave_operator.get_last_mass_iterations()
+          << ", L2 error at t=" << time << ": " << error_string.str()
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<1>(1);
+  test<1>(2);
+  test<2>(1);
+  test<2>(2);
+
+  return 0;
+}
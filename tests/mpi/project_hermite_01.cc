@@ -0,0 +1,168 @@
+/*
+ * Test VectorTools::project with FE_Hermite and MappingHermite on a
+ * parallel::distributed::Triangulation, with the boundary values projected
+ * first. A polynomial in the finite element space is projected, so the
+ * locally owned entries of the result must match its derivatives at the
+ * vertices.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include "../tests.h"
+
+
+// degrees of freedom of a product of 1D polynomials of the degree of the
+// element, see tests/fe/hanging_nodes_hermite.cc
+template <int dim>
+double
+vertex_dof_value(
+  const std::vector<Polynomials::Polynomial<double>> &polynomials,
+  const Point<dim> &                                   p,
+  const unsigned int                                   regularity,
+  const unsigned int                                   vertex_dof)
+{
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+
+  double              result = 1.;
+  unsigned int        index  = vertex_dof;
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int d = 0; d < dim; ++d, index /= regularity + 1)
+    {
+      const unsigned int m = index % (regularity + 1);
+      polynomials[d].value(p[d], values);
+      basis_1d[m].value(0., basis_values);
+      result *= values[m] / basis_values[m];
+    }
+  return result;
+}
+
+
+
+template <int dim>
+class ProductPolynomial : public Function<dim>
+{
+public:
+  ProductPolynomial(
+    const std::vector<Polynomials::Polynomial<double>> &polynomials)
+    : polynomials(polynomials)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double result = 1.;
+    for (unsigned int d = 0; d < dim; ++d)
+      result *= polynomials[d].value(p[d]);
+    return result;
+  }
+
+private:
+  const std::vector<Polynomials::Polynomial<double>> polynomials;
+};
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  std::vector<unsigned int> repetitions(dim, 3);
+  Point<dim>                p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    p2[d] = 1.5 + 0.25 * d;
+
+  parallel::distributed::Triangulation<dim> tr(MPI_COMM_WORLD);
+  GridGenerator::subdivided_hyper_rectangle(tr, repetitions, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  const IndexSet &locally_owned_dofs = dof.locally_owned_dofs();
+  IndexSet        locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof, locally_relevant_dofs);
+
+  // the random coefficients are the same on all processes
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(fe.degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+
+  AffineConstraints<double> constraints(locally_relevant_dofs);
+  constraints.close();
+
+  LinearAlgebra::distributed::Vector<double> projected(locally_owned_dofs,
+                                                       locally_relevant_dofs,
+                                                       MPI_COMM_WORLD);
+  VectorTools::project(mapping,
+                       dof,
+                       constraints,
+                       QGauss<dim>(fe.degree + 1),
+                       ProductPolynomial<dim>(polynomials),
+                       projected,
+                       false,
+                       QGauss<dim - 1>(fe.degree + 1),
+                       true);
+
+  bool ok = true;
+  for (const auto &cell : dof.active_cell_iterators())
+    if (cell->is_locally_owned())
+      for (const unsigned int v : cell->vertex_indices())
+        for (unsigned int i = 0; i < fe.n_dofs_per_vertex(); ++i)
+          {
+            const types::global_dof_index index = cell->vertex_dof_index(v, i);
+            if (locally_owned_dofs.is_element(index) &&
+                std::abs(projected(index) - vertex_dof_value(polynomials,
+                                                             cell->vertex(v),
+                                                             regularity,
+                                                             i)) > 1e-8)
+              ok = false;
+          }
+  ok = Utilities::MPI::min(ok ? 1 : 0, MPI_COMM_WORLD) == 1;
+
+  deallog << "dim=" << dim << ", regularity=" << regularity << ": "
+          << (ok ? "OK" : "FAILED") << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  std::ofstream logfile;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      logfile.open("output");
+      deallog.attach(logfile);
+    }
+
+  test<2>(0);
+  test<2>(1);
+  test<3>(1);
+
+  return 0;
+}
@@ -0,0 +1,332 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test PreconditionMGMixedPrecision: a V-cycle in single precision inside a
+// conjugate gradient solver in double precision must need as many iterations
+// as the V-cycle in double precision and reach the same solution. Also check
+// that the conversion within the first Chebyshev step gives the same result
+// as a separate conversion.
+
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <deal.II/multigrid/mg_mixed_precision.h>
+#include <deal.II/multigrid/mg_transfer_matrix_free.h>
+
+#include "../tests.h"
+
+
+
+// the operator -Delta + 1 without boundary conditions, on the active cells
+// or on a level of the mesh
+template <int dim, typename Number>
+class HelmholtzOperator : public Subscriptor
+{
+public:
+  using value_type = Number;
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  void
+  reinit(const DoFHandler<dim> &dof_handler,
+         const unsigned int     level = numbers::invalid_unsigned_int)
+  {
+    typename MatrixFree<dim, Number>::AdditionalData data;
+    data.mapping_update_flags =
+      update_values | update_gradients | update_JxW_values;
+    data.mg_level = level;
+
+    AffineConstraints<Number> constraints;
+    constraints.close();
+    matrix_free.reinit(MappingQ1<dim>(),
+                       dof_handler,
+                       constraints,
+                       QGauss<1>(dof_handler.get_fe().degree + 1),
+                       data);
+  }
+
+  types::global_dof_index
+  m() const
+  {
+    return matrix_free.get_vector_partitioner()->size();
+  }
+
+  Number
+  el(unsigned int, unsigned int) const
+  {
+    Assert(false, ExcNotImplemented());
+    return 0;
+  }
+
+  void
+  initialize_dof_vector(VectorType &vector) const
+  {
+    matrix_free.initialize_dof_vector(vector);
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    matrix_free.cell_loop(&HelmholtzOperator::local_apply,
+                          this,
+                          dst,
+                          src,
+                          true);
+  }
+
+  void
+  compute_inverse_diagonal(VectorType &diagonal) const
+  {
+    MatrixFreeTools::compute_diagonal(matrix_free,
+                                      diagonal,
+                                      &HelmholtzOperator::do_cell_integral,
+                                      this);
+    for (auto &entry : diagonal)
+      entry = 1. / entry;
+  }
+
+private:
+  using FECellIntegrator = FEEvaluation<dim, -1, 0, 1, Number>;
+
+  void
+  do_cell_integral(FECellIntegrator &phi) const
+  {
+    phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+    for (unsigned int q = 0; q < phi.n_q_points; ++q)
+      {
+        phi.submit_value(phi.get_value(q), q);
+        phi.submit_gradient(phi.get_gradient(q), q);
+      }
+    phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+  }
+
+  void
+  local_apply(const MatrixFree<dim, Number> &              data,
+              VectorType &                                 dst,
+              const VectorType &                           src,
+              const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FECellIntegrator phi(data);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.read_dof_values(src);
+        do_cell_integral(phi);
+        phi.distribute_local_to_global(dst);
+      }
+  }
+
+  MatrixFree<dim, Number> matrix_free;
+};
+
+
+
+// estimate the largest eigenvalue of the Jacobi-preconditioned matrix by a
+// few steps of the power method
+template <typename MatrixType, typename VectorType>
+double
+estimate_max_eigenvalue(const MatrixType &matrix,
+                        const VectorType &inverse_diagonal)
+{
+  VectorType x, y;
+  matrix.initialize_dof_vector(x);
+  matrix.initialize_dof_vector(y);
+  for (unsigned int i = 0; i < x.locally_owned_size(); ++i)
+    x.local_element(i) = 1. + 0.1 * (i % 7);
+
+  double eigenvalue = 0.;
+  for (unsigned int it = 0; it < 30; ++it)
+    {
+      x /= x.l2_norm();
+      matrix.vmult(y, x);
+      y.scale(inverse_diagonal);
+      eigenvalue = x * y;
+      x.swap(y);
+    }
+  return eigenvalue;
+}
+
+
+
+template <int dim, typename LevelNumber>
+unsigned int
+solve(const DoFHandler<dim> &                           dof_handler,
+      LinearAlgebra::distributed::Vector<double> &      solution,
+      const LinearAlgebra::distributed::Vector<double> &rhs,
+      const HelmholtzOperator<dim, double> &            system_matrix)
+{
+  using LevelVectorType = LinearAlgebra::distributed::Vector<LevelNumber>;
+  using LevelMatrixType = HelmholtzOperator<dim, LevelNumber>;
+  using Preconditioner  = PreconditionMGMixedPrecision<LevelMatrixType>;
+
+  const unsigned int min_level = 0;
+  const unsigned int max_level =
+    dof_handler.get_triangulation().n_global_levels() - 1;
+
+  MGLevelObject<LevelMatrixType> matrices(min_level, max_level);
+  MGLevelObject<typename Preconditioner::SmootherType::AdditionalData>
+    smoother_data(min_level, max_level);
+  for (unsigned int level = min_level; level <= max_level; ++level)
+    {
+      matrices[level].reinit(dof_handler, level);
+
+      auto &data          = smoother_data[level];
+      data.preconditioner = std::make_shared<DiagonalMatrix<LevelVectorType>>();
+      matrices[level].compute_inverse_diagonal(
+        data.preconditioner->get_vector());
+      data.degree = 3;
+      data.polynomial_type =
+        Preconditioner::SmootherType::AdditionalData::PolynomialType::
+          fourth_kind;
+      data.eig_cg_n_iterations = 0;
+      data.max_eigenvalue =
+        1.2 * estimate_max_eigenvalue(matrices[level],
+                                      data.preconditioner->get_vector());
+    }
+
+  MGTransferMatrixFree<dim, LevelNumber> transfer;
+  transfer.build(dof_handler);
+
+  Preconditioner preconditioner;
+  preconditioner.initialize(matrices,
+                            transfer,
+                            smoother_data,
+                            typename Preconditioner::AdditionalData(1e-3));
+
+  ReductionControl control(100, 1e-14, 1e-8, false, false);
+  SolverCG<LinearAlgebra::distributed::Vector<double>> solver(control);
+  solution = 0.;
+  solver.solve(system_matrix, solution, rhs, preconditioner);
+
+  return control.last_step();
+}
+
+
+
+template <int dim>
+void
+test_conversion(const DoFHandler<dim> &dof_handler)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<float>;
+  using ChebyshevType =
+    PreconditionChebyshev<HelmholtzOperator<dim, float>, VectorType>;
+
+  HelmholtzOperator<dim, float> matrix;
+  matrix.reinit(dof_handler);
+
+  typename ChebyshevType::AdditionalData data;
+  data.preconditioner = std::make_shared<DiagonalMatrix<VectorType>>();
+  matrix.compute_inverse_diagonal(data.preconditioner->get_vector());
+  data.degree              = 4;
+  data.eig_cg_n_iterations = 0;
+  data.max_eigenvalue      = 2.;
+  ChebyshevType chebyshev;
+  chebyshev.initialize(matrix, data);
+
+  LinearAlgebra::distributed::Vector<double> src;
+  VectorType                                 src_float, rhs, dst1, dst2;
+  matrix.initialize_dof_vector(src_float);
+  matrix.initialize_dof_vector(rhs);
+  matrix.initialize_dof_vector(dst1);
+  matrix.initialize_dof_vector(dst2);
+  src.reinit(src_float.get_partitioner());
+  for (unsigned int i = 0; i < src.locally_owned_size(); ++i)
+    src.local_element(i) = random_value<double>();
+
+  src_float.copy_locally_owned_data_from(src);
+  chebyshev.vmult(dst1, src_float);
+  chebyshev.vmult_with_conversion(dst2, rhs, src);
+
+  rhs -= src_float;
+  dst2 -= dst1;
+  deallog << "dim=" << dim << " conversion within Chebyshev: "
+          << (rhs.linfty_norm() == 0.f && dst2.linfty_norm() == 0.f ? "OK" :
+                                                                      "FAILED")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(6 - dim);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(FE_Q<dim>(3));
+  dof_handler.distribute_mg_dofs();
+
+  test_conversion(dof_handler);
+
+  HelmholtzOperator<dim, double> system_matrix;
+  system_matrix.reinit(dof_handler);
+
+  LinearAlgebra::distributed::Vector<double> rhs, solution_float,
+    solution_double;
+  system_matrix.initialize_dof_vector(rhs);
+  system_matrix.initialize_dof_vector(solution_float);
+  system_matrix.initialize_dof_vector(solution_double);
+  for (unsigned int i = 0; i < rhs.locally_owned_size(); ++i)
+    rhs.local_element(i) = 1. + 0.1 * (i % 5);
+
+  const unsigned int n_iterations_float =
+    solve<dim, float>(dof_handler, solution_float, rhs, system_matrix);
+  const unsigned int n_iterations_double =
+    solve<dim, double>(dof_handler, solution_double, rhs, system_matrix);
+
+  solution_float -= solution_double;
+  const double difference =
+    solution_float.linfty_norm() / solution_double.linfty_norm();
+  deallog << "dim=" << dim << " CG iterations with float V-cycle: "
+          << n_iterations_float
+          << ", with double V-cycle: " << n_iterations_double
+          << ", difference: " << (difference < 1e-6 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+
+  return 0;
+}
@@ -0,0 +1,172 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test MGTransferMatrixFree with FE_Hermite. The degrees of freedom of
+ * FE_Hermite are derivatives in real space, so the transfer needs to rescale
+ * them by the extents of the parent cells. A polynomial in the finite
+ * element space is prolongated between the levels of a mesh with cells of
+ * different sizes and aspect ratios and compared against its exact degrees
+ * of freedom on the finer level. Restriction is checked to be the transpose
+ * of prolongation.
+ */
+
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/multigrid/mg_transfer_matrix_free.h>
+
+#include "../tests.h"
+
+
+// degrees of freedom of a product of 1D polynomials of the degree of the
+// element, see tests/fe/hanging_nodes_hermite.cc
+template <int dim>
+double
+vertex_dof_value(
+  const std::vector<Polynomials::Polynomial<double>> &polynomials,
+  const Point<dim> &                                   p,
+  const unsigned int                                   regularity,
+  const unsigned int                                   vertex_dof)
+{
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+
+  double              result = 1.;
+  unsigned int        index  = vertex_dof;
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int d = 0; d < dim; ++d, index /= regularity + 1)
+    {
+      const unsigned int m = index % (regularity + 1);
+      polynomials[d].value(p[d], values);
+      basis_1d[m].value(0., basis_values);
+      result *= values[m] / basis_values[m];
+    }
+  return result;
+}
+
+
+
+template <int dim, typename Number>
+void
+check(const unsigned int regularity)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5 + 0.25 * d, 1.0};
+      p2[d]         = 1.5 + 0.25 * d;
+    }
+
+  Triangulation<dim> tr(Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+  tr.refine_global(2);
+
+  FE_Hermite<dim> fe(regularity);
+  DoFHandler<dim> mgdof(tr);
+  mgdof.distribute_dofs(fe);
+  mgdof.distribute_mg_dofs();
+
+  MGTransferMatrixFree<dim, Number> transfer;
+  transfer.build(mgdof);
+
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(fe.degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+
+  const unsigned int dofs_per_vertex = fe.n_dofs_per_vertex();
+  std::vector<LinearAlgebra::distributed::Vector<Number>> exact(
+    tr.n_global_levels());
+  for (unsigned int level = 0; level < tr.n_global_levels(); ++level)
+    {
+      exact[level].reinit(mgdof.n_dofs(level));
+      for (const auto &cell : mgdof.mg_cell_iterators_on_level(level))
+        for (const unsigned int v : cell->vertex_indices())
+          for (unsigned int i = 0; i < dofs_per_vertex; ++i)
+            exact[level](cell->mg_vertex_dof_index(level, v, i)) =
+              vertex_dof_value(polynomials, cell->vertex(v), regularity, i);
+    }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity << ", "
+          << (std::is_same<Number, float>::value ? "float" : "double")
+          << std::endl;
+
+  const Number tolerance = 1000. * std::numeric_limits<Number>::epsilon();
+  for (unsigned int level = 1; level < tr.n_global_levels(); ++level)
+    {
+      LinearAlgebra::distributed::Vector<Number> fine(mgdof.n_dofs(level)),
+        coarse(mgdof.n_dofs(level - 1));
+      transfer.prolongate(level, fine, exact[level - 1]);
+      fine -= exact[level];
+      const Number prolongation_error =
+        fine.linfty_norm() / exact[level].linfty_norm();
+
+      // restriction must be the transpose of prolongation
+      LinearAlgebra::distributed::Vector<Number> random_fine(
+        mgdof.n_dofs(level)),
+        random_coarse(mgdof.n_dofs(level - 1));
+      for (unsigned int i = 0; i < random_fine.size(); ++i)
+        random_fine(i) = random_value<Number>();
+      for (unsigned int i = 0; i < random_coarse.size(); ++i)
+        random_coarse(i) = random_value<Number>();
+      transfer.prolongate(level, fine, random_coarse);
+      transfer.restrict_and_add(level, coarse, random_fine);
+      const Number product_fine   = fine * random_fine;
+      const Number product_coarse = coarse * random_coarse;
+      const Number restriction_error =
+        std::abs(product_fine - product_coarse) / std::abs(product_fine);
+
+      deallog << "level=" << level << ", dofs=" << mgdof.n_dofs(level)
+              << ", relative error of prolongation: "
+              << filter_out_small_numbers(prolongation_error, tolerance)
+              << ", of restriction as its transpose: "
+              << filter_out_small_numbers(restriction_error, tolerance)
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  check<1, double>(1);
+  check<1, double>(2);
+  check<2, double>(1);
+  check<2, double>(2);
+  check<2, float>(1);
+  check<3, double>(1);
+
+  return 0;
+}
@@ -0,0 +1,299 @@
+/*
+ * Benchmark of the FE_Hermite pipeline: construction of the element,
+ * FEValues::reinit(), assembly of the mass and Laplace matrices, L2
+ * projection and boundary projection, for dim 1 to 3 and regularity 0 to 3.
+ * Each step is compared with FE_Q of the same polynomial degree on the same
+ * mesh, using MappingCartesian as the affine mapping for FE_Q. The best of
+ * several runs is reported as throughput in degrees of freedom per second
+ * on standard output, together with the peak resident memory of the
+ * process, so that the numbers can be collected from the log of the test.
+ * For the wave equation, the time steps per second of
+ * MatrixFreeOperators::HermiteWaveOperator are compared with the same
+ * low-storage Runge-Kutta method on assembled mass and Laplace matrices.
+ * Only the mesh sizes and the numbers of degrees of freedom are compared
+ * with the output file.
+ */
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/time_stepping.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_cartesian.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/la_parallel_block_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/hermite_wave_operator.h>
+
+#include <deal.II/numerics/matrix_tools.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#include "../tests.h"
+
+
+// number of runs of each step, of which the fastest one is reported
+const unsigned int n_runs = 3;
+
+
+
+// the wall time of the fastest of n_runs calls of the given function
+double
+best_time(const std::function<void()> &function)
+{
+  double result = std::numeric_limits<double>::max();
+  for (unsigned int run = 0; run < n_runs; ++run)
+    {
+      Timer timer;
+      function();
+      result = std::min(result, timer.wall_time());
+    }
+  return result;
+}
+
+
+
+template <int dim, typename MappingType>
+void
+benchmark(const MappingType &       mapping,
+          const FiniteElement<dim> &fe,
+          const Triangulation<dim> &tr)
+{
+  const double construction_time = best_time([&]() { fe.clone(); });
+
+  DoFHandler<dim> dof(tr);
+  dof.distribute_dofs(fe);
+  const double n_dofs = dof.n_dofs();
+
+  const QGauss<dim>     quadrature(fe.degree + 1);
+  const QGauss<dim - 1> face_quadrature(fe.degree + 1);
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          quadrature,
+                          update_values | update_gradients |
+                            update_JxW_values);
+  const double  reinit_time = best_time([&]() {
+    for (const auto &cell : dof.active_cell_iterators())
+      fe_values.reinit(cell);
+  });
+
+  DynamicSparsityPattern dsp(dof.n_dofs());
+  DoFTools::make_sparsity_pattern(dof, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  SparseMatrix<double> matrix(sparsity);
+  const double         mass_time = best_time([&]() {
+    MatrixCreator::create_mass_matrix(mapping, dof, quadrature, matrix);
+  });
+  const double         laplace_time = best_time([&]() {
+    MatrixCreator::create_laplace_matrix(mapping, dof, quadrature, matrix);
+  });
+
+  const ScalarFunctionFromFunctionObject<dim> function(
+    [](const Point<dim> &p) { return std::sin(p[0]) * std::exp(p[dim - 1]); });
+  AffineConstraints<double> constraints;
+  constraints.close();
+  Vector<double> solution(dof.n_dofs());
+  const double   project_time = best_time([&]() {
+    VectorTools::project(
+      mapping, dof, constraints, quadrature, function, solution);
+  });
+
+  std::map<types::boundary_id, const Function<dim> *> boundary_functions;
+  boundary_functions[0] = &function;
+  std::map<types::global_dof_index, double> boundary_values;
+  const double boundary_time = best_time([&]() {
+    boundary_values.clear();
+    VectorTools::project_boundary_values(
+      mapping, dof, boundary_functions, face_quadrature, boundary_values);
+  });
+
+  Utilities::System::MemoryStats stats;
+  Utilities::System::get_memory_stats(stats);
+
+  deallog << fe.get_name() << ", cells=" << tr.n_active_cells()
+          << ", dofs=" << dof.n_dofs() << std::endl;
+
+  std::cout << std::left << std::setw(24) << fe.get_name() << std::right
+            << std::scientific << std::setprecision(2) << std::setw(10)
+            << construction_time << std::setw(10) << n_dofs / reinit_time
+            << std::setw(10) << n_dofs / mass_time << std::setw(10)
+            << n_dofs / laplace_time << std::setw(10) << n_dofs / project_time
+            << std::setw(10) << n_dofs / boundary_time << std::setw(10)
+            << stats.VmHWM / 1024 << std::endl;
+}
+
+
+
+// time steps per second of the wave equation with the matrix-free operator
+// and with assembled matrices, using the same Runge-Kutta method and the same
+// accuracy of the inverse mass matrix
+template <int dim>
+void
+benchmark_wave(const FE_Hermite<dim> &fe, const Triangulation<dim> &tr)
+{
+  const unsigned int n_steps   = 5;
+  const double       time_step = 1e-4;
+
+  MappingHermite<dim> mapping;
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+  const unsigned int n_dofs = dof.n_dofs();
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  const ScalarFunctionFromFunctionObject<dim> function(
+    [](const Point<dim> &p) { return std::sin(p[0]) * std::exp(p[dim - 1]); });
+
+  TimeStepping::LowStorageRungeKutta<
+    LinearAlgebra::distributed::BlockVector<double>>
+    integrator(TimeStepping::LOW_STORAGE_RK_STAGE5_ORDER4);
+
+  MatrixFreeOperators::HermiteWaveOperator<dim> wave_operator;
+  wave_operator.reinit(mapping, dof, constraints, QGauss<1>(fe.degree + 1));
+  LinearAlgebra::distributed::BlockVector<double> initial, solution;
+  wave_operator.initialize_dof_vector(initial);
+  VectorTools::project(mapping,
+                       dof,
+                       constraints,
+                       QGauss<dim>(fe.degree + 1),
+                       function,
+                       initial.block(0));
+  const double matrix_free_time = best_time([&]() {
+    solution   = initial;
+    double time = 0.;
+    for (unsigned int step = 0; step < n_steps; ++step)
+      time = wave_operator.evolve_one_time_step(integrator,
+                                                time,
+                                                time_step,
+                                                solution);
+  });
+
+  DynamicSparsityPattern dsp(n_dofs);
+  DoFTools::make_sparsity_pattern(dof, dsp);
+  SparsityPattern sparsity;
+  sparsity.copy_from(dsp);
+  SparseMatrix<double> mass_matrix(sparsity), laplace_matrix(sparsity);
+  const QGauss<dim>    quadrature(fe.degree + 1);
+  MatrixCreator::create_mass_matrix(mapping, dof, quadrature, mass_matrix);
+  MatrixCreator::create_laplace_matrix(mapping,
+                                       dof,
+                                       quadrature,
+                                       laplace_matrix);
+  PreconditionSSOR<SparseMatrix<double>> preconditioner;
+  preconditioner.initialize(mass_matrix, 1.2);
+
+  Vector<double> tmp(n_dofs);
+  const auto     assembled_rhs = [&](const double, const BlockVector<double> &y) {
+    BlockVector<double> result(y);
+    result.block(0) = y.block(1);
+    laplace_matrix.vmult(tmp, y.block(0));
+    tmp *= -1.;
+    ReductionControl         control(5 * n_dofs, 0., 1e-12, false, false);
+    SolverCG<Vector<double>> cg(control);
+    result.block(1) = 0.;
+    cg.solve(mass_matrix, result.block(1), tmp, preconditioner);
+    return result;
+  };
+
+  TimeStepping::LowStorageRungeKutta<BlockVector<double>> integrator_assembled(
+    TimeStepping::LOW_STORAGE_RK_STAGE5_ORDER4);
+  BlockVector<double> solution_assembled(2, n_dofs);
+  const double        assembled_time = best_time([&]() {
+    BlockVector<double> vec_ri(solution_assembled), vec_ki(solution_assembled);
+    std::copy(initial.block(0).begin(),
+              initial.block(0).end(),
+              solution_assembled.block(0).begin());
+    solution_assembled.block(1) = 0.;
+    double time                 = 0.;
+    for (unsigned int step = 0; step < n_steps; ++step)
+      time = integrator_assembled.evolve_one_time_step(assembled_rhs,
+                                                       time,
+                                                       time_step,
+                                                       solution_assembled,
+                                                       vec_ri,
+                                                       vec_ki);
+  });
+
+  deallog << "wave equation " << fe.get_name() << ", dofs=" << 2 * n_dofs
+          << std::endl;
+
+  std::cout << "wave equation " << std::left << std::setw(24)
+            << fe.get_name() << std::right << std::scientific
+            << std::setprecision(2) << "steps/s matrix-free: " << std::setw(10)
+            << n_steps / matrix_free_time << ", assembled: " << std::setw(10)
+            << n_steps / assembled_time << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity, const unsigned int target_n_dofs)
+{
+  const FE_Hermite<dim> fe_hermite(regularity);
+  const FE_Q<dim>       fe_q(fe_hermite.degree);
+
+  // refine until the spaces have about the requested size
+  Triangulation<dim> tr;
+  GridGenerator::hyper_cube(tr);
+  while (tr.n_active_cells() * Utilities::pow(fe_hermite.degree, dim) <
+         target_n_dofs)
+    tr.refine_global(1);
+
+  benchmark(MappingHermite<dim>(), fe_hermite, tr);
+  benchmark(MappingCartesian<dim>(), fe_q, tr);
+
+  if (dim > 1 && regularity > 0)
+    benchmark_wave(fe_hermite, tr);
+}
+
+
+
+int
+main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  std::cout << std::left << std::setw(24) << "element" << std::right
+            << std::setw(10) << "create[s]" << std::setw(10) << "reinit"
+            << std::setw(10) << "mass" << std::setw(10) << "laplace"
+            << std::setw(10) << "project" << std::setw(10) << "boundary"
+            << std::setw(10) << "peak[MB]" << std::endl
+            << "(throughput in DoFs/s)" << std::endl;
+
+  for (unsigned int regularity = 0; regularity < 4; ++regularity)
+    test<1>(regularity, 100000);
+  for (unsigned int regularity = 0; regularity < 4; ++regularity)
+    test<2>(regularity, 50000);
+  for (unsigned int regularity = 0; regularity < 4; ++regularity)
+    test<3>(regularity, 8000);
+
+  return 0;
+}
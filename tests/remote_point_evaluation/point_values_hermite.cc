@@ -0,0 +1,165 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/*
+ * Test VectorTools::point_values() and VectorTools::point_gradients() for
+ * FE_Hermite with MappingHermite, which use FEPointEvaluation and its fast
+ * path for FE_Hermite. The degrees of freedom are set to the derivatives of
+ * a polynomial in the finite element space at the vertices, so the values
+ * and gradients at arbitrary points must match the ones of the polynomial.
+ */
+
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_hermite.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_hermite.h>
+#include <deal.II/fe/mapping_hermite.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools_evaluate.h>
+
+#include "../tests.h"
+
+
+// degrees of freedom of a product of 1D polynomials of the degree of the
+// element, see tests/fe/hanging_nodes_hermite.cc
+template <int dim>
+double
+vertex_dof_value(
+  const std::vector<Polynomials::Polynomial<double>> &polynomials,
+  const Point<dim> &                                   p,
+  const unsigned int                                   regularity,
+  const unsigned int                                   vertex_dof)
+{
+  const std::vector<Polynomials::Polynomial<double>> basis_1d =
+    Polynomials::HermiteMaxreg::generate_complete_basis(regularity);
+
+  double              result = 1.;
+  unsigned int        index  = vertex_dof;
+  std::vector<double> values(regularity + 1), basis_values(regularity + 1);
+  for (unsigned int d = 0; d < dim; ++d, index /= regularity + 1)
+    {
+      const unsigned int m = index % (regularity + 1);
+      polynomials[d].value(p[d], values);
+      basis_1d[m].value(0., basis_values);
+      result *= values[m] / basis_values[m];
+    }
+  return result;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int regularity)
+{
+  std::vector<std::vector<double>> step_sizes(dim);
+  Point<dim>                       p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      step_sizes[d] = {0.5, 0.25 + 0.1 * d, 1.0};
+      p2[d]         = 1.75 + 0.1 * d;
+    }
+
+  Triangulation<dim> tr;
+  GridGenerator::subdivided_hyper_rectangle(tr, step_sizes, Point<dim>(), p2);
+
+  MappingHermite<dim> mapping;
+  FE_Hermite<dim>     fe(regularity);
+  DoFHandler<dim>     dof(tr);
+  dof.distribute_dofs(fe);
+
+  std::vector<Polynomials::Polynomial<double>> polynomials;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      std::vector<double> coefficients(fe.degree + 1);
+      for (double &c : coefficients)
+        c = random_value<double>();
+      polynomials.emplace_back(coefficients);
+    }
+
+  Vector<double> solution(dof.n_dofs());
+  for (const auto &cell : dof.active_cell_iterators())
+    for (const unsigned int v : cell->vertex_indices())
+      for (unsigned int i = 0; i < fe.n_dofs_per_vertex(); ++i)
+        solution(cell->vertex_dof_index(v, i)) =
+          vertex_dof_value(polynomials, cell->vertex(v), regularity, i);
+
+  std::vector<Point<dim>> points(20);
+  for (Point<dim> &p : points)
+    for (unsigned int d = 0; d < dim; ++d)
+      p[d] = random_value<double>(0., p2[d]);
+
+  Utilities::MPI::RemotePointEvaluation<dim> cache;
+  const std::vector<double>                  values =
+    VectorTools::point_values<1>(mapping, dof, solution, points, cache);
+  const std::vector<Tensor<1, dim>> gradients =
+    VectorTools::point_gradients<1>(mapping, dof, solution, points, cache);
+
+  double values_error = 0., gradients_error = 0.;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      double         value = 1.;
+      Tensor<1, dim> gradient;
+      for (unsigned int d = 0; d < dim; ++d)
+        gradient[d] = 1.;
+      std::vector<double> derivatives(2);
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          polynomials[d].value(points[i][d], derivatives);
+          value *= derivatives[0];
+          for (unsigned int e = 0; e < dim; ++e)
+            gradient[e] *= (d == e ? derivatives[1] : derivatives[0]);
+        }
+
+      values_error = std::max(values_error, std::abs(values[i] - value));
+      gradients_error =
+        std::max(gradients_error, (gradients[i] - gradient).norm());
+    }
+
+  deallog << "dim=" << dim << ", regularity=" << regularity
+          << ", value at first point: " << values[0]
+          << ", gradient: " << gradients[0] << std::endl;
+  deallog << "errors of values: " << filter_out_small_numbers(values_error, 1e-10)
+          << ", gradients: " << filter_out_small_numbers(gradients_error, 1e-10)
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  test<1>(1);
+  test<2>(0);
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+
+  return 0;
+}